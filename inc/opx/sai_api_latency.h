@@ -0,0 +1,139 @@
+/*
+ * Copyright (c) 2016 Dell Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * THIS CODE IS PROVIDED ON AN *AS IS* BASIS, WITHOUT WARRANTIES OR
+ * CONDITIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING WITHOUT
+ * LIMITATION ANY IMPLIED WARRANTIES OR CONDITIONS OF TITLE, FITNESS
+ * FOR A PARTICULAR PURPOSE, MERCHANTABLITY OR NON-INFRINGEMENT.
+ *
+ * See the Apache Version 2.0 License for specific language governing
+ * permissions and limitations under the License.
+ */
+
+/**
+ * @file sai_api_latency.h
+ *
+ * @brief This file contains the data structures and function prototypes
+ *        for the SAI API latency instrumentation layer. The layer wraps
+ *        selected functions of the method tables returned by sai_api_query
+ *        and keeps per function latency histograms, split into common
+ *        layer time and NPU plugin time.
+ */
+
+#ifndef __SAI_API_LATENCY_H__
+#define __SAI_API_LATENCY_H__
+
+#include "sai.h"
+#include "saitypes.h"
+#include "std_type_defs.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+/*
+ * Latencies are kept in log-linear histograms of nanoseconds. Bucket 0
+ * counts durations below 1us. Every power of two above that is split in
+ * SAI_API_LATENCY_HIST_SUB_BUCKETS linear buckets and the last bucket
+ * counts everything above the previous bucket.
+ */
+#define SAI_API_LATENCY_HIST_MIN_SHIFT     (10)
+#define SAI_API_LATENCY_HIST_SUB_SHIFT     (2)
+#define SAI_API_LATENCY_HIST_SUB_BUCKETS   (1 << SAI_API_LATENCY_HIST_SUB_SHIFT)
+#define SAI_API_LATENCY_HIST_OCTAVES       (24)
+#define SAI_API_LATENCY_HIST_BUCKETS       \
+        (1 + (SAI_API_LATENCY_HIST_OCTAVES * SAI_API_LATENCY_HIST_SUB_BUCKETS))
+
+#define SAI_API_LATENCY_NAME_LEN_MAX       (48)
+
+/*
+ * SAI API functions instrumented by the latency layer.
+ */
+typedef enum _sai_api_latency_func_t {
+    SAI_API_LATENCY_ROUTE_CREATE,
+    SAI_API_LATENCY_ROUTE_REMOVE,
+    SAI_API_LATENCY_ROUTE_SET,
+    SAI_API_LATENCY_ROUTE_GET,
+    SAI_API_LATENCY_FDB_CREATE,
+    SAI_API_LATENCY_FDB_REMOVE,
+    SAI_API_LATENCY_FDB_SET,
+    SAI_API_LATENCY_FDB_GET,
+    SAI_API_LATENCY_ACL_ENTRY_CREATE,
+    SAI_API_LATENCY_ACL_ENTRY_REMOVE,
+    SAI_API_LATENCY_ACL_ENTRY_SET,
+    SAI_API_LATENCY_ACL_ENTRY_GET,
+    SAI_API_LATENCY_PORT_SET,
+    SAI_API_LATENCY_PORT_GET,
+    SAI_API_LATENCY_QUEUE_SET,
+    SAI_API_LATENCY_QUEUE_GET,
+    SAI_API_LATENCY_SCHEDULER_CREATE,
+    SAI_API_LATENCY_SCHEDULER_REMOVE,
+    SAI_API_LATENCY_SCHEDULER_SET,
+    SAI_API_LATENCY_SCHEDULER_GET,
+    SAI_API_LATENCY_QOS_MAP_CREATE,
+    SAI_API_LATENCY_QOS_MAP_REMOVE,
+    SAI_API_LATENCY_QOS_MAP_SET,
+    SAI_API_LATENCY_QOS_MAP_GET,
+    SAI_API_LATENCY_FUNC_MAX,
+} sai_api_latency_func_t;
+
+/*
+ * Latency statistics of an instrumented SAI API function. Common layer
+ * time is the total time of a call minus the time spent in the NPU plugin
+ * calls made on its behalf.
+ */
+typedef struct _sai_api_latency_stats_t {
+    char     func_name [SAI_API_LATENCY_NAME_LEN_MAX];
+    sai_api_t api_id;
+    uint64_t call_count;
+    uint64_t error_count;
+    uint64_t total_ns;
+    uint64_t max_ns;
+    uint64_t common_total_ns;
+    uint64_t npu_total_ns;
+    uint64_t npu_call_count;
+    uint64_t common_hist [SAI_API_LATENCY_HIST_BUCKETS];
+    uint64_t npu_hist [SAI_API_LATENCY_HIST_BUCKETS];
+} sai_api_latency_stats_t;
+
+extern bool sai_api_latency_enabled;
+
+/*
+ * Returns the instrumented copy of an API method table, or the given
+ * table if no function of the API is instrumented.
+ */
+void *sai_api_latency_method_table_wrap (sai_api_t api_id, void *api_method_table);
+
+/*
+ * NPU plugin call hooks. The start time is zero when the layer is
+ * disabled or the NPU call is not made on behalf of an instrumented
+ * function.
+ */
+uint64_t sai_api_latency_npu_call_start (void);
+
+void sai_api_latency_npu_call_end (uint64_t start_ns);
+
+#define SAI_API_LATENCY_NPU_CALL(rc, npu_call)                              \
+    do {                                                                    \
+        uint64_t _npu_start_ns = sai_api_latency_npu_call_start ();         \
+        (rc) = (npu_call);                                                  \
+        sai_api_latency_npu_call_end (_npu_start_ns);                       \
+    } while (0)
+
+void sai_api_latency_enable (bool enable);
+
+void sai_api_latency_reset (void);
+
+/*
+ * Copies the statistics of all instrumented functions to stats_list. On
+ * input count holds the number of entries of stats_list, on output the
+ * number of entries filled.
+ */
+sai_status_t sai_api_latency_stats_get (uint32_t *count,
+                                        sai_api_latency_stats_t *stats_list);
+
+void sai_api_latency_dump (const char *func_name);
+
+#endif /* __SAI_API_LATENCY_H__ */
@@ -28,11 +28,65 @@
 #include "saitypes.h"
 #include "saifdb.h"
 #include "sai_fdb_api.h"
+#include "std_type_defs.h"
 
 #define SAI_FDB_MAX_FD 2
 #define SAI_FDB_READ_FD 0
 #define SAI_FDB_WRITE_FD 1
 
+/* Software aging time value to fall back to the VLAN or global aging time */
+#define SAI_FDB_AGING_TIME_INHERIT UINT32_MAX
+
+/**
+ * @brief Callback to poll the NPU hit bits of a batch of FDB entries.
+ *        hit_list[i] is set when fdb_entry_list[i] was hit since the
+ *        previous poll, the callback is expected to clear the hit bits.
+ */
+typedef void (*sai_fdb_hit_poll_fn) (uint_t count,
+                                     const sai_fdb_entry_t *fdb_entry_list,
+                                     bool *hit_list);
+
+typedef struct _sai_fdb_sw_aging_stats_t {
+    uint_t   timer_count;
+    uint64_t aged_count;
+    uint64_t hit_refresh_count;
+    uint64_t flush_fail_count;
+    uint64_t batch_count;
+} sai_fdb_sw_aging_stats_t;
+
+/* Filter for the FDB bulk export, unset match flags match every entry */
+typedef struct _sai_fdb_export_filter_t {
+    bool                 match_port;
+    sai_object_id_t      port_id;
+    bool                 match_vlan;
+    sai_vlan_id_t        vlan_id;
+    bool                 match_type;
+    sai_fdb_entry_type_t entry_type;
+} sai_fdb_export_filter_t;
+
+typedef struct _sai_fdb_export_entry_t {
+    sai_fdb_entry_t      fdb_entry;
+    sai_object_id_t      port_id;
+    sai_fdb_entry_type_t entry_type;
+    sai_packet_action_t  action;
+    uint32_t             metadata;
+} sai_fdb_export_entry_t;
+
+/**
+ * @brief Resume point of an FDB bulk export. Entries are returned in FDB
+ *        key order, the cursor holds the last key returned and the cache
+ *        generation seen so that changes during the export are detected.
+ */
+typedef struct _sai_fdb_export_cursor_t {
+    sai_fdb_export_filter_t filter;
+    bool                    key_valid;
+    sai_mac_t               mac_address;
+    sai_vlan_id_t           vlan_id;
+    uint64_t                start_generation;
+    uint64_t                generation;
+    bool                    done;
+} sai_fdb_export_cursor_t;
+
 sai_status_t sai_l2_fdb_set_aging_time(uint32_t value);
 
 sai_status_t sai_l2_fdb_get_aging_time(uint32_t *value);
@@ -72,6 +126,69 @@ sai_status_t sai_l2_deregister_fdb_entry(const sai_fdb_entry_t *fdb_entry);
 
 void sai_l2_fdb_register_internal_callback (sai_fdb_internal_callback_fn
                                                        fdb_internal_callback);
+
+/**
+ * @brief Enable or disable software FDB aging. When enabled the NPU aging
+ *        is turned off and dynamic entries are aged by the SAI using the
+ *        per port, per VLAN or global aging time in that order.
+ *        A hit poll callback must be registered before enabling, else
+ *        SAI_STATUS_UNINITIALIZED is returned. If the callback is removed
+ *        while enabled, expired entries are kept as if hit.
+ */
+sai_status_t sai_l2_fdb_sw_aging_enable(bool enable);
+
+bool sai_l2_fdb_sw_aging_is_enabled(void);
+
+sai_status_t sai_l2_fdb_sw_aging_vlan_time_set(sai_vlan_id_t vlan_id,
+                                               uint32_t value);
+
+sai_status_t sai_l2_fdb_sw_aging_port_time_set(sai_object_id_t port_id,
+                                               uint32_t value);
+
+void sai_l2_fdb_register_hit_poll_callback(sai_fdb_hit_poll_fn hit_poll_fn);
+
+void sai_l2_fdb_sw_aging_stats_get(sai_fdb_sw_aging_stats_t *p_stats);
+
+/**
+ * @brief Start an FDB bulk export, filter may be NULL to export all entries.
+ */
+void sai_l2_fdb_export_start(sai_fdb_export_cursor_t *cursor,
+                             const sai_fdb_export_filter_t *filter);
+
+/**
+ * @brief Return the next chunk of at most max_count entries of an export.
+ *        The FDB lock is only held for the chunk. count may be 0 while the
+ *        export is not done when a chunk scanned only filtered out entries.
+ */
+sai_status_t sai_l2_fdb_export_next(sai_fdb_export_cursor_t *cursor,
+                                    uint_t max_count,
+                                    sai_fdb_export_entry_t *entry_list,
+                                    uint_t *count);
+
+/**
+ * @brief Check whether the FDB cache changed since the export started. If
+ *        not, the chunks returned so far form a consistent snapshot.
+ */
+bool sai_l2_fdb_export_is_consistent(const sai_fdb_export_cursor_t *cursor);
+
+/* Internal APIs between the FDB cache, software aging and export */
+sai_status_t sai_fdb_sw_aging_time_set(uint32_t value);
+
+sai_status_t sai_fdb_sw_aging_time_get(uint32_t *value);
+
+void sai_fdb_sw_aging_entry_update(const sai_fdb_entry_t *fdb_entry,
+                                   sai_object_id_t port_id,
+                                   sai_fdb_entry_type_t entry_type);
+
+void sai_fdb_sw_aging_entry_remove(const sai_fdb_entry_t *fdb_entry);
+
+void sai_fdb_cache_generation_bump(void);
+
+uint64_t sai_fdb_cache_generation_get(void);
+
+void sai_l2_fdb_aged_entries_notify(uint_t count,
+                                    sai_fdb_event_notification_data_t *data);
+
 void sai_dump_all_fdb_entry_nodes (void);
 
 void sai_dump_all_fdb_entry_count (void);
@@ -84,4 +201,6 @@ void sai_dump_fdb_entry_nodes_per_vlan (sai_vlan_id_t vlan_id);
 
 void sai_dump_fdb_entry_nodes_per_port_vlan (sai_object_id_t port_id,
                                              sai_vlan_id_t vlan_id);
+
+void sai_dump_fdb_sw_aging (void);
 #endif
@@ -31,5 +31,29 @@
 
 void sai_hostif_rx_register_callback(sai_packet_event_notification_fn rx_register_fn);
 sai_status_t sai_hostif_get_default_trap_group(sai_attribute_t *attr);
+
+/*
+ * Received packet and byte counters per trap and per cpu queue, maintained
+ * by the common layer on the packet rx path.
+ */
+sai_status_t sai_hostif_trap_counters_get(sai_hostif_trap_type_t trap_id,
+                                          uint64_t *packets, uint64_t *bytes);
+sai_status_t sai_hostif_cpu_queue_counters_get(uint32_t cpu_queue,
+                                               uint64_t *packets, uint64_t *bytes);
+void sai_hostif_counters_clear(void);
+
+/*
+ * Transmit pkt_count packets sharing a single packet attribute list.
+ * The attribute list is validated once for the whole batch and the
+ * result of each packet transmission is returned in status_list.
+ * Returns SAI_STATUS_SUCCESS only if all the packets were transmitted.
+ */
+sai_status_t sai_hostif_send_packet_bulk(sai_object_id_t hif_id,
+                                         uint32_t pkt_count,
+                                         void **buffer_list,
+                                         const sai_size_t *buffer_size_list,
+                                         uint32_t attr_count,
+                                         sai_attribute_t *attr_list,
+                                         sai_status_t *status_list);
 #endif
 
@@ -40,6 +40,24 @@
 #define DN_HOSTIF_MAX_TRAP_GROUPS          (128)
 #define DN_HOSTIF_DEFAULT_MIN_PRIO         (0)
 #define DN_HOSTIF_DEFAULT_TRAP_GROUP_ATTRS (3)
+
+/* CPU queues beyond this range fall back to a trap group tree walk */
+#define DN_HOSTIF_MAX_CPU_QUEUES           (64)
+#define DN_HOSTIF_INVALID_CPU_QUEUE        (DN_HOSTIF_MAX_CPU_QUEUES)
+
+/*
+ * Trap ids are grouped by SAI in ranges of (1 << DN_HOSTIF_TRAP_RANGE_SHIFT).
+ * The first DN_HOSTIF_TRAP_RANGE_SIZE ids of each range are direct indexed.
+ */
+#define DN_HOSTIF_TRAP_RANGE_SHIFT         (12)
+#define DN_HOSTIF_TRAP_RANGE_COUNT         (8)
+#define DN_HOSTIF_TRAP_RANGE_SIZE          (64)
+#define DN_HOSTIF_MAX_TRAP_INDEX           (DN_HOSTIF_TRAP_RANGE_COUNT * \
+                                            DN_HOSTIF_TRAP_RANGE_SIZE)
+
+/* Packet attribute ids are tracked in a 64 bit mask during pkt send */
+#define DN_HOSTIF_PKT_ATTR_MASK_BITS       (64)
+#define DN_HOSTIF_PKT_ATTR_BIT(attr_id)    (((uint64_t)1) << (attr_id))
 typedef struct _dn_sai_hostif_pkt_attr_property_t {
     sai_attr_id_t attr_id;
     bool valid_on_send;
@@ -60,6 +78,11 @@ typedef struct _dn_sai_hostif_trap_group_attr_property_t {
     bool valid_in_set;
 } dn_sai_hostif_trap_group_attr_property_t;
 
+typedef struct _dn_sai_hostif_pkt_counter_t {
+    uint64_t packets;
+    uint64_t bytes;
+} dn_sai_hostif_pkt_counter_t;
+
 typedef struct _dn_sai_hostif_info_t {
     rbtree_handle             trap_tree;
     rbtree_handle             trap_group_tree;
@@ -70,6 +93,20 @@ typedef struct _dn_sai_hostif_info_t {
     uint_t                    max_pkt_attrs;
     uint_t                    max_trap_group_attrs;
     uint_t                    max_trap_attrs;
+    uint64_t                  known_pkt_attr_mask;
+    uint64_t                  valid_send_pkt_attr_mask;
+    uint64_t                  mandatory_send_pkt_attr_mask;
+
+    /* Direct index tables kept in sync with trap_tree and trap_group_tree */
+    dn_sai_trap_group_node_t *trap_group_index[DN_HOSTIF_MAX_TRAP_GROUPS];
+    dn_sai_trap_group_node_t *cpu_queue_index[DN_HOSTIF_MAX_CPU_QUEUES];
+    dn_sai_trap_node_t       *trap_index[DN_HOSTIF_MAX_TRAP_INDEX];
+    uint_t                    trap_cpu_queue[DN_HOSTIF_MAX_TRAP_INDEX];
+
+    /* Received packet counters updated from the packet rx path */
+    dn_sai_hostif_pkt_counter_t cpu_queue_counters[DN_HOSTIF_MAX_CPU_QUEUES];
+    dn_sai_hostif_pkt_counter_t trap_counters[DN_HOSTIF_MAX_TRAP_INDEX];
+    sai_packet_event_notification_fn rx_notification_fn;
 } dn_sai_hostintf_info_t;
 
 typedef struct _dn_sai_hostif_valid_traps_t {
@@ -78,6 +115,23 @@ typedef struct _dn_sai_hostif_valid_traps_t {
 } dn_sai_hostif_valid_traps_t;
 
 /***************STATIC INLINE FUNCTIONS********************/
+static inline bool dn_sai_hostif_trap_index_get(sai_hostif_trap_type_t trap_id,
+                                                uint_t *index)
+{
+    uint_t range = ((uint_t)trap_id) >> DN_HOSTIF_TRAP_RANGE_SHIFT;
+    uint_t offset = ((uint_t)trap_id) & ((1 << DN_HOSTIF_TRAP_RANGE_SHIFT) - 1);
+
+    STD_ASSERT(index != NULL);
+
+    if ((range >= DN_HOSTIF_TRAP_RANGE_COUNT) ||
+        (offset >= DN_HOSTIF_TRAP_RANGE_SIZE)) {
+        return false;
+    }
+
+    *index = (range * DN_HOSTIF_TRAP_RANGE_SIZE) + offset;
+    return true;
+}
+
 static inline void dn_sai_hostif_add_trap_to_trapgroup(
                             dn_sai_trap_node_t *trap_node,
                             dn_sai_trap_group_node_t *trap_group)
@@ -156,4 +210,16 @@ sai_status_t dn_sai_hostif_validate_trapgroup_oid(const sai_attribute_t *attr);
 sai_status_t dn_sai_hostif_validate_portlist(const sai_attribute_t *attr);
 sai_status_t dn_sai_hostif_validate_action(const sai_attribute_t *attr);
 dn_sai_trap_group_node_t *dn_sai_hostif_find_trapgroup_by_queue(uint_t cpu_queue);
+dn_sai_trap_group_node_t *dn_sai_hostif_trapgroup_get(sai_object_id_t trap_group_id);
+dn_sai_trap_node_t *dn_sai_hostif_trap_node_get(sai_hostif_trap_type_t trap_id);
+void dn_sai_hostif_trapgroup_index_add(dn_sai_trap_group_node_t *trap_group);
+void dn_sai_hostif_trapgroup_index_remove(dn_sai_trap_group_node_t *trap_group);
+void dn_sai_hostif_trapgroup_queue_index_update(dn_sai_trap_group_node_t *trap_group,
+                                                uint_t new_cpu_queue);
+void dn_sai_hostif_trap_index_add(dn_sai_trap_node_t *trap_node);
+void dn_sai_hostif_trap_queue_index_update(dn_sai_trap_node_t *trap_node,
+                                           dn_sai_trap_group_node_t *trap_group);
+void dn_sai_hostif_rx_pkt_counters_update(sai_size_t buffer_size,
+                                          uint_t attr_count,
+                                          const sai_attribute_t *attr_list);
 #endif /*_SAI_HOSTIF_MAIN_H_*/
@@ -0,0 +1,85 @@
+/*
+ * Copyright (c) 2016 Dell Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * THIS CODE IS PROVIDED ON AN *AS IS* BASIS, WITHOUT WARRANTIES OR
+ * CONDITIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING WITHOUT
+ * LIMITATION ANY IMPLIED WARRANTIES OR CONDITIONS OF TITLE, FITNESS
+ * FOR A PARTICULAR PURPOSE, MERCHANTABLITY OR NON-INFRINGEMENT.
+ *
+ * See the Apache Version 2.0 License for specific language governing
+ * permissions and limitations under the License.
+ */
+
+/**
+ * @file sai_id_allocator.h
+ *
+ * @brief This file contains the data structures and function prototypes
+ *        for the bitmap based object Id allocator.
+ */
+
+#ifndef __SAI_ID_ALLOCATOR_H__
+#define __SAI_ID_ALLOCATOR_H__
+
+#include "saistatus.h"
+#include "std_type_defs.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+/*
+ * Ids are tracked in a four level bitmap of 64 bit words. A bit in the
+ * upper levels is set when the word it covers is full, so a free Id is
+ * found by following the first clear bit from the top level. The top level
+ * being a single word bounds the Id range to SAI_ID_ALLOCATOR_MAX_IDS
+ * (16777216) Ids, a larger max_id is rejected by sai_id_allocator_init.
+ * The bitmaps are sized to max_id, about 2 MB at the maximum.
+ */
+#define SAI_ID_ALLOCATOR_WORD_BITS   (64)
+
+#define SAI_ID_ALLOCATOR_LEVELS      (4)
+
+#define SAI_ID_ALLOCATOR_MAX_IDS     \
+        (SAI_ID_ALLOCATOR_WORD_BITS * SAI_ID_ALLOCATOR_WORD_BITS * \
+         SAI_ID_ALLOCATOR_WORD_BITS * SAI_ID_ALLOCATOR_WORD_BITS)
+
+typedef struct _sai_id_allocator_t {
+    const char *name;
+    /* Ids are allocated from the range [1, max_id] */
+    uint64_t    max_id;
+    uint64_t    used_count;
+    /* Next Id to search from, allocation is round robin over the range */
+    uint64_t    next_id;
+    /* Level 0 has a bit per Id, the last level is a single word */
+    uint64_t   *p_level [SAI_ID_ALLOCATOR_LEVELS];
+    uint_t      level_words [SAI_ID_ALLOCATOR_LEVELS];
+} sai_id_allocator_t;
+
+/*
+ * Initializes a zero initialized allocator for the Id range [1, max_id].
+ * Reinitializing an allocator releases all the allocated Ids.
+ */
+sai_status_t sai_id_allocator_init (sai_id_allocator_t *p_allocator,
+                                    const char *name, uint64_t max_id);
+
+void sai_id_allocator_deinit (sai_id_allocator_t *p_allocator);
+
+/*
+ * Allocates the next free Id after the last allocated Id, wrapping around
+ * to the start of the range. Returns SAI_STATUS_INSUFFICIENT_RESOURCES when
+ * the range is full.
+ */
+sai_status_t sai_id_allocator_alloc (sai_id_allocator_t *p_allocator,
+                                     uint64_t *p_id);
+
+sai_status_t sai_id_allocator_free (sai_id_allocator_t *p_allocator,
+                                    uint64_t id);
+
+bool sai_id_allocator_is_allocated (const sai_id_allocator_t *p_allocator,
+                                    uint64_t id);
+
+uint64_t sai_id_allocator_used_count_get (const sai_id_allocator_t *p_allocator);
+
+#endif /* __SAI_ID_ALLOCATOR_H__ */
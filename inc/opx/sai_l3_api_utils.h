@@ -65,12 +65,28 @@
 #define SAI_FIB_ROUTE_TREE_KEY_SIZE \
         (sizeof (sai_fib_route_key_t) * BITS_PER_BYTE)
 
-#define SAI_FIB_MAX_DEP_ROUTES_WALK_COUNT  (0)
+/* Max routes reprogrammed by the encap nh dep route walker per FIB lock hold */
+#define SAI_FIB_MAX_DEP_ROUTES_WALK_COUNT  (256)
 
 #define SAI_FIB_READ_FD    (0)
 #define SAI_FIB_WRITE_FD   (1)
 #define SAI_FIB_MAX_FD     (2)
 
+/* Encap Next Hop dependent route walker counters */
+typedef struct _sai_fib_encap_nh_walk_stats_t {
+    /* Encap Next Hops with a pending dependent route walk */
+    uint_t   pending_encap_nh_count;
+    uint64_t routes_walked;
+    uint64_t batches;
+    uint64_t walks_completed;
+    /* Time from walk enqueue to completion for an Encap Next Hop */
+    uint64_t last_walk_latency_us;
+    uint64_t max_walk_latency_us;
+} sai_fib_encap_nh_walk_stats_t;
+
+/* Called under the FIB lock for each route reprogrammed by the walker */
+typedef void (*sai_fib_encap_nh_walk_visit_fn) (const sai_fib_route_t *p_route);
+
 static inline uint_t sai_fib_route_key_len_get (uint_t prefix_len)
 {
     return (((STD_STR_SIZE_OF(sai_ip_address_t, addr_family)) * BITS_PER_BYTE)
@@ -203,6 +219,11 @@ void sai_fib_nh_group_dep_encap_nh_update (sai_fib_nh_group_t *p_nh_group,
                                            sai_fib_nh_t *p_underlay_nh,
                                            bool is_add);
 sai_status_t sai_fib_encap_nh_dep_route_walker_create (void);
+void sai_fib_encap_nh_dep_route_walk_stats_get (
+                                       sai_fib_encap_nh_walk_stats_t *p_stats);
+void sai_fib_encap_nh_dep_route_walk_stats_clear (void);
+void sai_fib_encap_nh_dep_route_walk_visit_fn_set (
+                                       sai_fib_encap_nh_walk_visit_fn visit_fn);
 
 sai_status_t sai_fib_lag_rif_mapping_insert (sai_object_id_t lag_id,
                                              sai_object_id_t rif_id);
@@ -212,6 +233,72 @@ sai_status_t sai_fib_lag_rif_mapping_remove (sai_object_id_t lag_id,
 
 sai_status_t sai_fib_get_rif_id_from_lag_id (sai_object_id_t lag_id,
                                              sai_object_id_t *rif_id);
+
+sai_status_t sai_fib_rif_attach_index_init (void);
+
+/*
+ * Sets the expected number of neighbors, used to size the Neighbor MAC
+ * entry hash index when the first neighbor MAC entry is added.
+ */
+void sai_fib_neighbor_mac_hash_scale_set (uint_t neighbor_scale);
+
+/*
+ * Returns the RIF node attached to the given port/LAG or VLAN, looked up
+ * from the RIF attachment index. Must be called with the FIB lock held.
+ */
+sai_fib_router_interface_t *sai_fib_port_rif_node_get (sai_object_id_t port_id);
+
+sai_fib_router_interface_t *sai_fib_vlan_rif_node_get (sai_vlan_id_t vlan_id);
+
+/*
+ * Direct indexed lookup of the VRF, RIF and Next Hop nodes by object Id,
+ * falling back to the rbtree for object Ids outside the index range. Must
+ * be called with the FIB lock held.
+ */
+sai_fib_vrf_t *sai_fib_vrf_node_index_get (sai_object_id_t vrf_id);
+
+sai_fib_router_interface_t *sai_fib_router_interface_node_index_get (
+                                                        sai_object_id_t rif_id);
+
+sai_fib_nh_t *sai_fib_next_hop_node_index_get (sai_object_id_t nh_id);
+
+/*
+ * Adds or removes the node in the object index, called along with the
+ * insertion and removal of the node in its rbtree.
+ */
+void sai_fib_vrf_node_index_update (sai_fib_vrf_t *p_vrf_node, bool is_add);
+
+void sai_fib_router_interface_node_index_update (
+                             sai_fib_router_interface_t *p_rif_node, bool is_add);
+
+void sai_fib_next_hop_node_index_update (sai_fib_nh_t *p_nh_node, bool is_add);
+
+/*
+ * Removes all the neighbors in the VRF, or on the RIF, in a single FIB
+ * lock pass.
+ */
+sai_status_t sai_fib_neighbor_remove_all_in_vrf (sai_object_id_t vr_id);
+
+sai_status_t sai_fib_neighbor_remove_all_on_rif (sai_object_id_t rif_id);
+
+/*
+ * Creates or removes a list of neighbor entries in a single FIB lock pass.
+ * Per entry status is returned in object_statuses. When stop_on_error is
+ * set, entries after the first failure are marked SAI_STATUS_NOT_EXECUTED.
+ * Returns SAI_STATUS_SUCCESS only if all the entries succeeded.
+ */
+sai_status_t sai_fib_neighbor_bulk_create (uint32_t object_count,
+                                           const sai_neighbor_entry_t *neighbor_entry,
+                                           const uint32_t *attr_count,
+                                           const sai_attribute_t **attr_list,
+                                           bool stop_on_error,
+                                           sai_status_t *object_statuses);
+
+sai_status_t sai_fib_neighbor_bulk_remove (uint32_t object_count,
+                                           const sai_neighbor_entry_t *neighbor_entry,
+                                           bool stop_on_error,
+                                           sai_status_t *object_statuses);
+
 void sai_fib_dump_vr (sai_object_id_t vr_id);
 
 void sai_fib_dump_all_vr (void);
@@ -238,4 +325,6 @@ void sai_fib_dump_nh_list_from_nh_group (sai_object_id_t group_id);
 
 void sai_fib_dump_neighbor_mac_entry_tree (void);
 
+void sai_fib_dump_encap_nh_dep_route_walk_stats (void);
+
 #endif /* __SAI_L3_API_UTILS_H__ */
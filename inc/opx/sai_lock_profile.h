@@ -0,0 +1,121 @@
+/*
+ * Copyright (c) 2016 Dell Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * THIS CODE IS PROVIDED ON AN *AS IS* BASIS, WITHOUT WARRANTIES OR
+ * CONDITIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING WITHOUT
+ * LIMITATION ANY IMPLIED WARRANTIES OR CONDITIONS OF TITLE, FITNESS
+ * FOR A PARTICULAR PURPOSE, MERCHANTABLITY OR NON-INFRINGEMENT.
+ *
+ * See the Apache Version 2.0 License for specific language governing
+ * permissions and limitations under the License.
+ */
+
+/**
+ * @file sai_lock_profile.h
+ *
+ * @brief This file contains the data structures and function prototypes
+ *        for profiling contention and hold time of the SAI module locks.
+ */
+
+#ifndef __SAI_LOCK_PROFILE_H__
+#define __SAI_LOCK_PROFILE_H__
+
+#include "std_mutex_lock.h"
+#include "std_type_defs.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+/*
+ * Wait and hold times are kept in log2 histograms of microseconds.
+ * Bucket 0 counts durations below 1us and the last bucket everything
+ * above the previous bucket.
+ */
+#define SAI_LOCK_PROFILE_HIST_BUCKETS      (24)
+
+#define SAI_LOCK_PROFILE_NAME_LEN_MAX      (32)
+
+typedef struct _sai_lock_profile_t {
+    const char *name;
+    uint64_t    acquire_count;
+    uint64_t    total_wait_ns;
+    uint64_t    max_wait_ns;
+    uint64_t    total_hold_ns;
+    uint64_t    max_hold_ns;
+    uint64_t    wait_hist [SAI_LOCK_PROFILE_HIST_BUCKETS];
+    uint64_t    hold_hist [SAI_LOCK_PROFILE_HIST_BUCKETS];
+    /* Call site which held the lock for max_hold_ns */
+    void       *max_hold_call_site;
+
+    /* Current holder, valid only while the lock is held */
+    uint64_t    acquire_time_ns;
+    void       *holder_call_site;
+
+    struct _sai_lock_profile_t *next;
+} sai_lock_profile_t;
+
+/*
+ * Defines a static lock profile for a module lock and registers it with
+ * the lock profiler when the library is loaded.
+ */
+#define SAI_LOCK_PROFILE_DEFINE(profile, lock_name)                         \
+    static sai_lock_profile_t profile = { .name = lock_name };             \
+    static void __attribute__((constructor)) profile##_register (void)     \
+    {                                                                       \
+        sai_lock_profile_register (&profile);                               \
+    }
+
+/*
+ * Call site of the module lock function, recorded for the longest hold.
+ */
+#define SAI_LOCK_PROFILE_CALL_SITE()       (__builtin_return_address (0))
+
+extern bool sai_lock_profile_enabled;
+
+void sai_lock_profile_register (sai_lock_profile_t *p_profile);
+
+void sai_lock_profile_acquire (std_mutex_type_t *p_mutex,
+                               sai_lock_profile_t *p_profile,
+                               void *call_site);
+
+void sai_lock_profile_release (std_mutex_type_t *p_mutex,
+                               sai_lock_profile_t *p_profile);
+
+/*
+ * Lock and unlock a module mutex. When profiling is disabled this costs
+ * a single flag check over the plain mutex operation.
+ */
+static inline void sai_profiled_mutex_lock (std_mutex_type_t *p_mutex,
+                                            sai_lock_profile_t *p_profile,
+                                            void *call_site)
+{
+    if (!sai_lock_profile_enabled) {
+        std_mutex_lock (p_mutex);
+        p_profile->acquire_time_ns = 0;
+        return;
+    }
+
+    sai_lock_profile_acquire (p_mutex, p_profile, call_site);
+}
+
+static inline void sai_profiled_mutex_unlock (std_mutex_type_t *p_mutex,
+                                              sai_lock_profile_t *p_profile)
+{
+    if (p_profile->acquire_time_ns == 0) {
+        std_mutex_unlock (p_mutex);
+        return;
+    }
+
+    sai_lock_profile_release (p_mutex, p_profile);
+}
+
+void sai_lock_profile_enable (bool enable);
+
+void sai_lock_profile_reset (void);
+
+void sai_lock_profile_dump (const char *lock_name);
+
+#endif /* __SAI_LOCK_PROFILE_H__ */
@@ -26,6 +26,12 @@
 
 #include "sai_mirror_defs.h"
 
+/*
+ * Maximum number of mirror sessions, a session's slot indexes the per port
+ * session bitmaps
+ */
+#define SAI_MIRROR_MAX_SESSION_SLOTS (64)
+
 /*
  * Allocate memory for mirror session node
  * return Allocated memory of type (sai_mirror_session_info_t *)
@@ -72,6 +78,66 @@ sai_status_t sai_mirror_session_port_remove (sai_object_id_t session_id,
                                              sai_object_id_t mirror_port_id,
                                              sai_mirror_direction_t direction);
 
+/*
+ * Attach a list of source ports to a mirror session
+ * param - session_id Mirror session Id
+ * param - port_list List of mirror source port Ids
+ * param - direction Mirroring direction of the source ports
+ * param[out] - port_statuses Status of each port in port_list
+ * return - SAI_STATUS_SUCCESS if all the ports are attached otherwise
+ *          SAI_STATUS_FAILURE or appropriate error code
+ */
+sai_status_t sai_mirror_session_port_list_add (sai_object_id_t session_id,
+                                               const sai_object_list_t *port_list,
+                                               sai_mirror_direction_t direction,
+                                               sai_status_t *port_statuses);
+
+/*
+ * Detach a list of source ports from a mirror session
+ * param - session_id Mirror session Id
+ * param - port_list List of mirror source port Ids
+ * param - direction Mirroring direction of the source ports
+ * param[out] - port_statuses Status of each port in port_list
+ * return - SAI_STATUS_SUCCESS if all the ports are detached otherwise
+ *          SAI_STATUS_FAILURE or appropriate error code
+ */
+sai_status_t sai_mirror_session_port_list_remove (sai_object_id_t session_id,
+                                                  const sai_object_list_t *port_list,
+                                                  sai_mirror_direction_t direction,
+                                                  sai_status_t *port_statuses);
+
+/*
+ * Get the slot of a mirror session, must be called with mirror lock held
+ * param - session_id Mirror session Id
+ * return - slot of the session or -1 if not found
+ */
+int sai_mirror_session_slot_get (sai_object_id_t session_id);
+
+/*
+ * Get the mirror session in a slot, must be called with mirror lock held
+ * param - slot Mirror session slot
+ * return - Mirror session Id or SAI_NULL_OBJECT_ID
+ */
+sai_object_id_t sai_mirror_session_slot_id_get (uint_t slot);
+
+/*
+ * Initialize the per port mirror session bitmaps
+ */
+sai_status_t sai_mirror_port_session_map_init (void);
+
+/*
+ * Set or clear a session slot in the per port session bitmap, must be called
+ * with mirror lock held
+ * param - port_id Mirror source port Id
+ * param - slot Mirror session slot
+ * param - direction Mirroring direction of the source port
+ * param - is_set true to set the slot, false to clear it
+ * return - SAI_STATUS_SUCCESS if successful otherwise appropriate error code
+ */
+sai_status_t sai_mirror_port_session_map_update (sai_object_id_t port_id, uint_t slot,
+                                                 sai_mirror_direction_t direction,
+                                                 bool is_set);
+
 /*
  * Handle port mirroring for a port
  * param - port_id Mirror source port Id
@@ -42,6 +42,58 @@
 #define SAI_QOS_POLICER_TYPE_INVALID              (-1)
 #define SAI_QOS_WRED_MAX_ATTR_COUNT               (14)
 
+#ifdef SAI_STATUS_NOT_EXECUTED
+#define SAI_QOS_BULK_STATUS_NOT_EXECUTED          SAI_STATUS_NOT_EXECUTED
+#else
+#define SAI_QOS_BULK_STATUS_NOT_EXECUTED          SAI_STATUS_FAILURE
+#endif
+
+/** Bulk operation behaviour on a per object failure */
+typedef enum _dn_sai_qos_bulk_op_error_mode_t {
+    /** Stop at the first failure, later objects are not executed */
+    DN_SAI_QOS_BULK_OP_ERROR_MODE_STOP_ON_ERROR,
+
+    /** Attempt every object of the batch */
+    DN_SAI_QOS_BULK_OP_ERROR_MODE_IGNORE_ERROR,
+} dn_sai_qos_bulk_op_error_mode_t;
+
+/** Per object handlers run by the bulk helpers with the QoS lock held */
+typedef sai_status_t (*sai_qos_bulk_create_fn) (sai_object_id_t *object_id,
+                                                sai_object_id_t switch_id,
+                                                uint32_t attr_count,
+                                                const sai_attribute_t *attr_list);
+
+typedef sai_status_t (*sai_qos_bulk_remove_fn) (sai_object_id_t object_id);
+
+typedef sai_status_t (*sai_qos_bulk_set_fn) (sai_object_id_t object_id,
+                                             const sai_attribute_t *attr);
+
+/** Objects covered by the buffer watermark poller */
+typedef enum _sai_qos_watermark_obj_type_t {
+    SAI_QOS_WATERMARK_OBJ_BUFFER_POOL,
+    SAI_QOS_WATERMARK_OBJ_QUEUE,
+    SAI_QOS_WATERMARK_OBJ_PG,
+    SAI_QOS_WATERMARK_OBJ_TYPE_MAX,
+} sai_qos_watermark_obj_type_t;
+
+/** Buffer usage of one object in a watermark snapshot */
+typedef struct _sai_qos_watermark_entry_t {
+    sai_object_id_t object_id;
+    /** Occupancy when the object was last polled */
+    uint64_t        curr_occupancy_bytes;
+    /** Peak usage since the previous snapshot read */
+    uint64_t        watermark_bytes;
+} sai_qos_watermark_entry_t;
+
+/** Snapshot of all pool, queue and PG watermarks taken in one poll */
+typedef struct _sai_qos_watermark_snapshot_t {
+    uint64_t                   sequence;
+    uint64_t                   timestamp_us;
+    /** In: size of each list, Out: entries of each object type */
+    uint_t                     count [SAI_QOS_WATERMARK_OBJ_TYPE_MAX];
+    sai_qos_watermark_entry_t *list [SAI_QOS_WATERMARK_OBJ_TYPE_MAX];
+} sai_qos_watermark_snapshot_t;
+
 sai_status_t sai_qos_port_all_init (void);
 
 sai_status_t sai_qos_port_all_deinit (void);
@@ -118,6 +170,16 @@ sai_status_t sai_qos_map_process_port_set (sai_object_id_t port_id,
 
 sai_status_t sai_qos_map_port_list_update(dn_sai_qos_map_t *p_map);
 
+/* Id of the NPU profile programmed for the map, identical maps share one */
+sai_object_id_t sai_qos_map_npu_id_get(sai_object_id_t map_id);
+
+uint_t sai_qos_map_profile_ref_count_get(sai_object_id_t map_id);
+
+/* Debug counters of map list sets that reprogrammed the NPU and the ports */
+uint_t sai_qos_map_npu_update_count_get(void);
+
+uint_t sai_qos_map_port_update_count_get(void);
+
 sai_status_t sai_qos_port_scheduler_set (sai_object_id_t port_id,
                                          const sai_attribute_t *p_attr);
 
@@ -127,8 +189,39 @@ sai_status_t sai_qos_queue_scheduler_set (dn_sai_qos_queue_t *p_queue_node,
 sai_status_t sai_qos_sched_group_scheduler_set (dn_sai_qos_sched_group_t *p_sg_node,
                                                 const sai_attribute_t *p_attr);
 
-sai_status_t sai_qos_scheduler_reapply (dn_sai_qos_scheduler_t *p_old_sched_node,
-                                        dn_sai_qos_scheduler_t *p_new_sched_node);
+/**
+ * @brief Reapply the scheduler configuration held in p_sched_node on all
+ *        objects bound to it. Called with the QoS lock held. With
+ *        lock_release set the lock is released between chunks of bound
+ *        objects on large lists, so only a caller that holds the lock for
+ *        this one set may pass true. Objects moved to the new configuration
+ *        are reverted on failure.
+ *
+ * @param[in] p_sched_node Scheduler node holding the new configuration
+ * @param[in] p_old_cfg    Copy of the previous scheduler configuration
+ * @param[in] lock_release Allow releasing the QoS lock between chunks
+ * @return SAI_STATUS_SUCCESS if operation is successful otherwise a different
+ *  error code is returned.
+ */
+sai_status_t sai_qos_scheduler_reapply_chunked (dn_sai_qos_scheduler_t *p_sched_node,
+                                                dn_sai_qos_scheduler_t *p_old_cfg,
+                                                bool lock_release);
+
+bool sai_qos_scheduler_is_reapply_in_progress (sai_object_id_t sched_id);
+
+/**
+ * @brief Set multiple attributes on a scheduler with a single NPU attribute
+ *        set and a single reapply on the bound objects.
+ *
+ * @param[in] sched_id    Scheduler object id
+ * @param[in] attr_count  Number of attributes
+ * @param[in] p_attr_list List of attributes
+ * @return SAI_STATUS_SUCCESS if operation is successful otherwise a different
+ *  error code is returned.
+ */
+sai_status_t sai_qos_scheduler_attributes_set (sai_object_id_t sched_id,
+                                               uint_t attr_count,
+                                               const sai_attribute_t *p_attr_list);
 
 sai_status_t sai_policer_acl_entries_update(dn_sai_qos_policer_t *p_policer,
                                             dn_sai_qos_policer_t *p_policer_new);
@@ -139,9 +232,30 @@ sai_status_t sai_port_attr_storm_control_policer_set(sai_object_id_t port_id,
 sai_status_t sai_port_attr_storm_control_policer_set_internal(sai_object_id_t port_id,
                                                      const sai_attribute_t *attr);
 
+/*
+ * Walks the ports bound to a storm control policer for a storm control
+ * type. Start with *p_slot as 0, SAI_NULL_OBJECT_ID is returned after the
+ * last port. Must be called with the QoS lock held.
+ */
+sai_object_id_t sai_qos_policer_port_next_get (sai_object_id_t policer_id,
+                                               uint_t type, uint_t *p_slot);
+
 sai_status_t sai_qos_wred_link_set(sai_object_id_t wred_link_id,
         sai_object_id_t wred_id, dn_sai_qos_wred_link_t dn_wred_link);
 
+/**
+ * @brief Defer propagation of WRED attribute changes to the linked queues,
+ *        ports and port pools. Calls nest, the changes made in the window
+ *        are propagated once per WRED profile by the outermost end call.
+ */
+sai_status_t sai_qos_wred_update_defer_begin(void);
+
+/**
+ * @brief End a WRED deferral window. A profile whose propagation fails is
+ *        restored to the last propagated configuration on all its links.
+ */
+sai_status_t sai_qos_wred_update_defer_end(void);
+
 sai_status_t sai_switch_set_qos_default_tc(uint_t default_tc);
 
 sai_status_t sai_qos_hierarchy_handler(std_config_node_t hqos_node,
@@ -153,6 +267,175 @@ sai_status_t sai_qos_port_buffer_profile_set (sai_object_id_t obj_id,
 sai_status_t sai_qos_obj_update_buffer_profile (sai_object_id_t object_id,
                                                sai_object_id_t profile_id);
 
+/**
+ * @brief Apply buffer profiles to a batch of ports, queues and PGs. The pool
+ *        budget is validated once for the batch and each affected pool is
+ *        updated once. On failure no object of the batch is changed.
+ *        Caller holds the QoS lock.
+ */
+sai_status_t sai_qos_obj_update_buffer_profile_bulk (uint_t count,
+                                                     const sai_object_id_t *object_list,
+                                                     const sai_object_id_t *profile_list);
+
+/**
+ * @brief Locked variant of sai_qos_obj_update_buffer_profile_bulk.
+ */
+sai_status_t sai_qos_buffer_profile_bulk_apply (uint_t count,
+                                                const sai_object_id_t *object_list,
+                                                const sai_object_id_t *profile_list);
+
+/**
+ * @brief Run create_fn on a batch of objects. object_statuses holds the
+ *        status of each object; objects after a failure are not executed
+ *        in stop on error mode. The _internal variants expect the caller
+ *        to hold the QoS lock, the others take it once for the batch.
+ *
+ * @return SAI_STATUS_SUCCESS if all objects succeeded, SAI_STATUS_FAILURE
+ *  if any object failed, otherwise a parameter error.
+ */
+sai_status_t sai_qos_bulk_object_create (sai_qos_bulk_create_fn create_fn,
+                                         sai_object_id_t switch_id,
+                                         uint32_t object_count,
+                                         const uint32_t *attr_count,
+                                         const sai_attribute_t **attr_list,
+                                         dn_sai_qos_bulk_op_error_mode_t mode,
+                                         sai_object_id_t *object_id,
+                                         sai_status_t *object_statuses);
+
+sai_status_t sai_qos_bulk_object_create_internal (sai_qos_bulk_create_fn create_fn,
+                                                  sai_object_id_t switch_id,
+                                                  uint32_t object_count,
+                                                  const uint32_t *attr_count,
+                                                  const sai_attribute_t **attr_list,
+                                                  dn_sai_qos_bulk_op_error_mode_t mode,
+                                                  sai_object_id_t *object_id,
+                                                  sai_status_t *object_statuses);
+
+sai_status_t sai_qos_bulk_object_remove (sai_qos_bulk_remove_fn remove_fn,
+                                         uint32_t object_count,
+                                         const sai_object_id_t *object_id,
+                                         dn_sai_qos_bulk_op_error_mode_t mode,
+                                         sai_status_t *object_statuses);
+
+sai_status_t sai_qos_bulk_object_remove_internal (sai_qos_bulk_remove_fn remove_fn,
+                                                  uint32_t object_count,
+                                                  const sai_object_id_t *object_id,
+                                                  dn_sai_qos_bulk_op_error_mode_t mode,
+                                                  sai_status_t *object_statuses);
+
+/**
+ * @brief Run set_fn on a batch of objects, attr_list [i] is set on
+ *        object_id [i].
+ */
+sai_status_t sai_qos_bulk_object_set (sai_qos_bulk_set_fn set_fn,
+                                      uint32_t object_count,
+                                      const sai_object_id_t *object_id,
+                                      const sai_attribute_t *attr_list,
+                                      dn_sai_qos_bulk_op_error_mode_t mode,
+                                      sai_status_t *object_statuses);
+
+sai_status_t sai_qos_bulk_object_set_internal (sai_qos_bulk_set_fn set_fn,
+                                               uint32_t object_count,
+                                               const sai_object_id_t *object_id,
+                                               const sai_attribute_t *attr_list,
+                                               dn_sai_qos_bulk_op_error_mode_t mode,
+                                               sai_status_t *object_statuses);
+
+sai_status_t sai_qos_queue_bulk_create (sai_object_id_t switch_id,
+                                        uint32_t object_count,
+                                        const uint32_t *attr_count,
+                                        const sai_attribute_t **attr_list,
+                                        dn_sai_qos_bulk_op_error_mode_t mode,
+                                        sai_object_id_t *object_id,
+                                        sai_status_t *object_statuses);
+
+sai_status_t sai_qos_queue_bulk_remove (uint32_t object_count,
+                                        const sai_object_id_t *object_id,
+                                        dn_sai_qos_bulk_op_error_mode_t mode,
+                                        sai_status_t *object_statuses);
+
+sai_status_t sai_qos_queue_bulk_set (uint32_t object_count,
+                                     const sai_object_id_t *object_id,
+                                     const sai_attribute_t *attr_list,
+                                     dn_sai_qos_bulk_op_error_mode_t mode,
+                                     sai_status_t *object_statuses);
+
+sai_status_t sai_qos_sched_group_bulk_create (sai_object_id_t switch_id,
+                                              uint32_t object_count,
+                                              const uint32_t *attr_count,
+                                              const sai_attribute_t **attr_list,
+                                              dn_sai_qos_bulk_op_error_mode_t mode,
+                                              sai_object_id_t *object_id,
+                                              sai_status_t *object_statuses);
+
+sai_status_t sai_qos_sched_group_bulk_remove (uint32_t object_count,
+                                              const sai_object_id_t *object_id,
+                                              dn_sai_qos_bulk_op_error_mode_t mode,
+                                              sai_status_t *object_statuses);
+
+sai_status_t sai_qos_sched_group_bulk_set (uint32_t object_count,
+                                           const sai_object_id_t *object_id,
+                                           const sai_attribute_t *attr_list,
+                                           dn_sai_qos_bulk_op_error_mode_t mode,
+                                           sai_status_t *object_statuses);
+
+sai_status_t sai_qos_scheduler_bulk_create (sai_object_id_t switch_id,
+                                            uint32_t object_count,
+                                            const uint32_t *attr_count,
+                                            const sai_attribute_t **attr_list,
+                                            dn_sai_qos_bulk_op_error_mode_t mode,
+                                            sai_object_id_t *object_id,
+                                            sai_status_t *object_statuses);
+
+sai_status_t sai_qos_scheduler_bulk_remove (uint32_t object_count,
+                                            const sai_object_id_t *object_id,
+                                            dn_sai_qos_bulk_op_error_mode_t mode,
+                                            sai_status_t *object_statuses);
+
+sai_status_t sai_qos_scheduler_bulk_set (uint32_t object_count,
+                                         const sai_object_id_t *object_id,
+                                         const sai_attribute_t *attr_list,
+                                         dn_sai_qos_bulk_op_error_mode_t mode,
+                                         sai_status_t *object_statuses);
+
+sai_status_t sai_qos_wred_bulk_create (sai_object_id_t switch_id,
+                                       uint32_t object_count,
+                                       const uint32_t *attr_count,
+                                       const sai_attribute_t **attr_list,
+                                       dn_sai_qos_bulk_op_error_mode_t mode,
+                                       sai_object_id_t *object_id,
+                                       sai_status_t *object_statuses);
+
+sai_status_t sai_qos_wred_bulk_remove (uint32_t object_count,
+                                       const sai_object_id_t *object_id,
+                                       dn_sai_qos_bulk_op_error_mode_t mode,
+                                       sai_status_t *object_statuses);
+
+sai_status_t sai_qos_wred_bulk_set (uint32_t object_count,
+                                    const sai_object_id_t *object_id,
+                                    const sai_attribute_t *attr_list,
+                                    dn_sai_qos_bulk_op_error_mode_t mode,
+                                    sai_status_t *object_statuses);
+
+sai_status_t sai_qos_buffer_profile_bulk_create (sai_object_id_t switch_id,
+                                                 uint32_t object_count,
+                                                 const uint32_t *attr_count,
+                                                 const sai_attribute_t **attr_list,
+                                                 dn_sai_qos_bulk_op_error_mode_t mode,
+                                                 sai_object_id_t *object_id,
+                                                 sai_status_t *object_statuses);
+
+sai_status_t sai_qos_buffer_profile_bulk_remove (uint32_t object_count,
+                                                 const sai_object_id_t *object_id,
+                                                 dn_sai_qos_bulk_op_error_mode_t mode,
+                                                 sai_status_t *object_statuses);
+
+sai_status_t sai_qos_buffer_profile_bulk_set (uint32_t object_count,
+                                              const sai_object_id_t *object_id,
+                                              const sai_attribute_t *attr_list,
+                                              dn_sai_qos_bulk_op_error_mode_t mode,
+                                              sai_status_t *object_statuses);
+
 sai_status_t sai_buffer_init (void);
 
 sai_status_t sai_qos_port_create_all_pg (sai_object_id_t port_id);
@@ -337,4 +620,45 @@ sai_status_t sai_qos_port_clear_port_pool_stats(
         sai_object_id_t port_pool_id,
         uint32_t number_of_counters,
         const sai_port_pool_stat_t *counter_ids);
+
+/**
+ * @brief Start the buffer watermark poller or change its interval.
+ *
+ * The poller owns the queue and PG watermark counters and clears them
+ * on every poll, after folding them into a per object peak since the
+ * last client clear. Buffer pool peaks are taken from the polled occupancy.
+ */
+sai_status_t sai_qos_watermark_poll_start (uint32_t interval_ms);
+
+/**
+ * @brief Stop polling, the last snapshot stays readable
+ */
+sai_status_t sai_qos_watermark_poll_stop (void);
+
+/**
+ * @brief Copy the latest watermark snapshot without taking the QoS lock.
+ *
+ * Watermarks are peaks since the previous read, so there is one consumer.
+ * Returns SAI_STATUS_BUFFER_OVERFLOW with the required counts when a list
+ * is too small, and SAI_STATUS_UNINITIALIZED before the first poll.
+ */
+sai_status_t sai_qos_watermark_snapshot_read (sai_qos_watermark_snapshot_t *p_snapshot);
+
+/**
+ * @brief Raise a queue or PG WATERMARK_BYTES read to the polled peak.
+ *
+ * The hardware counter only holds the peak since the last poll, the polled
+ * peak covers the time since the last client clear. Called with the QoS
+ * lock held.
+ */
+void sai_qos_watermark_peak_apply (sai_object_id_t object_id, uint64_t *p_watermark_bytes);
+
+/**
+ * @brief Restart the polled peak of a queue or PG on a client clear.
+ *
+ * Returns true while the poller is enabled, the hardware watermark counter
+ * is then left to the poller and usage within the current poll interval
+ * may still be reported. Called with the QoS lock held.
+ */
+bool sai_qos_watermark_peak_clear (sai_object_id_t object_id);
 #endif /* __SAI_QOS_API_UTILS_H__ */
@@ -147,7 +147,16 @@ void sai_samplepacket_dump(sai_object_id_t session_id, bool all);
  */
 void sai_samplepacket_dump_session_node (sai_object_id_t samplepacket_session_id);
 
+/*
+ * Remove a deleted port from the samplepacket sessions applied on all the ports.
+ * Called from the port module on port delete, without the port lock held.
+ */
 sai_status_t sai_samplepacket_port_cleanup_on_fanout (sai_object_id_t port_id);
 
+/*
+ * Add a created port to the samplepacket sessions applied on all the ports.
+ * Called from the port module on port create, without the port lock held.
+ */
 sai_status_t sai_samplepacket_port_config_post_fanout (sai_object_id_t port_id);
+
 #endif /* __SAI_SAMPLEPACKET_API_H__ */
@@ -35,6 +35,13 @@ void dn_sai_tunnel_map_init(void);
 
 void dn_sai_tunnel_map_entry_init(void);
 
+void dn_sai_tunnel_term_init(void);
+
+/* Looks up a Tunnel Termination entry by the (VR, type, tunnel type, DIP,
+ * SIP) key fields filled in p_key_entry. Returns NULL if not found. */
+dn_sai_tunnel_term_entry_t *dn_sai_tunnel_term_entry_key_lookup (
+                           const dn_sai_tunnel_term_entry_t *p_key_entry);
+
 void dn_sai_tunnel_term_obj_api_fill (sai_tunnel_api_t *api_table);
 
 void dn_sai_tunnel_map_obj_api_fill (sai_tunnel_api_t *api_table);
@@ -50,15 +57,37 @@ sai_status_t sai_tunnel_encap_nh_setup(sai_ip_address_t *p_remote_ip,
 sai_status_t sai_tunnel_encap_nh_teardown(sai_ip_address_t *p_remote_ip,
                                           dn_sai_tunnel_t *p_tunnel);
 
+/*
+ * Reads the counter_ids of a list of tunnels, or of all tunnels, in one
+ * snapshot. The tunnel lock is taken per tunnel around its counter read,
+ * so configuration is not blocked for the whole sweep.
+ *
+ * If all_tunnels is true, tunnel_list is filled with the ids of all tunnels
+ * and *tunnel_count holds its size on input. If it is too small,
+ * SAI_STATUS_BUFFER_OVERFLOW is returned with the required count in
+ * *tunnel_count. Otherwise *tunnel_count tunnel ids are read from
+ * tunnel_list.
+ *
+ * counters holds num_counters values per tunnel, in tunnel_list order.
+ * tunnel_statuses gets the read status of each tunnel. If read_clear is
+ * true the counters are cleared after they are read. p_timestamp_us, if
+ * not NULL, gets the monotonic time of the snapshot in microseconds.
+ * Returns SAI_STATUS_FAILURE if any tunnel read failed.
+ */
+sai_status_t dn_sai_tunnel_stats_snapshot_get (bool all_tunnels,
+                                               uint32_t *tunnel_count,
+                                               sai_object_id_t *tunnel_list,
+                                               uint32_t num_counters,
+                                               const sai_tunnel_stat_t *counter_ids,
+                                               bool read_clear,
+                                               uint64_t *counters,
+                                               sai_status_t *tunnel_statuses,
+                                               uint64_t *p_timestamp_us);
+
 /* Accessor functions for Tunnel API global info */
 static inline uint8_t *dn_sai_tunnel_obj_id_bitmap (void)
 {
     return (dn_sai_tunnel_access_global_config()->tunnel_obj_id_bitmap);
 }
 
-static inline uint8_t *dn_sai_tunnel_term_obj_id_bitmap (void)
-{
-    return (dn_sai_tunnel_access_global_config()->tunnel_term_id_bitmap);
-}
-
 #endif /* _SAI_TUNNEL_API_UTILS_H_ */
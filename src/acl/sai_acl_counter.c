@@ -29,6 +29,7 @@
 #include "saiacl.h"
 #include "saistatus.h"
 #include "sai_oid_utils.h"
+#include "sai_id_allocator.h"
 
 #include "std_type_defs.h"
 #include "std_rbtree.h"
@@ -38,38 +39,32 @@
 #include <string.h>
 #include <inttypes.h>
 
-static dn_sai_id_gen_info_t acl_counter_obj_info;
+static sai_id_allocator_t acl_counter_id_allocator;
 
-static bool sai_is_acl_counter_id_in_use(uint64_t obj_id)
+static sai_object_id_t sai_acl_counter_id_create(void)
 {
-    acl_node_pt acl_node = sai_acl_get_acl_node();
-
-    sai_object_id_t acl_counter_id =
-        sai_uoid_create(SAI_OBJECT_TYPE_ACL_COUNTER,obj_id);
+    uint64_t id = 0;
 
-    if(sai_acl_cntr_find(acl_node->sai_acl_counter_tree,
-                                acl_counter_id) != NULL) {
-        return true;
+    if(SAI_STATUS_SUCCESS ==
+       sai_id_allocator_alloc(&acl_counter_id_allocator, &id)) {
+        return (sai_uoid_create(SAI_OBJECT_TYPE_ACL_COUNTER, id));
     }
-    return false;
+    return SAI_NULL_OBJECT_ID;
 }
 
-static sai_object_id_t sai_acl_counter_id_create(void)
+static void sai_acl_counter_id_release(sai_object_id_t acl_counter_id)
 {
-    if(SAI_STATUS_SUCCESS ==
-       dn_sai_get_next_free_id(&acl_counter_obj_info)) {
-        return (sai_uoid_create(SAI_OBJECT_TYPE_ACL_COUNTER,
-                                acl_counter_obj_info.cur_id));
-    }
-    return SAI_NULL_OBJECT_ID;
+    sai_id_allocator_free(&acl_counter_id_allocator,
+                          sai_uoid_npu_obj_id_get(acl_counter_id));
 }
 
 void sai_acl_counter_init(void)
 {
-    acl_counter_obj_info.cur_id = 0;
-    acl_counter_obj_info.is_wrappped = false;
-    acl_counter_obj_info.mask = SAI_UOID_NPU_OBJ_ID_MASK;
-    acl_counter_obj_info.is_id_in_use = sai_is_acl_counter_id_in_use;
+    if(SAI_STATUS_SUCCESS !=
+       sai_id_allocator_init(&acl_counter_id_allocator, "acl_counter",
+                             SAI_ID_ALLOCATOR_MAX_IDS)) {
+        SAI_ACL_LOG_ERR ("ACL Counter Id allocator init failed");
+    }
 }
 static void sai_acl_cntr_free(sai_acl_counter_t *acl_cntr)
 {
@@ -276,6 +271,9 @@ sai_status_t sai_create_acl_counter(sai_object_id_t *acl_counter_id,
     } while(0);
 
     if (rc != SAI_STATUS_SUCCESS) {
+        if (acl_cntr->counter_key.counter_id != SAI_NULL_OBJECT_ID) {
+            sai_acl_counter_id_release(acl_cntr->counter_key.counter_id);
+        }
         sai_acl_cntr_free(acl_cntr);
     }
 
@@ -362,6 +360,8 @@ sai_status_t sai_delete_acl_counter(sai_object_id_t acl_counter_id)
         STD_ASSERT(acl_table != NULL);
         acl_table->num_counters--;
 
+        sai_acl_counter_id_release(acl_counter_id);
+
         /* Finally free the ACL counter memory */
         sai_acl_cntr_free(acl_counter);
 
@@ -31,11 +31,15 @@
 #include "std_type_defs.h"
 #include "std_assert.h"
 #include "std_mutex_lock.h"
+#include "sai_lock_profile.h"
 #include <stdlib.h>
 #include <string.h>
 
 static sai_acl_table_id_node_t sai_acl_table_id_generator[SAI_ACL_TABLE_ID_MAX];
 static std_mutex_lock_create_static_init_fast(acl_lock);
+
+SAI_LOCK_PROFILE_DEFINE (acl_lock_profile, "acl")
+
 static sai_acl_api_t sai_acl_method_table =
 {
     sai_create_acl_table,
@@ -81,12 +85,13 @@ sai_acl_table_id_node_t *sai_acl_get_table_id_gen(void)
 
 void sai_acl_lock(void)
 {
-    std_mutex_lock (&acl_lock);
+    sai_profiled_mutex_lock (&acl_lock, &acl_lock_profile,
+                             SAI_LOCK_PROFILE_CALL_SITE ());
 }
 
 void sai_acl_unlock(void)
 {
-    std_mutex_unlock (&acl_lock);
+    sai_profiled_mutex_unlock (&acl_lock, &acl_lock_profile);
 }
 
 static void sai_acl_table_id_generate(void)
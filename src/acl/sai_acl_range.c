@@ -31,44 +31,37 @@
 #include "std_assert.h"
 #include "sai_oid_utils.h"
 #include "sai_common_infra.h"
+#include "sai_id_allocator.h"
 
 #include <stdlib.h>
 #include <inttypes.h>
 
-static dn_sai_id_gen_info_t acl_range_info;
+static sai_id_allocator_t acl_range_id_allocator;
 
-bool sai_is_acl_range_id_in_use(uint64_t obj_id)
+static sai_object_id_t sai_acl_range_id_create(void)
 {
-    acl_node_pt acl_node = NULL;
-
-    acl_node = sai_acl_get_acl_node();
-
-    sai_object_id_t acl_range_id = sai_uoid_create(SAI_OBJECT_TYPE_ACL_RANGE,obj_id);
+    uint64_t id = 0;
 
-    if(sai_acl_range_find(acl_node->sai_acl_range_tree,
-                                acl_range_id) != NULL) {
-        return true;
-    } else {
-        return false;
+    if(SAI_STATUS_SUCCESS ==
+       sai_id_allocator_alloc(&acl_range_id_allocator, &id)) {
+        return (sai_uoid_create(SAI_OBJECT_TYPE_ACL_RANGE, id));
     }
+    return SAI_NULL_OBJECT_ID;
 }
 
-static sai_object_id_t sai_acl_range_id_create(void)
+static void sai_acl_range_id_release(sai_object_id_t acl_range_id)
 {
-    if(SAI_STATUS_SUCCESS ==
-       dn_sai_get_next_free_id(&acl_range_info)) {
-        return (sai_uoid_create(SAI_OBJECT_TYPE_ACL_RANGE,
-                                acl_range_info.cur_id));
-    }
-    return SAI_NULL_OBJECT_ID;
+    sai_id_allocator_free(&acl_range_id_allocator,
+                          sai_uoid_npu_obj_id_get(acl_range_id));
 }
 
 void sai_acl_range_init(void)
 {
-    acl_range_info.cur_id = 0;
-    acl_range_info.is_wrappped = false;
-    acl_range_info.mask = SAI_UOID_NPU_OBJ_ID_MASK;
-    acl_range_info.is_id_in_use = sai_is_acl_range_id_in_use;
+    if(SAI_STATUS_SUCCESS !=
+       sai_id_allocator_init(&acl_range_id_allocator, "acl_range",
+                             SAI_ID_ALLOCATOR_MAX_IDS)) {
+        SAI_ACL_LOG_ERR ("ACL Range Id allocator init failed");
+    }
 }
 
 static sai_status_t sai_acl_range_attr_set(sai_acl_range_t *p_range_node,
@@ -207,6 +200,10 @@ sai_status_t sai_create_acl_range(sai_object_id_t *acl_range_id,
     }
     else{
         SAI_ACL_LOG_ERR("Range create failed");
+        if((p_range_node != NULL) &&
+           (p_range_node->acl_range_id != SAI_NULL_OBJECT_ID)) {
+            sai_acl_range_id_release(p_range_node->acl_range_id);
+        }
         sai_acl_range_free(p_range_node);
     }
 
@@ -270,6 +267,8 @@ sai_status_t sai_delete_acl_range(sai_object_id_t acl_range_id)
             break;
         }
 
+        sai_acl_range_id_release(acl_range_id);
+
     }while(0);
 
     sai_acl_unlock();
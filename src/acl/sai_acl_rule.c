@@ -32,6 +32,7 @@
 #include "saiacl.h"
 #include "saistatus.h"
 #include "sai_common_infra.h"
+#include "sai_api_latency.h"
 
 #include "std_type_defs.h"
 #include "std_assert.h"
@@ -484,7 +485,8 @@ static sai_status_t sai_install_acl_rule(sai_acl_table_t *acl_table,
     }
     /* Table programmed in hardware, now create the rule in
      * hardware. */
-    rc = sai_acl_npu_api_get()->create_acl_rule(acl_table, acl_rule);
+    SAI_API_LATENCY_NPU_CALL(rc,
+            sai_acl_npu_api_get()->create_acl_rule(acl_table, acl_rule));
 
     if (rc != SAI_STATUS_SUCCESS) {
         SAI_ACL_LOG_ERR ("ACL Rule Creation failed "
@@ -727,7 +729,8 @@ sai_status_t sai_delete_acl_rule(sai_object_id_t acl_id)
         }
 
         /* Delete the entry in the hardware*/
-        rc = sai_acl_npu_api_get()->delete_acl_rule(acl_table, acl_rule);
+        SAI_API_LATENCY_NPU_CALL(rc,
+                sai_acl_npu_api_get()->delete_acl_rule(acl_table, acl_rule));
         if (rc != SAI_STATUS_SUCCESS) {
             SAI_ACL_LOG_ERR ("Failure deleting ACL Rule Id 0x%"PRIx64" "
                              "from hardware", acl_id);
@@ -932,8 +935,9 @@ static sai_status_t sai_acl_rule_scan_and_mod(sai_acl_rule_t *rule_scan,
         /* Rule scan has been relevantly marked with the field/action change or
          * new field/action which needs to be added. Now modify ACL BCM
          * structures and update in NPU */
-        rc = sai_acl_npu_api_get()->set_acl_rule(acl_table, rule_scan,
-                                                 compare_rule, given_rule);
+        SAI_API_LATENCY_NPU_CALL(rc,
+                sai_acl_npu_api_get()->set_acl_rule(acl_table, rule_scan,
+                                                    compare_rule, given_rule));
 
         if (rc != SAI_STATUS_SUCCESS) {
             SAI_ACL_LOG_ERR ("ACL rule set attribute "
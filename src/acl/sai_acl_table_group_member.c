@@ -30,12 +30,13 @@
 #include "std_assert.h"
 #include "sai_oid_utils.h"
 #include "sai_common_infra.h"
+#include "sai_id_allocator.h"
 #include "sai_udf_api_utils.h"
 
 #include <stdlib.h>
 #include <inttypes.h>
 
-static dn_sai_id_gen_info_t acl_table_group_mem_obj_info;
+static sai_id_allocator_t acl_table_group_mem_id_allocator;
 
 static const dn_sai_attribute_entry_t dn_sai_acl_table_group_member_attr[] = {
     {SAI_ACL_TABLE_GROUP_MEMBER_ATTR_ACL_TABLE_GROUP_ID, true, true, false, true, true, true},
@@ -43,39 +44,30 @@ static const dn_sai_attribute_entry_t dn_sai_acl_table_group_member_attr[] = {
     {SAI_ACL_TABLE_GROUP_MEMBER_ATTR_PRIORITY, true, true, false, true, true, true},
 };
 
-bool sai_is_acl_table_group_member_id_in_use(uint64_t obj_id)
+static sai_object_id_t sai_acl_table_group_member_id_create(void)
 {
-    acl_node_pt acl_node = NULL;
-
-    acl_node = sai_acl_get_acl_node();
+    uint64_t id = 0;
 
-    sai_object_id_t acl_table_group_mem_id =
-        sai_uoid_create(SAI_OBJECT_TYPE_ACL_TABLE_GROUP_MEMBER,obj_id);
-
-    if(sai_acl_table_group_member_find(acl_node->sai_acl_table_group_member_tree,
-                                acl_table_group_mem_id) != NULL) {
-        return true;
-    } else {
-        return false;
+    if(SAI_STATUS_SUCCESS ==
+       sai_id_allocator_alloc(&acl_table_group_mem_id_allocator, &id)) {
+        return (sai_uoid_create(SAI_OBJECT_TYPE_ACL_TABLE_GROUP_MEMBER, id));
     }
+    return SAI_NULL_OBJECT_ID;
 }
 
-static sai_object_id_t sai_acl_table_group_member_id_create(void)
+static void sai_acl_table_group_member_id_release(sai_object_id_t acl_table_group_mem_id)
 {
-    if(SAI_STATUS_SUCCESS ==
-       dn_sai_get_next_free_id(&acl_table_group_mem_obj_info)) {
-        return (sai_uoid_create(SAI_OBJECT_TYPE_ACL_TABLE_GROUP_MEMBER,
-                                acl_table_group_mem_obj_info.cur_id));
-    }
-    return SAI_NULL_OBJECT_ID;
+    sai_id_allocator_free(&acl_table_group_mem_id_allocator,
+                          sai_uoid_npu_obj_id_get(acl_table_group_mem_id));
 }
 
 void sai_acl_table_group_member_init(void)
 {
-    acl_table_group_mem_obj_info.cur_id = 0;
-    acl_table_group_mem_obj_info.is_wrappped = false;
-    acl_table_group_mem_obj_info.mask = SAI_UOID_NPU_OBJ_ID_MASK;
-    acl_table_group_mem_obj_info.is_id_in_use = sai_is_acl_table_group_member_id_in_use;
+    if(SAI_STATUS_SUCCESS !=
+       sai_id_allocator_init(&acl_table_group_mem_id_allocator,
+                             "acl_table_group_member", SAI_ID_ALLOCATOR_MAX_IDS)) {
+        SAI_ACL_LOG_ERR ("ACL Table Group Member Id allocator init failed");
+    }
 }
 
 static inline void dn_sai_acl_table_group_member_attr_table_get (
@@ -317,6 +309,11 @@ sai_status_t sai_acl_table_group_member_create(sai_object_id_t *acl_table_group_
     }
     else{
         SAI_ACL_LOG_ERR("Acl table group create failed");
+        if((p_acl_table_group_mem_node != NULL) &&
+           (p_acl_table_group_mem_node->acl_table_group_member_id != SAI_NULL_OBJECT_ID)) {
+            sai_acl_table_group_member_id_release(
+                              p_acl_table_group_mem_node->acl_table_group_member_id);
+        }
         sai_acl_table_group_member_free(p_acl_table_group_mem_node);
     }
 
@@ -371,6 +368,7 @@ sai_status_t sai_acl_table_group_member_delete(sai_object_id_t acl_table_group_m
     }
     else {
         SAI_ACL_LOG_TRACE ("Removed acl table group 0x%"PRIx64"", acl_table_group_mem_id);
+        sai_acl_table_group_member_id_release(acl_table_group_mem_id);
         sai_acl_table_group_member_free(p_acl_table_group_mem_node);
     }
 
@@ -38,6 +38,7 @@
 #include "sai_npu_switch.h"
 
 #include "std_mutex_lock.h"
+#include "sai_lock_profile.h"
 #include "std_type_defs.h"
 #include "std_struct_utils.h"
 #include "std_rbtree.h"
@@ -100,6 +101,7 @@ static void dn_sai_switch_attr_id_to_hash_type (sai_attr_id_t attr_id,
  */
 static std_mutex_lock_create_static_init_fast (sai_hash_lock);
 
+SAI_LOCK_PROFILE_DEFINE (hash_lock_profile, "hash")
 
 static inline dn_sai_hash_obj_db_t *dn_sai_access_hash_obj_db (void)
 {
@@ -118,12 +120,13 @@ static inline uint8_t *dn_sai_hash_access_index_bitmap (void)
 
 static inline void dn_sai_hash_lock (void)
 {
-    std_mutex_lock (&sai_hash_lock);
+    sai_profiled_mutex_lock (&sai_hash_lock, &hash_lock_profile,
+                             SAI_LOCK_PROFILE_CALL_SITE ());
 }
 
 static inline void dn_sai_hash_unlock (void)
 {
-    std_mutex_unlock (&sai_hash_lock);
+    sai_profiled_mutex_unlock (&sai_hash_lock, &hash_lock_profile);
 }
 
 static dn_sai_hash_object_t *dn_sai_switch_attr_hash_obj_get (sai_attr_id_t attr_id)
@@ -89,6 +89,10 @@ sai_status_t sai_hostintf_init(void)
     memset(&g_hostif_info, 0, sizeof(dn_sai_hostintf_info_t));
     memset(&attr_list, 0, sizeof(attr_list));
 
+    for(index=0; index < DN_HOSTIF_MAX_TRAP_INDEX; index++) {
+        g_hostif_info.trap_cpu_queue[index] = DN_HOSTIF_INVALID_CPU_QUEUE;
+    }
+
     SAI_HOSTIF_LOG_INFO("Initializing hostif");
     g_hostif_info.max_pkt_attrs = sizeof(packet_attrs)
                          /sizeof(packet_attrs[0]);
@@ -98,8 +102,20 @@ sai_status_t sai_hostintf_init(void)
                           /sizeof(trap_attrs[0]);
 
     for(index=0; index < g_hostif_info.max_pkt_attrs; index++) {
+        STD_ASSERT(packet_attrs[index].attr_id < DN_HOSTIF_PKT_ATTR_MASK_BITS);
+
+        g_hostif_info.known_pkt_attr_mask |=
+            DN_HOSTIF_PKT_ATTR_BIT(packet_attrs[index].attr_id);
+
+        if(packet_attrs[index].valid_on_send) {
+            g_hostif_info.valid_send_pkt_attr_mask |=
+                DN_HOSTIF_PKT_ATTR_BIT(packet_attrs[index].attr_id);
+        }
+
         if(packet_attrs[index].mandatory_on_send) {
              g_hostif_info.mandatory_send_pkt_attr_count++;
+             g_hostif_info.mandatory_send_pkt_attr_mask |=
+                 DN_HOSTIF_PKT_ATTR_BIT(packet_attrs[index].attr_id);
         }
     }
 
@@ -425,6 +441,7 @@ static sai_status_t sai_create_hostif_trap_group(sai_object_id_t *trap_group_id,
                                "database",trap_group->key.trap_group_id);
             break;
         }
+        dn_sai_hostif_trapgroup_index_add(trap_group);
     } while(0);
 
     if (rc != SAI_STATUS_SUCCESS) {
@@ -456,8 +473,7 @@ static sai_status_t sai_remove_hostif_trap_group(sai_object_id_t trap_group_id)
 
     sai_hostif_lock();
     do {
-        trap_group = dn_sai_hostif_find_trapgroup(g_hostif_info.trap_group_tree,
-                                                  trap_group_id);
+        trap_group = dn_sai_hostif_trapgroup_get(trap_group_id);
         if (NULL == trap_group) {
             SAI_HOSTIF_LOG_ERR("Trap group %"PRIu64" not present",
                                trap_group_id);
@@ -488,6 +504,7 @@ static sai_status_t sai_remove_hostif_trap_group(sai_object_id_t trap_group_id)
         }
 
         rc = SAI_STATUS_SUCCESS;
+        dn_sai_hostif_trapgroup_index_remove(trap_group);
         dn_sai_hostif_dealloc_trapgroup(trap_group);
 
         SAI_HOSTIF_LOG_INFO("Successful removal of trap group %"PRIu64".",
@@ -532,6 +549,7 @@ static sai_status_t dn_sai_hostif_update_trapgroup(
     } else if (SAI_HOSTIF_TRAP_GROUP_ATTR_QUEUE == attr->id) {
         SAI_HOSTIF_LOG_TRACE("Updating trap group %"PRIu64" with new "
                              "cpu queue %u",attr->value.u32);
+        dn_sai_hostif_trapgroup_queue_index_update(trap_group, attr->value.u32);
         trap_group->cpu_queue = attr->value.u32;
     }
 
@@ -563,8 +581,7 @@ static sai_status_t sai_set_hostif_trap_group(sai_object_id_t trap_group_id,
 
     sai_hostif_lock();
     do {
-        trap_group = dn_sai_hostif_find_trapgroup(g_hostif_info.trap_group_tree,
-                                                  trap_group_id);
+        trap_group = dn_sai_hostif_trapgroup_get(trap_group_id);
         if (NULL == trap_group) {
             SAI_HOSTIF_LOG_ERR("Trap group %"PRIu64" not present",
                                trap_group_id);
@@ -636,8 +653,7 @@ static sai_status_t sai_get_hostif_trap_group(sai_object_id_t trap_group_id,
 
     sai_hostif_lock();
     do {
-        trap_group = dn_sai_hostif_find_trapgroup(g_hostif_info.trap_group_tree,
-                                                  trap_group_id);
+        trap_group = dn_sai_hostif_trapgroup_get(trap_group_id);
         if (NULL == trap_group) {
             SAI_HOSTIF_LOG_ERR("Trap group %"PRIu64" not present",
                                trap_group_id);
@@ -729,14 +745,15 @@ static dn_sai_trap_node_t * dn_sai_hostif_add_trap_node(
         }
 
         if(SAI_NULL_OBJECT_ID != g_hostif_info.default_trap_group_id) {
-            trap_group = dn_sai_hostif_find_trapgroup(g_hostif_info.trap_group_tree,
-                                                      g_hostif_info.default_trap_group_id);
+            trap_group = dn_sai_hostif_trapgroup_get(g_hostif_info.default_trap_group_id);
             STD_ASSERT(trap_group != NULL);
             dn_sai_hostif_add_trap_to_trapgroup(trap_node, trap_group);
             trap_node->trap_group = g_hostif_info.default_trap_group_id;
         } else {
             trap_node->trap_group = SAI_NULL_OBJECT_ID;
         }
+        dn_sai_hostif_trap_index_add(trap_node);
+        dn_sai_hostif_trap_queue_index_update(trap_node, trap_group);
     } while(0);
 
     if (rc != STD_ERR_OK) {
@@ -767,15 +784,13 @@ static sai_status_t dn_sai_hostif_update_trap_node(
         SAI_HOSTIF_LOG_TRACE("New trap priority %u",attr->value.u32);
         trap_node->trap_prio = attr->value.u32;
     } else if (SAI_HOSTIF_TRAP_ATTR_TRAP_GROUP == attr->id) {
-        old_group = dn_sai_hostif_find_trapgroup(g_hostif_info.trap_group_tree,
-                                                 trap_node->trap_group);
+        old_group = dn_sai_hostif_trapgroup_get(trap_node->trap_group);
         if (old_group != NULL) {
             dn_sai_hostif_remove_trap_to_trapgroup(trap_node, old_group);
         }
 
         if(attr->value.oid != SAI_NULL_OBJECT_ID) {
-            new_group = dn_sai_hostif_find_trapgroup(g_hostif_info.trap_group_tree,
-                                                     attr->value.oid);
+            new_group = dn_sai_hostif_trapgroup_get(attr->value.oid);
             if (NULL == new_group) {
                 SAI_HOSTIF_LOG_CRIT("Retrieval of the new trap group failed");
             }
@@ -783,6 +798,7 @@ static sai_status_t dn_sai_hostif_update_trap_node(
             STD_ASSERT(new_group != NULL);
             dn_sai_hostif_add_trap_to_trapgroup(trap_node, new_group);
         }
+        dn_sai_hostif_trap_queue_index_update(trap_node, new_group);
         SAI_HOSTIF_LOG_TRACE("New trap group %"PRIu64".",attr->value.oid);
         trap_node->trap_group = attr->value.oid;
 
@@ -821,8 +837,7 @@ static sai_status_t dn_sai_hostif_update_trap(
 
     if(SAI_NULL_OBJECT_ID != trap_node->trap_group) {
         /*Retrive existing trap group*/
-        trap_group = dn_sai_hostif_find_trapgroup(g_hostif_info.trap_group_tree,
-                                                  trap_node->trap_group);
+        trap_group = dn_sai_hostif_trapgroup_get(trap_node->trap_group);
         if (NULL == trap_group) {
             SAI_HOSTIF_LOG_CRIT("Retrieval of existing trap group failed");
         }
@@ -847,8 +862,7 @@ static sai_status_t dn_sai_hostif_update_trap(
         }
         /*New trap group id*/
         if (SAI_NULL_OBJECT_ID != attr->value.oid) {
-            trap_group = dn_sai_hostif_find_trapgroup(g_hostif_info.trap_group_tree,
-                                                      attr->value.oid);
+            trap_group = dn_sai_hostif_trapgroup_get(attr->value.oid);
         } else {
             trap_group = NULL;
         }
@@ -883,8 +897,7 @@ static sai_status_t sai_set_hostif_trap(sai_object_id_t trapid,
             break;
         }
 
-        trap_node = dn_sai_hostif_find_trap_node(g_hostif_info.trap_tree,
-                                                 trapid);
+        trap_node = dn_sai_hostif_trap_node_get(trapid);
         if (NULL == trap_node) {
             /*Create and add the node in the global trap node tree*/
             trap_node = dn_sai_hostif_add_trap_node(trapid);
@@ -925,7 +938,7 @@ static sai_status_t sai_get_hostif_trap(sai_object_id_t trapid,
 
     sai_hostif_lock();
     do {
-        trap_node = dn_sai_hostif_find_trap_node(g_hostif_info.trap_tree, trapid);
+        trap_node = dn_sai_hostif_trap_node_get(trapid);
         if (NULL == trap_node) {
             SAI_HOSTIF_LOG_ERR("Trap %d could not be found for get operation", trapid);
             rc = SAI_STATUS_ITEM_NOT_FOUND;
@@ -984,11 +997,18 @@ static sai_status_t sai_get_hostif_user_defined_trap(
     return SAI_STATUS_NOT_SUPPORTED;
 }
 
+/*
+ * Packet attributes are validated in a single pass over the attribute list.
+ * Known, send-valid and mandatory attributes are precomputed as bitmasks
+ * during init, and a mask of the attributes seen so far is used to catch
+ * duplicates.
+ */
 static sai_status_t sai_hostif_validate_pkt_attrlist(
                     uint_t attr_count, const sai_attribute_t *attr_list)
 {
-    uint_t attr_idx = 0, pkt_attr_idx = 0, dup_index = 0;
-    uint_t cur_mand_attr_count = 0, mand_attr_count = 0;
+    uint_t   attr_idx = 0;
+    uint64_t attr_bit = 0;
+    uint64_t seen_attr_mask = 0;
 
     STD_ASSERT(attr_list != NULL);
 
@@ -997,42 +1017,37 @@ static sai_status_t sai_hostif_validate_pkt_attrlist(
         return SAI_STATUS_INVALID_PARAMETER;
     }
 
-    mand_attr_count = g_hostif_info.mandatory_send_pkt_attr_count;
-
-    if (dn_sai_check_duplicate_attr(attr_count, attr_list, &dup_index)) {
-        SAI_HOSTIF_LOG_ERR("Duplicate pkt attrinute at index %u", dup_index);
-        return sai_get_indexed_ret_val(SAI_STATUS_INVALID_ATTRIBUTE_0,
-                                       dup_index);
-    }
-
     for (attr_idx = 0; attr_idx < attr_count; attr_idx++) {
         SAI_HOSTIF_LOG_TRACE("Validate pkt attribute %u", attr_list[attr_idx].id);
-        for (pkt_attr_idx = 0; pkt_attr_idx < g_hostif_info.max_pkt_attrs;
-             pkt_attr_idx++) {
-            if (attr_list[attr_idx].id == packet_attrs[pkt_attr_idx].attr_id) {
-
-                packet_attrs[pkt_attr_idx].mandatory_on_send ?
-                    cur_mand_attr_count++ : cur_mand_attr_count;
-
-                if (!packet_attrs[pkt_attr_idx].valid_on_send) {
-                    SAI_HOSTIF_LOG_ERR("Invalid attribute %u on pkt send",
-                                       attr_list[attr_idx].id);
-                    return sai_get_indexed_ret_val(SAI_STATUS_INVALID_ATTRIBUTE_0,
-                                                   attr_idx);
-                }
-                break;
-            }
-        }
 
-        if (pkt_attr_idx == g_hostif_info.max_pkt_attrs) {
+        if ((attr_list[attr_idx].id >= DN_HOSTIF_PKT_ATTR_MASK_BITS) ||
+            (!(g_hostif_info.known_pkt_attr_mask &
+               DN_HOSTIF_PKT_ATTR_BIT(attr_list[attr_idx].id)))) {
             SAI_HOSTIF_LOG_ERR("Unknown attribute %u on pkt send",
                                attr_list[attr_idx].id);
             return sai_get_indexed_ret_val(SAI_STATUS_UNKNOWN_ATTRIBUTE_0,
                                            attr_idx);
         }
+
+        attr_bit = DN_HOSTIF_PKT_ATTR_BIT(attr_list[attr_idx].id);
+
+        if (seen_attr_mask & attr_bit) {
+            SAI_HOSTIF_LOG_ERR("Duplicate pkt attribute at index %u", attr_idx);
+            return sai_get_indexed_ret_val(SAI_STATUS_INVALID_ATTRIBUTE_0,
+                                           attr_idx);
+        }
+        seen_attr_mask |= attr_bit;
+
+        if (!(g_hostif_info.valid_send_pkt_attr_mask & attr_bit)) {
+            SAI_HOSTIF_LOG_ERR("Invalid attribute %u on pkt send",
+                               attr_list[attr_idx].id);
+            return sai_get_indexed_ret_val(SAI_STATUS_INVALID_ATTRIBUTE_0,
+                                           attr_idx);
+        }
     }
 
-    if (cur_mand_attr_count < mand_attr_count) {
+    if ((seen_attr_mask & g_hostif_info.mandatory_send_pkt_attr_mask) !=
+        g_hostif_info.mandatory_send_pkt_attr_mask) {
         SAI_HOSTIF_LOG_ERR("Missing mandatory attributes on packet send");
         return SAI_STATUS_MANDATORY_ATTRIBUTE_MISSING;
     }
@@ -1083,10 +1098,83 @@ static sai_status_t sai_send_hostif_packet(sai_object_id_t  hif_id,
     return rc;
 }
 
+sai_status_t sai_hostif_send_packet_bulk(sai_object_id_t hif_id,
+                                         uint32_t pkt_count,
+                                         void **buffer_list,
+                                         const sai_size_t *buffer_size_list,
+                                         uint32_t attr_count,
+                                         sai_attribute_t *attr_list,
+                                         sai_status_t *status_list)
+{
+    uint_t       pkt_idx = 0;
+    uint_t       fail_count = 0;
+    sai_status_t rc = SAI_STATUS_FAILURE;
+
+    STD_ASSERT(buffer_list != NULL);
+    STD_ASSERT(buffer_size_list != NULL);
+    STD_ASSERT(attr_list != NULL);
+    STD_ASSERT(status_list != NULL);
+
+    SAI_HOSTIF_LOG_TRACE("Transmitting %u packets attribute count = %u",
+                         pkt_count, attr_count);
+
+    if (0 == pkt_count) {
+        SAI_HOSTIF_LOG_ERR("Invalid packet count %u for bulk pkt send",
+                           pkt_count);
+        return SAI_STATUS_INVALID_PARAMETER;
+    }
+
+    /* Attributes are shared by all packets, so validate them only once */
+    rc = sai_hostif_validate_pkt_attrlist(attr_count, attr_list);
+    if(rc != SAI_STATUS_SUCCESS) {
+        SAI_HOSTIF_LOG_ERR("failed validation of pkt attribute for bulk pkt send");
+        return rc;
+    }
+
+    for (pkt_idx = 0; pkt_idx < pkt_count; pkt_idx++) {
+        if ((NULL == buffer_list[pkt_idx]) || (0 == buffer_size_list[pkt_idx])) {
+            SAI_HOSTIF_LOG_ERR("Invalid buffer at index %u for bulk pkt send",
+                               pkt_idx);
+            status_list[pkt_idx] = SAI_STATUS_INVALID_PARAMETER;
+            fail_count++;
+            continue;
+        }
+
+        status_list[pkt_idx] = sai_hostif_npu_api_get()->npu_send_packet(
+                                                   buffer_list[pkt_idx],
+                                                   buffer_size_list[pkt_idx],
+                                                   attr_count, attr_list);
+        if (status_list[pkt_idx] != SAI_STATUS_SUCCESS) {
+            fail_count++;
+        }
+    }
+
+    SAI_HOSTIF_LOG_TRACE("Bulk pkt send done, %u of %u packets failed",
+                         fail_count, pkt_count);
+
+    return ((fail_count == 0) ? SAI_STATUS_SUCCESS : SAI_STATUS_FAILURE);
+}
+
+static void sai_hostif_rx_packet_notify(const void *buffer,
+                                        sai_size_t buffer_size,
+                                        uint32_t attr_count,
+                                        const sai_attribute_t *attr_list)
+{
+    sai_packet_event_notification_fn rx_fn = g_hostif_info.rx_notification_fn;
+
+    dn_sai_hostif_rx_pkt_counters_update(buffer_size, attr_count, attr_list);
+
+    if (rx_fn != NULL) {
+        rx_fn(buffer, buffer_size, attr_count, attr_list);
+    }
+}
+
 void sai_hostif_rx_register_callback(sai_packet_event_notification_fn rx_register_fn)
 {
     sai_hostif_lock();
-    sai_hostif_npu_api_get()->npu_register_packet_rx(rx_register_fn);
+    g_hostif_info.rx_notification_fn = rx_register_fn;
+    sai_hostif_npu_api_get()->npu_register_packet_rx(
+                     (rx_register_fn != NULL) ? sai_hostif_rx_packet_notify : NULL);
     sai_hostif_unlock();
 }
 
@@ -130,11 +130,45 @@ void sai_hostif_dump_trapgroups()
     }
 }
 
+void sai_hostif_dump_counters()
+{
+    dn_sai_hostintf_info_t *hostif_info = dn_sai_hostintf_get_info();
+    dn_sai_trap_node_t *trap_node = NULL;
+    uint_t index = 0;
+    uint_t cpu_queue = 0;
+
+    SAI_DEBUG("\r\nDumping received packet counters per trap\r\n");
+
+    for (index = 0; index < DN_HOSTIF_MAX_TRAP_INDEX; index++) {
+        trap_node = hostif_info->trap_index[index];
+        if (NULL == trap_node) {
+            continue;
+        }
+        SAI_DEBUG("Trap id = %d cpu queue = %u packets = %"PRIu64" bytes = %"PRIu64"",
+                  trap_node->key.trap_id, hostif_info->trap_cpu_queue[index],
+                  hostif_info->trap_counters[index].packets,
+                  hostif_info->trap_counters[index].bytes);
+    }
+
+    SAI_DEBUG("\r\nDumping received packet counters per cpu queue\r\n");
+
+    for (cpu_queue = 0; cpu_queue < DN_HOSTIF_MAX_CPU_QUEUES; cpu_queue++) {
+        if ((NULL == hostif_info->cpu_queue_index[cpu_queue]) &&
+            (0 == hostif_info->cpu_queue_counters[cpu_queue].packets)) {
+            continue;
+        }
+        SAI_DEBUG("Cpu queue = %u packets = %"PRIu64" bytes = %"PRIu64"",
+                  cpu_queue, hostif_info->cpu_queue_counters[cpu_queue].packets,
+                  hostif_info->cpu_queue_counters[cpu_queue].bytes);
+    }
+}
+
 void sai_hostif_help()
 {
     SAI_DEBUG("The dump functions are:");
     SAI_DEBUG("1. sai_hostif_dump_info(void)");
     SAI_DEBUG("2. sai_hostif_dump_traps(void)");
     SAI_DEBUG("3. sai_hostif_dump_trapgroups(void)");
+    SAI_DEBUG("4. sai_hostif_dump_counters(void)");
 }
 
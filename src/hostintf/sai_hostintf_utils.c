@@ -22,10 +22,12 @@
 
 #include "std_type_defs.h"
 #include "std_mutex_lock.h"
+#include "sai_lock_profile.h"
 #include "sai_hostif_main.h"
 #include "sai_hostif_api.h"
 #include "sai_gen_utils.h"
 #include "sai_hostif_common.h"
+#include "sai_oid_utils.h"
 
 #include "saihostintf.h"
 #include "saiswitch.h"
@@ -68,14 +70,17 @@ static const dn_sai_hostif_valid_traps_t valid_traps[] = {
 
 static std_mutex_lock_create_static_init_fast(sai_hostintf_lock);
 
+SAI_LOCK_PROFILE_DEFINE (hostif_lock_profile, "hostif")
+
 void sai_hostif_lock()
 {
-    std_mutex_lock (&sai_hostintf_lock);
+    sai_profiled_mutex_lock (&sai_hostintf_lock, &hostif_lock_profile,
+                             SAI_LOCK_PROFILE_CALL_SITE ());
 }
 
 void sai_hostif_unlock()
 {
-    std_mutex_unlock (&sai_hostintf_lock);
+    sai_profiled_mutex_unlock (&sai_hostintf_lock, &hostif_lock_profile);
 }
 
 bool dn_sai_hostif_is_valid_trap_id(
@@ -127,8 +132,7 @@ sai_status_t dn_sai_hostif_validate_trapgroup_oid(const sai_attribute_t *attr)
     dn_sai_hostintf_info_t *hostif_info = dn_sai_hostintf_get_info();
 
     if ((SAI_NULL_OBJECT_ID != attr->value.oid) &&
-        (NULL == dn_sai_hostif_find_trapgroup(hostif_info->trap_group_tree,
-                                              attr->value.oid))) {
+        (NULL == dn_sai_hostif_trapgroup_get(attr->value.oid))) {
         SAI_HOSTIF_LOG_ERR("Trap group %"PRIu64" not present",
                            attr->value.oid);
         return SAI_STATUS_INVALID_OBJECT_ID;
@@ -166,8 +170,17 @@ sai_status_t dn_sai_hostif_validate_action(const sai_attribute_t *attr)
 dn_sai_trap_group_node_t *dn_sai_hostif_find_trapgroup_by_queue(uint_t cpu_queue)
 {
     dn_sai_hostintf_info_t *hostif_info = dn_sai_hostintf_get_info();
+    dn_sai_trap_group_node_t *trap_group = NULL;
+
+    if (cpu_queue < DN_HOSTIF_MAX_CPU_QUEUES) {
+        trap_group = hostif_info->cpu_queue_index[cpu_queue];
+        if (trap_group != NULL) {
+            SAI_HOSTIF_LOG_TRACE("Found trap group with queue = %u", cpu_queue);
+        }
+        return trap_group;
+    }
 
-    dn_sai_trap_group_node_t *trap_group = (dn_sai_trap_group_node_t *)
+    trap_group = (dn_sai_trap_group_node_t *)
                          std_rbtree_getfirst(hostif_info->trap_group_tree);
 
     while (trap_group != NULL) {
@@ -181,3 +194,238 @@ dn_sai_trap_group_node_t *dn_sai_hostif_find_trapgroup_by_queue(uint_t cpu_queue
     return trap_group;
 }
 
+dn_sai_trap_group_node_t *dn_sai_hostif_trapgroup_get(sai_object_id_t trap_group_id)
+{
+    dn_sai_hostintf_info_t *hostif_info = dn_sai_hostintf_get_info();
+    dn_sai_trap_group_node_t *trap_group = NULL;
+    uint_t id = 0;
+
+    if (!sai_is_obj_id_hostif_trap_group(trap_group_id)) {
+        return NULL;
+    }
+
+    id = sai_uoid_npu_obj_id_get(trap_group_id);
+    if (id >= DN_HOSTIF_MAX_TRAP_GROUPS) {
+        return NULL;
+    }
+
+    trap_group = hostif_info->trap_group_index[id];
+    if ((trap_group != NULL) &&
+        (trap_group->key.trap_group_id != trap_group_id)) {
+        return NULL;
+    }
+    return trap_group;
+}
+
+dn_sai_trap_node_t *dn_sai_hostif_trap_node_get(sai_hostif_trap_type_t trap_id)
+{
+    dn_sai_hostintf_info_t *hostif_info = dn_sai_hostintf_get_info();
+    uint_t index = 0;
+
+    if (dn_sai_hostif_trap_index_get(trap_id, &index)) {
+        return hostif_info->trap_index[index];
+    }
+    return dn_sai_hostif_find_trap_node(hostif_info->trap_tree, trap_id);
+}
+
+void dn_sai_hostif_trapgroup_index_add(dn_sai_trap_group_node_t *trap_group)
+{
+    dn_sai_hostintf_info_t *hostif_info = dn_sai_hostintf_get_info();
+    uint_t id = 0;
+
+    STD_ASSERT(trap_group != NULL);
+
+    id = sai_uoid_npu_obj_id_get(trap_group->key.trap_group_id);
+    STD_ASSERT(id < DN_HOSTIF_MAX_TRAP_GROUPS);
+
+    hostif_info->trap_group_index[id] = trap_group;
+
+    if (trap_group->cpu_queue < DN_HOSTIF_MAX_CPU_QUEUES) {
+        hostif_info->cpu_queue_index[trap_group->cpu_queue] = trap_group;
+    }
+}
+
+void dn_sai_hostif_trapgroup_index_remove(dn_sai_trap_group_node_t *trap_group)
+{
+    dn_sai_hostintf_info_t *hostif_info = dn_sai_hostintf_get_info();
+    uint_t id = 0;
+
+    STD_ASSERT(trap_group != NULL);
+
+    id = sai_uoid_npu_obj_id_get(trap_group->key.trap_group_id);
+    if ((id < DN_HOSTIF_MAX_TRAP_GROUPS) &&
+        (hostif_info->trap_group_index[id] == trap_group)) {
+        hostif_info->trap_group_index[id] = NULL;
+    }
+
+    if ((trap_group->cpu_queue < DN_HOSTIF_MAX_CPU_QUEUES) &&
+        (hostif_info->cpu_queue_index[trap_group->cpu_queue] == trap_group)) {
+        hostif_info->cpu_queue_index[trap_group->cpu_queue] = NULL;
+    }
+}
+
+void dn_sai_hostif_trapgroup_queue_index_update(dn_sai_trap_group_node_t *trap_group,
+                                                uint_t new_cpu_queue)
+{
+    dn_sai_hostintf_info_t *hostif_info = dn_sai_hostintf_get_info();
+    dn_sai_trap_node_t *trap_node = NULL;
+    uint_t index = 0;
+
+    STD_ASSERT(trap_group != NULL);
+
+    if ((trap_group->cpu_queue < DN_HOSTIF_MAX_CPU_QUEUES) &&
+        (hostif_info->cpu_queue_index[trap_group->cpu_queue] == trap_group)) {
+        hostif_info->cpu_queue_index[trap_group->cpu_queue] = NULL;
+    }
+
+    if (new_cpu_queue < DN_HOSTIF_MAX_CPU_QUEUES) {
+        hostif_info->cpu_queue_index[new_cpu_queue] = trap_group;
+    }
+
+    trap_node = (dn_sai_trap_node_t *)std_dll_getfirst(&trap_group->trap_list);
+    while (trap_node != NULL) {
+        if (dn_sai_hostif_trap_index_get(trap_node->key.trap_id, &index)) {
+            hostif_info->trap_cpu_queue[index] = new_cpu_queue;
+        }
+        trap_node = (dn_sai_trap_node_t *)std_dll_getnext(&trap_group->trap_list,
+                                                          (std_dll *)trap_node);
+    }
+}
+
+void dn_sai_hostif_trap_index_add(dn_sai_trap_node_t *trap_node)
+{
+    dn_sai_hostintf_info_t *hostif_info = dn_sai_hostintf_get_info();
+    uint_t index = 0;
+
+    STD_ASSERT(trap_node != NULL);
+
+    if (dn_sai_hostif_trap_index_get(trap_node->key.trap_id, &index)) {
+        hostif_info->trap_index[index] = trap_node;
+    }
+}
+
+void dn_sai_hostif_trap_queue_index_update(dn_sai_trap_node_t *trap_node,
+                                           dn_sai_trap_group_node_t *trap_group)
+{
+    dn_sai_hostintf_info_t *hostif_info = dn_sai_hostintf_get_info();
+    uint_t index = 0;
+
+    STD_ASSERT(trap_node != NULL);
+
+    if (dn_sai_hostif_trap_index_get(trap_node->key.trap_id, &index)) {
+        hostif_info->trap_cpu_queue[index] = (trap_group != NULL) ?
+            trap_group->cpu_queue : DN_HOSTIF_INVALID_CPU_QUEUE;
+    }
+}
+
+/*
+ * Called for every received packet. Classification only uses the direct
+ * index tables and counters are updated atomically, so the hostif lock is
+ * not taken on the packet rx path.
+ */
+void dn_sai_hostif_rx_pkt_counters_update(sai_size_t buffer_size,
+                                          uint_t attr_count,
+                                          const sai_attribute_t *attr_list)
+{
+    dn_sai_hostintf_info_t *hostif_info = dn_sai_hostintf_get_info();
+    sai_hostif_trap_type_t trap_id = 0;
+    uint_t attr_idx = 0;
+    uint_t index = 0;
+    uint_t cpu_queue = DN_HOSTIF_INVALID_CPU_QUEUE;
+
+    if (NULL == attr_list) {
+        return;
+    }
+
+    for (attr_idx = 0; attr_idx < attr_count; attr_idx++) {
+        if (SAI_HOSTIF_PACKET_ATTR_HOSTIF_TRAP_ID == attr_list[attr_idx].id) {
+            break;
+        }
+    }
+
+    if (attr_idx == attr_count) {
+        return;
+    }
+
+    trap_id = (sai_hostif_trap_type_t)attr_list[attr_idx].value.oid;
+    if (!dn_sai_hostif_trap_index_get(trap_id, &index)) {
+        return;
+    }
+
+    __sync_fetch_and_add(&hostif_info->trap_counters[index].packets, 1);
+    __sync_fetch_and_add(&hostif_info->trap_counters[index].bytes, buffer_size);
+
+    cpu_queue = hostif_info->trap_cpu_queue[index];
+    if (cpu_queue < DN_HOSTIF_MAX_CPU_QUEUES) {
+        __sync_fetch_and_add(&hostif_info->cpu_queue_counters[cpu_queue].packets, 1);
+        __sync_fetch_and_add(&hostif_info->cpu_queue_counters[cpu_queue].bytes,
+                             buffer_size);
+    }
+}
+
+sai_status_t sai_hostif_trap_counters_get(sai_hostif_trap_type_t trap_id,
+                                          uint64_t *packets, uint64_t *bytes)
+{
+    dn_sai_hostintf_info_t *hostif_info = dn_sai_hostintf_get_info();
+    uint_t index = 0;
+
+    STD_ASSERT(packets != NULL);
+    STD_ASSERT(bytes != NULL);
+
+    if (!dn_sai_hostif_trap_index_get(trap_id, &index)) {
+        SAI_HOSTIF_LOG_ERR("Counters not supported for trap %d", trap_id);
+        return SAI_STATUS_INVALID_PARAMETER;
+    }
+
+    *packets = __atomic_load_n(&hostif_info->trap_counters[index].packets,
+                               __ATOMIC_RELAXED);
+    *bytes = __atomic_load_n(&hostif_info->trap_counters[index].bytes,
+                             __ATOMIC_RELAXED);
+
+    return SAI_STATUS_SUCCESS;
+}
+
+sai_status_t sai_hostif_cpu_queue_counters_get(uint32_t cpu_queue,
+                                               uint64_t *packets, uint64_t *bytes)
+{
+    dn_sai_hostintf_info_t *hostif_info = dn_sai_hostintf_get_info();
+
+    STD_ASSERT(packets != NULL);
+    STD_ASSERT(bytes != NULL);
+
+    if (cpu_queue >= DN_HOSTIF_MAX_CPU_QUEUES) {
+        SAI_HOSTIF_LOG_ERR("Counters not supported for cpu queue %u", cpu_queue);
+        return SAI_STATUS_INVALID_PARAMETER;
+    }
+
+    *packets = __atomic_load_n(&hostif_info->cpu_queue_counters[cpu_queue].packets,
+                               __ATOMIC_RELAXED);
+    *bytes = __atomic_load_n(&hostif_info->cpu_queue_counters[cpu_queue].bytes,
+                             __ATOMIC_RELAXED);
+
+    return SAI_STATUS_SUCCESS;
+}
+
+/*
+ * The rx path keeps incrementing the counters while they are cleared, so
+ * each counter is reset with an atomic store rather than a memset.
+ */
+void sai_hostif_counters_clear(void)
+{
+    dn_sai_hostintf_info_t *hostif_info = dn_sai_hostintf_get_info();
+    uint_t index = 0;
+
+    for (index = 0; index < DN_HOSTIF_MAX_TRAP_INDEX; index++) {
+        __atomic_store_n(&hostif_info->trap_counters[index].packets, 0,
+                         __ATOMIC_RELAXED);
+        __atomic_store_n(&hostif_info->trap_counters[index].bytes, 0,
+                         __ATOMIC_RELAXED);
+    }
+
+    for (index = 0; index < DN_HOSTIF_MAX_CPU_QUEUES; index++) {
+        __atomic_store_n(&hostif_info->cpu_queue_counters[index].packets, 0,
+                         __ATOMIC_RELAXED);
+        __atomic_store_n(&hostif_info->cpu_queue_counters[index].bytes, 0,
+                         __ATOMIC_RELAXED);
+    }
+}
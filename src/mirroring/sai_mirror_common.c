@@ -50,11 +50,36 @@
 
 static rbtree_handle mirror_sessions_tree = NULL;
 
+/* Session slot table, the slot indexes the per port session bitmaps */
+static sai_object_id_t mirror_session_slots [SAI_MIRROR_MAX_SESSION_SLOTS];
+
 rbtree_handle sai_mirror_sessions_db_get (void)
 {
     return mirror_sessions_tree;
 }
 
+int sai_mirror_session_slot_get (sai_object_id_t session_id)
+{
+    uint_t slot = 0;
+
+    for (slot = 0; slot < SAI_MIRROR_MAX_SESSION_SLOTS; slot++) {
+        if (mirror_session_slots [slot] == session_id) {
+            return slot;
+        }
+    }
+
+    return -1;
+}
+
+sai_object_id_t sai_mirror_session_slot_id_get (uint_t slot)
+{
+    if (slot >= SAI_MIRROR_MAX_SESSION_SLOTS) {
+        return SAI_NULL_OBJECT_ID;
+    }
+
+    return mirror_session_slots [slot];
+}
+
 static inline bool sai_mirror_is_span_type_valid (sai_mirror_session_type_t span_type)
 {
     switch (span_type) {
@@ -298,6 +323,7 @@ sai_status_t sai_mirror_session_create (sai_object_id_t *session_id,
     uint32_t                   attr_index              = 0;
     sai_status_t               error                   = SAI_STATUS_SUCCESS;
     sai_npu_object_id_t        npu_object_id           = 0;
+    int                        slot                    = 0;
 
     STD_ASSERT (attr_list != NULL);
     STD_ASSERT (attr_count);
@@ -311,6 +337,13 @@ sai_status_t sai_mirror_session_create (sai_object_id_t *session_id,
             break;
         }
 
+        slot = sai_mirror_session_slot_get (SAI_NULL_OBJECT_ID);
+        if (slot < 0) {
+            SAI_MIRROR_LOG_ERR ("Mirror session slots exhausted");
+            error = SAI_STATUS_INSUFFICIENT_RESOURCES;
+            break;
+        }
+
         p_session_info = sai_mirror_session_node_alloc ();
         if (!(p_session_info)) {
             SAI_MIRROR_LOG_ERR ("Memory allocation failed");
@@ -386,6 +419,8 @@ sai_status_t sai_mirror_session_create (sai_object_id_t *session_id,
             break;
         }
 
+        mirror_session_slots [slot] = p_session_info->session_id;
+
         *session_id = p_session_info->session_id;
     } while (0);
 
@@ -401,6 +436,7 @@ sai_status_t sai_mirror_session_remove (sai_object_id_t session_id)
 {
     sai_mirror_session_info_t *p_session_info = NULL;
     sai_status_t               error          = SAI_STATUS_SUCCESS;
+    int                        slot           = 0;
 
     if (!sai_is_obj_id_mirror_session (session_id)) {
         SAI_MIRROR_LOG_ERR ("0x%"PRIx64" is not a valid Mirror obj", session_id);
@@ -451,6 +487,11 @@ sai_status_t sai_mirror_session_remove (sai_object_id_t session_id)
             break;
         }
 
+        slot = sai_mirror_session_slot_get (session_id);
+        if (slot >= 0) {
+            mirror_session_slots [slot] = SAI_NULL_OBJECT_ID;
+        }
+
         sai_mirror_session_node_free (p_session_info);
 
     } while (0);
@@ -460,79 +501,64 @@ sai_status_t sai_mirror_session_remove (sai_object_id_t session_id)
     return error;
 }
 
-sai_status_t sai_mirror_session_port_add (sai_object_id_t session_id,
-                                          sai_object_id_t mirror_port_id,
-                                          sai_mirror_direction_t mirror_direction)
+/*
+ * Attaches a source port to the mirror session and updates the per port
+ * session bitmap. Caller must hold the mirror lock.
+ */
+static sai_status_t sai_mirror_session_source_port_add (sai_mirror_session_info_t *p_session_info,
+                                                        sai_object_id_t mirror_port_id,
+                                                        sai_mirror_direction_t mirror_direction)
 {
-    sai_mirror_session_info_t *p_session_info = NULL;
     sai_mirror_port_info_t    *p_source_node  = NULL;
     sai_status_t               error          = SAI_STATUS_SUCCESS;
     sai_mirror_port_info_t     tmp_source_node;
-    bool                       is_source_node_created = false;
+    int                        slot           = 0;
 
     memset (&tmp_source_node, 0, sizeof(tmp_source_node));
 
-    if (!sai_is_obj_id_mirror_session (session_id)) {
-        SAI_MIRROR_LOG_ERR ("0x%"PRIx64" is not a valid Mirror obj", session_id);
+    SAI_MIRROR_LOG_TRACE ("Add port 0x%"PRIx64" to mirror session 0x%"PRIx64" in direction %d",
+                           mirror_port_id, p_session_info->session_id, mirror_direction);
 
-        return SAI_STATUS_INVALID_OBJECT_TYPE;
+    if(!sai_is_port_valid(mirror_port_id)) {
+        SAI_MIRROR_LOG_ERR("Port id 0x%"PRIx64" is not valid", mirror_port_id);
+        return SAI_STATUS_INVALID_OBJECT_ID;
     }
 
-    sai_mirror_lock();
-    SAI_MIRROR_LOG_TRACE ("Add port 0x%"PRIx64" to mirror session 0x%"PRIx64" in direction %d",
-                           mirror_port_id, session_id, mirror_direction);
-    do {
-        if(!sai_is_port_valid(mirror_port_id)) {
-            SAI_MIRROR_LOG_ERR("Port id 0x%"PRIx64" is not valid", mirror_port_id);
-            error = SAI_STATUS_INVALID_OBJECT_ID;
-            break;
-        }
-        if (!mirror_sessions_tree) {
-            SAI_MIRROR_LOG_ERR ("Mirror initialization not done");
-            error = SAI_STATUS_FAILURE;
-            break;
-        }
+    if (!p_session_info->source_ports_tree) {
+        SAI_MIRROR_LOG_ERR ("Source ports tree initialization not done");
+        return SAI_STATUS_FAILURE;
+    }
 
-        p_session_info = (sai_mirror_session_info_t *) std_rbtree_getexact (
-                                        mirror_sessions_tree, (void *)&session_id);
-        if (p_session_info == NULL) {
-            SAI_MIRROR_LOG_ERR ("Mirror Session not found 0x%"PRIx64"", session_id);
-            error = SAI_STATUS_INVALID_OBJECT_ID;
-            break;
-        }
+    slot = sai_mirror_session_slot_get (p_session_info->session_id);
+    if (slot < 0) {
+        SAI_MIRROR_LOG_ERR ("Mirror session slot not found 0x%"PRIx64"",
+                            p_session_info->session_id);
+        return SAI_STATUS_FAILURE;
+    }
 
-        if (!p_session_info->source_ports_tree) {
-            SAI_MIRROR_LOG_ERR ("Source ports tree initialization not done");
-            error = SAI_STATUS_FAILURE;
-            break;
-        }
+    tmp_source_node.mirror_port = mirror_port_id;
+    tmp_source_node.mirror_direction   = mirror_direction;
 
-        tmp_source_node.mirror_port = mirror_port_id;
-        tmp_source_node.mirror_direction   = mirror_direction;
-
-        p_source_node = std_rbtree_getexact (p_session_info->source_ports_tree,
-                                            (void *) &tmp_source_node);
-        if (p_source_node == NULL) {
-            p_source_node = sai_source_port_node_alloc();
-            if (p_source_node == NULL) {
-                SAI_MIRROR_LOG_ERR ("Memory allocation failed for source port 0x%"PRIx64"",
-                        mirror_port_id);
-                error = SAI_STATUS_NO_MEMORY;
-                break;
-            }
-            is_source_node_created = true;
-        } else {
-            SAI_MIRROR_LOG_ERR ("Mirror port 0x%"PRIx64" already exists for direction %d",
-                                mirror_port_id, mirror_direction);
-            error = SAI_STATUS_ITEM_ALREADY_EXISTS;
-            break;
-        }
+    if (std_rbtree_getexact (p_session_info->source_ports_tree,
+                             (void *) &tmp_source_node) != NULL) {
+        SAI_MIRROR_LOG_ERR ("Mirror port 0x%"PRIx64" already exists for direction %d",
+                            mirror_port_id, mirror_direction);
+        return SAI_STATUS_ITEM_ALREADY_EXISTS;
+    }
+
+    p_source_node = sai_source_port_node_alloc();
+    if (p_source_node == NULL) {
+        SAI_MIRROR_LOG_ERR ("Memory allocation failed for source port 0x%"PRIx64"",
+                mirror_port_id);
+        return SAI_STATUS_NO_MEMORY;
+    }
 
-        p_source_node->mirror_direction = mirror_direction;
-        p_source_node->mirror_port = mirror_port_id;
+    p_source_node->mirror_direction = mirror_direction;
+    p_source_node->mirror_port = mirror_port_id;
 
-        if ((error = sai_mirror_npu_api_get()->session_port_add (session_id, mirror_port_id,
-                            mirror_direction)) != SAI_STATUS_SUCCESS) {
+    do {
+        if ((error = sai_mirror_npu_api_get()->session_port_add (p_session_info->session_id,
+                            mirror_port_id, mirror_direction)) != SAI_STATUS_SUCCESS) {
             SAI_MIRROR_LOG_ERR ("Mirror Port addition failed for port 0x%"PRIx64"",
                     mirror_port_id);
             break;
@@ -546,12 +572,129 @@ sai_status_t sai_mirror_session_port_add (sai_object_id_t session_id,
             break;
         }
 
+        error = sai_mirror_port_session_map_update (mirror_port_id, slot,
+                                                    mirror_direction, true);
+        if (error != SAI_STATUS_SUCCESS) {
+            std_rbtree_remove (p_session_info->source_ports_tree, (void *)p_source_node);
+            sai_mirror_npu_api_get()->session_port_remove (p_session_info->session_id, mirror_port_id,
+                                                mirror_direction);
+            break;
+        }
     } while (0);
 
-    if ((p_source_node) && (is_source_node_created) && (error != SAI_STATUS_SUCCESS)) {
+    if (error != SAI_STATUS_SUCCESS) {
         sai_source_port_node_free (p_source_node);
     }
 
+    return error;
+}
+
+/*
+ * Detaches a source port from the mirror session and updates the per port
+ * session bitmap. Caller must hold the mirror lock.
+ */
+static sai_status_t sai_mirror_session_source_port_remove (sai_mirror_session_info_t *p_session_info,
+                                                           sai_object_id_t mirror_port_id,
+                                                           sai_mirror_direction_t mirror_direction)
+{
+    sai_mirror_port_info_t    *p_source_node  = NULL;
+    sai_status_t               error          = SAI_STATUS_SUCCESS;
+    sai_mirror_port_info_t     tmp_source_node;
+    int                        slot           = 0;
+
+    memset (&tmp_source_node, 0, sizeof(tmp_source_node));
+
+    SAI_MIRROR_LOG_TRACE ("Remove port 0x%"PRIx64" from mirror session 0x%"PRIx64" for direction %d",
+                           mirror_port_id, p_session_info->session_id, mirror_direction);
+
+    if(!(sai_is_port_valid(mirror_port_id))) {
+        SAI_MIRROR_LOG_ERR("Port id 0x%"PRIx64" is not valid", mirror_port_id);
+        return SAI_STATUS_INVALID_OBJECT_ID;
+    }
+
+    if (!p_session_info->source_ports_tree) {
+        SAI_MIRROR_LOG_ERR ("Source ports tree initialization not done");
+        return SAI_STATUS_FAILURE;
+    }
+
+    tmp_source_node.mirror_port = mirror_port_id;
+    tmp_source_node.mirror_direction   = mirror_direction;
+
+    p_source_node = std_rbtree_getexact (p_session_info->source_ports_tree,
+                                        (void *) &tmp_source_node);
+    if (p_source_node == NULL) {
+        SAI_MIRROR_LOG_ERR ("Mirror port not found 0x%"PRIx64"", mirror_port_id);
+        return SAI_STATUS_ITEM_NOT_FOUND;
+    }
+
+    if ((error = sai_mirror_npu_api_get()->session_port_remove (p_session_info->session_id,
+                        mirror_port_id, mirror_direction)) != SAI_STATUS_SUCCESS) {
+        SAI_MIRROR_LOG_ERR ("Mirror port 0x%"PRIx64" removal from session 0x%"PRIx64" failed",
+                               mirror_port_id, p_session_info->session_id);
+        return error;
+    }
+
+    if (std_rbtree_remove (p_session_info->source_ports_tree, (void *)p_source_node) !=
+            p_source_node) {
+        SAI_MIRROR_LOG_ERR ("Mirror port node remove failed 0x%"PRIx64"", mirror_port_id);
+        return SAI_STATUS_FAILURE;
+    }
+
+    sai_source_port_node_free (p_source_node);
+
+    slot = sai_mirror_session_slot_get (p_session_info->session_id);
+    if (slot >= 0) {
+        sai_mirror_port_session_map_update (mirror_port_id, slot, mirror_direction, false);
+    }
+
+    return SAI_STATUS_SUCCESS;
+}
+
+/*
+ * Looks up the mirror session. Caller must hold the mirror lock.
+ */
+static sai_mirror_session_info_t *sai_mirror_session_node_get (sai_object_id_t session_id)
+{
+    sai_mirror_session_info_t *p_session_info = NULL;
+
+    if (!mirror_sessions_tree) {
+        SAI_MIRROR_LOG_ERR ("Mirror initialization not done");
+        return NULL;
+    }
+
+    p_session_info = (sai_mirror_session_info_t *) std_rbtree_getexact (
+                                    mirror_sessions_tree, (void *)&session_id);
+    if (p_session_info == NULL) {
+        SAI_MIRROR_LOG_ERR ("Mirror Session not found 0x%"PRIx64"", session_id);
+    }
+
+    return p_session_info;
+}
+
+sai_status_t sai_mirror_session_port_add (sai_object_id_t session_id,
+                                          sai_object_id_t mirror_port_id,
+                                          sai_mirror_direction_t mirror_direction)
+{
+    sai_mirror_session_info_t *p_session_info = NULL;
+    sai_status_t               error          = SAI_STATUS_SUCCESS;
+
+    if (!sai_is_obj_id_mirror_session (session_id)) {
+        SAI_MIRROR_LOG_ERR ("0x%"PRIx64" is not a valid Mirror obj", session_id);
+
+        return SAI_STATUS_INVALID_OBJECT_TYPE;
+    }
+
+    sai_mirror_lock();
+
+    p_session_info = sai_mirror_session_node_get (session_id);
+
+    if (p_session_info == NULL) {
+        error = SAI_STATUS_INVALID_OBJECT_ID;
+    } else {
+        error = sai_mirror_session_source_port_add (p_session_info, mirror_port_id,
+                                                    mirror_direction);
+    }
+
     sai_mirror_unlock();
     return error;
 }
@@ -561,11 +704,7 @@ sai_status_t sai_mirror_session_port_remove  (sai_object_id_t session_id,
                                               sai_mirror_direction_t mirror_direction)
 {
     sai_mirror_session_info_t *p_session_info = NULL;
-    sai_mirror_port_info_t    *p_source_node  = NULL;
     sai_status_t               error          = SAI_STATUS_SUCCESS;
-    sai_mirror_port_info_t    tmp_source_node;
-
-    memset (&tmp_source_node, 0, sizeof(tmp_source_node));
 
     if (!sai_is_obj_id_mirror_session (session_id)) {
         SAI_MIRROR_LOG_ERR ("0x%"PRIx64" is not a valid Mirror obj", session_id);
@@ -574,70 +713,92 @@ sai_status_t sai_mirror_session_port_remove  (sai_object_id_t session_id,
     }
 
     sai_mirror_lock();
-    SAI_MIRROR_LOG_TRACE ("Remove port 0x%"PRIx64" from mirror session 0x%"PRIx64" for direction %d",
-                           mirror_port_id, session_id, mirror_direction);
 
-    do {
-        if(!(sai_is_port_valid(mirror_port_id))) {
-            SAI_MIRROR_LOG_ERR("Port id 0x%"PRIx64" is not valid", mirror_port_id);
-            error = SAI_STATUS_INVALID_OBJECT_ID;
-            break;
-        }
+    p_session_info = sai_mirror_session_node_get (session_id);
 
-        if (!mirror_sessions_tree) {
-            SAI_MIRROR_LOG_ERR ("Mirror initialization not done");
-            error = SAI_STATUS_FAILURE;
-            break;
-        }
+    if (p_session_info == NULL) {
+        error = SAI_STATUS_INVALID_OBJECT_ID;
+    } else {
+        error = sai_mirror_session_source_port_remove (p_session_info, mirror_port_id,
+                                                       mirror_direction);
+    }
 
-        p_session_info = (sai_mirror_session_info_t *) std_rbtree_getexact (
-                                  mirror_sessions_tree, (void *)&session_id);
-        if (p_session_info == NULL) {
-            SAI_MIRROR_LOG_ERR ("Mirror session not found 0x%"PRIx64"", session_id);
-            error = SAI_STATUS_INVALID_OBJECT_ID;
-            break;
-        }
+    sai_mirror_unlock();
 
-        if (!p_session_info->source_ports_tree) {
-            SAI_MIRROR_LOG_ERR ("Source ports tree initialization not done");
-            error = SAI_STATUS_FAILURE;
-            break;
-        }
+    return error;
+}
 
-        tmp_source_node.mirror_port = mirror_port_id;
-        tmp_source_node.mirror_direction   = mirror_direction;
+static sai_status_t sai_mirror_session_port_list_update (sai_object_id_t session_id,
+                                                         const sai_object_list_t *port_list,
+                                                         sai_mirror_direction_t mirror_direction,
+                                                         bool is_add,
+                                                         sai_status_t *port_statuses)
+{
+    sai_mirror_session_info_t *p_session_info = NULL;
+    sai_status_t               error          = SAI_STATUS_SUCCESS;
+    uint32_t                   port_idx       = 0;
 
-        p_source_node = std_rbtree_getexact (p_session_info->source_ports_tree,
-                                            (void *) &tmp_source_node);
-        if (p_source_node == NULL) {
-            SAI_MIRROR_LOG_ERR ("Mirror port not found 0x%"PRIx64"", mirror_port_id);
-            error = SAI_STATUS_ITEM_NOT_FOUND;
-            break;
-        }
+    if ((port_list == NULL) || (port_list->list == NULL) ||
+        (port_list->count == 0) || (port_statuses == NULL)) {
+        return SAI_STATUS_INVALID_PARAMETER;
+    }
 
-        if ((error = sai_mirror_npu_api_get()->session_port_remove (session_id, mirror_port_id,
-                            mirror_direction)) != SAI_STATUS_SUCCESS) {
-            SAI_MIRROR_LOG_ERR ("Mirror port 0x%"PRIx64" removal from session 0x%"PRIx64" failed",
-                                   mirror_port_id, session_id);
-            break;
+    if (!sai_is_obj_id_mirror_session (session_id)) {
+        SAI_MIRROR_LOG_ERR ("0x%"PRIx64" is not a valid Mirror obj", session_id);
+
+        return SAI_STATUS_INVALID_OBJECT_TYPE;
+    }
+
+    sai_mirror_lock();
+
+    p_session_info = sai_mirror_session_node_get (session_id);
+
+    if (p_session_info == NULL) {
+        sai_mirror_unlock();
+        return SAI_STATUS_INVALID_OBJECT_ID;
+    }
+
+    for (port_idx = 0; port_idx < port_list->count; port_idx++) {
+        if (is_add) {
+            port_statuses [port_idx] =
+                sai_mirror_session_source_port_add (p_session_info,
+                                                    port_list->list [port_idx],
+                                                    mirror_direction);
+        } else {
+            port_statuses [port_idx] =
+                sai_mirror_session_source_port_remove (p_session_info,
+                                                       port_list->list [port_idx],
+                                                       mirror_direction);
         }
 
-        if (std_rbtree_remove (p_session_info->source_ports_tree, (void *)p_source_node) !=
-                p_source_node) {
-            SAI_MIRROR_LOG_ERR ("Mirror port node remove failed 0x%"PRIx64"", mirror_port_id);
+        if (port_statuses [port_idx] != SAI_STATUS_SUCCESS) {
             error = SAI_STATUS_FAILURE;
-            break;
         }
-
-        sai_source_port_node_free (p_source_node);
-
-    } while (0);
+    }
 
     sai_mirror_unlock();
 
     return error;
 }
 
+sai_status_t sai_mirror_session_port_list_add (sai_object_id_t session_id,
+                                               const sai_object_list_t *port_list,
+                                               sai_mirror_direction_t mirror_direction,
+                                               sai_status_t *port_statuses)
+{
+    return sai_mirror_session_port_list_update (session_id, port_list, mirror_direction,
+                                                true, port_statuses);
+}
+
+sai_status_t sai_mirror_session_port_list_remove (sai_object_id_t session_id,
+                                                  const sai_object_list_t *port_list,
+                                                  sai_mirror_direction_t mirror_direction,
+                                                  sai_status_t *port_statuses)
+{
+    return sai_mirror_session_port_list_update (session_id, port_list, mirror_direction,
+                                                false, port_statuses);
+}
+
 sai_status_t sai_mirror_session_attribute_set (sai_object_id_t session_id,
                                                const sai_attribute_t *attr)
 {
@@ -745,6 +906,11 @@ sai_status_t sai_mirror_init (void)
         return SAI_STATUS_FAILURE;
     }
 
+    if (sai_mirror_port_session_map_init () != SAI_STATUS_SUCCESS) {
+        SAI_MIRROR_LOG_ERR ("Mirror port session map create failed");
+        return SAI_STATUS_FAILURE;
+    }
+
     ret = sai_mirror_npu_api_get()->mirror_init();
 
     if (ret != SAI_STATUS_SUCCESS) {
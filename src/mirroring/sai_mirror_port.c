@@ -32,187 +32,185 @@
 
 #include "std_assert.h"
 #include "std_rbtree.h"
+#include "std_struct_utils.h"
 
 #include <string.h>
 #include <stdlib.h>
 #include <inttypes.h>
 
-static sai_status_t sai_mirror_remove_mirror_per_port (sai_object_id_t port_id,
-                                     const sai_attribute_t *attr,
-                                     sai_mirror_direction_t mirror_direction)
-{
-    sai_status_t                    ret                   = SAI_STATUS_SUCCESS;
-    uint32_t                        session_idx           = 0;
-    rbtree_handle                   mirror_per_port_tree  = NULL;
-    bool                            is_remove             = false;
-    sai_object_id_t                 mirror_session_id     = 0;
-    sai_mirror_session_per_port_t  *mirror_session_node   = NULL;
-    sai_mirror_session_per_port_t   temp_mirror_session_node;
-    sai_port_application_info_t    *port_node             = NULL;
+/*
+ * Mirror sessions attached to a port, as bitmaps indexed by session slot.
+ */
+typedef struct _sai_mirror_port_session_map_t {
+    sai_object_id_t port_id;
+    uint64_t        ingress_map;
+    uint64_t        egress_map;
+} sai_mirror_port_session_map_t;
 
-    memset (&temp_mirror_session_node, 0, sizeof (temp_mirror_session_node));
+static rbtree_handle mirror_port_session_map_tree = NULL;
 
-    SAI_MIRROR_LOG_TRACE ("Mirror is enabled in port 0x%"PRIx64" for direction %d", port_id,
-                            mirror_direction);
+sai_status_t sai_mirror_port_session_map_init (void)
+{
+    mirror_port_session_map_tree = std_rbtree_create_simple ("mirror_port_session_map_tree",
+                           STD_STR_OFFSET_OF(sai_mirror_port_session_map_t, port_id),
+                           STD_STR_SIZE_OF(sai_mirror_port_session_map_t, port_id));
 
-    port_node = sai_port_application_info_create_and_get (port_id);
-    if (port_node == NULL) {
-        SAI_MIRROR_LOG_ERR ("Port Info is NULL for port 0x%"PRIx64"", port_id);
+    if (mirror_port_session_map_tree == NULL) {
         return SAI_STATUS_FAILURE;
-    } else {
-        mirror_per_port_tree = (rbtree_handle) port_node->mirror_sessions_tree;
-        if (mirror_per_port_tree == NULL) {
-            SAI_MIRROR_LOG_ERR ("Mirror sessions tree is NULL for port 0x%"PRIx64"", port_id);
-            return SAI_STATUS_FAILURE;
-        }
     }
 
-    mirror_session_node = std_rbtree_getfirst (mirror_per_port_tree);
-    while (mirror_session_node)
-    {
-        temp_mirror_session_node.session_id = mirror_session_node->session_id;
-        temp_mirror_session_node.mirror_direction = mirror_session_node->mirror_direction;
+    return SAI_STATUS_SUCCESS;
+}
 
-        if (mirror_session_node->mirror_direction != mirror_direction)  {
-            mirror_session_node = std_rbtree_getnext (mirror_per_port_tree,
-                                                     &temp_mirror_session_node);
-            continue;
+static uint64_t *sai_mirror_port_session_map_ptr_get (sai_mirror_port_session_map_t *p_map,
+                                                      sai_mirror_direction_t mirror_direction)
+{
+    return ((mirror_direction == SAI_MIRROR_DIR_INGRESS) ?
+            &p_map->ingress_map : &p_map->egress_map);
+}
+
+static uint64_t sai_mirror_port_session_map_get (sai_object_id_t port_id,
+                                                 sai_mirror_direction_t mirror_direction)
+{
+    sai_mirror_port_session_map_t *p_map = NULL;
+
+    p_map = std_rbtree_getexact (mirror_port_session_map_tree, (void *) &port_id);
+
+    if (p_map == NULL) {
+        return 0;
+    }
+
+    return *sai_mirror_port_session_map_ptr_get (p_map, mirror_direction);
+}
+
+sai_status_t sai_mirror_port_session_map_update (sai_object_id_t port_id, uint_t slot,
+                                                 sai_mirror_direction_t mirror_direction,
+                                                 bool is_set)
+{
+    sai_mirror_port_session_map_t *p_map = NULL;
+    uint64_t                      *p_session_map = NULL;
+
+    STD_ASSERT (slot < SAI_MIRROR_MAX_SESSION_SLOTS);
+
+    p_map = std_rbtree_getexact (mirror_port_session_map_tree, (void *) &port_id);
+
+    if (p_map == NULL) {
+        if (!is_set) {
+            return SAI_STATUS_SUCCESS;
         }
-        is_remove = true;
-
-        for (session_idx = 0; session_idx < attr->value.objlist.count;
-             session_idx++)
-        {
-            mirror_session_id = attr->value.objlist.list[session_idx];
-            if (mirror_session_node->session_id == mirror_session_id) {
-                is_remove = false;
-                break;
-            }
+
+        p_map = (sai_mirror_port_session_map_t *) calloc (1, sizeof (*p_map));
+        if (p_map == NULL) {
+            SAI_MIRROR_LOG_ERR("Memory allocation failed for mirror session map "
+                               "for port 0x%"PRIx64"", port_id);
+            return SAI_STATUS_NO_MEMORY;
         }
 
-        if (is_remove) {
-            ret = sai_mirror_session_port_remove (mirror_session_node->session_id,
-                    port_id, mirror_direction);
-            if (ret != SAI_STATUS_SUCCESS) {
-                SAI_MIRROR_LOG_ERR("Could not remove port 0x%"PRIx64" from the mirror session 0x%"PRIx64"",
-                        port_id, mirror_session_id);
-                break;
-            } else {
-                if (std_rbtree_remove(mirror_per_port_tree,
-                            (void *) mirror_session_node) != mirror_session_node) {
-
-                    ret = SAI_STATUS_FAILURE;
-                    SAI_MIRROR_LOG_ERR ("Node remove failed 0x%"PRIx64"", mirror_session_node->session_id);
-                    break;
-                }
-                free (mirror_session_node);
-            }
+        p_map->port_id = port_id;
+
+        if (std_rbtree_insert (mirror_port_session_map_tree, (void *) p_map) != STD_ERR_OK) {
+            SAI_MIRROR_LOG_ERR ("Mirror session map insertion failed for port 0x%"PRIx64"",
+                                port_id);
+            free (p_map);
+            return SAI_STATUS_FAILURE;
         }
+    }
+
+    p_session_map = sai_mirror_port_session_map_ptr_get (p_map, mirror_direction);
 
-        mirror_session_node = std_rbtree_getnext (mirror_per_port_tree, &temp_mirror_session_node);
+    if (is_set) {
+        *p_session_map |= (1ULL << slot);
+    } else {
+        *p_session_map &= ~(1ULL << slot);
     }
-    if (std_rbtree_getfirst(mirror_per_port_tree) == NULL)
-    {
-         std_rbtree_destroy (mirror_per_port_tree);
-         port_node->mirror_sessions_tree = NULL;
-         sai_port_application_info_remove(port_node);
+
+    if ((p_map->ingress_map == 0) && (p_map->egress_map == 0)) {
+        std_rbtree_remove (mirror_port_session_map_tree, (void *) p_map);
+        free (p_map);
     }
 
-    return ret;
+    return SAI_STATUS_SUCCESS;
 }
 
 sai_status_t sai_mirror_handle_per_port (sai_object_id_t port_id,
                                      const sai_attribute_t *attr,
                                      sai_mirror_direction_t mirror_direction)
 {
-    sai_status_t                       ret                 = SAI_STATUS_SUCCESS;
-    uint32_t                           session_idx         = 0;
-    rbtree_handle                      mirror_per_port_tree         = NULL;
-    sai_object_id_t                    mirror_session_id   = 0;
-    sai_mirror_session_per_port_t     *mirror_session_node = NULL;
-    sai_mirror_session_per_port_t      temp_mirror_session_node;
-    sai_port_application_info_t       *port_node = NULL;
-
-    memset (&temp_mirror_session_node, 0, sizeof (temp_mirror_session_node));
+    sai_status_t     ret               = SAI_STATUS_SUCCESS;
+    uint32_t         session_idx       = 0;
+    uint_t           slot              = 0;
+    int              session_slot      = 0;
+    sai_object_id_t  mirror_session_id = 0;
+    sai_object_id_t  slot_session_id [SAI_MIRROR_MAX_SESSION_SLOTS];
+    uint64_t         cur_map           = 0;
+    uint64_t         new_map           = 0;
 
     SAI_MIRROR_LOG_TRACE ("Mirror is enabled in port 0x%"PRIx64" for direction %d", port_id,
                             mirror_direction);
 
-    port_node = sai_port_application_info_create_and_get (port_id);
-    if (port_node == NULL) {
-        SAI_MIRROR_LOG_ERR ("Port Info is NULL for port 0x%"PRIx64"", port_id);
-        return SAI_STATUS_FAILURE;
-    } else {
-        if (port_node->mirror_sessions_tree == NULL) {
-            SAI_MIRROR_LOG_INFO ("Mirror sessions tree is NULL for port 0x%"PRIx64"", port_id);
-            port_node->mirror_sessions_tree = std_rbtree_create_simple (
-                    "mirror_sessions_tree_per_port", 0, sizeof(sai_mirror_session_per_port_t));
-            if (port_node->mirror_sessions_tree == NULL) {
-                SAI_MIRROR_LOG_ERR ("Mirror port tree is NULL for port 0x%"PRIx64"", port_id);
-                return SAI_STATUS_FAILURE;
-            }
-        }
-    }
-    mirror_per_port_tree = (rbtree_handle) port_node->mirror_sessions_tree;
-
     /*
-     * Walk through the attribute and check whether it is a new session add or
-     * update of the sessions and process accordingly.
+     * Build the bitmap of requested sessions and diff it against the
+     * sessions currently attached to the port.
      */
+    sai_mirror_lock();
+
     for (session_idx = 0; session_idx < attr->value.objlist.count; session_idx++)
     {
         mirror_session_id = attr->value.objlist.list[session_idx];
-        temp_mirror_session_node.session_id = mirror_session_id;
-        temp_mirror_session_node.mirror_direction = mirror_direction;
-        mirror_session_node = std_rbtree_getexact (mirror_per_port_tree,
-                (void *) &temp_mirror_session_node);
-        if ((mirror_session_node == NULL) || ((mirror_session_node) &&
-            (mirror_session_node->mirror_direction != mirror_direction))) {
-
-            /*
-             * New session add for the given direction.
-             */
-
-            ret = sai_mirror_session_port_add(mirror_session_id,
-                    port_id, mirror_direction);
-            if (ret != SAI_STATUS_SUCCESS) {
-                SAI_MIRROR_LOG_ERR("Could not add port 0x%"PRIx64" to the mirror session 0x%"PRIx64"",
-                                    port_id, mirror_session_id);
-                break;
-            } else {
-                mirror_session_node = (sai_mirror_session_per_port_t *)
-                                      calloc (1, sizeof (sai_mirror_session_per_port_t));
-                if (!mirror_session_node) {
-                    SAI_MIRROR_LOG_ERR("Memory allocation failed for mirror info node"
-                                       "for port 0x%"PRIx64"", port_id);
-                    ret = SAI_STATUS_NO_MEMORY;
-                    break;
-                }
-                mirror_session_node->session_id = mirror_session_id;
-                mirror_session_node->mirror_direction = mirror_direction;
-                if ((std_rbtree_insert(mirror_per_port_tree,
-                                      (void *) mirror_session_node)) != STD_ERR_OK) {
-
-                    ret = SAI_STATUS_FAILURE;
-                    SAI_MIRROR_LOG_ERR ("Node insertion failed for session 0x%"PRIx64" direction %d",
-                                         mirror_session_node->session_id,
-                                         mirror_session_node->mirror_direction);
-                    sai_mirror_session_port_remove (mirror_session_node->session_id,
-                            port_id, mirror_direction);
-                    free (mirror_session_node);
-                    break;
-                }
-            }
+        session_slot = sai_mirror_session_slot_get (mirror_session_id);
+
+        if ((mirror_session_id == SAI_NULL_OBJECT_ID) || (session_slot < 0)) {
+            SAI_MIRROR_LOG_ERR ("Mirror session not found 0x%"PRIx64"", mirror_session_id);
+            ret = SAI_STATUS_INVALID_OBJECT_ID;
+            break;
+        }
+
+        new_map |= (1ULL << session_slot);
+    }
+
+    cur_map = sai_mirror_port_session_map_get (port_id, mirror_direction);
+
+    for (slot = 0; slot < SAI_MIRROR_MAX_SESSION_SLOTS; slot++) {
+        slot_session_id [slot] = sai_mirror_session_slot_id_get (slot);
+    }
+
+    sai_mirror_unlock();
+
+    if (ret != SAI_STATUS_SUCCESS) {
+        return ret;
+    }
+
+    /*
+     * New session add for the given direction.
+     */
+    for (slot = 0; slot < SAI_MIRROR_MAX_SESSION_SLOTS; slot++) {
+        if (!(new_map & ~cur_map & (1ULL << slot))) {
+            continue;
+        }
+
+        ret = sai_mirror_session_port_add (slot_session_id [slot], port_id, mirror_direction);
+        if (ret != SAI_STATUS_SUCCESS) {
+            SAI_MIRROR_LOG_ERR("Could not add port 0x%"PRIx64" to the mirror session 0x%"PRIx64"",
+                                port_id, slot_session_id [slot]);
+            return ret;
         }
     }
 
     /*
      * Remove the sessions which is not present in the updated list.
      */
-    if (ret == SAI_STATUS_SUCCESS) {
-        ret = sai_mirror_remove_mirror_per_port (port_id, attr, mirror_direction);
+    for (slot = 0; slot < SAI_MIRROR_MAX_SESSION_SLOTS; slot++) {
+        if (!(cur_map & ~new_map & (1ULL << slot))) {
+            continue;
+        }
+
+        ret = sai_mirror_session_port_remove (slot_session_id [slot], port_id, mirror_direction);
+        if (ret != SAI_STATUS_SUCCESS) {
+            SAI_MIRROR_LOG_ERR("Could not remove port 0x%"PRIx64" from the mirror session 0x%"PRIx64"",
+                    port_id, slot_session_id [slot]);
+            return ret;
+        }
     }
 
     return ret;
 }
-
@@ -23,6 +23,7 @@
 
 #include <stdlib.h>
 #include "std_mutex_lock.h"
+#include "sai_lock_profile.h"
 
 #include "sai_mirror_defs.h"
 #include "sai_mirror_api.h"
@@ -30,6 +31,8 @@
 
 static std_mutex_type_t mirror_lock;
 
+SAI_LOCK_PROFILE_DEFINE (mirror_lock_profile, "mirror")
+
 sai_mirror_session_info_t *sai_mirror_session_node_alloc (void)
 {
     return ((sai_mirror_session_info_t *)calloc (1,
@@ -61,10 +64,11 @@ void sai_mirror_mutex_lock_init(void)
 
 void sai_mirror_lock(void)
 {
-    std_mutex_lock (&mirror_lock);
+    sai_profiled_mutex_lock (&mirror_lock, &mirror_lock_profile,
+                             SAI_LOCK_PROFILE_CALL_SITE ());
 }
 
 void sai_mirror_unlock(void)
 {
-    std_mutex_unlock (&mirror_lock);
+    sai_profiled_mutex_unlock (&mirror_lock, &mirror_lock_profile);
 }
@@ -32,6 +32,7 @@
 #include "sai_qos_util.h"
 #include "sai_samplepacket_api.h"
 #include "sai_common_infra.h"
+#include "sai_api_latency.h"
 #include "sai_common_utils.h"
 #include "sai_port_common.h"
 
@@ -284,7 +285,8 @@ static sai_status_t sai_port_apply_attribute (sai_object_id_t port_id,
                 break;
 
             default:
-                ret = sai_port_npu_api_get()->port_set_attribute(port_id, port_info, attr);
+                SAI_API_LATENCY_NPU_CALL(ret,
+                        sai_port_npu_api_get()->port_set_attribute(port_id, port_info, attr));
                 if(ret != SAI_STATUS_SUCCESS) {
                     SAI_PORT_LOG_ERR("Attr set for port id 0x%"PRIx64" failed with err %d",
                                      port_id, ret);
@@ -358,8 +360,9 @@ sai_status_t sai_port_get_attribute(sai_object_id_t port_id,
 
         sai_port_info = sai_port_info_get (port_id);
 
-        ret = sai_port_npu_api_get()->port_get_attribute(port_id, sai_port_info,
-                                                         attr_count, attr_list);
+        SAI_API_LATENCY_NPU_CALL(ret,
+                sai_port_npu_api_get()->port_get_attribute(port_id, sai_port_info,
+                                                           attr_count, attr_list));
         if(ret != SAI_STATUS_SUCCESS) {
             SAI_PORT_LOG_TRACE("Attr get for port id 0x%"PRIx64" failed with err %d",
                                 port_id, ret);
@@ -636,6 +639,19 @@ static void sai_port_event_internal_notif_handler(uint32_t count,
                 SAI_PORT_LOG_ERR("SAI Port ID 0x%"PRIx64" default configuration failed with err %d",
                                  data[port_idx].port_id, ret);
             }
+
+            /* Samplepacket sessions applied on all the ports cover the new port */
+            ret = sai_samplepacket_port_config_post_fanout(data[port_idx].port_id);
+            if (ret != SAI_STATUS_SUCCESS) {
+                SAI_PORT_LOG_ERR("SAI Port ID 0x%"PRIx64" samplepacket configuration failed with err %d",
+                                 data[port_idx].port_id, ret);
+            }
+        } else if (data[port_idx].port_event == SAI_PORT_EVENT_DELETE) {
+            ret = sai_samplepacket_port_cleanup_on_fanout(data[port_idx].port_id);
+            if (ret != SAI_STATUS_SUCCESS) {
+                SAI_PORT_LOG_ERR("SAI Port ID 0x%"PRIx64" samplepacket cleanup failed with err %d",
+                                 data[port_idx].port_id, ret);
+            }
         }
     }
     sai_port_npu_api_get()->switching_mode_update(count, data);
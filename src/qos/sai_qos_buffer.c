@@ -415,10 +415,10 @@ static sai_status_t sai_qos_buffer_profile_attributes_validate (
     return SAI_STATUS_SUCCESS;
 }
 
-static sai_status_t sai_qos_create_buffer_profile (sai_object_id_t* profile_id,
-                                                   _In_ sai_object_id_t switch_id,
-                                                   uint32_t attr_count,
-                                                   const sai_attribute_t *attr_list)
+static sai_status_t sai_qos_create_buffer_profile_internal (sai_object_id_t* profile_id,
+                                                            sai_object_id_t switch_id,
+                                                            uint32_t attr_count,
+                                                            const sai_attribute_t *attr_list)
 {
     sai_status_t sai_rc;
     dn_sai_qos_buffer_profile_t  *p_buf_profile_node = NULL;
@@ -440,8 +440,6 @@ static sai_status_t sai_qos_create_buffer_profile (sai_object_id_t* profile_id,
     }
     sai_qos_init_buffer_profile_node (p_buf_profile_node);
 
-    sai_qos_lock ();
-
     do {
         sai_rc = sai_qos_update_buffer_profile_node(p_buf_profile_node, attr_count,
                                                     attr_list);
@@ -474,18 +472,31 @@ static sai_status_t sai_qos_create_buffer_profile (sai_object_id_t* profile_id,
         sai_qos_buffer_profile_node_free(p_buf_profile_node);
     }
 
+    return sai_rc;
+}
+
+static sai_status_t sai_qos_create_buffer_profile (sai_object_id_t* profile_id,
+                                                   _In_ sai_object_id_t switch_id,
+                                                   uint32_t attr_count,
+                                                   const sai_attribute_t *attr_list)
+{
+    sai_status_t sai_rc = SAI_STATUS_SUCCESS;
+
+    sai_qos_lock ();
+
+    sai_rc = sai_qos_create_buffer_profile_internal (profile_id, switch_id,
+                                                     attr_count, attr_list);
+
     sai_qos_unlock ();
 
     return sai_rc;
 }
 
-static sai_status_t sai_qos_remove_buffer_profile (sai_object_id_t profile_id)
+static sai_status_t sai_qos_remove_buffer_profile_internal (sai_object_id_t profile_id)
 {
     sai_status_t sai_rc;
     dn_sai_qos_buffer_profile_t  *p_buf_profile_node = NULL;
 
-    sai_qos_lock ();
-
     do {
 
         p_buf_profile_node = sai_qos_buffer_profile_node_get (profile_id);
@@ -517,7 +528,19 @@ static sai_status_t sai_qos_remove_buffer_profile (sai_object_id_t profile_id)
 
     } while(0);
 
+    return sai_rc;
+}
+
+static sai_status_t sai_qos_remove_buffer_profile (sai_object_id_t profile_id)
+{
+    sai_status_t sai_rc = SAI_STATUS_SUCCESS;
+
+    sai_qos_lock ();
+
+    sai_rc = sai_qos_remove_buffer_profile_internal (profile_id);
+
     sai_qos_unlock ();
+
     return sai_rc;
 }
 
@@ -542,7 +565,6 @@ static sai_status_t sai_qos_buffer_profile_attr_get_internal (sai_object_id_t pr
     if (NULL == p_buf_profile_node) {
         SAI_BUFFER_LOG_ERR ("Error buffer profile object not found 0x"PRIx64"",
                              profile_id);
-        sai_qos_unlock();
         return SAI_STATUS_ITEM_NOT_FOUND;
     }
 
@@ -888,8 +910,8 @@ static sai_status_t  sai_qos_check_buffer_profile_attr_value (const sai_attribut
     return SAI_STATUS_SUCCESS;
 }
 
-static sai_status_t sai_qos_buffer_profile_attr_set (sai_object_id_t profile_id,
-                                                     const sai_attribute_t *attr)
+static sai_status_t sai_qos_buffer_profile_attr_set_internal (sai_object_id_t profile_id,
+                                                              const sai_attribute_t *attr)
 {
     sai_status_t sai_rc;
     dn_sai_qos_buffer_profile_t  *p_buf_profile_node = NULL;
@@ -909,8 +931,6 @@ static sai_status_t sai_qos_buffer_profile_attr_set (sai_object_id_t profile_id,
     memset(&old_attr, 0, sizeof(old_attr));
     old_attr.id = attr->id;
 
-    sai_qos_lock ();
-
     do {
         sai_rc = sai_qos_buffer_profile_attr_get_internal (profile_id, 1, &old_attr);
         if (sai_rc != SAI_STATUS_SUCCESS) {
@@ -957,145 +977,344 @@ static sai_status_t sai_qos_buffer_profile_attr_set (sai_object_id_t profile_id,
 
     } while (0);
 
+    return sai_rc;
+}
+
+static sai_status_t sai_qos_buffer_profile_attr_set (sai_object_id_t profile_id,
+                                                     const sai_attribute_t *attr)
+{
+    sai_status_t sai_rc = SAI_STATUS_SUCCESS;
+
+    sai_qos_lock ();
+
+    sai_rc = sai_qos_buffer_profile_attr_set_internal (profile_id, attr);
 
     sai_qos_unlock ();
+
     return sai_rc;
 }
 
-static sai_status_t sai_qos_calc_pool_size (sai_object_id_t old_pool_id, sai_object_id_t new_pool_id,
-                                            bool check_th, uint_t old_size, uint_t new_size,
-                                            uint_t *tmp_size, bool *is_add)
+/* Staged buffer profile change of one object in a batch */
+typedef struct _sai_qos_buffer_profile_change_t {
+    sai_object_id_t              object_id;
+    sai_object_id_t              old_profile_id;
+    sai_object_id_t              new_profile_id;
+    dn_sai_qos_buffer_profile_t *p_old_profile;
+    dn_sai_qos_buffer_profile_t *p_new_profile;
+    bool                         skip;
+} sai_qos_buffer_profile_change_t;
+
+/* Net shared size consumed from one buffer pool by a batch */
+typedef struct _sai_qos_buffer_pool_delta_t {
+    dn_sai_qos_buffer_pool_t *p_pool_node;
+    int64_t                   delta;
+} sai_qos_buffer_pool_delta_t;
+
+static sai_status_t sai_qos_buffer_pool_delta_add (sai_qos_buffer_pool_delta_t *p_delta_list,
+                                                   uint_t *p_delta_count,
+                                                   sai_object_id_t pool_id,
+                                                   int64_t size)
 {
-    if(old_pool_id == new_pool_id) {
-        if(new_size > old_size) {
-            *tmp_size = new_size - old_size;
-            *is_add = true;
-        } else {
-            *tmp_size = old_size - new_size;
-        }
-    } else {
-        if (new_pool_id != SAI_NULL_OBJECT_ID) {
-            if (old_pool_id != SAI_NULL_OBJECT_ID) {
-                if (!sai_qos_is_buffer_pool_compatible (old_pool_id, new_pool_id, check_th)) {
-                    SAI_BUFFER_LOG_WARN ("New buffer pool is not of same type");
-                    return SAI_STATUS_INVALID_PARAMETER;
-                }
-            }
-            *tmp_size = new_size;
-        }
+    dn_sai_qos_buffer_pool_t *p_pool_node = NULL;
+    uint_t idx;
+
+    p_pool_node = sai_qos_buffer_pool_node_get (pool_id);
 
+    if(p_pool_node == NULL) {
+        SAI_BUFFER_LOG_ERR ("Error buffer pool object not found 0x%"PRIx64"", pool_id);
+        return SAI_STATUS_ITEM_NOT_FOUND;
     }
 
-    if((new_pool_id != SAI_NULL_OBJECT_ID) &&
-       (!sai_qos_is_buffer_pool_available(new_pool_id, *tmp_size))) {
-        SAI_BUFFER_LOG_WARN ("Error not enough memory in buffer pool");
-        return SAI_STATUS_INSUFFICIENT_RESOURCES;
+    for(idx = 0; idx < *p_delta_count; idx++) {
+        if(p_delta_list[idx].p_pool_node == p_pool_node) {
+            p_delta_list[idx].delta += size;
+            return SAI_STATUS_SUCCESS;
+        }
     }
+
+    p_delta_list[idx].p_pool_node = p_pool_node;
+    p_delta_list[idx].delta = size;
+    (*p_delta_count)++;
+
     return SAI_STATUS_SUCCESS;
 }
 
-sai_status_t sai_qos_obj_update_buffer_profile (sai_object_id_t object_id,
-                                                sai_object_id_t profile_id)
+/* Validate one object's profile change and account it in the pool deltas */
+static sai_status_t sai_qos_buffer_profile_change_stage (sai_qos_buffer_profile_change_t *p_change,
+                                                         dn_sai_qos_buffer_profile_t *p_def_profile,
+                                                         sai_qos_buffer_pool_delta_t *p_delta_list,
+                                                         uint_t *p_delta_count)
 {
     sai_status_t sai_rc;
-    dn_sai_qos_buffer_profile_t  *p_buf_profile_node = NULL;
-    dn_sai_qos_buffer_profile_t  *p_old_buf_profile_node = NULL;
-    dn_sai_qos_buffer_profile_t   def_buf_profile;
-    sai_object_id_t old_profile_id = SAI_NULL_OBJECT_ID;
     sai_object_id_t old_pool_id = SAI_NULL_OBJECT_ID;
     sai_object_id_t new_pool_id = SAI_NULL_OBJECT_ID;
     uint_t new_size = 0;
     uint_t old_size = 0;
-    uint_t tmp_size = 0;
-    bool is_add = false;
     bool check_th = true;
 
-    sai_rc = sai_qos_get_buffer_profile_id (object_id, &old_profile_id);
+    sai_rc = sai_qos_get_buffer_profile_id (p_change->object_id, &p_change->old_profile_id);
     if(sai_rc != SAI_STATUS_SUCCESS) {
         SAI_BUFFER_LOG_ERR ("Error unable to get old buffer profile");
         return sai_rc;
     }
 
-    if(old_profile_id == profile_id) {
+    if(p_change->old_profile_id == p_change->new_profile_id) {
         SAI_BUFFER_LOG_INFO ("Item already exists");
+        p_change->skip = true;
         return SAI_STATUS_SUCCESS;
     }
 
-    if (profile_id != SAI_NULL_OBJECT_ID) {
-        p_buf_profile_node = sai_qos_buffer_profile_node_get (profile_id);
-        if (NULL == p_buf_profile_node) {
-            SAI_BUFFER_LOG_ERR ("Error buffer profile object not found 0x"PRIx64"",
-                                profile_id);
+    if (p_change->new_profile_id != SAI_NULL_OBJECT_ID) {
+        p_change->p_new_profile = sai_qos_buffer_profile_node_get (p_change->new_profile_id);
+        if (NULL == p_change->p_new_profile) {
+            SAI_BUFFER_LOG_ERR ("Error buffer profile object not found 0x%"PRIx64"",
+                                p_change->new_profile_id);
             return SAI_STATUS_ITEM_NOT_FOUND;
         }
 
-        if(!sai_qos_is_object_buffer_profile_compatible (object_id,
-                                                         p_buf_profile_node)) {
-            SAI_BUFFER_LOG_ERR ("Error buffer profile object incompatible 0x"PRIx64"",
-                                profile_id);
+        if(!sai_qos_is_object_buffer_profile_compatible (p_change->object_id,
+                                                         p_change->p_new_profile)) {
+            SAI_BUFFER_LOG_ERR ("Error buffer profile object incompatible 0x%"PRIx64"",
+                                p_change->new_profile_id);
             return SAI_STATUS_INVALID_PARAMETER;
         }
 
-        new_size = p_buf_profile_node->size + sai_qos_buffer_profile_get_reserved_xoff_th_get(p_buf_profile_node);
-        new_pool_id = p_buf_profile_node->buffer_pool_id;
+        new_size = p_change->p_new_profile->size +
+            sai_qos_buffer_profile_get_reserved_xoff_th_get(p_change->p_new_profile);
+        new_pool_id = p_change->p_new_profile->buffer_pool_id;
     } else {
-        memset(&def_buf_profile, 0, sizeof(dn_sai_qos_buffer_profile_t));
-        sai_qos_get_default_buffer_profile (&def_buf_profile);
-        p_buf_profile_node = &def_buf_profile;
+        p_change->p_new_profile = p_def_profile;
     }
 
-    if(old_profile_id != SAI_NULL_OBJECT_ID) {
-        p_old_buf_profile_node = sai_qos_buffer_profile_node_get (old_profile_id);
-        if (NULL == p_old_buf_profile_node) {
-            SAI_BUFFER_LOG_ERR ("Error old buffer profile object not found 0x"PRIx64"",
-                                old_profile_id);
+    if(p_change->old_profile_id != SAI_NULL_OBJECT_ID) {
+        p_change->p_old_profile = sai_qos_buffer_profile_node_get (p_change->old_profile_id);
+        if (NULL == p_change->p_old_profile) {
+            SAI_BUFFER_LOG_ERR ("Error old buffer profile object not found 0x%"PRIx64"",
+                                p_change->old_profile_id);
             return SAI_STATUS_ITEM_NOT_FOUND;
         }
-        old_size = p_old_buf_profile_node->size + sai_qos_buffer_profile_get_reserved_xoff_th_get(p_old_buf_profile_node);
-        old_pool_id = p_old_buf_profile_node->buffer_pool_id;
-        if(p_old_buf_profile_node->profile_th_enable) {
+        old_size = p_change->p_old_profile->size +
+            sai_qos_buffer_profile_get_reserved_xoff_th_get(p_change->p_old_profile);
+        old_pool_id = p_change->p_old_profile->buffer_pool_id;
+        if(p_change->p_old_profile->profile_th_enable) {
             check_th = false;
         }
     } else {
-        memset(&def_buf_profile, 0, sizeof(dn_sai_qos_buffer_profile_t));
-        sai_qos_get_default_buffer_profile (&def_buf_profile);
-        p_old_buf_profile_node = &def_buf_profile;
+        p_change->p_old_profile = p_def_profile;
     }
 
-    sai_rc = sai_qos_calc_pool_size (old_pool_id, new_pool_id, check_th,
-                                     old_size, new_size, &tmp_size, &is_add);
-    if(sai_rc != SAI_STATUS_SUCCESS) {
-        return sai_rc;
+    if((old_pool_id != new_pool_id) && (old_pool_id != SAI_NULL_OBJECT_ID) &&
+       (new_pool_id != SAI_NULL_OBJECT_ID) &&
+       (!sai_qos_is_buffer_pool_compatible (old_pool_id, new_pool_id, check_th))) {
+        SAI_BUFFER_LOG_WARN ("New buffer pool is not of same type");
+        return SAI_STATUS_INVALID_PARAMETER;
     }
 
-    sai_rc = sai_buffer_npu_api_get()->buffer_profile_apply (object_id, p_old_buf_profile_node,
-                                                             p_buf_profile_node, false);
-    if(sai_rc != SAI_STATUS_SUCCESS) {
-        SAI_BUFFER_LOG_ERR ("Error unable to set buffer profile object");
-        return sai_rc;
+    if(old_pool_id != SAI_NULL_OBJECT_ID) {
+        sai_rc = sai_qos_buffer_pool_delta_add (p_delta_list, p_delta_count,
+                                                old_pool_id, -((int64_t) old_size));
+        if(sai_rc != SAI_STATUS_SUCCESS) {
+            return sai_rc;
+        }
     }
 
-    sai_rc = sai_qos_obj_update_buffer_profile_node (object_id, profile_id);
+    if(new_pool_id != SAI_NULL_OBJECT_ID) {
+        sai_rc = sai_qos_buffer_pool_delta_add (p_delta_list, p_delta_count,
+                                                new_pool_id, new_size);
+        if(sai_rc != SAI_STATUS_SUCCESS) {
+            return sai_rc;
+        }
+    }
 
-    if(sai_rc != SAI_STATUS_SUCCESS) {
-        SAI_BUFFER_LOG_ERR ("Error unable to update buffer profile node");
-        if(old_profile_id != SAI_NULL_OBJECT_ID) {
-            sai_buffer_npu_api_get()->buffer_profile_apply (object_id, p_buf_profile_node,
-                                                            p_old_buf_profile_node, false);
+    return SAI_STATUS_SUCCESS;
+}
+
+/* Revert the NPU and DB profile of the first count changes of a batch */
+static void sai_qos_buffer_profile_changes_revert (sai_qos_buffer_profile_change_t *p_change_list,
+                                                   uint_t count)
+{
+    sai_qos_buffer_profile_change_t *p_change = NULL;
+    uint_t idx;
+
+    for(idx = count; idx > 0; idx--) {
+        p_change = &p_change_list[idx - 1];
+
+        if(p_change->skip) {
+            continue;
         }
-        return sai_rc;
+
+        sai_buffer_npu_api_get()->buffer_profile_apply (p_change->object_id,
+                                                        p_change->p_new_profile,
+                                                        p_change->p_old_profile, false);
+        sai_qos_obj_update_buffer_profile_node (p_change->object_id,
+                                                p_change->old_profile_id);
     }
+}
 
-    if(old_pool_id == new_pool_id) {
-        sai_qos_buffer_pool_size_recalc (old_pool_id, tmp_size, is_add);
-    } else {
-        if(old_pool_id != SAI_NULL_OBJECT_ID) {
-            sai_qos_buffer_pool_size_recalc (old_pool_id, old_size, false);
+/* Commit the pool deltas of a batch with one NPU update per pool */
+static void sai_qos_buffer_pool_deltas_commit (sai_qos_buffer_pool_delta_t *p_delta_list,
+                                               uint_t delta_count)
+{
+    dn_sai_qos_buffer_pool_t *p_pool_node = NULL;
+    sai_attribute_t attr;
+    uint_t old_shared_size;
+    uint_t idx;
+
+    for(idx = 0; idx < delta_count; idx++) {
+        if(p_delta_list[idx].delta == 0) {
+            continue;
+        }
+
+        p_pool_node = p_delta_list[idx].p_pool_node;
+        old_shared_size = p_pool_node->shared_size;
+        p_pool_node->shared_size = (uint_t)((int64_t) p_pool_node->shared_size -
+                                            p_delta_list[idx].delta);
+
+        memset(&attr, 0, sizeof(attr));
+        attr.id = SAI_BUFFER_POOL_ATTR_SIZE;
+        attr.value.u32 = p_pool_node->size;
+
+        if(sai_buffer_npu_api_get()->buffer_pool_attr_set (p_pool_node, &attr)
+           != SAI_STATUS_SUCCESS) {
+            SAI_BUFFER_LOG_WARN ("Unable to update buffer pool DB for pool ID"
+                                 "0x%"PRIx64"", p_pool_node->key.pool_id);
+            p_pool_node->shared_size = old_shared_size;
+        }
+    }
+}
+
+sai_status_t sai_qos_obj_update_buffer_profile_bulk (uint_t count,
+                                                     const sai_object_id_t *object_list,
+                                                     const sai_object_id_t *profile_list)
+{
+    sai_status_t sai_rc = SAI_STATUS_SUCCESS;
+    sai_qos_buffer_profile_change_t *p_change_list = NULL;
+    sai_qos_buffer_profile_change_t *p_change = NULL;
+    sai_qos_buffer_pool_delta_t *p_delta_list = NULL;
+    dn_sai_qos_buffer_profile_t def_buf_profile;
+    uint_t delta_count = 0;
+    uint_t applied_count = 0;
+    uint_t idx;
+    uint_t dup_idx;
+
+    STD_ASSERT (object_list != NULL);
+    STD_ASSERT (profile_list != NULL);
+
+    if(count == 0) {
+        return SAI_STATUS_SUCCESS;
+    }
+
+    p_change_list = (sai_qos_buffer_profile_change_t *)
+        calloc (count, sizeof(sai_qos_buffer_profile_change_t));
+    p_delta_list = (sai_qos_buffer_pool_delta_t *)
+        calloc (2 * count, sizeof(sai_qos_buffer_pool_delta_t));
+
+    if((p_change_list == NULL) || (p_delta_list == NULL)) {
+        free (p_change_list);
+        free (p_delta_list);
+        return SAI_STATUS_NO_MEMORY;
+    }
+
+    memset(&def_buf_profile, 0, sizeof(dn_sai_qos_buffer_profile_t));
+    sai_qos_get_default_buffer_profile (&def_buf_profile);
+
+    /* Stage every change and accumulate the net pool usage */
+    for(idx = 0; idx < count; idx++) {
+        for(dup_idx = 0; dup_idx < idx; dup_idx++) {
+            if(object_list[dup_idx] == object_list[idx]) {
+                SAI_BUFFER_LOG_ERR ("Error object 0x%"PRIx64" repeated in batch",
+                                    object_list[idx]);
+                sai_rc = sai_get_indexed_ret_val (SAI_STATUS_INVALID_PARAMETER, idx);
+                break;
+            }
+        }
+        if(sai_rc != SAI_STATUS_SUCCESS) {
+            break;
+        }
+
+        p_change = &p_change_list[idx];
+        p_change->object_id = object_list[idx];
+        p_change->new_profile_id = profile_list[idx];
+
+        sai_rc = sai_qos_buffer_profile_change_stage (p_change, &def_buf_profile,
+                                                      p_delta_list, &delta_count);
+        if(sai_rc != SAI_STATUS_SUCCESS) {
+            break;
+        }
+    }
+
+    /* Validate the pool budget once for the whole batch */
+    for(idx = 0; (sai_rc == SAI_STATUS_SUCCESS) && (idx < delta_count); idx++) {
+        if((p_delta_list[idx].delta > 0) &&
+           ((int64_t) p_delta_list[idx].p_pool_node->shared_size < p_delta_list[idx].delta)) {
+            SAI_BUFFER_LOG_WARN ("Error not enough memory in buffer pool 0x%"PRIx64" "
+                                 "Available:%u Required:%"PRId64"",
+                                 p_delta_list[idx].p_pool_node->key.pool_id,
+                                 p_delta_list[idx].p_pool_node->shared_size,
+                                 p_delta_list[idx].delta);
+            sai_rc = SAI_STATUS_INSUFFICIENT_RESOURCES;
+        }
+    }
+
+    for(idx = 0; (sai_rc == SAI_STATUS_SUCCESS) && (idx < count); idx++) {
+        p_change = &p_change_list[idx];
+
+        if(p_change->skip) {
+            continue;
         }
-        if(new_pool_id != SAI_NULL_OBJECT_ID) {
-            sai_qos_buffer_pool_size_recalc (new_pool_id, new_size, true);
+
+        sai_rc = sai_buffer_npu_api_get()->buffer_profile_apply (p_change->object_id,
+                                                                 p_change->p_old_profile,
+                                                                 p_change->p_new_profile,
+                                                                 false);
+        if(sai_rc != SAI_STATUS_SUCCESS) {
+            SAI_BUFFER_LOG_ERR ("Error unable to set buffer profile object");
+            break;
+        }
+
+        sai_rc = sai_qos_obj_update_buffer_profile_node (p_change->object_id,
+                                                         p_change->new_profile_id);
+        if(sai_rc != SAI_STATUS_SUCCESS) {
+            SAI_BUFFER_LOG_ERR ("Error unable to update buffer profile node");
+            sai_buffer_npu_api_get()->buffer_profile_apply (p_change->object_id,
+                                                            p_change->p_new_profile,
+                                                            p_change->p_old_profile,
+                                                            false);
+            break;
         }
+        applied_count = idx + 1;
+    }
+
+    if(sai_rc != SAI_STATUS_SUCCESS) {
+        sai_qos_buffer_profile_changes_revert (p_change_list, applied_count);
+    } else {
+        sai_qos_buffer_pool_deltas_commit (p_delta_list, delta_count);
     }
+
+    free (p_change_list);
+    free (p_delta_list);
+
+    return sai_rc;
+}
+
+sai_status_t sai_qos_obj_update_buffer_profile (sai_object_id_t object_id,
+                                                sai_object_id_t profile_id)
+{
+    return sai_qos_obj_update_buffer_profile_bulk (1, &object_id, &profile_id);
+}
+
+sai_status_t sai_qos_buffer_profile_bulk_apply (uint_t count,
+                                                const sai_object_id_t *object_list,
+                                                const sai_object_id_t *profile_list)
+{
+    sai_status_t sai_rc;
+
+    sai_qos_lock ();
+
+    sai_rc = sai_qos_obj_update_buffer_profile_bulk (count, object_list, profile_list);
+
+    sai_qos_unlock ();
+
     return sai_rc;
 }
 
@@ -1128,6 +1347,39 @@ sai_status_t sai_qos_buffer_pool_stats_clear (sai_object_id_t pool_id,
     return SAI_STATUS_NOT_IMPLEMENTED;
 }
 
+sai_status_t sai_qos_buffer_profile_bulk_create (sai_object_id_t switch_id,
+                                                 uint32_t object_count,
+                                                 const uint32_t *attr_count,
+                                                 const sai_attribute_t **attr_list,
+                                                 dn_sai_qos_bulk_op_error_mode_t mode,
+                                                 sai_object_id_t *object_id,
+                                                 sai_status_t *object_statuses)
+{
+    return sai_qos_bulk_object_create (sai_qos_create_buffer_profile_internal, switch_id,
+                                       object_count, attr_count, attr_list,
+                                       mode, object_id, object_statuses);
+}
+
+sai_status_t sai_qos_buffer_profile_bulk_remove (uint32_t object_count,
+                                                 const sai_object_id_t *object_id,
+                                                 dn_sai_qos_bulk_op_error_mode_t mode,
+                                                 sai_status_t *object_statuses)
+{
+    return sai_qos_bulk_object_remove (sai_qos_remove_buffer_profile_internal, object_count,
+                                       object_id, mode, object_statuses);
+}
+
+sai_status_t sai_qos_buffer_profile_bulk_set (uint32_t object_count,
+                                              const sai_object_id_t *object_id,
+                                              const sai_attribute_t *attr_list,
+                                              dn_sai_qos_bulk_op_error_mode_t mode,
+                                              sai_status_t *object_statuses)
+{
+    return sai_qos_bulk_object_set (sai_qos_buffer_profile_attr_set_internal, object_count,
+                                    object_id, attr_list, mode,
+                                    object_statuses);
+}
+
 static sai_buffer_api_t sai_qos_buffer_method_table = {
     sai_qos_create_buffer_pool,
     sai_qos_remove_buffer_pool,
@@ -0,0 +1,242 @@
+/*
+ * Copyright (c) 2016 Dell Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * THIS CODE IS PROVIDED ON AN *AS IS* BASIS, WITHOUT WARRANTIES OR
+ * CONDITIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING WITHOUT
+ * LIMITATION ANY IMPLIED WARRANTIES OR CONDITIONS OF TITLE, FITNESS
+ * FOR A PARTICULAR PURPOSE, MERCHANTABLITY OR NON-INFRINGEMENT.
+ *
+ * See the Apache Version 2.0 License for specific language governing
+ * permissions and limitations under the License.
+ */
+
+/**
+ * @file  sai_qos_bulk.c
+ *
+ * @brief This file contains the common bulk create, remove and set
+ *        handling for SAI QoS objects. A batch is run under a single
+ *        QoS lock hold and reports a status per object.
+ */
+
+#include "sai_qos_common.h"
+#include "sai_qos_util.h"
+#include "sai_qos_api_utils.h"
+
+#include "saistatus.h"
+#include "saitypes.h"
+
+#include "std_assert.h"
+
+#include <inttypes.h>
+
+static bool sai_qos_bulk_params_validate (uint32_t object_count,
+                                          const void *p_object_list,
+                                          const sai_status_t *object_statuses,
+                                          dn_sai_qos_bulk_op_error_mode_t mode)
+{
+    if ((object_count == 0) || (p_object_list == NULL) ||
+        (object_statuses == NULL)) {
+        return false;
+    }
+
+    if ((mode != DN_SAI_QOS_BULK_OP_ERROR_MODE_STOP_ON_ERROR) &&
+        (mode != DN_SAI_QOS_BULK_OP_ERROR_MODE_IGNORE_ERROR)) {
+        return false;
+    }
+
+    return true;
+}
+
+/* Objects following a failure in stop on error mode are not attempted */
+static void sai_qos_bulk_not_executed_fill (uint32_t start, uint32_t object_count,
+                                            sai_status_t *object_statuses)
+{
+    uint32_t index = 0;
+
+    for (index = start; index < object_count; index++) {
+        object_statuses [index] = SAI_QOS_BULK_STATUS_NOT_EXECUTED;
+    }
+}
+
+sai_status_t sai_qos_bulk_object_create_internal (
+                                     sai_qos_bulk_create_fn create_fn,
+                                     sai_object_id_t switch_id,
+                                     uint32_t object_count,
+                                     const uint32_t *attr_count,
+                                     const sai_attribute_t **attr_list,
+                                     dn_sai_qos_bulk_op_error_mode_t mode,
+                                     sai_object_id_t *object_id,
+                                     sai_status_t *object_statuses)
+{
+    sai_status_t sai_rc = SAI_STATUS_SUCCESS;
+    uint32_t     index = 0;
+
+    STD_ASSERT (create_fn != NULL);
+
+    if ((!sai_qos_bulk_params_validate (object_count, object_id,
+                                        object_statuses, mode)) ||
+        (attr_count == NULL) || (attr_list == NULL)) {
+        return SAI_STATUS_INVALID_PARAMETER;
+    }
+
+    for (index = 0; index < object_count; index++) {
+        object_id [index] = SAI_NULL_OBJECT_ID;
+        object_statuses [index] = create_fn (&object_id [index], switch_id,
+                                             attr_count [index], attr_list [index]);
+
+        if (object_statuses [index] != SAI_STATUS_SUCCESS) {
+            SAI_QOS_LOG_ERR ("Bulk create failed for object %d of %d, Error: %d.",
+                             index, object_count, object_statuses [index]);
+            sai_rc = SAI_STATUS_FAILURE;
+
+            if (mode == DN_SAI_QOS_BULK_OP_ERROR_MODE_STOP_ON_ERROR) {
+                sai_qos_bulk_not_executed_fill (index + 1, object_count,
+                                                object_statuses);
+                break;
+            }
+        }
+    }
+
+    return sai_rc;
+}
+
+sai_status_t sai_qos_bulk_object_remove_internal (
+                                     sai_qos_bulk_remove_fn remove_fn,
+                                     uint32_t object_count,
+                                     const sai_object_id_t *object_id,
+                                     dn_sai_qos_bulk_op_error_mode_t mode,
+                                     sai_status_t *object_statuses)
+{
+    sai_status_t sai_rc = SAI_STATUS_SUCCESS;
+    uint32_t     index = 0;
+
+    STD_ASSERT (remove_fn != NULL);
+
+    if (!sai_qos_bulk_params_validate (object_count, object_id,
+                                       object_statuses, mode)) {
+        return SAI_STATUS_INVALID_PARAMETER;
+    }
+
+    for (index = 0; index < object_count; index++) {
+        object_statuses [index] = remove_fn (object_id [index]);
+
+        if (object_statuses [index] != SAI_STATUS_SUCCESS) {
+            SAI_QOS_LOG_ERR ("Bulk remove failed for object 0x%"PRIx64", "
+                             "Error: %d.", object_id [index],
+                             object_statuses [index]);
+            sai_rc = SAI_STATUS_FAILURE;
+
+            if (mode == DN_SAI_QOS_BULK_OP_ERROR_MODE_STOP_ON_ERROR) {
+                sai_qos_bulk_not_executed_fill (index + 1, object_count,
+                                                object_statuses);
+                break;
+            }
+        }
+    }
+
+    return sai_rc;
+}
+
+sai_status_t sai_qos_bulk_object_set_internal (
+                                     sai_qos_bulk_set_fn set_fn,
+                                     uint32_t object_count,
+                                     const sai_object_id_t *object_id,
+                                     const sai_attribute_t *attr_list,
+                                     dn_sai_qos_bulk_op_error_mode_t mode,
+                                     sai_status_t *object_statuses)
+{
+    sai_status_t sai_rc = SAI_STATUS_SUCCESS;
+    uint32_t     index = 0;
+
+    STD_ASSERT (set_fn != NULL);
+
+    if ((!sai_qos_bulk_params_validate (object_count, object_id,
+                                        object_statuses, mode)) ||
+        (attr_list == NULL)) {
+        return SAI_STATUS_INVALID_PARAMETER;
+    }
+
+    for (index = 0; index < object_count; index++) {
+        object_statuses [index] = set_fn (object_id [index], &attr_list [index]);
+
+        if (object_statuses [index] != SAI_STATUS_SUCCESS) {
+            SAI_QOS_LOG_ERR ("Bulk set of Attribute ID %d failed for object "
+                             "0x%"PRIx64", Error: %d.", attr_list [index].id,
+                             object_id [index], object_statuses [index]);
+            sai_rc = SAI_STATUS_FAILURE;
+
+            if (mode == DN_SAI_QOS_BULK_OP_ERROR_MODE_STOP_ON_ERROR) {
+                sai_qos_bulk_not_executed_fill (index + 1, object_count,
+                                                object_statuses);
+                break;
+            }
+        }
+    }
+
+    return sai_rc;
+}
+
+sai_status_t sai_qos_bulk_object_create (sai_qos_bulk_create_fn create_fn,
+                                         sai_object_id_t switch_id,
+                                         uint32_t object_count,
+                                         const uint32_t *attr_count,
+                                         const sai_attribute_t **attr_list,
+                                         dn_sai_qos_bulk_op_error_mode_t mode,
+                                         sai_object_id_t *object_id,
+                                         sai_status_t *object_statuses)
+{
+    sai_status_t sai_rc = SAI_STATUS_SUCCESS;
+
+    sai_qos_lock ();
+
+    sai_rc = sai_qos_bulk_object_create_internal (create_fn, switch_id,
+                                                  object_count, attr_count,
+                                                  attr_list, mode, object_id,
+                                                  object_statuses);
+
+    sai_qos_unlock ();
+
+    return sai_rc;
+}
+
+sai_status_t sai_qos_bulk_object_remove (sai_qos_bulk_remove_fn remove_fn,
+                                         uint32_t object_count,
+                                         const sai_object_id_t *object_id,
+                                         dn_sai_qos_bulk_op_error_mode_t mode,
+                                         sai_status_t *object_statuses)
+{
+    sai_status_t sai_rc = SAI_STATUS_SUCCESS;
+
+    sai_qos_lock ();
+
+    sai_rc = sai_qos_bulk_object_remove_internal (remove_fn, object_count,
+                                                  object_id, mode,
+                                                  object_statuses);
+
+    sai_qos_unlock ();
+
+    return sai_rc;
+}
+
+sai_status_t sai_qos_bulk_object_set (sai_qos_bulk_set_fn set_fn,
+                                      uint32_t object_count,
+                                      const sai_object_id_t *object_id,
+                                      const sai_attribute_t *attr_list,
+                                      dn_sai_qos_bulk_op_error_mode_t mode,
+                                      sai_status_t *object_statuses)
+{
+    sai_status_t sai_rc = SAI_STATUS_SUCCESS;
+
+    sai_qos_lock ();
+
+    sai_rc = sai_qos_bulk_object_set_internal (set_fn, object_count, object_id,
+                                               attr_list, mode, object_statuses);
+
+    sai_qos_unlock ();
+
+    return sai_rc;
+}
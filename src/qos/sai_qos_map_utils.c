@@ -51,7 +51,7 @@ sai_status_t sai_qos_map_port_list_update(dn_sai_qos_map_t *p_map)
     {
 
         sai_rc = sai_qos_map_npu_api_get()->port_map_set(p_qos_port_node->port_id,
-                                                         p_map->key.map_id,
+                                                         sai_qos_map_npu_id_get(p_map->key.map_id),
                                                          p_map->map_type,
                                                          true);
 
@@ -140,7 +140,7 @@ static sai_status_t sai_qos_map_update_ingress_maps(dn_sai_qos_port_t *p_qos_por
                                SAI_QOS_MAP_TYPE_DSCP_TO_TC, map_id);
 
             sai_rc = sai_qos_map_npu_api_get()->port_map_set
-                (p_qos_port_node->port_id, map_id,
+                (p_qos_port_node->port_id, sai_qos_map_npu_id_get(map_id),
                  SAI_QOS_MAP_TYPE_DSCP_TO_TC, true);
 
             return sai_rc;
@@ -153,7 +153,7 @@ static sai_status_t sai_qos_map_update_ingress_maps(dn_sai_qos_port_t *p_qos_por
                                SAI_QOS_MAP_TYPE_DSCP_TO_COLOR, map_id);
 
             sai_rc = sai_qos_map_npu_api_get()->port_map_set
-                (p_qos_port_node->port_id, map_id,
+                (p_qos_port_node->port_id, sai_qos_map_npu_id_get(map_id),
                  SAI_QOS_MAP_TYPE_DSCP_TO_COLOR, true);
 
             return sai_rc;
@@ -166,7 +166,7 @@ static sai_status_t sai_qos_map_update_ingress_maps(dn_sai_qos_port_t *p_qos_por
                                SAI_QOS_MAP_TYPE_DSCP_TO_TC_AND_COLOR, map_id);
 
             sai_rc = sai_qos_map_npu_api_get()->port_map_set
-                (p_qos_port_node->port_id, map_id,
+                (p_qos_port_node->port_id, sai_qos_map_npu_id_get(map_id),
                  SAI_QOS_MAP_TYPE_DSCP_TO_TC_AND_COLOR, true);
 
             return sai_rc;
@@ -195,7 +195,7 @@ static sai_status_t sai_qos_map_update_ingress_maps(dn_sai_qos_port_t *p_qos_por
                                    SAI_QOS_MAP_TYPE_DOT1P_TO_TC, map_id);
 
             sai_rc = sai_qos_map_npu_api_get()->port_map_set
-                (p_qos_port_node->port_id, map_id,
+                (p_qos_port_node->port_id, sai_qos_map_npu_id_get(map_id),
                  SAI_QOS_MAP_TYPE_DOT1P_TO_TC, true);
             return sai_rc;
         }
@@ -207,7 +207,7 @@ static sai_status_t sai_qos_map_update_ingress_maps(dn_sai_qos_port_t *p_qos_por
                                    SAI_QOS_MAP_TYPE_DOT1P_TO_COLOR, map_id);
 
             sai_rc = sai_qos_map_npu_api_get()->port_map_set
-                (p_qos_port_node->port_id, map_id,
+                (p_qos_port_node->port_id, sai_qos_map_npu_id_get(map_id),
                  SAI_QOS_MAP_TYPE_DOT1P_TO_COLOR, true);
             return sai_rc;
         }
@@ -219,7 +219,7 @@ static sai_status_t sai_qos_map_update_ingress_maps(dn_sai_qos_port_t *p_qos_por
                                    SAI_QOS_MAP_TYPE_DOT1P_TO_TC_AND_COLOR, map_id);
 
             sai_rc = sai_qos_map_npu_api_get()->port_map_set
-                (p_qos_port_node->port_id, map_id,
+                (p_qos_port_node->port_id, sai_qos_map_npu_id_get(map_id),
                  SAI_QOS_MAP_TYPE_DOT1P_TO_TC_AND_COLOR, true);
             return sai_rc;
             }
@@ -248,7 +248,8 @@ static sai_status_t sai_qos_map_port_remove(dn_sai_qos_port_t *p_qos_port_node,
         return SAI_STATUS_INVALID_OBJECT_ID;
     }
     sai_rc = sai_qos_map_npu_api_get()->port_map_set(p_qos_port_node->port_id,
-                                                     map_id, map_type, false);
+                                                     sai_qos_map_npu_id_get(map_id),
+                                                     map_type, false);
 
     if(sai_rc != SAI_STATUS_SUCCESS){
         SAI_MAPS_LOG_ERR("Npu set failed to remove for mapid 0x%"PRIx64" on portid 0x%"PRIx64"",
@@ -289,7 +290,8 @@ static sai_status_t sai_qos_map_port_add(dn_sai_qos_port_t *p_qos_port_node,
 
 
     sai_rc = sai_qos_map_npu_api_get()->port_map_set(p_qos_port_node->port_id,
-                                                     map_id, map_type, true);
+                                                     sai_qos_map_npu_id_get(map_id),
+                                                     map_type, true);
 
     if(sai_rc != SAI_STATUS_SUCCESS){
         SAI_MAPS_LOG_ERR("Npu set failed to add for mapid 0x%"PRIx64" on portid 0x%"PRIx64"",
@@ -29,6 +29,8 @@
 #include "sai_gen_utils.h"
 #include "sai_qos_mem.h"
 #include "sai_common_infra.h"
+#include "sai_id_allocator.h"
+#include "sai_api_latency.h"
 
 #include "sai.h"
 #include "saiqosmaps.h"
@@ -36,9 +38,46 @@
 #include "std_type_defs.h"
 #include "std_utils.h"
 #include "std_assert.h"
+#include "std_rbtree.h"
 #include <stdlib.h>
+#include <string.h>
 #include <inttypes.h>
 
+/*
+ * Hardware profiles of the QoS maps programmed in the NPU. Map lists are
+ * canonical by construction, each entry is stored at the index of its key
+ * in a zeroed list, so maps of the same type and list share one NPU
+ * profile. A profile is refcounted by the maps using it, and a map whose
+ * entries change while its profile is shared moves to another profile.
+ */
+#define SAI_QOS_MAP_PROFILE_HASH_BUCKETS 256
+
+/* Map ids of maps sharing a profile are allocated above the NPU ids */
+#define SAI_QOS_MAP_SHARED_ID_BASE       0x100000
+#define SAI_QOS_MAP_SHARED_ID_MAX        0xfffff
+
+typedef struct _sai_qos_map_profile_t {
+    struct _sai_qos_map_profile_t *p_next;
+    uint32_t                       hash;
+    uint_t                         ref_count;
+    /* Map node programmed in the NPU, the key holds the NPU map id */
+    dn_sai_qos_map_t              *p_hw_node;
+} sai_qos_map_profile_t;
+
+typedef struct _sai_qos_map_profile_ref_t {
+    sai_object_id_t        map_id;
+    sai_qos_map_profile_t *p_profile;
+    /* Index from the shared id allocator, 0 if the NPU map id is used */
+    uint64_t               shared_id;
+} sai_qos_map_profile_ref_t;
+
+static sai_qos_map_profile_t *sai_qos_map_profile_hash [SAI_QOS_MAP_PROFILE_HASH_BUCKETS];
+static rbtree_handle sai_qos_map_profile_ref_tree = NULL;
+static sai_id_allocator_t sai_qos_map_shared_id_allocator;
+/* Debug counters of map list sets pushed to the NPU and to the bound ports */
+static uint_t sai_qos_map_npu_update_count = 0;
+static uint_t sai_qos_map_port_update_count = 0;
+
 static inline uint_t sai_qos_maps_get_index(uint_t value, uint_t tc)
 {
     return (value * SAI_QOS_MAX_TC) + tc;
@@ -516,6 +555,517 @@ dn_sai_qos_map_t *p_map_node, sai_qos_map_list_t map_list, dn_sai_operations_t o
     return sai_rc;
 }
 
+static sai_status_t sai_qos_map_profile_init(void)
+{
+    if(sai_qos_map_profile_ref_tree != NULL){
+        return SAI_STATUS_SUCCESS;
+    }
+
+    if(sai_id_allocator_init(&sai_qos_map_shared_id_allocator, "qos_map_shared_id",
+                             SAI_QOS_MAP_SHARED_ID_MAX) != SAI_STATUS_SUCCESS){
+        SAI_MAPS_LOG_ERR("Failed to init qos map shared id allocator");
+        return SAI_STATUS_NO_MEMORY;
+    }
+
+    sai_qos_map_profile_ref_tree =
+        std_rbtree_create_simple("qos_map_profile_ref_tree",
+                                 STD_STR_OFFSET_OF(sai_qos_map_profile_ref_t, map_id),
+                                 STD_STR_SIZE_OF(sai_qos_map_profile_ref_t, map_id));
+
+    if(sai_qos_map_profile_ref_tree == NULL){
+        SAI_MAPS_LOG_ERR("Failed to create qos map profile ref tree");
+        sai_id_allocator_deinit(&sai_qos_map_shared_id_allocator);
+        return SAI_STATUS_NO_MEMORY;
+    }
+
+    memset(sai_qos_map_profile_hash, 0, sizeof(sai_qos_map_profile_hash));
+
+    return SAI_STATUS_SUCCESS;
+}
+
+static bool sai_qos_map_is_profile_shared_type(uint_t map_type)
+{
+    /* Maps that are not hardware objects are programmed per port */
+    return sai_qos_map_npu_api_get()->map_is_hw_object(map_type);
+}
+
+static uint32_t sai_qos_map_profile_hash_get(const dn_sai_qos_map_t *p_map_node)
+{
+    const uint8_t *p_byte = (const uint8_t *) p_map_node->map_to_value.list;
+    size_t        len = p_map_node->map_to_value.count * sizeof(sai_qos_map_t);
+    uint32_t      hash = 2166136261u;
+    size_t        idx = 0;
+
+    /* FNV-1a over the map type and the zero padded list */
+    hash = (hash ^ p_map_node->map_type) * 16777619u;
+
+    for(idx = 0; (p_byte != NULL) && (idx < len); idx++){
+        hash = (hash ^ p_byte[idx]) * 16777619u;
+    }
+
+    return hash;
+}
+
+static bool sai_qos_map_profile_match(const sai_qos_map_profile_t *p_profile,
+                                      const dn_sai_qos_map_t *p_map_node,
+                                      uint32_t hash)
+{
+    const dn_sai_qos_map_t *p_hw_node = p_profile->p_hw_node;
+
+    if((p_profile->hash != hash) ||
+       (p_hw_node->map_type != p_map_node->map_type) ||
+       (p_hw_node->map_to_value.count != p_map_node->map_to_value.count)){
+        return false;
+    }
+
+    if(p_hw_node->map_to_value.count == 0){
+        return true;
+    }
+
+    return (memcmp(p_hw_node->map_to_value.list, p_map_node->map_to_value.list,
+                   p_hw_node->map_to_value.count * sizeof(sai_qos_map_t)) == 0);
+}
+
+static sai_qos_map_profile_t *sai_qos_map_profile_find(const dn_sai_qos_map_t *p_map_node,
+                                                       uint32_t hash)
+{
+    sai_qos_map_profile_t *p_profile = NULL;
+
+    p_profile = sai_qos_map_profile_hash[hash % SAI_QOS_MAP_PROFILE_HASH_BUCKETS];
+
+    while(p_profile != NULL){
+        if(sai_qos_map_profile_match(p_profile, p_map_node, hash)){
+            return p_profile;
+        }
+        p_profile = p_profile->p_next;
+    }
+
+    return NULL;
+}
+
+static void sai_qos_map_profile_link(sai_qos_map_profile_t *p_profile, uint32_t hash)
+{
+    uint_t bucket = hash % SAI_QOS_MAP_PROFILE_HASH_BUCKETS;
+
+    p_profile->hash = hash;
+    p_profile->p_next = sai_qos_map_profile_hash[bucket];
+    sai_qos_map_profile_hash[bucket] = p_profile;
+}
+
+static void sai_qos_map_profile_unlink(sai_qos_map_profile_t *p_profile)
+{
+    sai_qos_map_profile_t **pp_profile = NULL;
+
+    pp_profile = &sai_qos_map_profile_hash[p_profile->hash % SAI_QOS_MAP_PROFILE_HASH_BUCKETS];
+
+    while(*pp_profile != NULL){
+        if(*pp_profile == p_profile){
+            *pp_profile = p_profile->p_next;
+            break;
+        }
+        pp_profile = &(*pp_profile)->p_next;
+    }
+
+    p_profile->p_next = NULL;
+}
+
+static sai_status_t sai_qos_map_list_copy(dn_sai_qos_map_t *p_dst_node,
+                                          const dn_sai_qos_map_t *p_src_node)
+{
+    sai_status_t sai_rc = SAI_STATUS_SUCCESS;
+
+    p_dst_node->map_to_value.list = NULL;
+    p_dst_node->map_to_value.count = 0;
+
+    if(p_src_node->map_to_value.list == NULL){
+        return SAI_STATUS_SUCCESS;
+    }
+
+    sai_rc = sai_qos_map_list_alloc(p_dst_node, p_src_node->map_to_value.count);
+
+    if(sai_rc != SAI_STATUS_SUCCESS){
+        return sai_rc;
+    }
+
+    memcpy(p_dst_node->map_to_value.list, p_src_node->map_to_value.list,
+           p_src_node->map_to_value.count * sizeof(sai_qos_map_t));
+
+    return SAI_STATUS_SUCCESS;
+}
+
+/* Programs a new NPU profile with the contents of the map, unreferenced */
+static sai_status_t sai_qos_map_profile_create(const dn_sai_qos_map_t *p_map_node,
+                                               uint32_t hash,
+                                               sai_qos_map_profile_t **pp_profile)
+{
+    sai_qos_map_profile_t *p_profile = NULL;
+    dn_sai_qos_map_t      *p_hw_node = NULL;
+    sai_npu_object_id_t   hw_map_id = 0;
+    sai_status_t          sai_rc = SAI_STATUS_SUCCESS;
+
+    p_profile = (sai_qos_map_profile_t *) calloc(1, sizeof(*p_profile));
+    p_hw_node = sai_qos_maps_node_alloc();
+
+    if((p_profile == NULL) || (p_hw_node == NULL)){
+        free(p_profile);
+        sai_qos_map_free_resources(p_hw_node);
+        return SAI_STATUS_NO_MEMORY;
+    }
+
+    p_hw_node->map_type = p_map_node->map_type;
+
+    sai_rc = sai_qos_map_list_copy(p_hw_node, p_map_node);
+
+    if(sai_rc == SAI_STATUS_SUCCESS){
+        SAI_API_LATENCY_NPU_CALL(sai_rc,
+                sai_qos_map_npu_api_get()->map_create(p_hw_node, &hw_map_id));
+    }
+
+    if(sai_rc != SAI_STATUS_SUCCESS){
+        SAI_MAPS_LOG_ERR("Npu map profile create failed for maptype %d",
+                         p_map_node->map_type);
+        free(p_profile);
+        sai_qos_map_free_resources(p_hw_node);
+        return sai_rc;
+    }
+
+    /* Append the maptype to the NPU returned map id.*/
+    hw_map_id = sai_add_type_to_object(hw_map_id, p_hw_node->map_type);
+
+    p_hw_node->key.map_id = sai_uoid_create(SAI_OBJECT_TYPE_QOS_MAP, hw_map_id);
+
+    std_dll_init(&p_hw_node->port_dll_head);
+
+    p_profile->p_hw_node = p_hw_node;
+    sai_qos_map_profile_link(p_profile, hash);
+
+    SAI_MAPS_LOG_TRACE("Map profile 0x%"PRIx64" created for maptype %d",
+                       p_hw_node->key.map_id, p_hw_node->map_type);
+
+    *pp_profile = p_profile;
+
+    return SAI_STATUS_SUCCESS;
+}
+
+/* Drops a reference, the NPU profile is removed with its last user */
+static sai_status_t sai_qos_map_profile_release(sai_qos_map_profile_t *p_profile)
+{
+    sai_status_t sai_rc = SAI_STATUS_SUCCESS;
+
+    if(p_profile->ref_count > 1){
+        p_profile->ref_count--;
+        return SAI_STATUS_SUCCESS;
+    }
+
+    SAI_API_LATENCY_NPU_CALL(sai_rc,
+            sai_qos_map_npu_api_get()->map_remove(p_profile->p_hw_node));
+
+    if(sai_rc != SAI_STATUS_SUCCESS){
+        SAI_MAPS_LOG_ERR("Npu map profile remove failed for 0x%"PRIx64"",
+                         p_profile->p_hw_node->key.map_id);
+        return sai_rc;
+    }
+
+    SAI_MAPS_LOG_TRACE("Map profile 0x%"PRIx64" removed",
+                       p_profile->p_hw_node->key.map_id);
+
+    sai_qos_map_profile_unlink(p_profile);
+    sai_qos_map_free_resources(p_profile->p_hw_node);
+    free(p_profile);
+
+    return SAI_STATUS_SUCCESS;
+}
+
+static sai_qos_map_profile_ref_t *sai_qos_map_profile_ref_get(sai_object_id_t map_id)
+{
+    sai_qos_map_profile_ref_t tmp_ref;
+
+    if(sai_qos_map_profile_ref_tree == NULL){
+        return NULL;
+    }
+
+    tmp_ref.map_id = map_id;
+
+    return ((sai_qos_map_profile_ref_t *)
+            std_rbtree_getexact(sai_qos_map_profile_ref_tree, &tmp_ref));
+}
+
+/*
+ * The first map of a profile takes the NPU map id. Other maps, and maps
+ * created after that id is taken by a map which since moved to another
+ * profile, get an id from the shared id space.
+ */
+static sai_status_t sai_qos_map_profile_map_id_get(const sai_qos_map_profile_t *p_profile,
+                                                   sai_object_id_t *p_map_id,
+                                                   uint64_t *p_shared_id)
+{
+    sai_object_id_t map_id = p_profile->p_hw_node->key.map_id;
+    uint64_t        shared_id = 0;
+    uint_t          attempt = 0;
+
+    *p_shared_id = 0;
+
+    if(sai_qos_map_node_get(map_id) == NULL){
+        *p_map_id = map_id;
+        return SAI_STATUS_SUCCESS;
+    }
+
+    for(attempt = 0; attempt < SAI_QOS_MAP_SHARED_ID_MAX; attempt++){
+        if(sai_id_allocator_alloc(&sai_qos_map_shared_id_allocator, &shared_id)
+           != SAI_STATUS_SUCCESS){
+            break;
+        }
+
+        map_id = sai_uoid_create(SAI_OBJECT_TYPE_QOS_MAP,
+                                 sai_add_type_to_object(SAI_QOS_MAP_SHARED_ID_BASE + shared_id,
+                                                        p_profile->p_hw_node->map_type));
+
+        if(sai_qos_map_node_get(map_id) == NULL){
+            *p_map_id = map_id;
+            *p_shared_id = shared_id;
+            return SAI_STATUS_SUCCESS;
+        }
+
+        /* Taken by a map holding the NPU id, leave it allocated */
+    }
+
+    SAI_MAPS_LOG_ERR("No free shared map id for maptype %d",
+                     p_profile->p_hw_node->map_type);
+
+    return SAI_STATUS_INSUFFICIENT_RESOURCES;
+}
+
+static sai_status_t sai_qos_map_profile_ref_add(sai_object_id_t map_id,
+                                                sai_qos_map_profile_t *p_profile,
+                                                uint64_t shared_id)
+{
+    sai_qos_map_profile_ref_t *p_ref = NULL;
+
+    p_ref = (sai_qos_map_profile_ref_t *) calloc(1, sizeof(*p_ref));
+
+    if(p_ref == NULL){
+        return SAI_STATUS_NO_MEMORY;
+    }
+
+    p_ref->map_id = map_id;
+    p_ref->p_profile = p_profile;
+    p_ref->shared_id = shared_id;
+
+    if(std_rbtree_insert(sai_qos_map_profile_ref_tree, p_ref) != STD_ERR_OK){
+        free(p_ref);
+        return SAI_STATUS_FAILURE;
+    }
+
+    p_profile->ref_count++;
+
+    return SAI_STATUS_SUCCESS;
+}
+
+static void sai_qos_map_profile_ref_free(sai_qos_map_profile_ref_t *p_ref)
+{
+    if(p_ref->shared_id != 0){
+        sai_id_allocator_free(&sai_qos_map_shared_id_allocator, p_ref->shared_id);
+    }
+
+    std_rbtree_remove(sai_qos_map_profile_ref_tree, p_ref);
+    free(p_ref);
+}
+
+sai_object_id_t sai_qos_map_npu_id_get(sai_object_id_t map_id)
+{
+    sai_qos_map_profile_ref_t *p_ref = sai_qos_map_profile_ref_get(map_id);
+
+    if(p_ref == NULL){
+        return map_id;
+    }
+
+    return p_ref->p_profile->p_hw_node->key.map_id;
+}
+
+uint_t sai_qos_map_npu_update_count_get(void)
+{
+    return sai_qos_map_npu_update_count;
+}
+
+uint_t sai_qos_map_port_update_count_get(void)
+{
+    return sai_qos_map_port_update_count;
+}
+
+uint_t sai_qos_map_profile_ref_count_get(sai_object_id_t map_id)
+{
+    sai_qos_map_profile_ref_t *p_ref = sai_qos_map_profile_ref_get(map_id);
+
+    if(p_ref == NULL){
+        return 0;
+    }
+
+    return p_ref->p_profile->ref_count;
+}
+
+static sai_status_t sai_qos_map_profile_ports_set(dn_sai_qos_map_t *p_map_node,
+                                                  sai_object_id_t hw_map_id,
+                                                  sai_object_id_t rev_hw_map_id)
+{
+    dn_sai_qos_port_t *p_qos_port_node = NULL;
+    dn_sai_qos_port_t *p_rev_port_node = NULL;
+    sai_status_t      sai_rc = SAI_STATUS_SUCCESS;
+
+    p_qos_port_node = sai_qos_maps_get_port_node_from_map(p_map_node);
+
+    while(p_qos_port_node != NULL){
+        sai_rc = sai_qos_map_npu_api_get()->port_map_set(p_qos_port_node->port_id,
+                                                         hw_map_id,
+                                                         p_map_node->map_type,
+                                                         true);
+        if(sai_rc != SAI_STATUS_SUCCESS){
+            SAI_MAPS_LOG_ERR("Npu set failed for map profile 0x%"PRIx64" on "
+                             "portid 0x%"PRIx64"", hw_map_id,
+                             p_qos_port_node->port_id);
+            break;
+        }
+        p_qos_port_node = sai_qos_maps_next_port_node_from_map_get(p_map_node,
+                                                                   p_qos_port_node);
+    }
+
+    if(sai_rc == SAI_STATUS_SUCCESS){
+        return sai_rc;
+    }
+
+    p_rev_port_node = sai_qos_maps_get_port_node_from_map(p_map_node);
+
+    while((p_rev_port_node != NULL) && (p_rev_port_node != p_qos_port_node)){
+        if(sai_qos_map_npu_api_get()->port_map_set(p_rev_port_node->port_id,
+                                                   rev_hw_map_id,
+                                                   p_map_node->map_type,
+                                                   true) != SAI_STATUS_SUCCESS){
+            SAI_MAPS_LOG_ERR("Npu revert failed for map profile 0x%"PRIx64" on "
+                             "portid 0x%"PRIx64"", rev_hw_map_id,
+                             p_rev_port_node->port_id);
+        }
+        p_rev_port_node = sai_qos_maps_next_port_node_from_map_get(p_map_node,
+                                                                   p_rev_port_node);
+    }
+
+    return sai_rc;
+}
+
+/*
+ * Applies the new contents of a map. The map joins a profile with the same
+ * contents if there is one. Otherwise a profile used by this map alone is
+ * updated in place and a shared profile is copied on write.
+ */
+static sai_status_t sai_qos_map_profile_update(dn_sai_qos_map_t *p_map_node,
+                                               sai_qos_map_profile_ref_t *p_ref,
+                                               dn_sai_qos_map_t *p_new_node,
+                                               uint_t attr_flags)
+{
+    sai_qos_map_profile_t *p_old_profile = p_ref->p_profile;
+    sai_qos_map_profile_t *p_profile = NULL;
+    dn_sai_qos_map_t      hw_new_node;
+    uint32_t              hash = 0;
+    sai_status_t          sai_rc = SAI_STATUS_SUCCESS;
+
+    hash = sai_qos_map_profile_hash_get(p_new_node);
+
+    p_profile = sai_qos_map_profile_find(p_new_node, hash);
+
+    if(p_profile == p_old_profile){
+        return SAI_STATUS_SUCCESS;
+    }
+
+    if((p_profile == NULL) && (p_old_profile->ref_count == 1)){
+        memset(&hw_new_node, 0, sizeof(hw_new_node));
+
+        hw_new_node.key.map_id = p_old_profile->p_hw_node->key.map_id;
+        hw_new_node.map_type = p_old_profile->p_hw_node->map_type;
+
+        sai_rc = sai_qos_map_list_copy(&hw_new_node, p_new_node);
+
+        if(sai_rc != SAI_STATUS_SUCCESS){
+            return sai_rc;
+        }
+
+        SAI_API_LATENCY_NPU_CALL(sai_rc,
+                sai_qos_map_npu_api_get()->map_attr_set(&hw_new_node, attr_flags));
+
+        if(sai_rc != SAI_STATUS_SUCCESS){
+            sai_qos_map_node_list_free(hw_new_node.map_to_value.list);
+            return sai_rc;
+        }
+
+        if(p_old_profile->p_hw_node->map_to_value.list != NULL){
+            sai_qos_map_node_list_free(p_old_profile->p_hw_node->map_to_value.list);
+        }
+
+        memcpy(&p_old_profile->p_hw_node->map_to_value, &hw_new_node.map_to_value,
+               sizeof(hw_new_node.map_to_value));
+
+        sai_qos_map_profile_unlink(p_old_profile);
+        sai_qos_map_profile_link(p_old_profile, hash);
+
+        return SAI_STATUS_SUCCESS;
+    }
+
+    if(p_profile == NULL){
+        SAI_MAPS_LOG_TRACE("Map profile 0x%"PRIx64" is shared, copy on write",
+                           p_old_profile->p_hw_node->key.map_id);
+
+        sai_rc = sai_qos_map_profile_create(p_new_node, hash, &p_profile);
+
+        if(sai_rc != SAI_STATUS_SUCCESS){
+            return sai_rc;
+        }
+    }
+
+    sai_rc = sai_qos_map_profile_ports_set(p_map_node,
+                                           p_profile->p_hw_node->key.map_id,
+                                           p_old_profile->p_hw_node->key.map_id);
+
+    if(sai_rc != SAI_STATUS_SUCCESS){
+        if(p_profile->ref_count == 0){
+            sai_qos_map_profile_release(p_profile);
+        }
+        return sai_rc;
+    }
+
+    p_profile->ref_count++;
+    p_ref->p_profile = p_profile;
+
+    if(sai_qos_map_profile_release(p_old_profile) != SAI_STATUS_SUCCESS){
+        /* Left unreferenced in the table, where it can still be shared */
+        p_old_profile->ref_count = 0;
+    }
+
+    return SAI_STATUS_SUCCESS;
+}
+
+/*
+ * Number of entries that differ between the dense map lists of the nodes.
+ * Entries are compared in place as both lists are indexed by key.
+ */
+static uint_t sai_qos_map_list_changed_count_get(const dn_sai_qos_map_t *p_old_node,
+                                                 const dn_sai_qos_map_t *p_new_node)
+{
+    uint_t idx = 0;
+    uint_t changed_count = 0;
+
+    if((p_old_node->map_to_value.list == NULL) ||
+       (p_old_node->map_to_value.count != p_new_node->map_to_value.count)){
+        return p_new_node->map_to_value.count;
+    }
+
+    for(idx = 0; idx < p_new_node->map_to_value.count; idx++){
+        if(memcmp(&p_old_node->map_to_value.list[idx],
+                  &p_new_node->map_to_value.list[idx], sizeof(sai_qos_map_t)) != 0){
+            SAI_MAPS_LOG_TRACE("Map entry %d changed", idx);
+            changed_count++;
+        }
+    }
+
+    return changed_count;
+}
+
 static sai_status_t sai_qos_map_list_default_set(dn_sai_qos_map_t *p_map_node)
 {
     sai_status_t sai_rc = SAI_STATUS_SUCCESS;
@@ -743,8 +1293,12 @@ static sai_status_t sai_qos_map_create(sai_object_id_t *map_id,
 {
     sai_status_t           sai_rc = SAI_STATUS_SUCCESS;
     dn_sai_qos_map_t       *p_map_node = NULL;
+    sai_qos_map_profile_t  *p_profile = NULL;
     sai_npu_object_id_t    hw_map_id = 0;
     uint_t                 attr_flags = 0;
+    uint32_t               hash = 0;
+    uint64_t               shared_id = 0;
+    bool                   npu_created = false;
 
     STD_ASSERT(map_id != NULL);
     STD_ASSERT(attr_list != NULL);
@@ -776,23 +1330,53 @@ static sai_status_t sai_qos_map_create(sai_object_id_t *map_id,
             }
         }
 
-        sai_rc = sai_qos_map_npu_api_get()->map_create(p_map_node, &hw_map_id);
+        if(sai_qos_map_is_profile_shared_type(p_map_node->map_type)){
+            sai_rc = sai_qos_map_profile_init();
+            if(sai_rc != SAI_STATUS_SUCCESS){
+                break;
+            }
+
+            hash = sai_qos_map_profile_hash_get(p_map_node);
 
-        if(sai_rc != SAI_STATUS_SUCCESS){
-            SAI_MAPS_LOG_ERR("Npu map create failed for maptype %d",
-                             p_map_node->map_type);
-            break;
-        }
+            p_profile = sai_qos_map_profile_find(p_map_node, hash);
 
-        SAI_MAPS_LOG_TRACE("Mapid created in NPU 0x%"PRIx64"",hw_map_id);
+            if(p_profile == NULL){
+                sai_rc = sai_qos_map_profile_create(p_map_node, hash, &p_profile);
+                if(sai_rc != SAI_STATUS_SUCCESS){
+                    break;
+                }
+            } else {
+                SAI_MAPS_LOG_TRACE("Sharing map profile 0x%"PRIx64" for maptype %d",
+                                   p_profile->p_hw_node->key.map_id,
+                                   p_map_node->map_type);
+            }
 
-        /* Append the maptype to the NPU returned map id.*/
+            sai_rc = sai_qos_map_profile_map_id_get(p_profile, map_id, &shared_id);
+            if(sai_rc != SAI_STATUS_SUCCESS){
+                break;
+            }
+        } else {
+            SAI_API_LATENCY_NPU_CALL(sai_rc,
+                    sai_qos_map_npu_api_get()->map_create(p_map_node, &hw_map_id));
 
-        hw_map_id = sai_add_type_to_object(hw_map_id,
-                                                 p_map_node->map_type);
+            if(sai_rc != SAI_STATUS_SUCCESS){
+                SAI_MAPS_LOG_ERR("Npu map create failed for maptype %d",
+                                 p_map_node->map_type);
+                break;
+            }
+
+            npu_created = true;
 
-        *map_id = sai_uoid_create(SAI_OBJECT_TYPE_QOS_MAP,
-                                  hw_map_id);
+            SAI_MAPS_LOG_TRACE("Mapid created in NPU 0x%"PRIx64"",hw_map_id);
+
+            /* Append the maptype to the NPU returned map id.*/
+
+            hw_map_id = sai_add_type_to_object(hw_map_id,
+                                                     p_map_node->map_type);
+
+            *map_id = sai_uoid_create(SAI_OBJECT_TYPE_QOS_MAP,
+                                      hw_map_id);
+        }
 
         SAI_MAPS_LOG_TRACE("Map object id is 0x%"PRIx64"",*map_id);
 
@@ -801,14 +1385,22 @@ static sai_status_t sai_qos_map_create(sai_object_id_t *map_id,
         std_dll_init(&p_map_node->port_dll_head);
 
         if (sai_qos_map_node_insert(p_map_node) != STD_ERR_OK){
-            sai_qos_map_npu_api_get()->map_remove(p_map_node);
-
             SAI_MAPS_LOG_ERR("Map id insertion failed in RB tree");
 
             sai_rc = SAI_STATUS_FAILURE;
             break;
         }
 
+        if(p_profile != NULL){
+            sai_rc = sai_qos_map_profile_ref_add(*map_id, p_profile, shared_id);
+            if(sai_rc != SAI_STATUS_SUCCESS){
+                SAI_MAPS_LOG_ERR("Map profile reference add failed for mapid 0x%"PRIx64"",
+                                 *map_id);
+                sai_qos_map_node_remove(*map_id);
+                break;
+            }
+        }
+
     }while(0);
 
 
@@ -821,6 +1413,19 @@ static sai_status_t sai_qos_map_create(sai_object_id_t *map_id,
 
         SAI_MAPS_LOG_ERR("Map create failed for maptype %d",
                            p_map_node->map_type);
+
+        if(shared_id != 0){
+            sai_id_allocator_free(&sai_qos_map_shared_id_allocator, shared_id);
+        }
+
+        if(p_profile != NULL){
+            if(p_profile->ref_count == 0){
+                sai_qos_map_profile_release(p_profile);
+            }
+        }
+        else if(npu_created){
+            sai_qos_map_npu_api_get()->map_remove(p_map_node);
+        }
         sai_qos_map_free_resources(p_map_node);
     }
     sai_qos_unlock();
@@ -833,6 +1438,7 @@ static sai_status_t sai_qos_map_remove(sai_object_id_t map_id)
     dn_sai_qos_map_t  *p_map_node = NULL;
     sai_status_t      sai_rc = SAI_STATUS_SUCCESS;
     dn_sai_qos_port_t *p_qos_port_node = NULL;
+    sai_qos_map_profile_ref_t *p_ref = NULL;
 
     if(!sai_is_obj_id_qos_map(map_id)){
         SAI_MAPS_LOG_ERR("mapid 0x%"PRIx64" is not of type qosmap",map_id);
@@ -859,7 +1465,14 @@ static sai_status_t sai_qos_map_remove(sai_object_id_t map_id)
             break;
         }
 
-        sai_rc = sai_qos_map_npu_api_get()->map_remove(p_map_node);
+        p_ref = sai_qos_map_profile_ref_get(map_id);
+
+        if(p_ref != NULL){
+            sai_rc = sai_qos_map_profile_release(p_ref->p_profile);
+        } else {
+            SAI_API_LATENCY_NPU_CALL(sai_rc,
+                    sai_qos_map_npu_api_get()->map_remove(p_map_node));
+        }
 
         if(sai_rc != SAI_STATUS_SUCCESS){
             SAI_MAPS_LOG_ERR("Npu map remove failed for mapid 0x%"PRIx64"",
@@ -867,6 +1480,10 @@ static sai_status_t sai_qos_map_remove(sai_object_id_t map_id)
             break;
         }
 
+        if(p_ref != NULL){
+            sai_qos_map_profile_ref_free(p_ref);
+        }
+
         sai_qos_map_node_remove(map_id);
 
         sai_qos_map_free_resources(p_map_node);
@@ -894,6 +1511,8 @@ sai_object_id_t map_id, const sai_attribute_t *p_attr)
     sai_status_t      sai_rc = SAI_STATUS_SUCCESS;
     uint_t            attr_flags = 0;
     uint_t            attr_count = 1;
+    uint_t            changed_count = 0;
+    sai_qos_map_profile_ref_t *p_ref = NULL;
 
     STD_ASSERT (p_attr != NULL);
 
@@ -905,6 +1524,8 @@ sai_object_id_t map_id, const sai_attribute_t *p_attr)
     SAI_MAPS_LOG_TRACE("Setting attribute Id: %d on Map Id 0x%"PRIx64"",
            p_attr->id, map_id);
 
+    memset(&map_new_node, 0, sizeof(dn_sai_qos_map_t));
+
     sai_qos_lock();
 
     do{
@@ -917,15 +1538,16 @@ sai_object_id_t map_id, const sai_attribute_t *p_attr)
             break;
         }
 
-        memset(&map_new_node, 0, sizeof(dn_sai_qos_map_t));
-
         map_new_node.map_type = p_map_exist_node->map_type;
         map_new_node.key.map_id = map_id;
 
-        if(p_map_exist_node->map_to_value.list != NULL){
+        /* Work on a copy, the existing list may back a shared profile */
+        sai_rc = sai_qos_map_list_copy(&map_new_node, p_map_exist_node);
 
-            memcpy(&map_new_node.map_to_value,
-                   &p_map_exist_node->map_to_value, sizeof(p_map_exist_node->map_to_value));
+        if(sai_rc != SAI_STATUS_SUCCESS){
+            SAI_MAPS_LOG_ERR("Failed to copy map list of mapid 0x%"PRIx64"",
+                             map_id);
+            break;
         }
 
         sai_rc = sai_qos_parse_update_attributes(&map_new_node, attr_count,
@@ -940,8 +1562,30 @@ sai_object_id_t map_id, const sai_attribute_t *p_attr)
 
         SAI_MAPS_LOG_TRACE("Map list count in set is %d",
                                map_new_node.map_to_value.count);
-        sai_rc = sai_qos_map_npu_api_get()->map_attr_set
-            (&map_new_node, attr_flags);
+
+        changed_count = sai_qos_map_list_changed_count_get(p_map_exist_node,
+                                                           &map_new_node);
+
+        if(changed_count == 0){
+            SAI_MAPS_LOG_TRACE("No map entry changed on mapid 0x%"PRIx64"",
+                               map_id);
+            break;
+        }
+
+        SAI_MAPS_LOG_TRACE("%d map entries changed on mapid 0x%"PRIx64"",
+                           changed_count, map_id);
+
+        p_ref = sai_qos_map_profile_ref_get(map_id);
+        sai_qos_map_npu_update_count++;
+
+        if(p_ref != NULL){
+            sai_rc = sai_qos_map_profile_update(p_map_exist_node, p_ref,
+                                                &map_new_node, attr_flags);
+        } else {
+            SAI_API_LATENCY_NPU_CALL(sai_rc,
+                    sai_qos_map_npu_api_get()->map_attr_set
+                    (&map_new_node, attr_flags));
+        }
 
         if(sai_rc != SAI_STATUS_SUCCESS){
             SAI_MAPS_LOG_ERR("NPU set failed for attribute Id %d"
@@ -952,7 +1596,11 @@ sai_object_id_t map_id, const sai_attribute_t *p_attr)
     }while(0);
 
 
-    if(sai_rc == SAI_STATUS_SUCCESS){
+    if((sai_rc == SAI_STATUS_SUCCESS) && (changed_count != 0)){
+        if(p_map_exist_node->map_to_value.list != NULL){
+            sai_qos_map_node_list_free(p_map_exist_node->map_to_value.list);
+        }
+
         memcpy(&p_map_exist_node->map_to_value,
                &map_new_node.map_to_value, sizeof(p_map_exist_node->map_to_value));
 
@@ -962,9 +1610,14 @@ sai_object_id_t map_id, const sai_attribute_t *p_attr)
          */
 
         if(!sai_qos_map_npu_api_get()->map_is_hw_object(p_map_exist_node->map_type)){
+            sai_qos_map_port_update_count++;
             sai_qos_map_port_list_update(p_map_exist_node);
         }
     }
+    else if(map_new_node.map_to_value.list != NULL){
+        /* Failed or unchanged set, the stored list is kept */
+        sai_qos_map_node_list_free(map_new_node.map_to_value.list);
+    }
 
     sai_qos_unlock();
 
@@ -978,6 +1631,7 @@ static sai_status_t sai_qos_map_attribute_get(sai_object_id_t map_id,
 {
     sai_status_t sai_rc = SAI_STATUS_FAILURE;
     dn_sai_qos_map_t     *p_map_node = NULL;
+    sai_qos_map_profile_ref_t *p_ref = NULL;
     uint_t               attr_flags = 0;
 
     STD_ASSERT(attr_list != NULL);
@@ -1012,8 +1666,13 @@ static sai_status_t sai_qos_map_attribute_get(sai_object_id_t map_id,
             break;
         }
 
-        sai_rc = sai_qos_map_npu_api_get()->map_attr_get(p_map_node,
-                                                         attr_count, attr_list);
+        /* The NPU profile has the same contents as the map */
+        p_ref = sai_qos_map_profile_ref_get(map_id);
+
+        SAI_API_LATENCY_NPU_CALL(sai_rc,
+                sai_qos_map_npu_api_get()->map_attr_get
+                ((p_ref != NULL) ? p_ref->p_profile->p_hw_node : p_map_node,
+                 attr_count, attr_list));
 
         if (sai_rc != SAI_STATUS_SUCCESS){
             SAI_MAPS_LOG_ERR("Npu get failed for mapid 0x%"PRIx64"",map_id);
@@ -279,11 +279,21 @@ sai_status_t sai_qos_pg_stats_get (sai_object_id_t pg_id, const
                                    uint32_t number_of_counters, uint64_t* counters)
 {
     sai_status_t sai_rc = SAI_STATUS_SUCCESS;
+    uint32_t     counter_idx = 0;
 
     sai_qos_lock();
 
     sai_rc =  sai_buffer_npu_api_get()->pg_stats_get (pg_id, counter_ids, number_of_counters,
                                                    counters);
+
+    if (sai_rc == SAI_STATUS_SUCCESS) {
+        /* Watermark counter is cleared by the watermark poller */
+        for (counter_idx = 0; counter_idx < number_of_counters; counter_idx++) {
+            if (counter_ids[counter_idx] == SAI_INGRESS_PRIORITY_GROUP_STAT_WATERMARK_BYTES) {
+                sai_qos_watermark_peak_apply (pg_id, &counters[counter_idx]);
+            }
+        }
+    }
     sai_qos_unlock();
 
     return sai_rc;
@@ -293,12 +303,47 @@ sai_status_t sai_qos_pg_stats_clear (sai_object_id_t pg_id, uint32_t number_of_c
                                      const sai_ingress_priority_group_stat_t *counter_ids)
 {
     sai_status_t sai_rc = SAI_STATUS_SUCCESS;
+    const sai_ingress_priority_group_stat_t *npu_counter_ids = counter_ids;
+    sai_ingress_priority_group_stat_t       *p_filtered_ids = NULL;
+    uint32_t     npu_counter_count = number_of_counters;
+    uint32_t     counter_idx = 0;
+    bool         poller_owned = false;
 
     sai_qos_lock();
 
-    sai_rc = sai_buffer_npu_api_get()->pg_stats_clear (pg_id, counter_ids, number_of_counters);
+    for (counter_idx = 0; counter_idx < number_of_counters; counter_idx++) {
+        if (counter_ids[counter_idx] == SAI_INGRESS_PRIORITY_GROUP_STAT_WATERMARK_BYTES) {
+            poller_owned = sai_qos_watermark_peak_clear (pg_id);
+        }
+    }
+
+    /* Watermark counter is left to the watermark poller while it runs */
+    if (poller_owned) {
+        p_filtered_ids = (sai_ingress_priority_group_stat_t *) calloc (number_of_counters,
+                                             sizeof (sai_ingress_priority_group_stat_t));
+        if (p_filtered_ids == NULL) {
+            SAI_BUFFER_LOG_ERR ("Failed to allocate PG stats clear list");
+            sai_qos_unlock();
+            return SAI_STATUS_NO_MEMORY;
+        }
+
+        npu_counter_count = 0;
+        for (counter_idx = 0; counter_idx < number_of_counters; counter_idx++) {
+            if (counter_ids[counter_idx] != SAI_INGRESS_PRIORITY_GROUP_STAT_WATERMARK_BYTES) {
+                p_filtered_ids[npu_counter_count++] = counter_ids[counter_idx];
+            }
+        }
+        npu_counter_ids = p_filtered_ids;
+    }
+
+    if (npu_counter_count != 0) {
+        sai_rc = sai_buffer_npu_api_get()->pg_stats_clear (pg_id, npu_counter_ids,
+                                                           npu_counter_count);
+    }
 
     sai_qos_unlock();
 
+    free (p_filtered_ids);
+
     return sai_rc;
 }
@@ -30,14 +30,43 @@
 #include "sai_gen_utils.h"
 #include "sai_qos_mem.h"
 #include "sai_common_infra.h"
+#include "sai_switch_utils.h"
+#include "sai_id_allocator.h"
 
 #include "std_type_defs.h"
 #include "std_utils.h"
 #include "std_assert.h"
+#include "std_rbtree.h"
 
 #include <stdlib.h>
+#include <string.h>
 #include <inttypes.h>
 
+/*
+ * Storm control policer to port bindings. Each port bound to a storm
+ * control policer gets a slot, and each policer keeps a bitmap of slots
+ * per storm control type. The slot is released when the port has no
+ * storm control policer left.
+ */
+typedef struct _sai_qos_policer_port_slot_t {
+    sai_object_id_t port_id;
+    uint_t          slot;
+    uint_t          bind_count;
+} sai_qos_policer_port_slot_t;
+
+typedef struct _sai_qos_policer_port_set_t {
+    sai_object_id_t policer_id;
+    uint8_t        *port_bitmap [SAI_QOS_POLICER_TYPE_MAX];
+    uint_t          port_count [SAI_QOS_POLICER_TYPE_MAX];
+} sai_qos_policer_port_set_t;
+
+static rbtree_handle sai_qos_policer_port_slot_tree = NULL;
+static rbtree_handle sai_qos_policer_port_set_tree = NULL;
+static sai_id_allocator_t sai_qos_policer_port_slot_allocator;
+/* Port Id of each slot, indexed by slot */
+static sai_object_id_t *sai_qos_policer_slot_port_list = NULL;
+static uint_t sai_qos_policer_port_slot_max = 0;
+
 static uint_t sai_get_storm_control_type_from_port_attr(uint_t attr)
 {
     if(attr == SAI_PORT_ATTR_FLOOD_STORM_CONTROL_POLICER_ID){
@@ -306,11 +335,366 @@ static sai_status_t sai_policer_parse_update_attributes(
     return sai_rc;
 }
 
+static inline bool sai_qos_policer_slot_is_set (const uint8_t *p_bitmap, uint_t slot)
+{
+    return ((p_bitmap [slot / 8] & (1 << (slot % 8))) != 0);
+}
+
+static inline void sai_qos_policer_slot_set (uint8_t *p_bitmap, uint_t slot)
+{
+    p_bitmap [slot / 8] |= (1 << (slot % 8));
+}
+
+static inline void sai_qos_policer_slot_clear (uint8_t *p_bitmap, uint_t slot)
+{
+    p_bitmap [slot / 8] &= ~(1 << (slot % 8));
+}
+
+static inline size_t sai_qos_policer_port_bitmap_size (void)
+{
+    return ((sai_qos_policer_port_slot_max / 8) + 1);
+}
+
+static sai_status_t sai_qos_policer_port_index_init (void)
+{
+    if (sai_qos_policer_port_slot_tree != NULL) {
+        return SAI_STATUS_SUCCESS;
+    }
+
+    sai_qos_policer_port_slot_max = sai_switch_get_max_lport ();
+
+    sai_qos_policer_slot_port_list = (sai_object_id_t *)
+        calloc (sai_qos_policer_port_slot_max + 1, sizeof (sai_object_id_t));
+
+    sai_qos_policer_port_set_tree =
+        std_rbtree_create_simple ("policer_port_set_tree",
+                                  STD_STR_OFFSET_OF (sai_qos_policer_port_set_t,
+                                                     policer_id),
+                                  STD_STR_SIZE_OF (sai_qos_policer_port_set_t,
+                                                   policer_id));
+
+    sai_qos_policer_port_slot_tree =
+        std_rbtree_create_simple ("policer_port_slot_tree",
+                                  STD_STR_OFFSET_OF (sai_qos_policer_port_slot_t,
+                                                     port_id),
+                                  STD_STR_SIZE_OF (sai_qos_policer_port_slot_t,
+                                                   port_id));
+
+    if ((sai_qos_policer_slot_port_list == NULL) ||
+        (sai_qos_policer_port_set_tree == NULL) ||
+        (sai_qos_policer_port_slot_tree == NULL) ||
+        (sai_id_allocator_init (&sai_qos_policer_port_slot_allocator,
+                                "policer_port_slot",
+                                sai_qos_policer_port_slot_max)
+         != SAI_STATUS_SUCCESS)) {
+
+        SAI_POLICER_LOG_ERR ("Failed to init policer port index of %u ports",
+                             sai_qos_policer_port_slot_max);
+
+        free (sai_qos_policer_slot_port_list);
+        sai_qos_policer_slot_port_list = NULL;
+
+        if (sai_qos_policer_port_set_tree != NULL) {
+            std_rbtree_destroy (sai_qos_policer_port_set_tree);
+            sai_qos_policer_port_set_tree = NULL;
+        }
+
+        if (sai_qos_policer_port_slot_tree != NULL) {
+            std_rbtree_destroy (sai_qos_policer_port_slot_tree);
+            sai_qos_policer_port_slot_tree = NULL;
+        }
+
+        return SAI_STATUS_NO_MEMORY;
+    }
+
+    return SAI_STATUS_SUCCESS;
+}
+
+static sai_qos_policer_port_set_t *sai_qos_policer_port_set_get (
+                                                 sai_object_id_t policer_id)
+{
+    sai_qos_policer_port_set_t tmp_set;
+
+    if (sai_qos_policer_port_set_tree == NULL) {
+        return NULL;
+    }
+
+    tmp_set.policer_id = policer_id;
+
+    return ((sai_qos_policer_port_set_t *)
+            std_rbtree_getexact (sai_qos_policer_port_set_tree, &tmp_set));
+}
+
+static void sai_qos_policer_port_set_free (sai_qos_policer_port_set_t *p_set)
+{
+    uint_t type = 0;
+
+    for (type = 0; type < SAI_QOS_POLICER_TYPE_MAX; type++) {
+        free (p_set->port_bitmap [type]);
+    }
+
+    free (p_set);
+}
+
+static sai_qos_policer_port_set_t *sai_qos_policer_port_set_create (
+                                                 sai_object_id_t policer_id)
+{
+    sai_qos_policer_port_set_t *p_set = NULL;
+    uint_t                      type = 0;
+
+    p_set = (sai_qos_policer_port_set_t *) calloc (1, sizeof (*p_set));
+
+    if (p_set == NULL) {
+        return NULL;
+    }
+
+    p_set->policer_id = policer_id;
+
+    for (type = 0; type < SAI_QOS_POLICER_TYPE_MAX; type++) {
+        p_set->port_bitmap [type] = (uint8_t *)
+            calloc (1, sai_qos_policer_port_bitmap_size ());
+
+        if (p_set->port_bitmap [type] == NULL) {
+            sai_qos_policer_port_set_free (p_set);
+            return NULL;
+        }
+    }
+
+    if (std_rbtree_insert (sai_qos_policer_port_set_tree, p_set) != STD_ERR_OK) {
+        sai_qos_policer_port_set_free (p_set);
+        return NULL;
+    }
+
+    return p_set;
+}
+
+static void sai_qos_policer_port_set_remove (sai_object_id_t policer_id)
+{
+    sai_qos_policer_port_set_t *p_set = sai_qos_policer_port_set_get (policer_id);
+
+    if (p_set != NULL) {
+        std_rbtree_remove (sai_qos_policer_port_set_tree, p_set);
+        sai_qos_policer_port_set_free (p_set);
+    }
+}
+
+static sai_qos_policer_port_slot_t *sai_qos_policer_port_slot_get (
+                                                   sai_object_id_t port_id)
+{
+    sai_qos_policer_port_slot_t tmp_slot;
+
+    if (sai_qos_policer_port_slot_tree == NULL) {
+        return NULL;
+    }
+
+    tmp_slot.port_id = port_id;
+
+    return ((sai_qos_policer_port_slot_t *)
+            std_rbtree_getexact (sai_qos_policer_port_slot_tree, &tmp_slot));
+}
+
+static sai_qos_policer_port_slot_t *sai_qos_policer_port_slot_alloc (
+                                                   sai_object_id_t port_id)
+{
+    sai_qos_policer_port_slot_t *p_slot = NULL;
+    uint64_t                     slot = 0;
+
+    p_slot = (sai_qos_policer_port_slot_t *) calloc (1, sizeof (*p_slot));
+
+    if (p_slot == NULL) {
+        return NULL;
+    }
+
+    if (sai_id_allocator_alloc (&sai_qos_policer_port_slot_allocator, &slot)
+        != SAI_STATUS_SUCCESS) {
+        SAI_POLICER_LOG_ERR ("No free policer port slot for port 0x%"PRIx64"",
+                             port_id);
+        free (p_slot);
+        return NULL;
+    }
+
+    p_slot->port_id = port_id;
+    p_slot->slot = (uint_t) slot;
+
+    if (std_rbtree_insert (sai_qos_policer_port_slot_tree, p_slot) != STD_ERR_OK) {
+        sai_id_allocator_free (&sai_qos_policer_port_slot_allocator, slot);
+        free (p_slot);
+        return NULL;
+    }
+
+    sai_qos_policer_slot_port_list [p_slot->slot] = port_id;
+
+    return p_slot;
+}
+
+static void sai_qos_policer_port_slot_release (sai_qos_policer_port_slot_t *p_slot)
+{
+    sai_qos_policer_slot_port_list [p_slot->slot] = SAI_NULL_OBJECT_ID;
+
+    sai_id_allocator_free (&sai_qos_policer_port_slot_allocator, p_slot->slot);
+
+    std_rbtree_remove (sai_qos_policer_port_slot_tree, p_slot);
+
+    free (p_slot);
+}
+
+static sai_status_t sai_qos_policer_port_bind (sai_object_id_t policer_id,
+                                               sai_object_id_t port_id,
+                                               uint_t type)
+{
+    sai_qos_policer_port_set_t  *p_set = NULL;
+    sai_qos_policer_port_slot_t *p_slot = NULL;
+    sai_status_t                 sai_rc = SAI_STATUS_SUCCESS;
+
+    sai_rc = sai_qos_policer_port_index_init ();
+
+    if (sai_rc != SAI_STATUS_SUCCESS) {
+        return sai_rc;
+    }
+
+    p_set = sai_qos_policer_port_set_get (policer_id);
+
+    if (p_set == NULL) {
+        p_set = sai_qos_policer_port_set_create (policer_id);
+
+        if (p_set == NULL) {
+            return SAI_STATUS_NO_MEMORY;
+        }
+    }
+
+    p_slot = sai_qos_policer_port_slot_get (port_id);
+
+    if (p_slot == NULL) {
+        p_slot = sai_qos_policer_port_slot_alloc (port_id);
+
+        if (p_slot == NULL) {
+            return SAI_STATUS_INSUFFICIENT_RESOURCES;
+        }
+    }
+
+    if (!sai_qos_policer_slot_is_set (p_set->port_bitmap [type], p_slot->slot)) {
+        sai_qos_policer_slot_set (p_set->port_bitmap [type], p_slot->slot);
+        p_set->port_count [type]++;
+        p_slot->bind_count++;
+    }
+
+    return SAI_STATUS_SUCCESS;
+}
+
+static void sai_qos_policer_port_unbind (sai_object_id_t policer_id,
+                                         sai_object_id_t port_id,
+                                         uint_t type)
+{
+    sai_qos_policer_port_set_t  *p_set = sai_qos_policer_port_set_get (policer_id);
+    sai_qos_policer_port_slot_t *p_slot = sai_qos_policer_port_slot_get (port_id);
+
+    if ((p_set == NULL) || (p_slot == NULL) ||
+        (!sai_qos_policer_slot_is_set (p_set->port_bitmap [type], p_slot->slot))) {
+        return;
+    }
+
+    sai_qos_policer_slot_clear (p_set->port_bitmap [type], p_slot->slot);
+    p_set->port_count [type]--;
+    p_slot->bind_count--;
+
+    if (p_slot->bind_count == 0) {
+        sai_qos_policer_port_slot_release (p_slot);
+    }
+}
+
+static uint_t sai_qos_policer_port_count_get (sai_object_id_t policer_id,
+                                              uint_t type)
+{
+    sai_qos_policer_port_set_t *p_set = sai_qos_policer_port_set_get (policer_id);
+
+    return ((p_set != NULL) ? p_set->port_count [type] : 0);
+}
+
+sai_object_id_t sai_qos_policer_port_next_get (sai_object_id_t policer_id,
+                                               uint_t type, uint_t *p_slot)
+{
+    sai_qos_policer_port_set_t *p_set = NULL;
+    uint_t                      slot = 0;
+
+    STD_ASSERT (p_slot != NULL);
+
+    if (type >= SAI_QOS_POLICER_TYPE_MAX) {
+        return SAI_NULL_OBJECT_ID;
+    }
+
+    p_set = sai_qos_policer_port_set_get (policer_id);
+
+    if ((p_set == NULL) || (p_set->port_count [type] == 0)) {
+        return SAI_NULL_OBJECT_ID;
+    }
+
+    for (slot = *p_slot + 1; slot <= sai_qos_policer_port_slot_max; slot++) {
+
+        if (sai_qos_policer_slot_is_set (p_set->port_bitmap [type], slot)) {
+            *p_slot = slot;
+            return sai_qos_policer_slot_port_list [slot];
+        }
+    }
+
+    return SAI_NULL_OBJECT_ID;
+}
+
+/*
+ * Programs p_policer_node on the ports bound to policer_id for a storm
+ * control type. On failure the ports already programmed are programmed
+ * back with p_revert_node, so that the port set is left as it was.
+ */
+static sai_status_t sai_qos_policer_port_set_apply (sai_object_id_t policer_id,
+                                                    uint_t type,
+                                                    dn_sai_qos_policer_t *p_policer_node,
+                                                    dn_sai_qos_policer_t *p_revert_node)
+{
+    sai_status_t    sai_rc = SAI_STATUS_SUCCESS;
+    sai_object_id_t port_id = SAI_NULL_OBJECT_ID;
+    sai_object_id_t failed_port_id = SAI_NULL_OBJECT_ID;
+    uint_t          slot = 0;
+
+    for (port_id = sai_qos_policer_port_next_get (policer_id, type, &slot);
+         port_id != SAI_NULL_OBJECT_ID;
+         port_id = sai_qos_policer_port_next_get (policer_id, type, &slot)) {
+
+        SAI_POLICER_LOG_TRACE("Updating port 0x%"PRIx64" for type %d",
+                              port_id, type);
+
+        sai_rc = sai_qos_policer_npu_api_get()->policer_port_set
+            (port_id, p_policer_node, type, true);
+
+        if (sai_rc != SAI_STATUS_SUCCESS) {
+            SAI_POLICER_LOG_ERR("Npu update failed on port 0x%"PRIx64"", port_id);
+            failed_port_id = port_id;
+            break;
+        }
+    }
+
+    if ((sai_rc == SAI_STATUS_SUCCESS) || (p_revert_node == NULL)) {
+        return sai_rc;
+    }
+
+    slot = 0;
+
+    for (port_id = sai_qos_policer_port_next_get (policer_id, type, &slot);
+         port_id != failed_port_id;
+         port_id = sai_qos_policer_port_next_get (policer_id, type, &slot)) {
+
+        if (sai_qos_policer_npu_api_get()->policer_port_set
+            (port_id, p_revert_node, type, true) != SAI_STATUS_SUCCESS) {
+            SAI_POLICER_LOG_ERR("Npu revert failed on port 0x%"PRIx64"", port_id);
+        }
+    }
+
+    return sai_rc;
+}
+
 static sai_status_t sai_policer_update_port_list(dn_sai_qos_policer_t *p_policer_new)
 {
     STD_ASSERT(p_policer_new != NULL);
     uint_t type = 0;
-    dn_sai_qos_port_t *p_port_node = NULL;
+    uint_t rev_type = 0;
     dn_sai_qos_policer_t *p_policer_node_old = NULL;
     sai_status_t sai_rc = SAI_STATUS_SUCCESS;
 
@@ -325,19 +709,19 @@ static sai_status_t sai_policer_update_port_list(dn_sai_qos_policer_t *p_policer
 
     for(type = 0; type < SAI_QOS_POLICER_TYPE_MAX; type ++){
         SAI_POLICER_LOG_TRACE("updating type %d", type);
-        p_port_node = sai_qos_port_node_from_policer_get(p_policer_node_old, type);
 
-        while(p_port_node != NULL){
-            SAI_POLICER_LOG_TRACE("Updating port 0x%"PRIx64" for type %d",
-                                  p_port_node->port_id, type);
-            sai_rc = sai_qos_policer_npu_api_get()->policer_port_set
-                (p_port_node->port_id, p_policer_new, type, true);
+        sai_rc = sai_qos_policer_port_set_apply(p_policer_new->key.policer_id,
+                                                type, p_policer_new,
+                                                p_policer_node_old);
+        if(sai_rc != SAI_STATUS_SUCCESS){
+            break;
+        }
+    }
 
-            if(sai_rc != SAI_STATUS_SUCCESS){
-                SAI_POLICER_LOG_ERR("Npu update failed ");
-                return sai_rc;
-            }
-            p_port_node = sai_qos_next_port_node_from_policer_get(p_policer_node_old, p_port_node, type);
+    if(sai_rc != SAI_STATUS_SUCCESS){
+        for(rev_type = 0; rev_type < type; rev_type ++){
+            sai_qos_policer_port_set_apply(p_policer_new->key.policer_id,
+                                           rev_type, p_policer_node_old, NULL);
         }
     }
 
@@ -435,7 +819,7 @@ static sai_status_t sai_qos_policer_is_object_in_use(dn_sai_qos_policer_t *p_pol
 
     if(policer_type == SAI_POLICER_MODE_STORM_CONTROL){
         for(type = 0; type < SAI_QOS_POLICER_TYPE_MAX; type ++){
-            if(sai_qos_port_node_from_policer_get(p_policer_node, type)!= NULL){
+            if(sai_qos_policer_port_count_get(p_policer_node->key.policer_id, type) != 0){
                 SAI_POLICER_LOG_WARN("policer node is in use");
                 sai_rc = SAI_STATUS_OBJECT_IN_USE;
                 break;
@@ -489,6 +873,7 @@ static sai_status_t sai_qos_policer_remove(sai_object_id_t policer_id)
             break;
         }
 
+        sai_qos_policer_port_set_remove(policer_id);
         sai_qos_policer_node_remove(policer_id);
         sai_qos_policer_free_resources(p_policer_node);
     }while(0);
@@ -497,6 +882,41 @@ static sai_status_t sai_qos_policer_remove(sai_object_id_t policer_id)
     return sai_rc;
 }
 
+/* Restores a storm control policer attribute in NPU from the policer node */
+static void sai_policer_storm_control_attr_revert(dn_sai_qos_policer_t *p_policer_node,
+                                                  const sai_attribute_t *p_attr)
+{
+    sai_attribute_t old_attr;
+
+    memset(&old_attr, 0, sizeof(old_attr));
+    old_attr.id = p_attr->id;
+
+    switch(p_attr->id)
+    {
+        case SAI_POLICER_ATTR_METER_TYPE:
+            old_attr.value.s32 = p_policer_node->meter_type;
+            break;
+
+        case SAI_POLICER_ATTR_MODE:
+            old_attr.value.s32 = p_policer_node->policer_mode;
+            break;
+
+        case SAI_POLICER_ATTR_PIR:
+            old_attr.value.u64 = p_policer_node->pir;
+            break;
+
+        default:
+            return;
+    }
+
+    if(sai_qos_policer_npu_api_get()->policer_set(p_policer_node, &old_attr)
+       != SAI_STATUS_SUCCESS){
+        SAI_POLICER_LOG_ERR("NPU revert failed for attribute Id %d on "
+                            "policerid 0x%"PRIx64"", p_attr->id,
+                            p_policer_node->key.policer_id);
+    }
+}
+
 static sai_status_t sai_qos_policer_attribute_set(sai_object_id_t policer_id,
                                               const sai_attribute_t *p_attr)
 {
@@ -569,6 +989,7 @@ static sai_status_t sai_qos_policer_attribute_set(sai_object_id_t policer_id,
                 sai_rc = sai_policer_update_port_list(&policer_new_node);
                 if(sai_rc != SAI_STATUS_SUCCESS){
                     SAI_POLICER_LOG_ERR("Updating policer on port failed");
+                    sai_policer_storm_control_attr_revert(p_policer_exist_node, p_attr);
                     break;
                 }
             }
@@ -670,31 +1091,32 @@ static sai_status_t sai_policer_port_storm_control_node_update(dn_sai_qos_port_t
                                                 dn_sai_qos_policer_t *p_policer_node,
                                                 uint_t type, bool is_add)
 {
-    dn_sai_qos_policer_t *p_policer_node_old = NULL;
+    sai_status_t sai_rc = SAI_STATUS_SUCCESS;
     STD_ASSERT(p_port_node != NULL);
     STD_ASSERT(p_policer_node != NULL);
 
     if(is_add){
         SAI_POLICER_LOG_TRACE("Add policer 0x%"PRIx64" on port 0x%"PRIx64"",
                               p_policer_node->key.policer_id,p_port_node->port_id);
-        if(p_port_node->policer_id[type] != SAI_NULL_OBJECT_ID){
-            SAI_POLICER_LOG_TRACE("Removing existing policerid of type %d",type);
-            p_policer_node_old = sai_qos_policer_node_get(p_port_node->policer_id[type]);
 
-            if(p_policer_node_old != NULL){
-                std_dll_remove(&p_policer_node_old->port_dll_head[type],
-                               &p_port_node->policer_dll_glue[type]);
-            }
+        sai_rc = sai_qos_policer_port_bind(p_policer_node->key.policer_id,
+                                           p_port_node->port_id, type);
+        if(sai_rc != SAI_STATUS_SUCCESS){
+            return sai_rc;
+        }
 
+        if((p_port_node->policer_id[type] != SAI_NULL_OBJECT_ID) &&
+           (p_port_node->policer_id[type] != p_policer_node->key.policer_id)){
+            SAI_POLICER_LOG_TRACE("Removing existing policerid of type %d",type);
+            sai_qos_policer_port_unbind(p_port_node->policer_id[type],
+                                        p_port_node->port_id, type);
         }
-        std_dll_insertatback(&p_policer_node->port_dll_head[type],
-                             &p_port_node->policer_dll_glue[type]);
         p_port_node->policer_id[type] = p_policer_node->key.policer_id;
     }else {
         SAI_POLICER_LOG_TRACE("Remove policer 0x%"PRIx64" on port 0x%"PRIx64"",
                               p_policer_node->key.policer_id,p_port_node->port_id);
-        std_dll_remove(&p_policer_node->port_dll_head[type],
-                       &p_port_node->policer_dll_glue[type]);
+        sai_qos_policer_port_unbind(p_policer_node->key.policer_id,
+                                    p_port_node->port_id, type);
 
         p_port_node->policer_id[type] = SAI_NULL_OBJECT_ID;
     }
@@ -726,6 +1148,7 @@ sai_status_t sai_port_attr_storm_control_policer_set_internal
     uint_t type = 0;
     bool is_add = false;
     dn_sai_qos_policer_t *p_policer_node = NULL;
+    dn_sai_qos_policer_t *p_old_policer_node = NULL;
     dn_sai_qos_port_t *p_port_node = NULL;
     sai_status_t sai_rc =  SAI_STATUS_SUCCESS;
 
@@ -786,6 +1209,20 @@ sai_status_t sai_port_attr_storm_control_policer_set_internal
         sai_rc = sai_policer_port_storm_control_node_update(p_port_node,
                                                             p_policer_node,
                                                             type, is_add);
+        if(sai_rc != SAI_STATUS_SUCCESS){
+            SAI_POLICER_LOG_ERR("Policer port binding update failed, reverting NPU");
+            p_old_policer_node = sai_qos_policer_node_get(p_port_node->policer_id[type]);
+
+            if(p_old_policer_node != NULL){
+                sai_qos_policer_npu_api_get()->policer_port_set(p_port_node->port_id,
+                                                                p_old_policer_node,
+                                                                type, true);
+            }else {
+                sai_qos_policer_npu_api_get()->policer_port_set(p_port_node->port_id,
+                                                                p_policer_node,
+                                                                type, false);
+            }
+        }
     }
 
     return sai_rc;
@@ -18,6 +18,7 @@
 #include "saitypes.h"
 #include "sai_qos_util.h"
 #include "sai_qos_common.h"
+#include "sai_qos_api_utils.h"
 #include "sai_debug_utils.h"
 #include "std_type_defs.h"
 #include <inttypes.h>
@@ -35,7 +36,8 @@ void sai_qos_policer_dump_node(dn_sai_qos_policer_t *p_policer_node)
 {
     size_t count = 0;
     size_t type = 0;
-    dn_sai_qos_port_t *p_port_node = NULL;
+    uint_t slot = 0;
+    sai_object_id_t port_id = SAI_NULL_OBJECT_ID;
 
     SAI_DEBUG("Policer Id : 0x%"PRIx64" Policer mode: %d Meter_type: %d "
               "Color source : %d Cbs %lu Pbs %lu Cir %lu Pir %lu actioncount %d",
@@ -54,12 +56,14 @@ void sai_qos_policer_dump_node(dn_sai_qos_policer_t *p_policer_node)
     SAI_DEBUG("Policer applied on portlist:");
 
     for(type = 0; type < SAI_QOS_POLICER_TYPE_MAX; type ++){
-        p_port_node = sai_qos_port_node_from_policer_get(p_policer_node, type);
-
-        while(p_port_node != NULL){
-            SAI_DEBUG("Policer type %ld Portid: 0x%"PRIx64"",type, p_port_node->port_id);
-            p_port_node = sai_qos_next_port_node_from_policer_get(p_policer_node,
-                                                                  p_port_node, type);
+        slot = 0;
+        port_id = sai_qos_policer_port_next_get(p_policer_node->key.policer_id,
+                                                type, &slot);
+
+        while(port_id != SAI_NULL_OBJECT_ID){
+            SAI_DEBUG("Policer type %ld Portid: 0x%"PRIx64"",type, port_id);
+            port_id = sai_qos_policer_port_next_get(p_policer_node->key.policer_id,
+                                                    type, &slot);
         }
     }
 }
@@ -30,6 +30,7 @@
 #include "sai_qos_mem.h"
 #include "sai_common_infra.h"
 #include "sai_qos_port_util.h"
+#include "sai_id_allocator.h"
 
 #include "saistatus.h"
 
@@ -45,37 +46,34 @@ static const dn_sai_attribute_entry_t sai_port_pool_attr_table[] = {
     {SAI_PORT_POOL_ATTR_QOS_WRED_PROFILE_ID,   false, true,  true, true, true, true},
 };
 
-static dn_sai_id_gen_info_t port_pool_obj_gen_info;
+static sai_id_allocator_t port_pool_id_allocator;
 
-bool sai_is_port_pool_id_in_use(uint64_t obj_id)
+static sai_object_id_t sai_port_pool_id_create(void)
 {
-    sai_object_id_t port_pool_oid =
-        sai_uoid_create(SAI_OBJECT_TYPE_PORT_POOL,obj_id);
+    uint64_t id = 0;
 
-    if(sai_qos_port_pool_node_get_from_obj_id(port_pool_oid) != NULL) {
-        return true;
-    } else {
-        return false;
+    if(SAI_STATUS_SUCCESS ==
+            sai_id_allocator_alloc(&port_pool_id_allocator, &id)) {
+        return (sai_uoid_create(SAI_OBJECT_TYPE_PORT_POOL, id));
     }
+    return SAI_NULL_OBJECT_ID;
 }
 
-static sai_object_id_t sai_port_pool_id_create(void)
+static void sai_port_pool_id_release(sai_object_id_t port_pool_id)
 {
-    if(SAI_STATUS_SUCCESS ==
-            dn_sai_get_next_free_id(&port_pool_obj_gen_info)) {
-        return (sai_uoid_create(SAI_OBJECT_TYPE_PORT_POOL,
-                    port_pool_obj_gen_info.cur_id));
-    }
-    return SAI_NULL_OBJECT_ID;
+    sai_id_allocator_free(&port_pool_id_allocator,
+                          sai_uoid_npu_obj_id_get(port_pool_id));
 }
 
 void sai_qos_port_pool_oid_gen_init(void)
 {
-    port_pool_obj_gen_info.cur_id = 0;
-    port_pool_obj_gen_info.is_wrappped = false;
-    port_pool_obj_gen_info.mask = SAI_UOID_NPU_OBJ_ID_MASK;
-    port_pool_obj_gen_info.is_id_in_use = sai_is_port_pool_id_in_use;
+    if(SAI_STATUS_SUCCESS !=
+            sai_id_allocator_init(&port_pool_id_allocator, "port_pool",
+                                  SAI_ID_ALLOCATOR_MAX_IDS)) {
+        SAI_PORT_LOG_ERR("Port pool Id allocator init failed");
+    }
 }
+
 static sai_status_t sai_qos_port_node_insert_into_port_db (sai_object_id_t port_id,
                                                 dn_sai_qos_port_t *p_qos_port_node)
 {
@@ -1024,10 +1022,15 @@ sai_status_t sai_qos_port_create_port_pool(
     }
 
     port_pool_node.port_pool_id = sai_port_pool_id_create();
+    if(SAI_NULL_OBJECT_ID == port_pool_node.port_pool_id) {
+        SAI_PORT_LOG_ERR("Port pool id create failed");
+        return SAI_STATUS_INSUFFICIENT_RESOURCES;
+    }
 
     sai_rc = sai_qos_add_port_pool_node(&port_pool_node);
     if(sai_rc != SAI_STATUS_SUCCESS) {
         SAI_PORT_LOG_ERR("Port pool node insert failed, sai_rc %d", sai_rc);
+        sai_port_pool_id_release(port_pool_node.port_pool_id);
         return sai_rc;
     }
 
@@ -1042,11 +1045,13 @@ sai_status_t sai_qos_port_create_port_pool(
         }
     } else {
         SAI_PORT_LOG_ERR("Port pool 0x%"PRIx64" not found in DB.",port_pool_node.port_pool_id);
+        sai_port_pool_id_release(port_pool_node.port_pool_id);
         return SAI_STATUS_FAILURE;
     }
 
     if(sai_rc != SAI_STATUS_SUCCESS) {
         sai_qos_remove_port_pool_node(port_pool_node.port_pool_id);
+        sai_port_pool_id_release(port_pool_node.port_pool_id);
     } else {
         *port_pool_id = port_pool_node.port_pool_id;
     }
@@ -1085,6 +1090,7 @@ sai_status_t sai_qos_port_remove_port_pool(
             SAI_PORT_LOG_ERR("Port pool node remove failed, sai_rc %d", sai_rc);
             return sai_rc;
         }
+        sai_port_pool_id_release(port_pool_id);
     }
 
     return sai_rc;
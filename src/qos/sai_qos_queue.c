@@ -28,12 +28,14 @@
 #include "sai_switch_utils.h"
 #include "sai_common_infra.h"
 #include "sai_qos_buffer_util.h"
+#include "sai_api_latency.h"
 
 #include "saistatus.h"
 
 #include "std_assert.h"
 
 #include <string.h>
+#include <stdlib.h>
 #include <stdio.h>
 #include <inttypes.h>
 
@@ -713,8 +715,8 @@ static sai_status_t sai_qos_queue_remove (sai_object_id_t queue_id)
     return sai_rc;
 }
 
-static sai_status_t sai_qos_queue_attribute_set (sai_object_id_t queue_id,
-                                                 const sai_attribute_t *p_attr)
+static sai_status_t sai_qos_queue_attribute_set_internal (sai_object_id_t queue_id,
+                                                          const sai_attribute_t *p_attr)
 {
     sai_status_t                sai_rc = SAI_STATUS_SUCCESS;
     dn_sai_qos_queue_t          *p_queue_node = NULL;
@@ -732,8 +734,6 @@ static sai_status_t sai_qos_queue_attribute_set (sai_object_id_t queue_id,
         return SAI_STATUS_INVALID_OBJECT_TYPE;
     }
 
-    sai_qos_lock ();
-
     do {
         p_queue_node = sai_qos_queue_node_get (queue_id);
 
@@ -796,9 +796,10 @@ static sai_status_t sai_qos_queue_attribute_set (sai_object_id_t queue_id,
                 sai_qos_wred_link_apply_cache(queue_id);
                 break;
             default:
-                sai_rc = sai_queue_npu_api_get()->queue_attribute_set(p_queue_node,
-                                                                      attr_count,
-                                                                      p_attr);
+                SAI_API_LATENCY_NPU_CALL(sai_rc,
+                        sai_queue_npu_api_get()->queue_attribute_set(p_queue_node,
+                                                                     attr_count,
+                                                                     p_attr));
                 break;
         }
 
@@ -812,8 +813,16 @@ static sai_status_t sai_qos_queue_attribute_set (sai_object_id_t queue_id,
 
     } while (0);
 
-    sai_qos_unlock ();
+    return sai_rc;
+}
 
+static sai_status_t sai_qos_queue_attribute_set (sai_object_id_t queue_id,
+                                                 const sai_attribute_t *p_attr)
+{
+    sai_status_t         sai_rc = SAI_STATUS_SUCCESS;
+    sai_qos_lock ();
+    sai_rc = sai_qos_queue_attribute_set_internal (queue_id, p_attr);
+    sai_qos_unlock();
     return sai_rc;
 }
 
@@ -859,9 +868,10 @@ static sai_status_t sai_qos_queue_attribute_get (sai_object_id_t queue_id,
             break;
         }
 
-        sai_rc = sai_queue_npu_api_get()->queue_attribute_get (p_queue_node,
-                                                               attr_count,
-                                                               p_attr_list);
+        SAI_API_LATENCY_NPU_CALL(sai_rc,
+                sai_queue_npu_api_get()->queue_attribute_get (p_queue_node,
+                                                              attr_count,
+                                                              p_attr_list));
         if (sai_rc != SAI_STATUS_SUCCESS) {
             SAI_QUEUE_LOG_ERR ("Failed to get Queue Attributes from "
                                "NPU, Error: %d.", sai_rc);
@@ -1125,6 +1135,7 @@ static sai_status_t sai_qos_queue_stats_get (sai_object_id_t queue_id,
 
     sai_status_t                sai_rc = SAI_STATUS_SUCCESS;
     dn_sai_qos_queue_t          *p_queue_node = NULL;
+    uint32_t                    counter_idx = 0;
 
     if (counter_ids == NULL) {
         SAI_QUEUE_LOG_ERR("Invalid parameter counter_ids is NULL");
@@ -1168,6 +1179,13 @@ static sai_status_t sai_qos_queue_stats_get (sai_object_id_t queue_id,
 
     if (sai_rc != SAI_STATUS_SUCCESS) {
         SAI_QUEUE_LOG_ERR ("Failed to get Queue stats NPU, Error: %d.", sai_rc);
+    } else {
+        /* Watermark counter is cleared by the watermark poller */
+        for (counter_idx = 0; counter_idx < number_of_counters; counter_idx++) {
+            if (counter_ids[counter_idx] == SAI_QUEUE_STAT_WATERMARK_BYTES) {
+                sai_qos_watermark_peak_apply (queue_id, &counters[counter_idx]);
+            }
+        }
     }
 
     sai_qos_unlock ();
@@ -1182,6 +1200,11 @@ static sai_status_t sai_qos_queue_stats_clear (sai_object_id_t queue_id,
 
     sai_status_t                sai_rc = SAI_STATUS_SUCCESS;
     dn_sai_qos_queue_t          *p_queue_node = NULL;
+    const sai_queue_stat_t      *npu_counter_ids = counter_ids;
+    sai_queue_stat_t            *p_filtered_ids = NULL;
+    uint32_t                    npu_counter_count = number_of_counters;
+    uint32_t                    counter_idx = 0;
+    bool                        poller_owned = false;
 
     if (counter_ids == NULL) {
         SAI_QUEUE_LOG_ERR("Invalid parameter counter_ids is NULL");
@@ -1215,8 +1238,35 @@ static sai_status_t sai_qos_queue_stats_clear (sai_object_id_t queue_id,
 
     }
 
-    sai_rc = sai_queue_npu_api_get()->queue_stats_clear (p_queue_node, counter_ids,
-                                                         number_of_counters);
+    for (counter_idx = 0; counter_idx < number_of_counters; counter_idx++) {
+        if (counter_ids[counter_idx] == SAI_QUEUE_STAT_WATERMARK_BYTES) {
+            poller_owned = sai_qos_watermark_peak_clear (queue_id);
+        }
+    }
+
+    /* Watermark counter is left to the watermark poller while it runs */
+    if (poller_owned) {
+        p_filtered_ids = (sai_queue_stat_t *) calloc (number_of_counters,
+                                                      sizeof (sai_queue_stat_t));
+        if (p_filtered_ids == NULL) {
+            SAI_QUEUE_LOG_ERR ("Failed to allocate Queue stats clear list.");
+            sai_qos_unlock ();
+            return SAI_STATUS_NO_MEMORY;
+        }
+
+        npu_counter_count = 0;
+        for (counter_idx = 0; counter_idx < number_of_counters; counter_idx++) {
+            if (counter_ids[counter_idx] != SAI_QUEUE_STAT_WATERMARK_BYTES) {
+                p_filtered_ids[npu_counter_count++] = counter_ids[counter_idx];
+            }
+        }
+        npu_counter_ids = p_filtered_ids;
+    }
+
+    if (npu_counter_count != 0) {
+        sai_rc = sai_queue_npu_api_get()->queue_stats_clear (p_queue_node, npu_counter_ids,
+                                                             npu_counter_count);
+    }
 
     if (sai_rc != SAI_STATUS_SUCCESS) {
         SAI_QUEUE_LOG_ERR ("Failed to clear Queue stats NPU, Error: %d.", sai_rc);
@@ -1224,9 +1274,44 @@ static sai_status_t sai_qos_queue_stats_clear (sai_object_id_t queue_id,
 
     sai_qos_unlock ();
 
+    free (p_filtered_ids);
+
     return sai_rc;
 }
 
+sai_status_t sai_qos_queue_bulk_create (sai_object_id_t switch_id,
+                                        uint32_t object_count,
+                                        const uint32_t *attr_count,
+                                        const sai_attribute_t **attr_list,
+                                        dn_sai_qos_bulk_op_error_mode_t mode,
+                                        sai_object_id_t *object_id,
+                                        sai_status_t *object_statuses)
+{
+    return sai_qos_bulk_object_create (sai_qos_queue_create_internal, switch_id,
+                                       object_count, attr_count, attr_list,
+                                       mode, object_id, object_statuses);
+}
+
+sai_status_t sai_qos_queue_bulk_remove (uint32_t object_count,
+                                        const sai_object_id_t *object_id,
+                                        dn_sai_qos_bulk_op_error_mode_t mode,
+                                        sai_status_t *object_statuses)
+{
+    return sai_qos_bulk_object_remove (sai_qos_queue_remove_internal, object_count,
+                                       object_id, mode, object_statuses);
+}
+
+sai_status_t sai_qos_queue_bulk_set (uint32_t object_count,
+                                     const sai_object_id_t *object_id,
+                                     const sai_attribute_t *attr_list,
+                                     dn_sai_qos_bulk_op_error_mode_t mode,
+                                     sai_status_t *object_statuses)
+{
+    return sai_qos_bulk_object_set (sai_qos_queue_attribute_set_internal, object_count,
+                                    object_id, attr_list, mode,
+                                    object_statuses);
+}
+
 static sai_queue_api_t sai_qos_queue_method_table = {
     sai_qos_queue_create,
     sai_qos_queue_remove,
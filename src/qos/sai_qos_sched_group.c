@@ -751,8 +751,8 @@ static sai_status_t sai_qos_sched_group_modify_parent (
     return sai_rc;
 }
 
-static sai_status_t sai_qos_sched_group_attribute_set (sai_object_id_t sg_id,
-                                                       const sai_attribute_t *p_attr)
+static sai_status_t sai_qos_sched_group_attribute_set_internal (sai_object_id_t sg_id,
+                                                                const sai_attribute_t *p_attr)
 {
     sai_status_t                sai_rc = SAI_STATUS_SUCCESS;
     dn_sai_qos_sched_group_t    *p_sg_node = NULL;
@@ -770,8 +770,6 @@ static sai_status_t sai_qos_sched_group_attribute_set (sai_object_id_t sg_id,
         return SAI_STATUS_INVALID_OBJECT_TYPE;
     }
 
-    sai_qos_lock ();
-
     do {
         p_sg_node = sai_qos_sched_group_node_get (sg_id);
 
@@ -833,8 +831,17 @@ static sai_status_t sai_qos_sched_group_attribute_set (sai_object_id_t sg_id,
 
     } while (0);
 
-    sai_qos_unlock ();
+    return sai_rc;
+}
+
+static sai_status_t sai_qos_sched_group_attribute_set (sai_object_id_t sg_id,
+                                                       const sai_attribute_t *p_attr)
+{
+    sai_status_t sai_rc = SAI_STATUS_SUCCESS;
 
+    sai_qos_lock();
+    sai_rc = sai_qos_sched_group_attribute_set_internal(sg_id, p_attr);
+    sai_qos_unlock();
     return sai_rc;
 }
 
@@ -1130,6 +1137,47 @@ static sai_status_t sai_qos_sched_group_remove_api (sai_object_id_t sg_id)
     return sai_rc;
 }
 
+sai_status_t sai_qos_sched_group_bulk_create (sai_object_id_t switch_id,
+                                              uint32_t object_count,
+                                              const uint32_t *attr_count,
+                                              const sai_attribute_t **attr_list,
+                                              dn_sai_qos_bulk_op_error_mode_t mode,
+                                              sai_object_id_t *object_id,
+                                              sai_status_t *object_statuses)
+{
+    if (sai_qos_is_fixed_hierarchy_qos () == true) {
+        return SAI_STATUS_NOT_SUPPORTED;
+    }
+
+    return sai_qos_bulk_object_create (sai_qos_sched_group_create_internal, switch_id,
+                                       object_count, attr_count, attr_list,
+                                       mode, object_id, object_statuses);
+}
+
+sai_status_t sai_qos_sched_group_bulk_remove (uint32_t object_count,
+                                              const sai_object_id_t *object_id,
+                                              dn_sai_qos_bulk_op_error_mode_t mode,
+                                              sai_status_t *object_statuses)
+{
+    if (sai_qos_is_fixed_hierarchy_qos () == true) {
+        return SAI_STATUS_NOT_SUPPORTED;
+    }
+
+    return sai_qos_bulk_object_remove (sai_qos_sched_group_remove_internal, object_count,
+                                       object_id, mode, object_statuses);
+}
+
+sai_status_t sai_qos_sched_group_bulk_set (uint32_t object_count,
+                                           const sai_object_id_t *object_id,
+                                           const sai_attribute_t *attr_list,
+                                           dn_sai_qos_bulk_op_error_mode_t mode,
+                                           sai_status_t *object_statuses)
+{
+    return sai_qos_bulk_object_set (sai_qos_sched_group_attribute_set_internal, object_count,
+                                    object_id, attr_list, mode,
+                                    object_statuses);
+}
+
 static sai_scheduler_group_api_t sai_qos_sched_group_method_table = {
     sai_qos_sched_group_create_api,
     sai_qos_sched_group_remove_api,
@@ -29,12 +29,14 @@
 #include "sai_common_utils.h"
 #include "sai_gen_utils.h"
 #include "sai_common_infra.h"
+#include "sai_api_latency.h"
 
 #include "saistatus.h"
 #include "saitypes.h"
 
 #include "std_assert.h"
 
+#include <stdlib.h>
 #include <string.h>
 #include <inttypes.h>
 
@@ -308,8 +310,9 @@ static sai_status_t sai_qos_scheduler_create_internal (sai_object_id_t *sched_id
 
         sai_qos_scheduler_attr_set (p_sched_node, attr_count, attr_list);
 
-        sai_rc = sai_scheduler_npu_api_get()->scheduler_create (p_sched_node,
-                                         &p_sched_node->key.scheduler_id);
+        SAI_API_LATENCY_NPU_CALL(sai_rc,
+                sai_scheduler_npu_api_get()->scheduler_create (p_sched_node,
+                                         &p_sched_node->key.scheduler_id));
 
         if (sai_rc != SAI_STATUS_SUCCESS) {
             SAI_SCHED_LOG_ERR ("Scheduler creation failed in NPU.");
@@ -381,14 +384,16 @@ static sai_status_t sai_qos_scheduler_remove_internal (sai_object_id_t sched_id)
             break;
         }
 
-        if (sai_qos_scheduler_is_in_use (p_sched_node)) {
+        if ((sai_qos_scheduler_is_in_use (p_sched_node)) ||
+            (sai_qos_scheduler_is_reapply_in_progress (sched_id))) {
             SAI_SCHED_LOG_ERR ("Scheduler 0x%"PRIx64" can't be deleted, "
                                "It is in use.", sched_id);
             sai_rc = SAI_STATUS_OBJECT_IN_USE;
             break;
         }
 
-        sai_rc = sai_scheduler_npu_api_get()->scheduler_remove (p_sched_node);
+        SAI_API_LATENCY_NPU_CALL(sai_rc,
+                sai_scheduler_npu_api_get()->scheduler_remove (p_sched_node));
 
         if (sai_rc != SAI_STATUS_SUCCESS) {
             SAI_SCHED_LOG_ERR ("Scheduler 0x%"PRIx64" deletion failed in NPU.",
@@ -424,18 +429,89 @@ static sai_status_t sai_qos_scheduler_remove (sai_object_id_t sched_id)
     return sai_rc;
 }
 
-static sai_status_t sai_qos_scheduler_attribute_set (sai_object_id_t sched_id,
-                                                     const sai_attribute_t *p_attr)
+/* Fills the attribute values from the scheduler node, used to revert a set */
+static void sai_qos_scheduler_attr_value_fill (dn_sai_qos_scheduler_t *p_sched_node,
+                                               uint_t attr_count,
+                                               sai_attribute_t *p_attr_list)
+{
+    sai_attribute_t  *p_attr = NULL;
+    uint_t            list_index = 0;
+
+    STD_ASSERT(p_sched_node != NULL);
+
+    for (list_index = 0, p_attr = p_attr_list; (list_index < attr_count);
+         ++list_index, ++p_attr) {
+
+        switch (p_attr->id)
+        {
+            case SAI_SCHEDULER_ATTR_SCHEDULING_TYPE:
+                p_attr->value.s32 = p_sched_node->sched_algo;
+                break;
+
+            case SAI_SCHEDULER_ATTR_SCHEDULING_WEIGHT:
+                p_attr->value.u8 = p_sched_node->weight;
+                break;
+
+            case SAI_SCHEDULER_ATTR_METER_TYPE:
+                p_attr->value.s32 = p_sched_node->shape_type;
+                break;
+
+            case SAI_SCHEDULER_ATTR_MIN_BANDWIDTH_RATE:
+                p_attr->value.u64 = p_sched_node->min_bandwidth_rate;
+                break;
+
+            case SAI_SCHEDULER_ATTR_MIN_BANDWIDTH_BURST_RATE:
+                p_attr->value.u64 = p_sched_node->min_bandwidth_burst;
+                break;
+
+            case SAI_SCHEDULER_ATTR_MAX_BANDWIDTH_RATE:
+                p_attr->value.u64 = p_sched_node->max_bandwidth_rate;
+                break;
+
+            case SAI_SCHEDULER_ATTR_MAX_BANDWIDTH_BURST_RATE:
+                p_attr->value.u64 = p_sched_node->max_bandwidth_burst;
+                break;
+
+            default:
+                break;
+        }
+    }
+}
+
+static bool sai_qos_scheduler_is_duplicate_set_list (dn_sai_qos_scheduler_t *p_sched_node,
+                                                     uint_t attr_count,
+                                                     const sai_attribute_t *p_attr_list)
+{
+    uint_t  list_index = 0;
+
+    for (list_index = 0; list_index < attr_count; list_index++) {
+        if (! sai_qos_scheduler_is_duplicate_set (p_sched_node,
+                                                  &p_attr_list [list_index])) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/*
+ * Called with the QoS lock held. The reapply on the bound objects releases
+ * the lock between chunks only when lock_release is set, which only the top
+ * level set does. Callers holding the lock across several sets pass false.
+ */
+static sai_status_t sai_qos_scheduler_attributes_set_internal (
+                                              sai_object_id_t sched_id,
+                                              uint_t attr_count,
+                                              const sai_attribute_t *p_attr_list,
+                                              bool lock_release)
 {
     sai_status_t               sai_rc = SAI_STATUS_SUCCESS;
     dn_sai_qos_scheduler_t    *p_sched_node = NULL;
-    dn_sai_qos_scheduler_t     new_sched_node;
-    const uint_t               attr_count = 1;
-
-    STD_ASSERT (p_attr != NULL);
+    dn_sai_qos_scheduler_t     old_sched_node;
+    sai_attribute_t           *p_revert_list = NULL;
 
-    SAI_SCHED_LOG_TRACE ("Setting Attribute ID %d on Scheduler 0x%"PRIx64".",
-                          p_attr->id, sched_id);
+    SAI_SCHED_LOG_TRACE ("Setting %d Attributes on Scheduler 0x%"PRIx64".",
+                          attr_count, sched_id);
 
     if (! sai_is_obj_id_scheduler (sched_id)) {
         SAI_SCHED_LOG_ERR ("%"PRIx64" is not a valid Scheduler obj id.",
@@ -444,8 +520,6 @@ static sai_status_t sai_qos_scheduler_attribute_set (sai_object_id_t sched_id,
         return SAI_STATUS_INVALID_OBJECT_TYPE;
     }
 
-    sai_qos_lock ();
-
     do {
         p_sched_node = sai_qos_scheduler_node_get (sched_id);
 
@@ -457,7 +531,7 @@ static sai_status_t sai_qos_scheduler_attribute_set (sai_object_id_t sched_id,
             break;
         }
 
-        sai_rc = sai_qos_scheduler_attributes_validate (attr_count, p_attr,
+        sai_rc = sai_qos_scheduler_attributes_validate (attr_count, p_attr_list,
                                                         SAI_OP_SET);
 
         if (sai_rc != SAI_STATUS_SUCCESS) {
@@ -466,34 +540,107 @@ static sai_status_t sai_qos_scheduler_attribute_set (sai_object_id_t sched_id,
             break;
         }
 
-        if (sai_qos_scheduler_is_duplicate_set (p_sched_node, p_attr)) {
-            SAI_SCHED_LOG_TRACE ("Duplicate set value for Attribute ID %d.",
-                                 p_attr->id);
+        if (sai_qos_scheduler_is_reapply_in_progress (sched_id)) {
+            SAI_SCHED_LOG_ERR ("Scheduler 0x%"PRIx64" reapply is in progress.",
+                               sched_id);
+            sai_rc = SAI_STATUS_OBJECT_IN_USE;
             break;
         }
 
-        sai_rc = sai_scheduler_npu_api_get()->scheduler_attribute_set(p_sched_node,
-                                                                      attr_count,
-                                                                      p_attr);
+        if (sai_qos_scheduler_is_duplicate_set_list (p_sched_node, attr_count,
+                                                     p_attr_list)) {
+            SAI_SCHED_LOG_TRACE ("Duplicate set value for all attributes.");
+            break;
+        }
+
+        p_revert_list = (sai_attribute_t *) calloc (attr_count, sizeof (sai_attribute_t));
+
+        if (p_revert_list == NULL) {
+            SAI_SCHED_LOG_ERR ("Failed to allocate Scheduler revert attributes.");
+            sai_rc = SAI_STATUS_NO_MEMORY;
+            break;
+        }
+
+        memcpy (p_revert_list, p_attr_list, attr_count * sizeof (sai_attribute_t));
+        sai_qos_scheduler_attr_value_fill (p_sched_node, attr_count, p_revert_list);
+
+        SAI_API_LATENCY_NPU_CALL(sai_rc,
+                sai_scheduler_npu_api_get()->scheduler_attribute_set(p_sched_node,
+                                                                     attr_count,
+                                                                     p_attr_list));
         if (sai_rc != SAI_STATUS_SUCCESS) {
-            SAI_SCHED_LOG_ERR ("Failed to set Scheduler Attribute ID: %d "
-                               "in NPU, Error: %d.", p_attr->id, sai_rc);
+            SAI_SCHED_LOG_ERR ("Failed to set %d Scheduler Attributes "
+                               "in NPU, Error: %d.", attr_count, sai_rc);
             break;
         }
 
-        if (! sai_scheduler_npu_api_get()->scheduler_is_hw_object()) {
-            memcpy(&new_sched_node, p_sched_node, sizeof (dn_sai_qos_scheduler_t));
-            sai_qos_scheduler_attr_set (&new_sched_node, attr_count, p_attr);
-            sai_rc = sai_qos_scheduler_reapply (p_sched_node, &new_sched_node);
+        memcpy (&old_sched_node, p_sched_node, sizeof (dn_sai_qos_scheduler_t));
+
+        /* Objects bound while the reapply releases the lock pick up
+         * the new configuration from the node. */
+        sai_qos_scheduler_attr_set (p_sched_node, attr_count, p_attr_list);
+
+        if (sai_scheduler_npu_api_get()->scheduler_is_hw_object()) {
+            break;
+        }
+
+        sai_rc = sai_qos_scheduler_reapply_chunked (p_sched_node, &old_sched_node,
+                                                    lock_release);
+
+        if (sai_rc != SAI_STATUS_SUCCESS) {
+            SAI_SCHED_LOG_ERR ("Failed to reapply Scheduler 0x%"PRIx64", "
+                               "restoring attributes.", sched_id);
+
+            sai_qos_scheduler_attr_set (p_sched_node, attr_count, p_revert_list);
+
+            if (sai_scheduler_npu_api_get()->scheduler_attribute_set(p_sched_node,
+                                                                     attr_count,
+                                                                     p_revert_list)
+                != SAI_STATUS_SUCCESS) {
+                SAI_SCHED_LOG_ERR ("Failed to restore Scheduler 0x%"PRIx64" "
+                                   "attributes in NPU.", sched_id);
+            }
         }
-        sai_qos_scheduler_attr_set (p_sched_node, attr_count, p_attr);
     } while (0);
 
+    free (p_revert_list);
+
+    return sai_rc;
+}
+
+sai_status_t sai_qos_scheduler_attributes_set (sai_object_id_t sched_id,
+                                               uint_t attr_count,
+                                               const sai_attribute_t *p_attr_list)
+{
+    sai_status_t sai_rc = SAI_STATUS_SUCCESS;
+
+    sai_qos_lock ();
+
+    sai_rc = sai_qos_scheduler_attributes_set_internal (sched_id, attr_count,
+                                                        p_attr_list, true);
+
     sai_qos_unlock ();
 
     return sai_rc;
 }
 
+static sai_status_t sai_qos_scheduler_attribute_set_internal (sai_object_id_t sched_id,
+                                                              const sai_attribute_t *p_attr)
+{
+    STD_ASSERT (p_attr != NULL);
+
+    /* Bulk set holds the QoS lock across objects, keep it held */
+    return sai_qos_scheduler_attributes_set_internal (sched_id, 1, p_attr, false);
+}
+
+static sai_status_t sai_qos_scheduler_attribute_set (sai_object_id_t sched_id,
+                                                     const sai_attribute_t *p_attr)
+{
+    STD_ASSERT (p_attr != NULL);
+
+    return sai_qos_scheduler_attributes_set (sched_id, 1, p_attr);
+}
+
 static sai_status_t sai_qos_scheduler_attribute_get (sai_object_id_t sched_id,
                                                      uint32_t attr_count,
                                                      sai_attribute_t *p_attr_list)
@@ -534,9 +681,10 @@ static sai_status_t sai_qos_scheduler_attribute_get (sai_object_id_t sched_id,
             break;
         }
 
-        sai_rc = sai_scheduler_npu_api_get()->scheduler_attribute_get (p_sched_node,
-                                                                       attr_count,
-                                                                       p_attr_list);
+        SAI_API_LATENCY_NPU_CALL(sai_rc,
+                sai_scheduler_npu_api_get()->scheduler_attribute_get (p_sched_node,
+                                                                      attr_count,
+                                                                      p_attr_list));
         if (sai_rc != SAI_STATUS_SUCCESS) {
             SAI_SCHED_LOG_ERR ("Failed to get Scheduler Attributes from "
                                "NPU, Error: %d.", sai_rc);
@@ -978,6 +1126,39 @@ sai_status_t sai_qos_remove_default_scheduler()
 }
 
 
+sai_status_t sai_qos_scheduler_bulk_create (sai_object_id_t switch_id,
+                                            uint32_t object_count,
+                                            const uint32_t *attr_count,
+                                            const sai_attribute_t **attr_list,
+                                            dn_sai_qos_bulk_op_error_mode_t mode,
+                                            sai_object_id_t *object_id,
+                                            sai_status_t *object_statuses)
+{
+    return sai_qos_bulk_object_create (sai_qos_scheduler_create_internal, switch_id,
+                                       object_count, attr_count, attr_list,
+                                       mode, object_id, object_statuses);
+}
+
+sai_status_t sai_qos_scheduler_bulk_remove (uint32_t object_count,
+                                            const sai_object_id_t *object_id,
+                                            dn_sai_qos_bulk_op_error_mode_t mode,
+                                            sai_status_t *object_statuses)
+{
+    return sai_qos_bulk_object_remove (sai_qos_scheduler_remove_internal, object_count,
+                                       object_id, mode, object_statuses);
+}
+
+sai_status_t sai_qos_scheduler_bulk_set (uint32_t object_count,
+                                         const sai_object_id_t *object_id,
+                                         const sai_attribute_t *attr_list,
+                                         dn_sai_qos_bulk_op_error_mode_t mode,
+                                         sai_status_t *object_statuses)
+{
+    return sai_qos_bulk_object_set (sai_qos_scheduler_attribute_set_internal, object_count,
+                                    object_id, attr_list, mode,
+                                    object_statuses);
+}
+
 static sai_scheduler_api_t sai_qos_scheduler_method_table = {
     sai_qos_scheduler_create,
     sai_qos_scheduler_remove,
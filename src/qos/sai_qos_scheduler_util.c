@@ -31,217 +31,339 @@
 
 #include "std_assert.h"
 
+#include <stdlib.h>
+#include <string.h>
 #include <inttypes.h>
+#include <sched.h>
 
-/* Input *p_count != 0 in case of revert == true */
-static sai_status_t sai_qos_scheduler_queue_reapply (
-                                      dn_sai_qos_scheduler_t *p_old_sched_node,
-                                      dn_sai_qos_scheduler_t *p_new_sched_node,
-                                      uint_t *p_count, bool revert)
-{
-    sai_status_t            sai_rc = SAI_STATUS_SUCCESS;
-    dn_sai_qos_queue_t     *p_queue_node = NULL;
-    uint_t                  count = 0;
-    dn_sai_qos_scheduler_t *p_sched_node = NULL;
+/* Bound objects programmed before the QoS lock is released for a while */
+#define SAI_QOS_SCHED_REAPPLY_CHUNK_SIZE       64
 
-    STD_ASSERT (p_old_sched_node != NULL);
-    STD_ASSERT (p_new_sched_node != NULL);
-    STD_ASSERT (p_count != NULL);
+/* Schedulers that can be reapplied chunk wise at the same time */
+#define SAI_QOS_SCHED_REAPPLY_MAX_IN_PROGRESS  16
 
-    /* Only Original scheduler node will have glue pointers.
-     * Apply case Original - p_old_sched_node
-     * Revert case Original - p_new_sched_node */
-    p_sched_node = (revert ? p_new_sched_node : p_old_sched_node);
+/* Schedulers whose reapply has released the QoS lock between chunks */
+static sai_object_id_t sai_qos_sched_reapply_in_progress [SAI_QOS_SCHED_REAPPLY_MAX_IN_PROGRESS];
 
-    for (p_queue_node = sai_qos_scheduler_get_first_queue (p_sched_node);
-        (p_queue_node != NULL); p_queue_node =
-         sai_qos_scheduler_get_next_queue (p_sched_node, p_queue_node)) {
+bool sai_qos_scheduler_is_reapply_in_progress (sai_object_id_t sched_id)
+{
+    uint_t  index = 0;
 
-        if (revert && (count >= *p_count))
-            break;
+    for (index = 0; index < SAI_QOS_SCHED_REAPPLY_MAX_IN_PROGRESS; index++) {
+        if (sai_qos_sched_reapply_in_progress [index] == sched_id) {
+            return true;
+        }
+    }
 
-        SAI_SCHED_LOG_TRACE ("Reapplying Scheduler 0x%"PRIx64" on "
-                             "Queue 0x%"PRIx64"", p_old_sched_node->key.scheduler_id,
-                             p_queue_node->key.queue_id);
-        sai_rc = sai_scheduler_npu_api_get()->scheduler_set (p_queue_node->key.queue_id,
-                                                             p_old_sched_node,
-                                                             p_new_sched_node);
-        if (sai_rc != SAI_STATUS_SUCCESS) {
-            SAI_SCHED_LOG_ERR("Scheduler 0x%"PRIx64" reapply on queue 0x%"PRIx64" "
-                              "failed with err %d", p_old_sched_node->key.scheduler_id,
-                              p_queue_node->key.queue_id, sai_rc);
-            break;
+    return false;
+}
+
+static bool sai_qos_scheduler_reapply_in_progress_mark (sai_object_id_t sched_id)
+{
+    uint_t  index = 0;
+
+    for (index = 0; index < SAI_QOS_SCHED_REAPPLY_MAX_IN_PROGRESS; index++) {
+        if (sai_qos_sched_reapply_in_progress [index] == SAI_NULL_OBJECT_ID) {
+            sai_qos_sched_reapply_in_progress [index] = sched_id;
+            return true;
         }
-        count++;
     }
-    *p_count = count;
 
-    return sai_rc;
+    return false;
 }
 
-/* Input *p_count != 0 in case of revert == true */
-static sai_status_t sai_qos_scheduler_sched_group_reapply (
-                                      dn_sai_qos_scheduler_t *p_old_sched_node,
-                                      dn_sai_qos_scheduler_t *p_new_sched_node,
-                                      uint_t *p_count, bool revert)
+static void sai_qos_scheduler_reapply_in_progress_clear (sai_object_id_t sched_id)
+{
+    uint_t  index = 0;
+
+    for (index = 0; index < SAI_QOS_SCHED_REAPPLY_MAX_IN_PROGRESS; index++) {
+        if (sai_qos_sched_reapply_in_progress [index] == sched_id) {
+            sai_qos_sched_reapply_in_progress [index] = SAI_NULL_OBJECT_ID;
+        }
+    }
+}
+
+static int sai_qos_scheduler_obj_id_cmp (const void *p_left, const void *p_right)
 {
-    sai_status_t                sai_rc = SAI_STATUS_SUCCESS;
-    dn_sai_qos_sched_group_t   *p_sg_node = NULL;
-    uint_t                      count = 0;
-    dn_sai_qos_scheduler_t     *p_sched_node = NULL;
+    sai_object_id_t left = *(const sai_object_id_t *) p_left;
+    sai_object_id_t right = *(const sai_object_id_t *) p_right;
+
+    return ((left > right) - (left < right));
+}
 
-    STD_ASSERT (p_old_sched_node != NULL);
-    STD_ASSERT (p_new_sched_node != NULL);
+/*
+ * Collects the queues, scheduler groups and ports bound to the scheduler
+ * in a single walk, in the order they are reapplied.
+ * Caller frees *p_obj_list.
+ */
+static sai_status_t sai_qos_scheduler_bound_obj_list_get (
+                                      dn_sai_qos_scheduler_t *p_sched_node,
+                                      sai_object_id_t **p_obj_list,
+                                      uint_t *p_count)
+{
+    dn_sai_qos_queue_t        *p_queue_node = NULL;
+    dn_sai_qos_sched_group_t  *p_sg_node = NULL;
+    dn_sai_qos_port_t         *p_qos_port_node = NULL;
+    sai_object_id_t           *obj_list = NULL;
+    uint_t                     count = 0;
+    uint_t                     index = 0;
+
+    STD_ASSERT (p_sched_node != NULL);
+    STD_ASSERT (p_obj_list != NULL);
     STD_ASSERT (p_count != NULL);
 
-    /* Only Original scheduler node will have glue pointers.
-     * Apply case Original - p_old_sched_node
-     * Revert case Original - p_new_sched_node */
-    p_sched_node = (revert ? p_new_sched_node : p_old_sched_node);
+    *p_obj_list = NULL;
+    *p_count = 0;
 
+    for (p_queue_node = sai_qos_scheduler_get_first_queue (p_sched_node);
+         (p_queue_node != NULL); p_queue_node =
+         sai_qos_scheduler_get_next_queue (p_sched_node, p_queue_node)) {
+        count++;
+    }
 
     for (p_sg_node = sai_qos_scheduler_get_first_sched_group (p_sched_node);
-        (p_sg_node != NULL) ; p_sg_node =
+         (p_sg_node != NULL); p_sg_node =
          sai_qos_scheduler_get_next_sched_group (p_sched_node, p_sg_node)) {
+        count++;
+    }
 
-        if (revert && (count >= *p_count))
-            break;
+    for (p_qos_port_node = sai_qos_scheduler_get_first_port (p_sched_node);
+         (p_qos_port_node != NULL); p_qos_port_node =
+         sai_qos_scheduler_get_next_port (p_sched_node, p_qos_port_node)) {
+        count++;
+    }
 
-        SAI_SCHED_LOG_TRACE ("Reapplying Scheduler 0x%"PRIx64" on SG 0x%"PRIx64"",
-                             p_old_sched_node->key.scheduler_id,
-                             p_sg_node->key.sched_group_id);
-        sai_rc = sai_scheduler_npu_api_get()->scheduler_set (p_sg_node->key.sched_group_id,
-                                                             p_old_sched_node,
-                                                             p_new_sched_node);
-        if (sai_rc != SAI_STATUS_SUCCESS) {
-            SAI_SCHED_LOG_ERR("Scheduler 0x%"PRIx64" reapply on SG 0x%"PRIx64" "
-                              "failed with err %d", p_old_sched_node->key.scheduler_id,
-                              p_sg_node->key.sched_group_id, sai_rc);
-            break;
+    if (count == 0) {
+        return SAI_STATUS_SUCCESS;
+    }
 
-        }
-        count++;
+    obj_list = (sai_object_id_t *) calloc (count, sizeof (sai_object_id_t));
+
+    if (obj_list == NULL) {
+        SAI_SCHED_LOG_ERR ("Failed to allocate bound object list of size %d "
+                           "for Scheduler 0x%"PRIx64".", count,
+                           p_sched_node->key.scheduler_id);
+        return SAI_STATUS_NO_MEMORY;
+    }
+
+    for (p_queue_node = sai_qos_scheduler_get_first_queue (p_sched_node);
+         (p_queue_node != NULL); p_queue_node =
+         sai_qos_scheduler_get_next_queue (p_sched_node, p_queue_node)) {
+        obj_list [index++] = p_queue_node->key.queue_id;
+    }
+
+    for (p_sg_node = sai_qos_scheduler_get_first_sched_group (p_sched_node);
+         (p_sg_node != NULL); p_sg_node =
+         sai_qos_scheduler_get_next_sched_group (p_sched_node, p_sg_node)) {
+        obj_list [index++] = p_sg_node->key.sched_group_id;
+    }
+
+    for (p_qos_port_node = sai_qos_scheduler_get_first_port (p_sched_node);
+         (p_qos_port_node != NULL); p_qos_port_node =
+         sai_qos_scheduler_get_next_port (p_sched_node, p_qos_port_node)) {
+        obj_list [index++] = p_qos_port_node->port_id;
     }
+
+    *p_obj_list = obj_list;
     *p_count = count;
 
-    return sai_rc;
+    return SAI_STATUS_SUCCESS;
 }
 
-/* Input *p_count != 0 in case of revert == true */
-static sai_status_t sai_qos_scheduler_port_reapply (
-                                      dn_sai_qos_scheduler_t *p_old_sched_node,
-                                      dn_sai_qos_scheduler_t *p_new_sched_node,
-                                      uint_t *p_count, bool revert)
+/* Objects may get unbound while the QoS lock is released between chunks */
+static bool sai_qos_scheduler_is_obj_bound (sai_object_id_t sched_id,
+                                            sai_object_id_t obj_id)
 {
-    sai_status_t            sai_rc = SAI_STATUS_SUCCESS;
-    dn_sai_qos_port_t      *p_qos_port_node = NULL;
-    uint_t                  count = 0;
-    dn_sai_qos_scheduler_t *p_sched_node = NULL;
+    dn_sai_qos_queue_t        *p_queue_node = NULL;
+    dn_sai_qos_sched_group_t  *p_sg_node = NULL;
+    dn_sai_qos_port_t         *p_qos_port_node = NULL;
 
-    STD_ASSERT (p_old_sched_node != NULL);
-    STD_ASSERT (p_new_sched_node != NULL);
-    STD_ASSERT (p_count != NULL);
+    if (sai_is_obj_id_queue (obj_id)) {
+        p_queue_node = sai_qos_queue_node_get (obj_id);
 
-    /* Only Original scheduler node will have glue pointers.
-     * Apply case Original - p_old_sched_node
-     * Revert case Original - p_new_sched_node */
-    p_sched_node = (revert ? p_new_sched_node : p_old_sched_node);
+        return ((p_queue_node != NULL) && (p_queue_node->scheduler_id == sched_id));
+    }
 
-    for (p_qos_port_node = sai_qos_scheduler_get_first_port (p_sched_node);
-         (p_qos_port_node != NULL) ; p_qos_port_node =
-         sai_qos_scheduler_get_next_port (p_sched_node, p_qos_port_node)) {
+    if (sai_is_obj_id_scheduler_group (obj_id)) {
+        p_sg_node = sai_qos_sched_group_node_get (obj_id);
 
-        if (revert && (count >= *p_count))
-            break;
+        return ((p_sg_node != NULL) && (p_sg_node->scheduler_id == sched_id));
+    }
+
+    p_qos_port_node = sai_qos_port_node_get (obj_id);
 
-        SAI_SCHED_LOG_TRACE ("Reapplying Scheduler 0x%"PRIx64" on port 0x%"PRIx64"",
-                             p_old_sched_node->key.scheduler_id,
-                             p_qos_port_node->port_id);
+    return ((p_qos_port_node != NULL) && (p_qos_port_node->scheduler_id == sched_id));
+}
 
-        sai_rc = sai_scheduler_npu_api_get()->scheduler_set (p_qos_port_node->port_id,
+/*
+ * Programs the scheduler change on obj_list [start, end).
+ * *p_next is the index of the first object not programmed.
+ */
+static sai_status_t sai_qos_scheduler_obj_list_apply (
+                                      const sai_object_id_t *obj_list,
+                                      uint_t start, uint_t end,
+                                      dn_sai_qos_scheduler_t *p_old_sched_node,
+                                      dn_sai_qos_scheduler_t *p_new_sched_node,
+                                      bool check_bound, uint_t *p_next)
+{
+    sai_status_t     sai_rc = SAI_STATUS_SUCCESS;
+    sai_object_id_t  sched_id = p_old_sched_node->key.scheduler_id;
+    uint_t           index = 0;
+
+    for (index = start; index < end; index++) {
+
+        if (check_bound && (!sai_qos_scheduler_is_obj_bound (sched_id,
+                                                             obj_list [index]))) {
+            SAI_SCHED_LOG_TRACE ("Object 0x%"PRIx64" no longer bound to "
+                                 "Scheduler 0x%"PRIx64", skipped.",
+                                 obj_list [index], sched_id);
+            continue;
+        }
+
+        SAI_SCHED_LOG_TRACE ("Reapplying Scheduler 0x%"PRIx64" on "
+                             "object 0x%"PRIx64"", sched_id, obj_list [index]);
+
+        sai_rc = sai_scheduler_npu_api_get()->scheduler_set (obj_list [index],
                                                              p_old_sched_node,
                                                              p_new_sched_node);
         if (sai_rc != SAI_STATUS_SUCCESS) {
-            SAI_SCHED_LOG_ERR("Scheduler 0x%"PRIx64" reapply on port 0x%"PRIx64" "
-                              "failed with err %d", p_old_sched_node->key.scheduler_id,
-                              p_qos_port_node->port_id, sai_rc);
+            SAI_SCHED_LOG_ERR ("Scheduler 0x%"PRIx64" reapply on object 0x%"PRIx64" "
+                               "failed with err %d", sched_id, obj_list [index],
+                               sai_rc);
             break;
         }
-        count++;
     }
 
-    *p_count = count;
+    *p_next = index;
 
     return sai_rc;
 }
 
-sai_status_t sai_qos_scheduler_reapply (dn_sai_qos_scheduler_t *p_old_sched_node,
-                                        dn_sai_qos_scheduler_t *p_new_sched_node)
+/*
+ * Reverts every object currently bound to the scheduler that was moved to
+ * the new configuration: the objects programmed before the failure and the
+ * objects bound while the lock was released. pending_list holds the
+ * snapshot objects that were never programmed.
+ */
+static void sai_qos_scheduler_reapply_chunked_revert (
+                                      dn_sai_qos_scheduler_t *p_sched_node,
+                                      dn_sai_qos_scheduler_t *p_old_cfg,
+                                      dn_sai_qos_scheduler_t *p_new_cfg,
+                                      sai_object_id_t *pending_list,
+                                      uint_t pending_count)
 {
-    sai_status_t                sai_rc = SAI_STATUS_SUCCESS;
-    sai_status_t                sai_revrt_rc = SAI_STATUS_SUCCESS;
-    uint_t                      update_queue_cnt = 0;
-    uint_t                      update_sg_cnt = 0;
-    uint_t                      update_port_cnt = 0;
+    sai_status_t      sai_rc = SAI_STATUS_SUCCESS;
+    sai_object_id_t  *bound_list = NULL;
+    uint_t            bound_count = 0;
+    uint_t            index = 0;
+    uint_t            next = 0;
+
+    sai_rc = sai_qos_scheduler_bound_obj_list_get (p_sched_node, &bound_list,
+                                                   &bound_count);
+    if (sai_rc != SAI_STATUS_SUCCESS) {
+        SAI_SCHED_LOG_ERR ("Failed to revert Scheduler 0x%"PRIx64".",
+                           p_sched_node->key.scheduler_id);
+        return;
+    }
 
-    STD_ASSERT (p_old_sched_node != NULL);
+    qsort (pending_list, pending_count, sizeof (sai_object_id_t),
+           sai_qos_scheduler_obj_id_cmp);
 
-    do {
-        sai_rc = sai_qos_scheduler_queue_reapply (p_old_sched_node, p_new_sched_node,
-                                                  &update_queue_cnt, false);
-        if (sai_rc != SAI_STATUS_SUCCESS) {
-            SAI_SCHED_LOG_ERR("Failed to reapply Scheduler 0x%"PRIx64" on queue.",
-                              p_new_sched_node->key.scheduler_id);
-            break;
+    for (index = 0; index < bound_count; index++) {
+
+        if (bsearch (&bound_list [index], pending_list, pending_count,
+                     sizeof (sai_object_id_t), sai_qos_scheduler_obj_id_cmp) != NULL) {
+            continue;
         }
 
-        sai_rc = sai_qos_scheduler_sched_group_reapply (p_old_sched_node, p_new_sched_node,
-                                                        &update_sg_cnt, false);
+        sai_rc = sai_qos_scheduler_obj_list_apply (bound_list, index, index + 1,
+                                                   p_new_cfg, p_old_cfg,
+                                                   false, &next);
         if (sai_rc != SAI_STATUS_SUCCESS) {
-            SAI_SCHED_LOG_ERR("Failed to reapply Scheduler 0x%"PRIx64" on SG.",
-                              p_new_sched_node->key.scheduler_id);
-            break;
+            SAI_SCHED_LOG_ERR ("Failed to revert Scheduler 0x%"PRIx64" on "
+                               "object 0x%"PRIx64".",
+                               p_sched_node->key.scheduler_id, bound_list [index]);
         }
+    }
+
+    free (bound_list);
+}
+
+sai_status_t sai_qos_scheduler_reapply_chunked (dn_sai_qos_scheduler_t *p_sched_node,
+                                                dn_sai_qos_scheduler_t *p_old_cfg,
+                                                bool lock_release)
+{
+    sai_status_t            sai_rc = SAI_STATUS_SUCCESS;
+    dn_sai_qos_scheduler_t  new_cfg;
+    sai_object_id_t         sched_id = SAI_NULL_OBJECT_ID;
+    sai_object_id_t        *obj_list = NULL;
+    uint_t                  count = 0;
+    uint_t                  start = 0;
+    uint_t                  end = 0;
+    uint_t                  next = 0;
+    bool                    is_chunked = false;
+
+    STD_ASSERT (p_sched_node != NULL);
+    STD_ASSERT (p_old_cfg != NULL);
+
+    sched_id = p_sched_node->key.scheduler_id;
+
+    /* Small bound lists, callers that keep the lock held and a full in
+     * progress table fall back to a reapply under a single lock hold. */
+    sai_rc = sai_qos_scheduler_bound_obj_list_get (p_sched_node, &obj_list, &count);
+
+    if (sai_rc != SAI_STATUS_SUCCESS) {
+        return sai_rc;
+    }
+
+    memcpy (&new_cfg, p_sched_node, sizeof (dn_sai_qos_scheduler_t));
+
+    if (lock_release && (count > SAI_QOS_SCHED_REAPPLY_CHUNK_SIZE)) {
+        is_chunked = sai_qos_scheduler_reapply_in_progress_mark (sched_id);
+    }
+
+    SAI_SCHED_LOG_TRACE ("Reapplying Scheduler 0x%"PRIx64" on %d objects, "
+                         "chunked %d.", sched_id, count, is_chunked);
 
-        sai_rc = sai_qos_scheduler_port_reapply (p_old_sched_node, p_new_sched_node,
-                                                 &update_port_cnt, false);
+    for (start = 0; start < count; start = end) {
+
+        end = (is_chunked ? (start + SAI_QOS_SCHED_REAPPLY_CHUNK_SIZE) : count);
+
+        if (end > count) {
+            end = count;
+        }
+
+        sai_rc = sai_qos_scheduler_obj_list_apply (obj_list, start, end,
+                                                   p_old_cfg, &new_cfg,
+                                                   is_chunked, &next);
         if (sai_rc != SAI_STATUS_SUCCESS) {
-            SAI_SCHED_LOG_ERR("Failed to reapply Scheduler 0x%"PRIx64" on port.",
-                              p_new_sched_node->key.scheduler_id);
             break;
         }
-    } while(0);
-
-     if (sai_rc != SAI_STATUS_SUCCESS) {
-        if (update_queue_cnt) {
-            sai_revrt_rc = sai_qos_scheduler_queue_reapply (p_new_sched_node, p_old_sched_node,
-                                                            &update_queue_cnt, true);
-            if (sai_revrt_rc != SAI_STATUS_SUCCESS) {
-                SAI_SCHED_LOG_ERR("Failed to revert Scheduler 0x%"PRIx64" on queue.",
-                                  p_old_sched_node->key.scheduler_id);
-                /* TODO - ADDing ASSERT is only possibel here */
-            }
-        }
 
-        if (update_sg_cnt) {
-            sai_revrt_rc = sai_qos_scheduler_sched_group_reapply (p_new_sched_node, p_old_sched_node,
-                                                                  &update_sg_cnt, true);
-            if (sai_revrt_rc != SAI_STATUS_SUCCESS) {
-                SAI_SCHED_LOG_ERR("Failed to revert Scheduler 0x%"PRIx64" on SG.",
-                                  p_old_sched_node->key.scheduler_id);
-                /* TODO - ADDing ASSERT is only possibel here */
-            }
-        }
+        if (is_chunked && (end < count)) {
+            sai_qos_unlock ();
 
-        if (update_port_cnt) {
-            sai_revrt_rc = sai_qos_scheduler_port_reapply (p_new_sched_node, p_old_sched_node,
-                                                           &update_port_cnt, true);
-            if (sai_revrt_rc != SAI_STATUS_SUCCESS) {
-                SAI_SCHED_LOG_ERR("Failed to revert Scheduler 0x%"PRIx64" on port.",
-                                  p_old_sched_node->key.scheduler_id);
-                /* TODO - ADDing ASSERT is only possibel here */
-            }
+            /* Let the waiting QoS API threads take the lock */
+            sched_yield ();
+
+            sai_qos_lock ();
         }
-     }
-     return sai_rc;
+    }
+
+    if (sai_rc != SAI_STATUS_SUCCESS) {
+        SAI_SCHED_LOG_ERR ("Failed to reapply Scheduler 0x%"PRIx64" on object "
+                           "%d of %d, reverting.", sched_id, next, count);
+
+        sai_qos_scheduler_reapply_chunked_revert (p_sched_node, p_old_cfg,
+                                                  &new_cfg, &obj_list [next],
+                                                  count - next);
+    }
+
+    if (is_chunked) {
+        sai_qos_scheduler_reapply_in_progress_clear (sched_id);
+    }
+
+    free (obj_list);
+
+    return sai_rc;
 }
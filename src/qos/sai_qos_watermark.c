@@ -0,0 +1,608 @@
+/*
+ * Copyright (c) 2016 Dell Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * THIS CODE IS PROVIDED ON AN *AS IS* BASIS, WITHOUT WARRANTIES OR
+ * CONDITIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING WITHOUT
+ * LIMITATION ANY IMPLIED WARRANTIES OR CONDITIONS OF TITLE, FITNESS
+ * FOR A PARTICULAR PURPOSE, MERCHANTABLITY OR NON-INFRINGEMENT.
+ *
+ * See the Apache Version 2.0 License for specific language governing
+ * permissions and limitations under the License.
+ */
+
+/**
+ * @file  sai_qos_watermark.c
+ *
+ * @brief This file contains the buffer watermark poller.
+ *
+ * A poller thread reads the occupancy and watermark of every buffer pool,
+ * queue and PG into the back buffer of a double buffered snapshot. The
+ * QoS lock is taken for one batch of objects at a time. The snapshot is
+ * then merged with the front buffer and published under a separate lock,
+ * so readers copy the last snapshot without touching the QoS lock.
+ *
+ * The poller is the only one to clear the queue and PG watermark counters.
+ * It keeps a peak per object since the last client clear, which the public
+ * queue and PG stats fold into their watermark reads.
+ */
+
+#include "sai_npu_qos.h"
+#include "sai_qos_common.h"
+#include "sai_qos_util.h"
+#include "sai_qos_buffer_util.h"
+#include "sai_qos_api_utils.h"
+#include "sai_common_infra.h"
+
+#include "sai.h"
+#include "saibuffer.h"
+#include "saiqueue.h"
+
+#include "std_type_defs.h"
+#include "std_assert.h"
+#include "std_rbtree.h"
+#include "std_mutex_lock.h"
+#include "std_thread_tools.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <inttypes.h>
+#include <time.h>
+
+/* Objects read from the NPU per QoS lock hold */
+#define SAI_QOS_WATERMARK_BATCH_SIZE        64
+#define SAI_QOS_WATERMARK_MIN_INTERVAL_MS   10
+#define SAI_QOS_WATERMARK_LIST_INIT_SIZE    64
+
+typedef struct _sai_qos_watermark_buffer_t {
+    sai_qos_watermark_snapshot_t snapshot;
+    uint_t                       max_count [SAI_QOS_WATERMARK_OBJ_TYPE_MAX];
+    /* Set once the snapshot is read, the next poll restarts the peaks */
+    bool                         consumed;
+} sai_qos_watermark_buffer_t;
+
+/* Queue or PG watermark peak since the last client clear */
+typedef struct _sai_qos_watermark_peak_t {
+    sai_object_id_t object_id;
+    uint64_t        watermark_bytes;
+    /* Poll that last read the object, older peaks are of removed objects */
+    uint_t          poll_count;
+} sai_qos_watermark_peak_t;
+
+typedef struct _sai_qos_watermark_ctx_t {
+    bool                       enabled;
+    uint32_t                   interval_ms;
+    /* Written by the poller thread alone, under the lock */
+    uint_t                     front_idx;
+    sai_qos_watermark_buffer_t buffers [2];
+    /* Peak tree is guarded by the QoS lock */
+    rbtree_handle              peak_tree;
+    uint_t                     poll_count;
+} sai_qos_watermark_ctx_t;
+
+static sai_qos_watermark_ctx_t sai_qos_watermark;
+static std_mutex_lock_create_static_init_fast (sai_qos_watermark_lock);
+static std_thread_create_param_t sai_qos_watermark_thread;
+static bool sai_qos_watermark_thread_created = false;
+
+static uint64_t sai_qos_watermark_time_us_get (void)
+{
+    struct timespec ts;
+
+    clock_gettime (CLOCK_MONOTONIC, &ts);
+
+    return (((uint64_t) ts.tv_sec * 1000000) + ((uint64_t) ts.tv_nsec / 1000));
+}
+
+static sai_status_t sai_qos_watermark_entry_reserve (sai_qos_watermark_buffer_t *p_buf,
+                                                     sai_qos_watermark_obj_type_t type)
+{
+    sai_qos_watermark_entry_t *p_list = NULL;
+    uint_t                     max_count = 0;
+
+    if (p_buf->snapshot.count [type] < p_buf->max_count [type]) {
+        return SAI_STATUS_SUCCESS;
+    }
+
+    max_count = (p_buf->max_count [type] == 0) ? SAI_QOS_WATERMARK_LIST_INIT_SIZE :
+                (p_buf->max_count [type] * 2);
+
+    p_list = (sai_qos_watermark_entry_t *) realloc (p_buf->snapshot.list [type],
+                                                    max_count * sizeof (*p_list));
+
+    if (p_list == NULL) {
+        SAI_BUFFER_LOG_ERR ("Failed to grow watermark list of type %d to %u",
+                            type, max_count);
+        return SAI_STATUS_NO_MEMORY;
+    }
+
+    p_buf->snapshot.list [type] = p_list;
+    p_buf->max_count [type] = max_count;
+
+    return SAI_STATUS_SUCCESS;
+}
+
+/* Returns the node after last_id in the object tree, the first if p_last_id is NULL */
+static void *sai_qos_watermark_node_next_get (sai_qos_watermark_obj_type_t type,
+                                              const sai_object_id_t *p_last_id)
+{
+    dn_sai_qos_buffer_pool_t tmp_pool;
+    dn_sai_qos_queue_t       tmp_queue;
+    dn_sai_qos_pg_t          tmp_pg;
+    rbtree_handle            tree = NULL;
+    void                    *p_key = NULL;
+
+    switch (type) {
+        case SAI_QOS_WATERMARK_OBJ_BUFFER_POOL:
+            tree = sai_qos_access_global_config()->buffer_pool_tree;
+            if (p_last_id != NULL) {
+                memset (&tmp_pool, 0, sizeof (tmp_pool));
+                tmp_pool.key.pool_id = *p_last_id;
+                p_key = &tmp_pool;
+            }
+            break;
+
+        case SAI_QOS_WATERMARK_OBJ_QUEUE:
+            tree = sai_qos_access_global_config()->queue_tree;
+            if (p_last_id != NULL) {
+                memset (&tmp_queue, 0, sizeof (tmp_queue));
+                tmp_queue.key.queue_id = *p_last_id;
+                p_key = &tmp_queue;
+            }
+            break;
+
+        case SAI_QOS_WATERMARK_OBJ_PG:
+            tree = sai_qos_access_global_config()->pg_tree;
+            if (p_last_id != NULL) {
+                memset (&tmp_pg, 0, sizeof (tmp_pg));
+                tmp_pg.key.pg_id = *p_last_id;
+                p_key = &tmp_pg;
+            }
+            break;
+
+        default:
+            break;
+    }
+
+    if (tree == NULL) {
+        return NULL;
+    }
+
+    if (p_key == NULL) {
+        return std_rbtree_getfirst (tree);
+    }
+
+    return std_rbtree_getnext (tree, p_key);
+}
+
+static sai_object_id_t sai_qos_watermark_node_id_get (sai_qos_watermark_obj_type_t type,
+                                                      void *p_node)
+{
+    switch (type) {
+        case SAI_QOS_WATERMARK_OBJ_BUFFER_POOL:
+            return ((dn_sai_qos_buffer_pool_t *) p_node)->key.pool_id;
+
+        case SAI_QOS_WATERMARK_OBJ_QUEUE:
+            return ((dn_sai_qos_queue_t *) p_node)->key.queue_id;
+
+        case SAI_QOS_WATERMARK_OBJ_PG:
+            return ((dn_sai_qos_pg_t *) p_node)->key.pg_id;
+
+        default:
+            break;
+    }
+
+    return SAI_NULL_OBJECT_ID;
+}
+
+static sai_qos_watermark_peak_t *sai_qos_watermark_peak_get (sai_object_id_t object_id)
+{
+    if (sai_qos_watermark.peak_tree == NULL) {
+        return NULL;
+    }
+
+    return (sai_qos_watermark_peak_t *) std_rbtree_getexact (sai_qos_watermark.peak_tree,
+                                                             (void *) &object_id);
+}
+
+static sai_status_t sai_qos_watermark_peak_update (sai_object_id_t object_id,
+                                                   uint64_t watermark_bytes)
+{
+    sai_qos_watermark_peak_t *p_peak = sai_qos_watermark_peak_get (object_id);
+
+    if (p_peak == NULL) {
+        p_peak = (sai_qos_watermark_peak_t *) calloc (1, sizeof (*p_peak));
+
+        if (p_peak == NULL) {
+            return SAI_STATUS_NO_MEMORY;
+        }
+
+        p_peak->object_id = object_id;
+
+        if (std_rbtree_insert (sai_qos_watermark.peak_tree, p_peak) != STD_ERR_OK) {
+            free (p_peak);
+            return SAI_STATUS_FAILURE;
+        }
+    }
+
+    if (watermark_bytes > p_peak->watermark_bytes) {
+        p_peak->watermark_bytes = watermark_bytes;
+    }
+
+    p_peak->poll_count = sai_qos_watermark.poll_count;
+
+    return SAI_STATUS_SUCCESS;
+}
+
+/* Drops the peaks of objects that the last poll did not find */
+static void sai_qos_watermark_peaks_prune (void)
+{
+    sai_qos_watermark_peak_t *p_peak = NULL;
+    sai_qos_watermark_peak_t *p_next = NULL;
+
+    sai_qos_lock ();
+
+    p_peak = (sai_qos_watermark_peak_t *) std_rbtree_getfirst (sai_qos_watermark.peak_tree);
+
+    while (p_peak != NULL) {
+        p_next = (sai_qos_watermark_peak_t *) std_rbtree_getnext (sai_qos_watermark.peak_tree,
+                                                                  p_peak);
+
+        if (p_peak->poll_count != sai_qos_watermark.poll_count) {
+            std_rbtree_remove (sai_qos_watermark.peak_tree, p_peak);
+            free (p_peak);
+        }
+
+        p_peak = p_next;
+    }
+
+    sai_qos_unlock ();
+}
+
+/*
+ * Reads the object usage since the previous poll. Queue and PG
+ * watermarks are folded into the object peak and then cleared, the
+ * hardware counter is not cleared if the peak can not be kept. Buffer
+ * pool watermarks can not be cleared, so the polled pool occupancy is
+ * used as its peak.
+ */
+static sai_status_t sai_qos_watermark_node_read (sai_qos_watermark_obj_type_t type,
+                                                 void *p_node,
+                                                 sai_qos_watermark_entry_t *p_entry)
+{
+    static const sai_buffer_pool_stat_t pool_counter_ids [] = {
+        SAI_BUFFER_POOL_STAT_CURR_OCCUPANCY_BYTES,
+    };
+    static const sai_queue_stat_t queue_counter_ids [] = {
+        SAI_QUEUE_STAT_CURR_OCCUPANCY_BYTES,
+        SAI_QUEUE_STAT_WATERMARK_BYTES,
+    };
+    static const sai_ingress_priority_group_stat_t pg_counter_ids [] = {
+        SAI_INGRESS_PRIORITY_GROUP_STAT_CURR_OCCUPANCY_BYTES,
+        SAI_INGRESS_PRIORITY_GROUP_STAT_WATERMARK_BYTES,
+    };
+    uint64_t        counters [2] = {0, 0};
+    sai_object_id_t object_id = sai_qos_watermark_node_id_get (type, p_node);
+    sai_status_t    sai_rc = SAI_STATUS_SUCCESS;
+
+    switch (type) {
+        case SAI_QOS_WATERMARK_OBJ_BUFFER_POOL:
+            sai_rc = sai_buffer_npu_api_get()->buffer_pool_stats_get (object_id,
+                                                                      pool_counter_ids,
+                                                                      1, counters);
+            counters [1] = counters [0];
+            break;
+
+        case SAI_QOS_WATERMARK_OBJ_QUEUE:
+            sai_rc = sai_queue_npu_api_get()->queue_stats_get ((dn_sai_qos_queue_t *) p_node,
+                                                               queue_counter_ids, 2,
+                                                               counters);
+            if ((sai_rc == SAI_STATUS_SUCCESS) &&
+                (sai_qos_watermark_peak_update (object_id, counters [1]) == SAI_STATUS_SUCCESS)) {
+                sai_queue_npu_api_get()->queue_stats_clear ((dn_sai_qos_queue_t *) p_node,
+                                                            &queue_counter_ids [1], 1);
+            }
+            break;
+
+        case SAI_QOS_WATERMARK_OBJ_PG:
+            sai_rc = sai_buffer_npu_api_get()->pg_stats_get (object_id, pg_counter_ids,
+                                                             2, counters);
+            if ((sai_rc == SAI_STATUS_SUCCESS) &&
+                (sai_qos_watermark_peak_update (object_id, counters [1]) == SAI_STATUS_SUCCESS)) {
+                sai_buffer_npu_api_get()->pg_stats_clear (object_id, &pg_counter_ids [1], 1);
+            }
+            break;
+
+        default:
+            sai_rc = SAI_STATUS_INVALID_PARAMETER;
+            break;
+    }
+
+    if (sai_rc != SAI_STATUS_SUCCESS) {
+        SAI_BUFFER_LOG_TRACE ("Watermark read failed for 0x%"PRIx64", Error: %d.",
+                              object_id, sai_rc);
+        return sai_rc;
+    }
+
+    p_entry->object_id = object_id;
+    p_entry->curr_occupancy_bytes = counters [0];
+    p_entry->watermark_bytes = (counters [1] > counters [0]) ? counters [1] : counters [0];
+
+    return SAI_STATUS_SUCCESS;
+}
+
+static void sai_qos_watermark_collect (sai_qos_watermark_buffer_t *p_buf,
+                                       sai_qos_watermark_obj_type_t type)
+{
+    sai_qos_watermark_entry_t *p_entry = NULL;
+    void                      *p_node = NULL;
+    sai_object_id_t            last_id = SAI_NULL_OBJECT_ID;
+    bool                       started = false;
+    bool                       done = false;
+    uint_t                     batch = 0;
+
+    p_buf->snapshot.count [type] = 0;
+
+    while (!done) {
+        sai_qos_lock ();
+
+        for (batch = 0; batch < SAI_QOS_WATERMARK_BATCH_SIZE; batch++) {
+            p_node = sai_qos_watermark_node_next_get (type, started ? &last_id : NULL);
+
+            if ((p_node == NULL) ||
+                (sai_qos_watermark_entry_reserve (p_buf, type) != SAI_STATUS_SUCCESS)) {
+                done = true;
+                break;
+            }
+
+            last_id = sai_qos_watermark_node_id_get (type, p_node);
+            started = true;
+
+            p_entry = &p_buf->snapshot.list [type][p_buf->snapshot.count [type]];
+
+            if (sai_qos_watermark_node_read (type, p_node, p_entry) == SAI_STATUS_SUCCESS) {
+                p_buf->snapshot.count [type]++;
+            }
+        }
+
+        sai_qos_unlock ();
+    }
+}
+
+/*
+ * Carries the peaks of the front buffer over unless it was read. Both
+ * lists are in tree order, so the search resumes from the last match.
+ */
+static void sai_qos_watermark_peaks_merge (sai_qos_watermark_buffer_t *p_back,
+                                           const sai_qos_watermark_buffer_t *p_front,
+                                           sai_qos_watermark_obj_type_t type)
+{
+    const sai_qos_watermark_entry_t *p_prev = NULL;
+    sai_qos_watermark_entry_t       *p_entry = NULL;
+    uint_t                           idx = 0;
+    uint_t                           prev_idx = 0;
+    uint_t                           cursor = 0;
+
+    if (p_front->consumed) {
+        return;
+    }
+
+    for (idx = 0; idx < p_back->snapshot.count [type]; idx++) {
+        p_entry = &p_back->snapshot.list [type][idx];
+
+        for (prev_idx = cursor; prev_idx < p_front->snapshot.count [type]; prev_idx++) {
+            p_prev = &p_front->snapshot.list [type][prev_idx];
+
+            if (p_prev->object_id == p_entry->object_id) {
+                if (p_prev->watermark_bytes > p_entry->watermark_bytes) {
+                    p_entry->watermark_bytes = p_prev->watermark_bytes;
+                }
+                cursor = prev_idx + 1;
+                break;
+            }
+        }
+    }
+}
+
+static void sai_qos_watermark_poll (void)
+{
+    sai_qos_watermark_buffer_t *p_front = NULL;
+    sai_qos_watermark_buffer_t *p_back = NULL;
+    uint_t                      type = 0;
+
+    /* Only this thread moves the front index, the back buffer is its own */
+    p_back = &sai_qos_watermark.buffers [1 - sai_qos_watermark.front_idx];
+
+    sai_qos_watermark.poll_count++;
+
+    for (type = 0; type < SAI_QOS_WATERMARK_OBJ_TYPE_MAX; type++) {
+        sai_qos_watermark_collect (p_back, type);
+    }
+
+    sai_qos_watermark_peaks_prune ();
+
+    p_back->snapshot.timestamp_us = sai_qos_watermark_time_us_get ();
+
+    std_mutex_lock (&sai_qos_watermark_lock);
+
+    p_front = &sai_qos_watermark.buffers [sai_qos_watermark.front_idx];
+
+    for (type = 0; type < SAI_QOS_WATERMARK_OBJ_TYPE_MAX; type++) {
+        sai_qos_watermark_peaks_merge (p_back, p_front, type);
+    }
+
+    p_back->snapshot.sequence = p_front->snapshot.sequence + 1;
+    p_back->consumed = false;
+
+    sai_qos_watermark.front_idx = 1 - sai_qos_watermark.front_idx;
+
+    std_mutex_unlock (&sai_qos_watermark_lock);
+}
+
+static void *sai_qos_watermark_thread_fn (void *param)
+{
+    struct timespec ts;
+    uint32_t        interval_ms = 0;
+    bool            enabled = false;
+
+    while (1) {
+        std_mutex_lock (&sai_qos_watermark_lock);
+
+        interval_ms = sai_qos_watermark.interval_ms;
+        enabled = sai_qos_watermark.enabled;
+
+        std_mutex_unlock (&sai_qos_watermark_lock);
+
+        ts.tv_sec = interval_ms / 1000;
+        ts.tv_nsec = (interval_ms % 1000) * 1000000;
+
+        nanosleep (&ts, NULL);
+
+        if (enabled) {
+            sai_qos_watermark_poll ();
+        }
+    }
+
+    return NULL;
+}
+
+sai_status_t sai_qos_watermark_poll_start (uint32_t interval_ms)
+{
+    if (interval_ms < SAI_QOS_WATERMARK_MIN_INTERVAL_MS) {
+        SAI_BUFFER_LOG_ERR ("Watermark poll interval %u ms is below %u ms",
+                            interval_ms, SAI_QOS_WATERMARK_MIN_INTERVAL_MS);
+        return SAI_STATUS_INVALID_PARAMETER;
+    }
+
+    /* The QoS lock is never taken under the watermark lock */
+    sai_qos_lock ();
+
+    if (sai_qos_watermark.peak_tree == NULL) {
+        sai_qos_watermark.peak_tree = std_rbtree_create_simple ("watermark_peak_tree",
+                               STD_STR_OFFSET_OF (sai_qos_watermark_peak_t, object_id),
+                               STD_STR_SIZE_OF (sai_qos_watermark_peak_t, object_id));
+    }
+
+    sai_qos_unlock ();
+
+    if (sai_qos_watermark.peak_tree == NULL) {
+        SAI_BUFFER_LOG_ERR ("Watermark peak tree create failed");
+        return SAI_STATUS_NO_MEMORY;
+    }
+
+    std_mutex_lock (&sai_qos_watermark_lock);
+
+    if (!sai_qos_watermark_thread_created) {
+        std_thread_init_struct (&sai_qos_watermark_thread);
+        sai_qos_watermark_thread.name = "sai_qos_watermark";
+        sai_qos_watermark_thread.thread_function = sai_qos_watermark_thread_fn;
+
+        if (std_thread_create (&sai_qos_watermark_thread) != STD_ERR_OK) {
+            SAI_BUFFER_LOG_ERR ("Watermark poller thread create failed");
+            std_mutex_unlock (&sai_qos_watermark_lock);
+            return SAI_STATUS_FAILURE;
+        }
+        sai_qos_watermark_thread_created = true;
+    }
+
+    if (!sai_qos_watermark.enabled) {
+        /* Peaks seen before the poller was stopped are not carried over */
+        sai_qos_watermark.buffers [sai_qos_watermark.front_idx].consumed = true;
+    }
+
+    sai_qos_watermark.interval_ms = interval_ms;
+    sai_qos_watermark.enabled = true;
+
+    std_mutex_unlock (&sai_qos_watermark_lock);
+
+    SAI_BUFFER_LOG_INFO ("Watermark poller started with %u ms interval", interval_ms);
+
+    return SAI_STATUS_SUCCESS;
+}
+
+sai_status_t sai_qos_watermark_poll_stop (void)
+{
+    std_mutex_lock (&sai_qos_watermark_lock);
+
+    sai_qos_watermark.enabled = false;
+
+    std_mutex_unlock (&sai_qos_watermark_lock);
+
+    return SAI_STATUS_SUCCESS;
+}
+
+sai_status_t sai_qos_watermark_snapshot_read (sai_qos_watermark_snapshot_t *p_snapshot)
+{
+    sai_qos_watermark_buffer_t *p_front = NULL;
+    sai_status_t                sai_rc = SAI_STATUS_SUCCESS;
+    uint_t                      type = 0;
+
+    STD_ASSERT (p_snapshot != NULL);
+
+    std_mutex_lock (&sai_qos_watermark_lock);
+
+    p_front = &sai_qos_watermark.buffers [sai_qos_watermark.front_idx];
+
+    if (p_front->snapshot.sequence == 0) {
+        std_mutex_unlock (&sai_qos_watermark_lock);
+        return SAI_STATUS_UNINITIALIZED;
+    }
+
+    for (type = 0; type < SAI_QOS_WATERMARK_OBJ_TYPE_MAX; type++) {
+        if ((p_snapshot->count [type] < p_front->snapshot.count [type]) ||
+            ((p_front->snapshot.count [type] != 0) && (p_snapshot->list [type] == NULL))) {
+            sai_rc = SAI_STATUS_BUFFER_OVERFLOW;
+        }
+    }
+
+    for (type = 0; type < SAI_QOS_WATERMARK_OBJ_TYPE_MAX; type++) {
+        if ((sai_rc == SAI_STATUS_SUCCESS) && (p_front->snapshot.count [type] != 0)) {
+            memcpy (p_snapshot->list [type], p_front->snapshot.list [type],
+                    p_front->snapshot.count [type] * sizeof (sai_qos_watermark_entry_t));
+        }
+        p_snapshot->count [type] = p_front->snapshot.count [type];
+    }
+
+    p_snapshot->sequence = p_front->snapshot.sequence;
+    p_snapshot->timestamp_us = p_front->snapshot.timestamp_us;
+
+    if (sai_rc == SAI_STATUS_SUCCESS) {
+        p_front->consumed = true;
+    }
+
+    std_mutex_unlock (&sai_qos_watermark_lock);
+
+    return sai_rc;
+}
+
+void sai_qos_watermark_peak_apply (sai_object_id_t object_id, uint64_t *p_watermark_bytes)
+{
+    sai_qos_watermark_peak_t *p_peak = sai_qos_watermark_peak_get (object_id);
+
+    STD_ASSERT (p_watermark_bytes != NULL);
+
+    if ((p_peak != NULL) && (p_peak->watermark_bytes > *p_watermark_bytes)) {
+        *p_watermark_bytes = p_peak->watermark_bytes;
+    }
+}
+
+bool sai_qos_watermark_peak_clear (sai_object_id_t object_id)
+{
+    sai_qos_watermark_peak_t *p_peak = sai_qos_watermark_peak_get (object_id);
+    bool                      enabled = false;
+
+    if (p_peak != NULL) {
+        p_peak->watermark_bytes = 0;
+    }
+
+    std_mutex_lock (&sai_qos_watermark_lock);
+
+    enabled = sai_qos_watermark.enabled;
+
+    std_mutex_unlock (&sai_qos_watermark_lock);
+
+    return enabled;
+}
@@ -36,6 +36,7 @@
 
 #include "std_type_defs.h"
 #include "std_utils.h"
+#include "std_llist.h"
 #include "std_assert.h"
 #include <stdlib.h>
 #include <inttypes.h>
@@ -274,10 +275,10 @@ static sai_status_t sai_wred_parse_update_attributes(dn_sai_qos_wred_t *p_wred_n
     return sai_rc;
 }
 
-static sai_status_t sai_qos_wred_create(sai_object_id_t *wred_id,
-                                    sai_object_id_t switch_id,
-                                    uint32_t attr_count,
-                                    const sai_attribute_t *attr_list)
+static sai_status_t sai_qos_wred_create_internal(sai_object_id_t *wred_id,
+                                             sai_object_id_t switch_id,
+                                             uint32_t attr_count,
+                                             const sai_attribute_t *attr_list)
 {
     sai_status_t           sai_rc = SAI_STATUS_SUCCESS;
     dn_sai_qos_wred_t      *p_wred_node = NULL;
@@ -285,8 +286,6 @@ static sai_status_t sai_qos_wred_create(sai_object_id_t *wred_id,
 
     STD_ASSERT(wred_id != NULL);
 
-    sai_qos_lock();
-
     do
     {
         if((p_wred_node = sai_qos_wred_node_alloc()) == NULL){
@@ -343,13 +342,330 @@ static sai_status_t sai_qos_wred_create(sai_object_id_t *wred_id,
         sai_qos_wred_free_resources(p_wred_node);
     }
 
+    return sai_rc;
+}
+
+static sai_status_t sai_qos_wred_create(sai_object_id_t *wred_id,
+                                        sai_object_id_t switch_id,
+                                        uint32_t attr_count,
+                                        const sai_attribute_t *attr_list)
+{
+    sai_status_t sai_rc = SAI_STATUS_SUCCESS;
+
+    sai_qos_lock();
+    sai_rc = sai_qos_wred_create_internal(wred_id, switch_id, attr_count, attr_list);
     sai_qos_unlock();
+
     return sai_rc;
 }
 
-static sai_status_t sai_qos_wred_remove(sai_object_id_t wred_id)
+/* Link of a WRED profile captured for one propagation */
+typedef struct _sai_qos_wred_link_entry_t {
+    sai_object_id_t        link_id;
+    dn_sai_qos_wred_link_t link_type;
+} sai_qos_wred_link_entry_t;
+
+/*
+ * WRED profile with attribute changes not yet propagated to its links.
+ * propagated_node holds the profile last programmed on the links and is
+ * the rollback checkpoint if the propagation fails.
+ */
+typedef struct _sai_qos_wred_pending_t {
+    /* Must be the first member, entry is linked in the pending list */
+    std_dll           dll_glue;
+    sai_object_id_t   wred_id;
+    dn_sai_qos_wred_t propagated_node;
+} sai_qos_wred_pending_t;
+
+static uint_t       sai_qos_wred_defer_count = 0;
+static bool         sai_qos_wred_pending_list_init = false;
+static std_dll_head sai_qos_wred_pending_list;
+
+/* Capture all the links of the WRED profile in a single walk */
+static sai_status_t sai_wred_link_vector_build(dn_sai_qos_wred_t *p_wred_node,
+        sai_qos_wred_link_entry_t **pp_link_vector, uint_t *p_link_count)
+{
+    void                      *p_wred_link_node = NULL;
+    sai_qos_wred_link_entry_t *p_link_vector = NULL;
+    sai_qos_wred_link_entry_t *p_new_vector = NULL;
+    dn_sai_qos_wred_link_t     wred_link_type = DN_SAI_QOS_WRED_LINK_QUEUE;
+    uint_t                     link_count = 0;
+    uint_t                     link_max = 0;
+
+    STD_ASSERT(p_wred_node != NULL);
+
+    for(wred_link_type = DN_SAI_QOS_WRED_LINK_QUEUE;
+            wred_link_type < DN_SAI_QOS_WRED_LINK_MAX;
+            wred_link_type++) {
+        p_wred_link_node = sai_qos_wred_link_node_get_first(p_wred_node, wred_link_type);
+
+        while(p_wred_link_node != NULL){
+            if(link_count == link_max) {
+                link_max = (link_max == 0) ? 64 : (2 * link_max);
+                p_new_vector = (sai_qos_wred_link_entry_t *)
+                    realloc(p_link_vector, link_max * sizeof(sai_qos_wred_link_entry_t));
+                if(p_new_vector == NULL) {
+                    free(p_link_vector);
+                    return SAI_STATUS_NO_MEMORY;
+                }
+                p_link_vector = p_new_vector;
+            }
+            p_link_vector[link_count].link_id =
+                sai_qos_wred_link_oid_get(p_wred_link_node, wred_link_type);
+            p_link_vector[link_count].link_type = wred_link_type;
+            link_count++;
+
+            p_wred_link_node =
+                sai_qos_wred_link_node_get_next(p_wred_node, p_wred_link_node, wred_link_type);
+        }
+    }
+
+    *pp_link_vector = p_link_vector;
+    *p_link_count = link_count;
+
+    return SAI_STATUS_SUCCESS;
+}
+
+/* Restore the checkpointed profile on the links programmed before a failure */
+static void sai_wred_link_error_recovery(dn_sai_qos_wred_t *p_wred_old,
+        const sai_qos_wred_link_entry_t *p_link_vector, uint_t count)
+{
+    sai_status_t sai_rc = SAI_STATUS_SUCCESS;
+    uint_t idx;
+
+    STD_ASSERT(p_wred_old != NULL);
+
+    for(idx = 0; idx < count; idx++) {
+        SAI_WRED_LOG_TRACE("Recovering WRED ID 0x%"PRIx64" for %s 0x%"PRIx64"",
+                p_wred_old->key.wred_id,
+                sai_qos_wred_link_str(p_link_vector[idx].link_type),
+                p_link_vector[idx].link_id);
+        sai_rc = sai_qos_wred_npu_api_get()->wred_link_set(p_link_vector[idx].link_id,
+                p_wred_old, p_link_vector[idx].link_type);
+
+        if(sai_rc != SAI_STATUS_SUCCESS){
+            SAI_WRED_LOG_ERR("Recovering WRED ID 0x%"PRIx64" for %s 0x%"PRIx64" failed, sai_rc 0x%x.",
+                    p_wred_old->key.wred_id,
+                    sai_qos_wred_link_str(p_link_vector[idx].link_type),
+                    p_link_vector[idx].link_id, sai_rc);
+        }
+    }
+}
+
+/* Program the new profile on every link of the WRED, p_wred_old on failure */
+static sai_status_t sai_wred_update_link(dn_sai_qos_wred_t *p_wred_old,
+                                         dn_sai_qos_wred_t *p_wred_new)
+{
+    dn_sai_qos_wred_t         *p_wred_node = NULL;
+    sai_qos_wred_link_entry_t *p_link_vector = NULL;
+    sai_status_t               sai_rc = SAI_STATUS_SUCCESS;
+    uint_t                     link_count = 0;
+    uint_t                     idx;
+
+    STD_ASSERT(p_wred_old != NULL);
+    STD_ASSERT(p_wred_new != NULL);
+    p_wred_node = sai_qos_wred_node_get(p_wred_new->key.wred_id);
+
+    if(p_wred_node == NULL){
+        SAI_WRED_LOG_ERR("WRED node not found for WRED ID 0x%"PRIx64"", p_wred_new->key.wred_id);
+        return SAI_STATUS_INVALID_OBJECT_ID;
+    }
+
+    sai_rc = sai_wred_link_vector_build(p_wred_node, &p_link_vector, &link_count);
+    if(sai_rc != SAI_STATUS_SUCCESS) {
+        return sai_rc;
+    }
+
+    for(idx = 0; idx < link_count; idx++) {
+        SAI_WRED_LOG_TRACE("Updating WRED ID to 0x%"PRIx64" for %s 0x%"PRIx64"",
+                p_wred_new->key.wred_id,
+                sai_qos_wred_link_str(p_link_vector[idx].link_type),
+                p_link_vector[idx].link_id);
+        sai_rc = sai_qos_wred_npu_api_get()->wred_link_set(p_link_vector[idx].link_id,
+                p_wred_new, p_link_vector[idx].link_type);
+
+        if(sai_rc != SAI_STATUS_SUCCESS){
+            SAI_WRED_LOG_TRACE("Updating WRED ID to 0x%"PRIx64" for %s 0x%"PRIx64" failed",
+                    p_wred_new->key.wred_id,
+                    sai_qos_wred_link_str(p_link_vector[idx].link_type),
+                    p_link_vector[idx].link_id);
+            sai_wred_link_error_recovery(p_wred_old, p_link_vector, idx);
+            break;
+        }
+    }
+
+    free(p_link_vector);
+
+    return sai_rc;
+}
+
+static sai_qos_wred_pending_t *sai_qos_wred_pending_get(sai_object_id_t wred_id)
+{
+    sai_qos_wred_pending_t *p_pending = NULL;
+
+    if(!sai_qos_wred_pending_list_init) {
+        return NULL;
+    }
+
+    for(p_pending = (sai_qos_wred_pending_t *) std_dll_getfirst(&sai_qos_wred_pending_list);
+        p_pending != NULL;
+        p_pending = (sai_qos_wred_pending_t *) std_dll_getnext(&sai_qos_wred_pending_list,
+                                                              &p_pending->dll_glue)) {
+        if(p_pending->wred_id == wred_id) {
+            return p_pending;
+        }
+    }
+
+    return NULL;
+}
+
+/* Record the profile programmed on the links before its first deferred change */
+static sai_status_t sai_qos_wred_pending_add(dn_sai_qos_wred_t *p_wred_node)
+{
+    sai_qos_wred_pending_t *p_pending = NULL;
+
+    if(sai_qos_wred_pending_get(p_wred_node->key.wred_id) != NULL) {
+        return SAI_STATUS_SUCCESS;
+    }
+
+    if(!sai_qos_wred_pending_list_init) {
+        std_dll_init(&sai_qos_wred_pending_list);
+        sai_qos_wred_pending_list_init = true;
+    }
+
+    p_pending = (sai_qos_wred_pending_t *) calloc(1, sizeof(sai_qos_wred_pending_t));
+    if(p_pending == NULL) {
+        return SAI_STATUS_NO_MEMORY;
+    }
+
+    p_pending->wred_id = p_wred_node->key.wred_id;
+    memcpy(&p_pending->propagated_node, p_wred_node, sizeof(dn_sai_qos_wred_t));
+
+    std_dll_insertatback(&sai_qos_wred_pending_list, &p_pending->dll_glue);
+
+    return SAI_STATUS_SUCCESS;
+}
+
+static void sai_qos_wred_pending_remove(sai_qos_wred_pending_t *p_pending)
+{
+    std_dll_remove(&sai_qos_wred_pending_list, &p_pending->dll_glue);
+    free(p_pending);
+}
+
+/* Restore the profile configuration, keeping the current link lists */
+static void sai_qos_wred_node_config_restore(dn_sai_qos_wred_t *p_wred_node,
+                                             const dn_sai_qos_wred_t *p_saved_node)
+{
+    std_dll_head           link_head[DN_SAI_QOS_WRED_LINK_MAX];
+    std_dll_head          *p_dll_head = NULL;
+    dn_sai_qos_wred_link_t wred_link_type = DN_SAI_QOS_WRED_LINK_QUEUE;
+
+    for(wred_link_type = DN_SAI_QOS_WRED_LINK_QUEUE;
+            wred_link_type < DN_SAI_QOS_WRED_LINK_MAX;
+            wred_link_type++) {
+        p_dll_head = sai_qos_wred_link_get_head_ptr(p_wred_node, wred_link_type);
+        if(p_dll_head != NULL) {
+            link_head[wred_link_type] = *p_dll_head;
+        }
+    }
+
+    memcpy(p_wred_node, p_saved_node, sizeof(dn_sai_qos_wred_t));
+
+    for(wred_link_type = DN_SAI_QOS_WRED_LINK_QUEUE;
+            wred_link_type < DN_SAI_QOS_WRED_LINK_MAX;
+            wred_link_type++) {
+        p_dll_head = sai_qos_wred_link_get_head_ptr(p_wred_node, wred_link_type);
+        if(p_dll_head != NULL) {
+            *p_dll_head = link_head[wred_link_type];
+        }
+    }
+}
+
+/*
+ * Propagate a pending WRED profile to its links and drop the entry. On
+ * failure the links and the WRED node are restored to the last propagated
+ * profile.
+ */
+static sai_status_t sai_qos_wred_pending_propagate(sai_qos_wred_pending_t *p_pending)
+{
+    dn_sai_qos_wred_t      *p_wred_node = NULL;
+    sai_status_t            sai_rc = SAI_STATUS_SUCCESS;
+
+    p_wred_node = sai_qos_wred_node_get(p_pending->wred_id);
+
+    if(p_wred_node != NULL) {
+        sai_rc = sai_wred_update_link(&p_pending->propagated_node, p_wred_node);
+
+        if(sai_rc != SAI_STATUS_SUCCESS) {
+            SAI_WRED_LOG_ERR("Deferred update of WRED 0x%"PRIx64" failed, "
+                             "restoring the previous profile", p_pending->wred_id);
+            sai_qos_wred_node_config_restore(p_wred_node, &p_pending->propagated_node);
+        }
+    }
+
+    sai_qos_wred_pending_remove(p_pending);
+
+    return sai_rc;
+}
+
+/* Propagate every pending WRED profile to its links once */
+static sai_status_t sai_qos_wred_pending_flush(void)
+{
+    sai_qos_wred_pending_t *p_pending = NULL;
+    sai_status_t            sai_rc = SAI_STATUS_SUCCESS;
+    sai_status_t            ret_rc = SAI_STATUS_SUCCESS;
+
+    if(!sai_qos_wred_pending_list_init) {
+        return SAI_STATUS_SUCCESS;
+    }
+
+    while((p_pending = (sai_qos_wred_pending_t *)
+           std_dll_getfirst(&sai_qos_wred_pending_list)) != NULL) {
+        sai_rc = sai_qos_wred_pending_propagate(p_pending);
+
+        if((sai_rc != SAI_STATUS_SUCCESS) && (ret_rc == SAI_STATUS_SUCCESS)) {
+            ret_rc = sai_rc;
+        }
+    }
+
+    return ret_rc;
+}
+
+sai_status_t sai_qos_wred_update_defer_begin(void)
+{
+    sai_qos_lock();
+    sai_qos_wred_defer_count++;
+    sai_qos_unlock();
+
+    return SAI_STATUS_SUCCESS;
+}
+
+sai_status_t sai_qos_wred_update_defer_end(void)
+{
+    sai_status_t sai_rc = SAI_STATUS_SUCCESS;
+
+    sai_qos_lock();
+
+    if(sai_qos_wred_defer_count == 0) {
+        sai_qos_unlock();
+        return SAI_STATUS_INVALID_PARAMETER;
+    }
+
+    sai_qos_wred_defer_count--;
+
+    if(sai_qos_wred_defer_count == 0) {
+        sai_rc = sai_qos_wred_pending_flush();
+    }
+
+    sai_qos_unlock();
+
+    return sai_rc;
+}
+
+static sai_status_t sai_qos_wred_remove_internal(sai_object_id_t wred_id)
 {
     dn_sai_qos_wred_t  *p_wred_node = NULL;
+    sai_qos_wred_pending_t *p_pending = NULL;
     sai_status_t      sai_rc = SAI_STATUS_SUCCESS;
 
     if(!sai_is_obj_id_wred(wred_id)) {
@@ -358,7 +674,6 @@ static sai_status_t sai_qos_wred_remove(sai_object_id_t wred_id)
     }
 
     SAI_WRED_LOG_TRACE("Removing wred id 0x%"PRIx64"",wred_id);
-    sai_qos_lock();
     do
     {
         p_wred_node = sai_qos_wred_node_get(wred_id);
@@ -384,95 +699,31 @@ static sai_status_t sai_qos_wred_remove(sai_object_id_t wred_id)
             break;
         }
 
+        p_pending = sai_qos_wred_pending_get(wred_id);
+        if(p_pending != NULL) {
+            sai_qos_wred_pending_remove(p_pending);
+        }
+
         sai_qos_wred_node_remove(wred_id);
         sai_qos_wred_free_resources(p_wred_node);
     }while(0);
 
-    sai_qos_unlock();
     return sai_rc;
 }
 
-static void sai_wred_link_error_recovery(dn_sai_qos_wred_t *p_wred_old,
-        uint_t count, dn_sai_qos_wred_link_t wred_link_type)
-{
-    void *p_wred_link_node = NULL;
-    sai_status_t sai_rc = SAI_STATUS_SUCCESS;
-    sai_object_id_t wred_link_id = SAI_NULL_OBJECT_ID;
-
-    STD_ASSERT(p_wred_old != NULL);
-
-    if(0 == count)
-    {
-        return;
-    }
-
-    p_wred_link_node = sai_qos_wred_link_node_get_first(p_wred_old, wred_link_type);
-
-    while((p_wred_link_node != NULL) && (count > 0)){
-        wred_link_id = sai_qos_wred_link_oid_get(p_wred_link_node,wred_link_type);
-        SAI_WRED_LOG_TRACE("Recovering WRED ID 0x%"PRIx64" for %s 0x%"PRIx64"",
-                p_wred_old->key.wred_id,sai_qos_wred_link_str(wred_link_type),wred_link_id);
-        sai_rc = sai_qos_wred_npu_api_get()->wred_link_set(wred_link_id, p_wred_old, wred_link_type);
-
-        if(sai_rc != SAI_STATUS_SUCCESS){
-            SAI_WRED_LOG_ERR("Recovering WRED ID 0x%"PRIx64" for %s 0x%"PRIx64" failed, sai_rc 0x%x.",
-                    p_wred_old->key.wred_id,sai_qos_wred_link_str(wred_link_type),wred_link_id,sai_rc);
-            break;
-        }
-        p_wred_link_node = sai_qos_wred_link_node_get_next(p_wred_old, p_wred_link_node, wred_link_type);
-        count --;
-    }
-}
-
-static sai_status_t sai_wred_update_link(dn_sai_qos_wred_t *p_wred_new)
+static sai_status_t sai_qos_wred_remove(sai_object_id_t wred_id)
 {
-    void                    *p_wred_link_node = NULL;
-    dn_sai_qos_wred_t *p_wred_node_old = NULL;
     sai_status_t sai_rc = SAI_STATUS_SUCCESS;
-    dn_sai_qos_wred_link_t  wred_link_type = DN_SAI_QOS_WRED_LINK_QUEUE;
-    sai_object_id_t         wred_link_id = SAI_NULL_OBJECT_ID;
-    uint_t count = 0;
-
-    STD_ASSERT(p_wred_new != NULL);
-    p_wred_node_old = sai_qos_wred_node_get(p_wred_new->key.wred_id);
-
-    if(p_wred_node_old == NULL){
-        SAI_WRED_LOG_ERR("WRED node not found for WRED ID 0x%"PRIx64"", p_wred_new->key.wred_id);
-        return SAI_STATUS_INVALID_OBJECT_ID;
-    }
-
-    for(wred_link_type = DN_SAI_QOS_WRED_LINK_QUEUE;
-            wred_link_type < DN_SAI_QOS_WRED_LINK_MAX;
-            wred_link_type++) {
-        p_wred_link_node = sai_qos_wred_link_node_get_first(p_wred_node_old, wred_link_type);
 
-        while(p_wred_link_node != NULL){
-            wred_link_id = sai_qos_wred_link_oid_get(p_wred_link_node,wred_link_type);
-            SAI_WRED_LOG_TRACE("Updating WRED ID to 0x%"PRIx64" for %s 0x%"PRIx64"",
-                    p_wred_new->key.wred_id,
-                    sai_qos_wred_link_str(wred_link_type),
-                    wred_link_id);
-            sai_rc =
-                sai_qos_wred_npu_api_get()->wred_link_set(wred_link_id, p_wred_new, wred_link_type);
-
-        if(sai_rc != SAI_STATUS_SUCCESS){
-                SAI_WRED_LOG_TRACE("Updating WRED ID to 0x%"PRIx64" for %s 0x%"PRIx64" failed",
-                        p_wred_new->key.wred_id,
-                        sai_qos_wred_link_str(wred_link_type),
-                        wred_link_id);
-                sai_wred_link_error_recovery(p_wred_node_old, count, wred_link_type);
-            break;
-        }
-            p_wred_link_node =
-                sai_qos_wred_link_node_get_next(p_wred_node_old,p_wred_link_node,wred_link_type);
-        count ++;
-        }
-    }
+    sai_qos_lock();
+    sai_rc = sai_qos_wred_remove_internal(wred_id);
+    sai_qos_unlock();
 
     return sai_rc;
 }
-static sai_status_t sai_qos_wred_attribute_set(sai_object_id_t wred_id,
-                                              const sai_attribute_t *p_attr)
+
+static sai_status_t sai_qos_wred_attribute_set_internal(sai_object_id_t wred_id,
+                                                       const sai_attribute_t *p_attr)
 {
     dn_sai_qos_wred_t   wred_new_node;
     dn_sai_qos_wred_t   *p_wred_exist_node = NULL;
@@ -488,7 +739,6 @@ static sai_status_t sai_qos_wred_attribute_set(sai_object_id_t wred_id,
         SAI_WRED_LOG_ERR("Passed object is not wred object");
         return SAI_STATUS_INVALID_OBJECT_TYPE;
     }
-    sai_qos_lock();
 
     do
     {
@@ -526,7 +776,12 @@ static sai_status_t sai_qos_wred_attribute_set(sai_object_id_t wred_id,
                               "for wred 0x%"PRIx64"", p_attr->id, wred_id);
 
         if(!sai_qos_wred_npu_api_get()->wred_is_hw_object()){
-            sai_rc = sai_wred_update_link(&wred_new_node);
+            if(sai_qos_wred_defer_count > 0) {
+                /* Links are updated once when the deferral ends */
+                sai_rc = sai_qos_wred_pending_add(p_wred_exist_node);
+            } else {
+                sai_rc = sai_wred_update_link(p_wred_exist_node, &wred_new_node);
+            }
             if(sai_rc != SAI_STATUS_SUCCESS) {
                 SAI_WRED_LOG_ERR("Error: Unable to update queuelist");
                 break;
@@ -536,8 +791,6 @@ static sai_status_t sai_qos_wred_attribute_set(sai_object_id_t wred_id,
         memcpy(p_wred_exist_node, &wred_new_node, sizeof(dn_sai_qos_wred_t));
     }while(0);
 
-    sai_qos_unlock();
-
     if(sai_rc == SAI_STATUS_SUCCESS){
         SAI_WRED_LOG_INFO("Set attribute success for wred 0x%"PRIx64" for attr %d",
                               p_wred_exist_node->key.wred_id, p_attr->id);
@@ -546,6 +799,18 @@ static sai_status_t sai_qos_wred_attribute_set(sai_object_id_t wred_id,
     return sai_rc;
 }
 
+static sai_status_t sai_qos_wred_attribute_set(sai_object_id_t wred_id,
+                                              const sai_attribute_t *p_attr)
+{
+    sai_status_t sai_rc = SAI_STATUS_SUCCESS;
+
+    sai_qos_lock();
+    sai_rc = sai_qos_wred_attribute_set_internal(wred_id, p_attr);
+    sai_qos_unlock();
+
+    return sai_rc;
+}
+
 static sai_status_t sai_qos_wred_attribute_get(sai_object_id_t wred_id,
                                        uint32_t attr_count,
                                        sai_attribute_t *attr_list)
@@ -909,6 +1174,89 @@ sai_status_t sai_qos_wred_link_apply_cache(sai_object_id_t queue_id)
 
     return SAI_STATUS_SUCCESS;
 }
+
+sai_status_t sai_qos_wred_bulk_create(sai_object_id_t switch_id,
+                                      uint32_t object_count,
+                                      const uint32_t *attr_count,
+                                      const sai_attribute_t **attr_list,
+                                      dn_sai_qos_bulk_op_error_mode_t mode,
+                                      sai_object_id_t *object_id,
+                                      sai_status_t *object_statuses)
+{
+    return sai_qos_bulk_object_create(sai_qos_wred_create_internal, switch_id,
+                                      object_count, attr_count, attr_list,
+                                      mode, object_id, object_statuses);
+}
+
+sai_status_t sai_qos_wred_bulk_remove(uint32_t object_count,
+                                      const sai_object_id_t *object_id,
+                                      dn_sai_qos_bulk_op_error_mode_t mode,
+                                      sai_status_t *object_statuses)
+{
+    return sai_qos_bulk_object_remove(sai_qos_wred_remove_internal, object_count,
+                                      object_id, mode, object_statuses);
+}
+
+/*
+ * Attribute changes of the batch are propagated to the links once per WRED
+ * profile, unless an enclosing deferral window propagates them later.
+ */
+sai_status_t sai_qos_wred_bulk_set(uint32_t object_count,
+                                   const sai_object_id_t *object_id,
+                                   const sai_attribute_t *attr_list,
+                                   dn_sai_qos_bulk_op_error_mode_t mode,
+                                   sai_status_t *object_statuses)
+{
+    sai_status_t            sai_rc = SAI_STATUS_SUCCESS;
+    sai_status_t            flush_rc = SAI_STATUS_SUCCESS;
+    sai_qos_wred_pending_t *p_pending = NULL;
+    bool                    is_outer_defer = false;
+    uint32_t                index = 0;
+    uint32_t                next = 0;
+
+    sai_qos_lock();
+
+    is_outer_defer = (sai_qos_wred_defer_count > 0);
+    sai_qos_wred_defer_count++;
+
+    sai_rc = sai_qos_bulk_object_set_internal(sai_qos_wred_attribute_set_internal,
+                                              object_count, object_id, attr_list,
+                                              mode, object_statuses);
+
+    sai_qos_wred_defer_count--;
+
+    if((!is_outer_defer) && (sai_rc != SAI_STATUS_INVALID_PARAMETER)) {
+        for(index = 0; index < object_count; index++) {
+            if(object_statuses[index] != SAI_STATUS_SUCCESS) {
+                continue;
+            }
+
+            p_pending = sai_qos_wred_pending_get(object_id[index]);
+            if(p_pending == NULL) {
+                continue;
+            }
+
+            flush_rc = sai_qos_wred_pending_propagate(p_pending);
+            if(flush_rc == SAI_STATUS_SUCCESS) {
+                continue;
+            }
+
+            /* Every set of the batch on this profile is rolled back */
+            for(next = index; next < object_count; next++) {
+                if((object_id[next] == object_id[index]) &&
+                   (object_statuses[next] == SAI_STATUS_SUCCESS)) {
+                    object_statuses[next] = flush_rc;
+                }
+            }
+            sai_rc = SAI_STATUS_FAILURE;
+        }
+    }
+
+    sai_qos_unlock();
+
+    return sai_rc;
+}
+
 /* API method table for Qos wred to be returned during query.
  **/
 static sai_wred_api_t sai_qos_wred_method_table = {
@@ -18,6 +18,7 @@
 #include "saitypes.h"
 #include "sai_l3_util.h"
 #include "sai_l3_common.h"
+#include "sai_l3_api_utils.h"
 #include "sai_debug_utils.h"
 #include "std_type_defs.h"
 #include "std_mac_utils.h"
@@ -61,6 +62,7 @@ void sai_fib_dump_help (void)
     SAI_DEBUG ("  void sai_fib_dump_dep_encap_nh_list_for_nhg (sai_object_id_t nhg_id");
     SAI_DEBUG ("  void sai_fib_dump_dep_route_list_for_encap_nh (sai_object_id_t nh_id");
     SAI_DEBUG ("  void sai_fib_dump_dep_nhg_list_for_encap_nh (sai_object_id_t nh_id");
+    SAI_DEBUG ("  void sai_fib_dump_encap_nh_dep_route_walk_stats (void)");
 }
 
 void sai_fib_dump_vr_node (sai_fib_vrf_t *p_vrf_node)
@@ -836,3 +838,18 @@ void sai_fib_dump_dep_nhg_list_for_encap_nh (sai_object_id_t nh_id)
         sai_fib_dump_nh_group_node (p_nh_group);
     }
 }
+
+void sai_fib_dump_encap_nh_dep_route_walk_stats (void)
+{
+    sai_fib_encap_nh_walk_stats_t stats;
+
+    sai_fib_encap_nh_dep_route_walk_stats_get (&stats);
+
+    SAI_DEBUG ("******** Encap Next Hop Dependent Route Walker Stats ********");
+    SAI_DEBUG ("Pending Encap Next Hops: %u, Routes walked: %"PRIu64", "
+               "Batches: %"PRIu64", Walks completed: %"PRIu64".",
+               stats.pending_encap_nh_count, stats.routes_walked,
+               stats.batches, stats.walks_completed);
+    SAI_DEBUG ("Last walk latency: %"PRIu64" us, Max walk latency: %"PRIu64" us.",
+               stats.last_walk_latency_us, stats.max_walk_latency_us);
+}
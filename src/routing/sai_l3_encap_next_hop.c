@@ -31,12 +31,37 @@
 #include "sai_tunnel_util.h"
 #include "std_assert.h"
 #include "std_thread_tools.h"
+#include "std_rbtree.h"
+#include "std_llist.h"
 #include <inttypes.h>
 #include <string.h>
+#include <stdlib.h>
+#include <sched.h>
+#include <time.h>
+
+/*
+ * Pending dependent route walk for an Encap Next Hop. The walk visits the
+ * routes in the Encap Next Hop's dependent route list and p_next_route is
+ * the resume cursor across FIB lock releases.
+ */
+typedef struct _sai_fib_encap_nh_walk_entry_t {
+    /* Must be the first member, entry is linked in the pending walk list */
+    std_dll          dll_glue;
+    sai_fib_nh_t    *p_encap_nh;
+    sai_fib_route_t *p_next_route;
+    bool             walk_started;
+    uint64_t         enqueue_time_us;
+} sai_fib_encap_nh_walk_entry_t;
 
 static std_thread_create_param_t thread;
 static int sai_fib_encap_nh_route_walker_fd [SAI_FIB_MAX_FD];
 
+/* Pending walks in FIFO order and indexed by the Encap Next Hop pointer */
+static std_dll_head  sai_fib_encap_nh_walk_list;
+static rbtree_handle sai_fib_encap_nh_walk_tree = NULL;
+static sai_fib_encap_nh_walk_stats_t sai_fib_encap_nh_walk_stats;
+static sai_fib_encap_nh_walk_visit_fn sai_fib_encap_nh_walk_visit_fn = NULL;
+
 void sai_fib_encap_next_hop_log_trace (sai_fib_nh_t *p_encap_nh,
                                        const char *p_trace_str)
 {
@@ -337,21 +362,101 @@ static void sai_fib_encap_next_hop_remove_from_underlay_obj (
 /*
  * Routines for resolving encap next hop object.
  */
-static void sai_fib_encap_nh_dep_routes_add_to_changelist (sai_fib_nh_t *p_encap_nh)
+static uint64_t sai_fib_encap_nh_walk_time_us_get (void)
 {
-    sai_fib_route_t  *p_route;
-    sai_fib_vrf_t    *p_vrf_node = NULL;
+    struct timespec ts;
+
+    clock_gettime (CLOCK_MONOTONIC, &ts);
+
+    return (((uint64_t) ts.tv_sec * 1000000) + (ts.tv_nsec / 1000));
+}
+
+static sai_fib_encap_nh_walk_entry_t *sai_fib_encap_nh_walk_entry_get (
+                                                     sai_fib_nh_t *p_encap_nh)
+{
+    sai_fib_encap_nh_walk_entry_t  tmp_entry;
+
+    if (sai_fib_encap_nh_walk_tree == NULL) {
+        return NULL;
+    }
+
+    memset (&tmp_entry, 0, sizeof (tmp_entry));
+
+    tmp_entry.p_encap_nh = p_encap_nh;
+
+    return ((sai_fib_encap_nh_walk_entry_t *)
+            std_rbtree_getexact (sai_fib_encap_nh_walk_tree, &tmp_entry));
+}
+
+static void sai_fib_encap_nh_walk_entry_free (
+                                    sai_fib_encap_nh_walk_entry_t *p_entry)
+{
+    std_rbtree_remove (sai_fib_encap_nh_walk_tree, p_entry);
+
+    std_dll_remove (&sai_fib_encap_nh_walk_list, &p_entry->dll_glue);
+
+    sai_fib_encap_nh_walk_stats.pending_encap_nh_count--;
+
+    free (p_entry);
+}
+
+/*
+ * Queue the routes in the Encap Next Hop's dependent route list for
+ * reprogramming. If a walk is already pending for the Encap Next Hop, it is
+ * restarted from the first dependent route.
+ */
+static void sai_fib_encap_nh_dep_routes_walk_enqueue (sai_fib_nh_t *p_encap_nh)
+{
+    sai_fib_encap_nh_walk_entry_t *p_entry;
+
+    if (sai_fib_get_first_dep_route_from_nh (p_encap_nh) == NULL) {
+        return;
+    }
+
+    p_entry = sai_fib_encap_nh_walk_entry_get (p_encap_nh);
+
+    if (p_entry != NULL) {
+
+        p_entry->walk_started = false;
+        p_entry->p_next_route = NULL;
+
+        return;
+    }
+
+    p_entry = (sai_fib_encap_nh_walk_entry_t *) calloc (1, sizeof (*p_entry));
+
+    if (p_entry == NULL) {
+
+        sai_fib_encap_next_hop_log_error (p_encap_nh, "Failed to allocate "
+                                          "dependent route walk entry.");
+        return;
+    }
+
+    p_entry->p_encap_nh = p_encap_nh;
+    p_entry->enqueue_time_us = sai_fib_encap_nh_walk_time_us_get ();
 
-    for (p_route = sai_fib_get_first_dep_route_from_nh (p_encap_nh);
-         p_route != NULL;
-         p_route = sai_fib_get_next_dep_route_from_nh (p_encap_nh, p_route)) {
+    if (std_rbtree_insert (sai_fib_encap_nh_walk_tree, p_entry) != STD_ERR_OK) {
 
-        p_vrf_node = sai_fib_vrf_node_get (p_route->vrf_id);
+        sai_fib_encap_next_hop_log_error (p_encap_nh, "Failed to insert "
+                                          "dependent route walk entry.");
+        free (p_entry);
 
-        STD_ASSERT (p_vrf_node != NULL);
+        return;
+    }
+
+    std_dll_insertatback (&sai_fib_encap_nh_walk_list, &p_entry->dll_glue);
+
+    sai_fib_encap_nh_walk_stats.pending_encap_nh_count++;
+}
+
+static void sai_fib_encap_nh_dep_routes_walk_dequeue (sai_fib_nh_t *p_encap_nh)
+{
+    sai_fib_encap_nh_walk_entry_t *p_entry;
 
-        std_radical_appendtochangelist (p_vrf_node->sai_route_tree,
-                                        &p_route->rt_head);
+    p_entry = sai_fib_encap_nh_walk_entry_get (p_encap_nh);
+
+    if (p_entry != NULL) {
+        sai_fib_encap_nh_walk_entry_free (p_entry);
     }
 }
 
@@ -403,7 +508,7 @@ static sai_status_t sai_fib_encap_nh_lpm_route_attr_set (
     }
 
     /* Update the routes in Encap Next Hop's dependent route list */
-    sai_fib_encap_nh_dep_routes_add_to_changelist (p_encap_nh);
+    sai_fib_encap_nh_dep_routes_walk_enqueue (p_encap_nh);
 
     return SAI_STATUS_SUCCESS;
 }
@@ -542,7 +647,7 @@ static sai_status_t sai_fib_encap_nh_neighbor_resolve (sai_fib_nh_t *p_encap_nh,
     }
 
     /* Update the routes in Encap Next Hop's dependent route list */
-    sai_fib_encap_nh_dep_routes_add_to_changelist (p_encap_nh);
+    sai_fib_encap_nh_dep_routes_walk_enqueue (p_encap_nh);
 
     return status;
 }
@@ -558,7 +663,7 @@ static sai_status_t sai_fib_encap_nh_underlay_obj_resolve (
     /* Get the underlay VRF to be used for resolving the next hop ip address */
     underlay_vrf_id = dn_sai_tunnel_underlay_vr_get (p_encap_nh->tunnel_id);
 
-    p_vrf_node = sai_fib_vrf_node_get (underlay_vrf_id);
+    p_vrf_node = sai_fib_vrf_node_index_get (underlay_vrf_id);
 
     if (p_vrf_node == NULL) {
 
@@ -611,20 +716,27 @@ void sai_fib_encap_nh_dep_route_add (sai_fib_route_t *p_route)
 
 void sai_fib_encap_nh_dep_route_remove (sai_fib_route_t *p_route)
 {
-    sai_fib_nh_t *p_encap_nh = p_route->nh_info.nh_node;
+    sai_fib_nh_t                  *p_encap_nh = p_route->nh_info.nh_node;
+    sai_fib_encap_nh_walk_entry_t *p_entry;
 
     if ((p_route->nh_type == SAI_OBJECT_TYPE_NEXT_HOP) &&
         (sai_fib_is_tunnel_encap_next_hop (p_encap_nh))) {
 
+        /* Move a pending walk's cursor past the route being removed */
+        p_entry = sai_fib_encap_nh_walk_entry_get (p_encap_nh);
+
+        if ((p_entry != NULL) && (p_entry->p_next_route == p_route)) {
+            p_entry->p_next_route =
+                sai_fib_get_next_dep_route_from_nh (p_encap_nh, p_route);
+        }
+
         std_dll_remove (&p_encap_nh->dep_route_list,
                         &p_route->nh_dep_route_link);
     }
 }
 
-int sai_fib_encap_nh_dep_route_walk_cb (std_radical_head_t *p_rt_head,
-                                        va_list ap)
+static sai_status_t sai_fib_encap_nh_dep_route_reprogram (sai_fib_route_t *p_route)
 {
-    sai_fib_route_t  *p_route = (sai_fib_route_t *) p_rt_head;
     char              addr_str [SAI_FIB_MAX_BUFSZ];
     sai_status_t      status;
 
@@ -667,30 +779,119 @@ static void sai_fib_encap_nh_signal_dep_route_walk (void)
     }
 }
 
-static void sai_fib_encap_nh_dep_route_changelist_walk (void)
+/*
+ * Walks the pending Encap Next Hop dependent route lists, reprogramming at
+ * most SAI_FIB_MAX_DEP_ROUTES_WALK_COUNT routes per FIB lock hold. Returns
+ * true if there is more pending work.
+ */
+static bool sai_fib_encap_nh_dep_route_walk_batch (void)
 {
-    rbtree_handle  vr_tree;
-    sai_fib_vrf_t *p_vrf_node = NULL;
-    int ret;
+    sai_fib_encap_nh_walk_entry_t *p_entry;
+    sai_fib_route_t               *p_route;
+    uint_t                         walk_count = 0;
+    uint64_t                       latency_us = 0;
+    bool                           more_work = false;
 
     sai_fib_lock ();
 
-    /* Scan the VRFs */
-    vr_tree = sai_fib_access_global_config()->vrf_tree;
+    while (walk_count < SAI_FIB_MAX_DEP_ROUTES_WALK_COUNT) {
 
-    p_vrf_node = std_rbtree_getfirst (vr_tree);
+        p_entry = (sai_fib_encap_nh_walk_entry_t *)
+                  std_dll_getfirst (&sai_fib_encap_nh_walk_list);
 
-    while (p_vrf_node) {
+        if (p_entry == NULL) {
+            break;
+        }
+
+        if (!p_entry->walk_started) {
+
+            p_entry->walk_started = true;
+            p_entry->p_next_route =
+                sai_fib_get_first_dep_route_from_nh (p_entry->p_encap_nh);
+        }
+
+        p_route = p_entry->p_next_route;
+
+        if (p_route == NULL) {
+
+            latency_us = sai_fib_encap_nh_walk_time_us_get () -
+                         p_entry->enqueue_time_us;
+
+            sai_fib_encap_nh_walk_stats.walks_completed++;
+            sai_fib_encap_nh_walk_stats.last_walk_latency_us = latency_us;
+
+            if (latency_us > sai_fib_encap_nh_walk_stats.max_walk_latency_us) {
+                sai_fib_encap_nh_walk_stats.max_walk_latency_us = latency_us;
+            }
+
+            sai_fib_encap_nh_walk_entry_free (p_entry);
+
+            continue;
+        }
 
-        std_radical_walkchangelist (p_vrf_node->sai_route_tree,
-                                    &p_vrf_node->route_marker,
-                                    sai_fib_encap_nh_dep_route_walk_cb, 0,
-                                    SAI_FIB_MAX_DEP_ROUTES_WALK_COUNT,
-                                    std_radix_getversion(p_vrf_node->sai_route_tree),
-                                    &ret);
+        p_entry->p_next_route =
+            sai_fib_get_next_dep_route_from_nh (p_entry->p_encap_nh, p_route);
+
+        sai_fib_encap_nh_dep_route_reprogram (p_route);
+
+        if (sai_fib_encap_nh_walk_visit_fn != NULL) {
+            sai_fib_encap_nh_walk_visit_fn (p_route);
+        }
+
+        sai_fib_encap_nh_walk_stats.routes_walked++;
+
+        walk_count++;
+    }
+
+    sai_fib_encap_nh_walk_stats.batches++;
+
+    more_work = (std_dll_getfirst (&sai_fib_encap_nh_walk_list) != NULL);
+
+    sai_fib_unlock ();
+
+    return more_work;
+}
+
+static void sai_fib_encap_nh_dep_route_pending_walk (void)
+{
+    while (sai_fib_encap_nh_dep_route_walk_batch ()) {
 
-        p_vrf_node = std_rbtree_getnext (vr_tree, p_vrf_node);
+        /* Let the route programming threads take the FIB lock */
+        sched_yield ();
     }
+}
+
+void sai_fib_encap_nh_dep_route_walk_stats_get (
+                                       sai_fib_encap_nh_walk_stats_t *p_stats)
+{
+    STD_ASSERT (p_stats != NULL);
+
+    sai_fib_lock ();
+
+    memcpy (p_stats, &sai_fib_encap_nh_walk_stats, sizeof (*p_stats));
+
+    sai_fib_unlock ();
+}
+
+void sai_fib_encap_nh_dep_route_walk_visit_fn_set (
+                                       sai_fib_encap_nh_walk_visit_fn visit_fn)
+{
+    sai_fib_lock ();
+
+    sai_fib_encap_nh_walk_visit_fn = visit_fn;
+
+    sai_fib_unlock ();
+}
+
+void sai_fib_encap_nh_dep_route_walk_stats_clear (void)
+{
+    sai_fib_lock ();
+
+    sai_fib_encap_nh_walk_stats.routes_walked = 0;
+    sai_fib_encap_nh_walk_stats.batches = 0;
+    sai_fib_encap_nh_walk_stats.walks_completed = 0;
+    sai_fib_encap_nh_walk_stats.last_walk_latency_us = 0;
+    sai_fib_encap_nh_walk_stats.max_walk_latency_us = 0;
 
     sai_fib_unlock ();
 }
@@ -704,7 +905,7 @@ void sai_fib_route_attr_set_affected_encap_nh_update (
     sai_fib_nh_t     *p_next_encap_nh;
     sai_fib_vrf_t    *p_vrf_node = NULL;
 
-    p_vrf_node = sai_fib_vrf_node_get (p_route_node->vrf_id);
+    p_vrf_node = sai_fib_vrf_node_index_get (p_route_node->vrf_id);
 
     if (p_vrf_node == NULL) {
         SAI_ROUTE_LOG_ERR ("VRF ID 0x%"PRIx64" does not exist in VRF tree.",
@@ -736,7 +937,7 @@ static void sai_fib_route_create_affected_encap_nh_update (
     sai_fib_vrf_t    *p_vrf_node = NULL;
     sai_ip_address_t  mask;
 
-    p_vrf_node = sai_fib_vrf_node_get (p_new_route->vrf_id);
+    p_vrf_node = sai_fib_vrf_node_index_get (p_new_route->vrf_id);
 
     if (p_vrf_node == NULL) {
         SAI_ROUTE_LOG_ERR ("VRF ID 0x%"PRIx64" does not exist in VRF tree.",
@@ -785,7 +986,7 @@ static void sai_fib_route_del_affected_encap_nh_update (
     sai_fib_nh_t     *p_next_encap_nh;
     sai_fib_vrf_t    *p_vrf_node = NULL;
 
-    p_vrf_node = sai_fib_vrf_node_get (p_route->vrf_id);
+    p_vrf_node = sai_fib_vrf_node_index_get (p_route->vrf_id);
 
     if (p_vrf_node == NULL) {
         SAI_ROUTE_LOG_ERR ("VRF ID 0x%"PRIx64" does not exist in VRF tree.",
@@ -839,7 +1040,7 @@ void sai_fib_neighbor_affected_encap_nh_resolve (sai_fib_nh_t *p_neighbor,
 
     memset (&key, 0, sizeof (sai_fib_nh_key_t));
 
-    p_vrf_node = sai_fib_vrf_node_get (p_neighbor->vrf_id);
+    p_vrf_node = sai_fib_vrf_node_index_get (p_neighbor->vrf_id);
 
     if (p_vrf_node == NULL) {
 
@@ -966,7 +1167,7 @@ static void *sai_fib_encap_nh_dep_route_walk_main (void *param)
         len = read (sai_fib_encap_nh_route_walker_fd[SAI_FIB_READ_FD], &wake,
                     sizeof(bool));
         if (len && wake) {
-           sai_fib_encap_nh_dep_route_changelist_walk ();
+           sai_fib_encap_nh_dep_route_pending_walk ();
         }
     }
 
@@ -975,6 +1176,22 @@ static void *sai_fib_encap_nh_dep_route_walk_main (void *param)
 
 sai_status_t sai_fib_encap_nh_dep_route_walker_create (void)
 {
+    std_dll_init (&sai_fib_encap_nh_walk_list);
+
+    memset (&sai_fib_encap_nh_walk_stats, 0,
+            sizeof (sai_fib_encap_nh_walk_stats));
+
+    sai_fib_encap_nh_walk_tree = std_rbtree_create_simple (
+                  "encap_nh_dep_route_walk_tree",
+                  STD_STR_OFFSET_OF (sai_fib_encap_nh_walk_entry_t, p_encap_nh),
+                  STD_STR_SIZE_OF (sai_fib_encap_nh_walk_entry_t, p_encap_nh));
+
+    if (sai_fib_encap_nh_walk_tree == NULL) {
+        SAI_ROUTER_LOG_CRIT ("Encap NH Dep Route walk tree init failed");
+
+        return SAI_STATUS_NO_MEMORY;
+    }
+
     if (pipe (sai_fib_encap_nh_route_walker_fd) != 0) {
         SAI_ROUTER_LOG_CRIT ("Encap NH Dep Route walker pipe init failed");
 
@@ -1044,6 +1261,8 @@ sai_status_t sai_fib_encap_next_hop_remove (sai_fib_nh_t *p_encap_nh)
 
     sai_fib_encap_next_hop_remove_from_underlay_obj (p_encap_nh);
 
+    sai_fib_encap_nh_dep_routes_walk_dequeue (p_encap_nh);
+
     dn_sai_tunnel_encap_nh_remove_from_tunnel_list (p_encap_nh);
 
     return SAI_STATUS_SUCCESS;
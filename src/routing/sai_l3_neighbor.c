@@ -37,10 +37,243 @@
 #include "sai_fdb_main.h"
 #include "sai_fdb_common.h"
 #include <string.h>
+#include <stdlib.h>
 #include <inttypes.h>
 
+/*
+ * Open addressing hash index of the Neighbor MAC entries, fronting the
+ * neighbor_mac_tree on the FDB event path. The (VLAN, MAC) key is packed
+ * in the slot so that a probe does not touch the MAC entry node unless
+ * the key matches. The radix tree is kept for the ordered debug walk.
+ */
+#define SAI_FIB_NEIGHBOR_MAC_HASH_DFLT_SCALE  (16384)
+#define SAI_FIB_NEIGHBOR_MAC_HASH_MIN_SIZE    (1024)
+#define SAI_FIB_NEIGHBOR_MAC_HASH_TOMBSTONE   \
+        ((sai_fib_neighbor_mac_entry_t *) 1)
+
+typedef struct _sai_fib_neighbor_mac_hash_slot_t {
+    uint64_t                      packed_key;
+    sai_fib_neighbor_mac_entry_t *p_mac_entry;
+} sai_fib_neighbor_mac_hash_slot_t;
+
+typedef struct _sai_fib_neighbor_mac_hash_t {
+    sai_fib_neighbor_mac_hash_slot_t *p_slots;
+    /* Number of slots, always a power of 2 */
+    uint_t                            size;
+    uint_t                            count;
+    uint_t                            tombstones;
+} sai_fib_neighbor_mac_hash_t;
+
+static sai_fib_neighbor_mac_hash_t sai_fib_neighbor_mac_hash;
+
+static uint_t sai_fib_neighbor_mac_hash_scale =
+                                       SAI_FIB_NEIGHBOR_MAC_HASH_DFLT_SCALE;
+
 static sai_status_t sai_fib_neighbor_mac_entry_remove (sai_fib_nh_t *p_neighbor);
 
+static inline uint64_t sai_fib_neighbor_mac_key_pack (
+                            const sai_fib_neighbor_mac_entry_key_t *p_key)
+{
+    uint64_t packed_key = p_key->vlan_id;
+    uint_t   idx;
+
+    for (idx = 0; idx < HAL_MAC_ADDR_LEN; idx++) {
+        packed_key = (packed_key << 8) | p_key->mac_addr [idx];
+    }
+
+    return packed_key;
+}
+
+static inline uint_t sai_fib_neighbor_mac_hash_slot_get (uint64_t packed_key,
+                                                         uint_t size)
+{
+    /* 64 bit finalizer mix, spreads the low entropy MAC OUI bits */
+    packed_key ^= packed_key >> 33;
+    packed_key *= 0xff51afd7ed558ccdULL;
+    packed_key ^= packed_key >> 33;
+
+    return ((uint_t) packed_key & (size - 1));
+}
+
+static sai_fib_neighbor_mac_hash_slot_t *sai_fib_neighbor_mac_hash_lookup (
+                                                  uint64_t packed_key,
+                                                  bool for_insert)
+{
+    sai_fib_neighbor_mac_hash_t      *p_hash = &sai_fib_neighbor_mac_hash;
+    sai_fib_neighbor_mac_hash_slot_t *p_slot = NULL;
+    sai_fib_neighbor_mac_hash_slot_t *p_free_slot = NULL;
+    uint_t                            slot;
+    uint_t                            probe;
+
+    slot = sai_fib_neighbor_mac_hash_slot_get (packed_key, p_hash->size);
+
+    for (probe = 0; probe < p_hash->size; probe++) {
+
+        p_slot = &p_hash->p_slots [(slot + probe) & (p_hash->size - 1)];
+
+        if (p_slot->p_mac_entry == NULL) {
+            return (for_insert ? ((p_free_slot != NULL) ? p_free_slot : p_slot)
+                    : NULL);
+        }
+
+        if (p_slot->p_mac_entry == SAI_FIB_NEIGHBOR_MAC_HASH_TOMBSTONE) {
+            if (p_free_slot == NULL) {
+                p_free_slot = p_slot;
+            }
+            continue;
+        }
+
+        if (p_slot->packed_key == packed_key) {
+            return (for_insert ? NULL : p_slot);
+        }
+    }
+
+    return (for_insert ? p_free_slot : NULL);
+}
+
+static sai_status_t sai_fib_neighbor_mac_hash_resize (uint_t size)
+{
+    sai_fib_neighbor_mac_hash_t       *p_hash = &sai_fib_neighbor_mac_hash;
+    sai_fib_neighbor_mac_hash_slot_t  *p_old_slots = p_hash->p_slots;
+    sai_fib_neighbor_mac_hash_slot_t  *p_slot = NULL;
+    uint_t                             old_size = p_hash->size;
+    uint_t                             idx;
+
+    p_hash->p_slots = (sai_fib_neighbor_mac_hash_slot_t *)
+                      calloc (size, sizeof (sai_fib_neighbor_mac_hash_slot_t));
+
+    if (p_hash->p_slots == NULL) {
+        SAI_NEIGHBOR_LOG_ERR ("Failed to allocate Neighbor MAC hash of size %u.",
+                              size);
+
+        p_hash->p_slots = p_old_slots;
+
+        return SAI_STATUS_NO_MEMORY;
+    }
+
+    p_hash->size = size;
+    p_hash->tombstones = 0;
+
+    for (idx = 0; idx < old_size; idx++) {
+
+        if ((p_old_slots [idx].p_mac_entry == NULL) ||
+            (p_old_slots [idx].p_mac_entry == SAI_FIB_NEIGHBOR_MAC_HASH_TOMBSTONE)) {
+            continue;
+        }
+
+        p_slot = sai_fib_neighbor_mac_hash_lookup (p_old_slots [idx].packed_key,
+                                                   true);
+
+        STD_ASSERT (p_slot != NULL);
+
+        *p_slot = p_old_slots [idx];
+    }
+
+    free (p_old_slots);
+
+    SAI_NEIGHBOR_LOG_TRACE ("Neighbor MAC hash resized to %u slots, "
+                            "entry count: %u.", size, p_hash->count);
+
+    return SAI_STATUS_SUCCESS;
+}
+
+static sai_status_t sai_fib_neighbor_mac_hash_insert (
+                                   sai_fib_neighbor_mac_entry_t *p_mac_entry)
+{
+    sai_fib_neighbor_mac_hash_t      *p_hash = &sai_fib_neighbor_mac_hash;
+    sai_fib_neighbor_mac_hash_slot_t *p_slot = NULL;
+    uint64_t                          packed_key;
+    uint_t                            size;
+    sai_status_t                      status;
+
+    if (p_hash->p_slots == NULL) {
+        /* Size for the configured neighbor scale at a load factor of 0.5 */
+        size = SAI_FIB_NEIGHBOR_MAC_HASH_MIN_SIZE;
+
+        while (size < (2 * sai_fib_neighbor_mac_hash_scale)) {
+            size <<= 1;
+        }
+
+        status = sai_fib_neighbor_mac_hash_resize (size);
+
+        if (status != SAI_STATUS_SUCCESS) {
+            return status;
+        }
+    } else if ((2 * (p_hash->count + p_hash->tombstones + 1)) > p_hash->size) {
+        /* Grow when live entries fill half the table, else drop tombstones */
+        size = ((4 * (p_hash->count + 1)) > p_hash->size) ?
+               (2 * p_hash->size) : p_hash->size;
+
+        status = sai_fib_neighbor_mac_hash_resize (size);
+
+        if (status != SAI_STATUS_SUCCESS) {
+            return status;
+        }
+    }
+
+    packed_key = sai_fib_neighbor_mac_key_pack (&p_mac_entry->key);
+
+    p_slot = sai_fib_neighbor_mac_hash_lookup (packed_key, true);
+
+    if (p_slot == NULL) {
+        return SAI_STATUS_ITEM_ALREADY_EXISTS;
+    }
+
+    if (p_slot->p_mac_entry == SAI_FIB_NEIGHBOR_MAC_HASH_TOMBSTONE) {
+        p_hash->tombstones--;
+    }
+
+    p_slot->packed_key  = packed_key;
+    p_slot->p_mac_entry = p_mac_entry;
+    p_hash->count++;
+
+    return SAI_STATUS_SUCCESS;
+}
+
+static void sai_fib_neighbor_mac_hash_remove (
+                                   sai_fib_neighbor_mac_entry_t *p_mac_entry)
+{
+    sai_fib_neighbor_mac_hash_t      *p_hash = &sai_fib_neighbor_mac_hash;
+    sai_fib_neighbor_mac_hash_slot_t *p_slot = NULL;
+
+    if (p_hash->p_slots == NULL) {
+        return;
+    }
+
+    p_slot = sai_fib_neighbor_mac_hash_lookup (
+                  sai_fib_neighbor_mac_key_pack (&p_mac_entry->key), false);
+
+    if (p_slot == NULL) {
+        return;
+    }
+
+    p_slot->p_mac_entry = SAI_FIB_NEIGHBOR_MAC_HASH_TOMBSTONE;
+    p_hash->count--;
+    p_hash->tombstones++;
+}
+
+static sai_fib_neighbor_mac_entry_t *sai_fib_neighbor_mac_hash_find (
+                            const sai_fib_neighbor_mac_entry_key_t *p_key)
+{
+    sai_fib_neighbor_mac_hash_slot_t *p_slot = NULL;
+
+    if (sai_fib_neighbor_mac_hash.count == 0) {
+        return NULL;
+    }
+
+    p_slot = sai_fib_neighbor_mac_hash_lookup (
+                               sai_fib_neighbor_mac_key_pack (p_key), false);
+
+    return ((p_slot != NULL) ? p_slot->p_mac_entry : NULL);
+}
+
+void sai_fib_neighbor_mac_hash_scale_set (uint_t neighbor_scale)
+{
+    if (neighbor_scale != 0) {
+        sai_fib_neighbor_mac_hash_scale = neighbor_scale;
+    }
+}
+
 /*
  * This is a helper routine for parsing attribute list input. Caller must
  * recalculate the error code with the attribute's index in the list.
@@ -276,7 +509,7 @@ static sai_status_t sai_fib_neighbor_entry_validate (
 
     STD_ASSERT (neighbor_entry != NULL);
 
-    p_rif_node = sai_fib_router_interface_node_get (neighbor_entry->rif_id);
+    p_rif_node = sai_fib_router_interface_node_index_get (neighbor_entry->rif_id);
     if (p_rif_node == NULL) {
 
         SAI_NEIGHBOR_LOG_ERR ("Invalid Neighbor RIF id: 0x%"PRIx64".",
@@ -379,7 +612,7 @@ static sai_status_t sai_fib_neighbor_port_id_resolve (sai_fib_nh_t *p_neighbor)
 
     STD_ASSERT (p_neighbor != NULL);
 
-    p_rif = sai_fib_router_interface_node_get (p_neighbor->key.rif_id);
+    p_rif = sai_fib_router_interface_node_index_get (p_neighbor->key.rif_id);
 
     if ((!p_rif)) {
 
@@ -456,7 +689,7 @@ static sai_status_t sai_fib_neighbor_mac_entry_insert (
 
     STD_ASSERT (p_neighbor != NULL);
 
-    p_rif_node = sai_fib_router_interface_node_get (p_neighbor->key.rif_id);
+    p_rif_node = sai_fib_router_interface_node_index_get (p_neighbor->key.rif_id);
 
     if (p_rif_node == NULL) {
         SAI_NEIGHBOR_LOG_ERR ("Neighbor RIF Id: 0x%"PRIx64" not found.",
@@ -483,7 +716,7 @@ static sai_status_t sai_fib_neighbor_mac_entry_insert (
     key.vlan_id = p_rif_node->attachment.vlan_id;
     memcpy (key.mac_addr, p_neighbor->mac_addr, HAL_MAC_ADDR_LEN);
 
-    p_mac_entry = sai_fib_neighbor_mac_entry_find (&key);
+    p_mac_entry = sai_fib_neighbor_mac_hash_find (&key);
 
     if (p_mac_entry == NULL) {
 
@@ -520,6 +753,20 @@ static sai_status_t sai_fib_neighbor_mac_entry_insert (
             return SAI_STATUS_FAILURE;
         }
 
+        status = sai_fib_neighbor_mac_hash_insert (p_mac_entry);
+
+        if (status != SAI_STATUS_SUCCESS) {
+
+            SAI_NEIGHBOR_LOG_ERR ("Failed to insert MAC entry node in hash.");
+
+            std_radix_remove (sai_fib_access_global_config()->neighbor_mac_tree,
+                              &p_mac_entry->rt_head);
+
+            sai_fib_neighbor_mac_entry_node_free (p_mac_entry);
+
+            return status;
+        }
+
         new_mac_entry = true;
     }
 
@@ -566,7 +813,7 @@ static sai_status_t sai_fib_neighbor_mac_entry_remove (sai_fib_nh_t *p_neighbor)
 
     STD_ASSERT (p_neighbor != NULL);
 
-    p_rif_node = sai_fib_router_interface_node_get (p_neighbor->key.rif_id);
+    p_rif_node = sai_fib_router_interface_node_index_get (p_neighbor->key.rif_id);
 
     if (p_rif_node == NULL) {
         SAI_NEIGHBOR_LOG_ERR ("Neighbor RIF Id: 0x%"PRIx64" not found.",
@@ -593,7 +840,7 @@ static sai_status_t sai_fib_neighbor_mac_entry_remove (sai_fib_nh_t *p_neighbor)
     key.vlan_id = p_rif_node->attachment.vlan_id;
     memcpy (key.mac_addr, p_neighbor->mac_addr, HAL_MAC_ADDR_LEN);
 
-    p_mac_entry = sai_fib_neighbor_mac_entry_find (&key);
+    p_mac_entry = sai_fib_neighbor_mac_hash_find (&key);
 
     if (p_mac_entry == NULL) {
         SAI_NEIGHBOR_LOG_TRACE ("Neighbor MAC entry node not found.");
@@ -608,7 +855,9 @@ static sai_status_t sai_fib_neighbor_mac_entry_remove (sai_fib_nh_t *p_neighbor)
     /* Free the MAC entry if there is no other neighbor in list */
     if (std_dll_getfirst (&p_mac_entry->neighbor_list) == NULL) {
 
-        /* Remove the MAC entry from tree */
+        /* Remove the MAC entry from hash index and tree */
+        sai_fib_neighbor_mac_hash_remove (p_mac_entry);
+
         std_radix_remove (sai_fib_access_global_config()->neighbor_mac_tree,
                           &p_mac_entry->rt_head);
 
@@ -670,8 +919,10 @@ static sai_status_t sai_fib_neighbor_node_create (sai_fib_nh_t *nh_info,
     return SAI_STATUS_SUCCESS;
 }
 
-/* Neighbor IPv4 address is expected in Network Byte Order */
-static sai_status_t sai_fib_neighbor_create (
+/*
+ * Creates a neighbor entry. Caller must hold the FIB lock.
+ */
+static sai_status_t sai_fib_neighbor_entry_create (
                                     const sai_neighbor_entry_t *neighbor_entry,
                                     uint32_t attr_count,
                                     const sai_attribute_t *attr_list)
@@ -688,8 +939,6 @@ static sai_status_t sai_fib_neighbor_create (
 
     sai_fib_neighbor_default_attr_set (&nh_info);
 
-    sai_fib_lock ();
-
     do {
         /* Validate the input neighbor entry key */
         status = sai_fib_neighbor_key_validate_and_fill (neighbor_entry,
@@ -769,110 +1018,148 @@ static sai_status_t sai_fib_neighbor_create (
         }
     }
 
-    sai_fib_unlock ();
-
     return status;
 }
 
 /* Neighbor IPv4 address is expected in Network Byte Order */
-static sai_status_t sai_fib_neighbor_remove (
-                                const sai_neighbor_entry_t *neighbor_entry)
+static sai_status_t sai_fib_neighbor_create (
+                                    const sai_neighbor_entry_t *neighbor_entry,
+                                    uint32_t attr_count,
+                                    const sai_attribute_t *attr_list)
 {
-    sai_status_t       status = SAI_STATUS_FAILURE;
-    sai_fib_nh_t      *p_nh_node = NULL;
-    sai_fib_nh_t       nh_node_copy;
-    sai_fib_nh_key_t   nh_key;
-    sai_ip_address_t  *p_ip_addr = NULL;
-
-    SAI_NEIGHBOR_LOG_TRACE ("SAI Neighbor remove.");
+    sai_status_t status;
 
     sai_fib_lock ();
 
-    do {
-        /* Validate the input neighbor entry key */
-        status = sai_fib_neighbor_entry_validate (neighbor_entry);
+    status = sai_fib_neighbor_entry_create (neighbor_entry, attr_count,
+                                            attr_list);
 
-        if (status != SAI_STATUS_SUCCESS) {
+    sai_fib_unlock ();
 
-            SAI_NEIGHBOR_LOG_ERR ("SAI Neighbor entry validation failed.");
+    return status;
+}
 
-            break;
-        }
+/*
+ * Removes the neighbor from the next hop node and from the NPU and frees
+ * the next hop node if it has no other owner. Caller must hold the FIB
+ * lock.
+ */
+static sai_status_t sai_fib_neighbor_node_remove (sai_fib_nh_t *p_nh_node)
+{
+    sai_status_t  status;
+    sai_fib_nh_t  nh_node_copy;
 
-        sai_fib_neighbor_entry_log_trace (neighbor_entry, "SAI Neighbor remove.");
+    STD_ASSERT (p_nh_node != NULL);
 
-        /* Fill the neighbor IP address key */
-        sai_fib_neighbor_ip_next_hop_node_key_fill (neighbor_entry, &nh_key);
+    /* Copy the next hop node info */
+    memcpy (&nh_node_copy, p_nh_node, sizeof (sai_fib_nh_t));
 
-        p_ip_addr = &nh_key.info.ip_nh.ip_addr;
+    status = sai_fib_neighbor_mac_entry_remove (p_nh_node);
 
-        /* Get the neighbor node */
-        p_nh_node = sai_fib_ip_next_hop_node_get (SAI_NEXT_HOP_TYPE_IP,
-                                                  neighbor_entry->rif_id,
-                                                  p_ip_addr,
-                                                  SAI_FIB_TUNNEL_TYPE_NONE);
+    if (status != SAI_STATUS_SUCCESS) {
 
-        if ((!p_nh_node)) {
+        SAI_NEIGHBOR_LOG_ERR ("Failed to remove Neighbor MAC entry node.");
 
-            SAI_NEIGHBOR_LOG_ERR ("SAI Neighbor removal. Neighbor not found.");
+        return status;
+    }
 
-            status = SAI_STATUS_ITEM_NOT_FOUND;
+    /* Reset the neighbor attributes in next hop node */
+    sai_fib_neighbor_info_reset (p_nh_node);
 
-            break;
-        }
+    /* Remove it in hardware */
+    status = sai_neighbor_npu_api_get()->neighbor_remove (p_nh_node);
 
-        if ((!sai_fib_is_owner_neighbor (p_nh_node))) {
+    if (status != SAI_STATUS_SUCCESS) {
 
-            sai_fib_next_hop_log_error (p_nh_node, "Neighbor not found.");
+        memcpy (p_nh_node, &nh_node_copy, sizeof (sai_fib_nh_t));
 
-            status = SAI_STATUS_ITEM_NOT_FOUND;
+        sai_fib_neighbor_mac_entry_insert (p_nh_node);
 
-            break;
-        }
+        sai_fib_next_hop_log_error (p_nh_node, "Failed to remove Neighbor "
+                                    "entry in NPU.");
+        return status;
+    }
 
-        /* Copy the next hop node info */
-        memcpy (&nh_node_copy, p_nh_node, sizeof (sai_fib_nh_t));
+    sai_fib_next_hop_log_trace (p_nh_node, "Next Hop node after "
+                                "neighbor entry deletion.");
 
-        status = sai_fib_neighbor_mac_entry_remove (p_nh_node);
+    sai_fib_neighbor_affected_encap_nh_resolve (p_nh_node, SAI_OP_REMOVE);
 
-        if (status != SAI_STATUS_SUCCESS) {
+    /* Free the next hop node */
+    sai_fib_check_and_delete_ip_next_hop_node (p_nh_node->vrf_id, p_nh_node);
 
-            SAI_NEIGHBOR_LOG_ERR ("Failed to remove Neighbor MAC entry node.");
+    return SAI_STATUS_SUCCESS;
+}
 
-            break;
-        }
+/*
+ * Removes a neighbor entry. Caller must hold the FIB lock.
+ */
+static sai_status_t sai_fib_neighbor_entry_remove (
+                                const sai_neighbor_entry_t *neighbor_entry)
+{
+    sai_status_t       status = SAI_STATUS_FAILURE;
+    sai_fib_nh_t      *p_nh_node = NULL;
+    sai_fib_nh_key_t   nh_key;
+    sai_ip_address_t  *p_ip_addr = NULL;
 
-        /* Reset the neighbor attributes in next hop node */
-        sai_fib_neighbor_info_reset (p_nh_node);
+    /* Validate the input neighbor entry key */
+    status = sai_fib_neighbor_entry_validate (neighbor_entry);
 
-        /* Remove it in hardware */
-        status = sai_neighbor_npu_api_get()->neighbor_remove (p_nh_node);
+    if (status != SAI_STATUS_SUCCESS) {
 
-        if (status != SAI_STATUS_SUCCESS) {
+        SAI_NEIGHBOR_LOG_ERR ("SAI Neighbor entry validation failed.");
 
-            memcpy (p_nh_node, &nh_node_copy, sizeof (sai_fib_nh_t));
+        return status;
+    }
 
-            sai_fib_neighbor_mac_entry_insert (p_nh_node);
+    sai_fib_neighbor_entry_log_trace (neighbor_entry, "SAI Neighbor remove.");
 
-            sai_fib_next_hop_log_error (p_nh_node, "Failed to remove Neighbor "
-                                        "entry in NPU.");
-            break;
-        }
-    } while (0);
+    /* Fill the neighbor IP address key */
+    sai_fib_neighbor_ip_next_hop_node_key_fill (neighbor_entry, &nh_key);
 
-    if (status == SAI_STATUS_SUCCESS) {
+    p_ip_addr = &nh_key.info.ip_nh.ip_addr;
+
+    /* Get the neighbor node */
+    p_nh_node = sai_fib_ip_next_hop_node_get (SAI_NEXT_HOP_TYPE_IP,
+                                              neighbor_entry->rif_id,
+                                              p_ip_addr,
+                                              SAI_FIB_TUNNEL_TYPE_NONE);
+
+    if ((!p_nh_node)) {
+
+        SAI_NEIGHBOR_LOG_ERR ("SAI Neighbor removal. Neighbor not found.");
+
+        return SAI_STATUS_ITEM_NOT_FOUND;
+    }
+
+    if ((!sai_fib_is_owner_neighbor (p_nh_node))) {
 
-        sai_fib_next_hop_log_trace (p_nh_node, "Next Hop node after "
-                                    "neighbor entry deletion.");
+        sai_fib_next_hop_log_error (p_nh_node, "Neighbor not found.");
 
-        sai_fib_neighbor_affected_encap_nh_resolve (p_nh_node, SAI_OP_REMOVE);
+        return SAI_STATUS_ITEM_NOT_FOUND;
+    }
 
-        /* Free the next hop node */
-        sai_fib_check_and_delete_ip_next_hop_node (p_nh_node->vrf_id, p_nh_node);
+    status = sai_fib_neighbor_node_remove (p_nh_node);
 
+    if (status == SAI_STATUS_SUCCESS) {
         SAI_NEIGHBOR_LOG_INFO ("Neighbor entry removed.");
     }
 
+    return status;
+}
+
+/* Neighbor IPv4 address is expected in Network Byte Order */
+static sai_status_t sai_fib_neighbor_remove (
+                                const sai_neighbor_entry_t *neighbor_entry)
+{
+    sai_status_t status;
+
+    SAI_NEIGHBOR_LOG_TRACE ("SAI Neighbor remove.");
+
+    sai_fib_lock ();
+
+    status = sai_fib_neighbor_entry_remove (neighbor_entry);
+
     sai_fib_unlock ();
 
     return status;
@@ -1116,7 +1403,16 @@ static sai_status_t sai_fib_neighbor_port_id_set (const sai_fdb_entry_t *fdb_ent
     sai_fib_lock ();
 
     do {
-        p_mac_entry = sai_fib_neighbor_mac_entry_find (&key);
+        /* Neighbor MAC entries exist only for VLANs with a VLAN RIF */
+        if (sai_fib_vlan_rif_node_get (fdb_entry->vlan_id) == NULL) {
+
+            SAI_NEIGHBOR_LOG_TRACE ("No VLAN RIF on VLAN %d.",
+                                    fdb_entry->vlan_id);
+
+            break;
+        }
+
+        p_mac_entry = sai_fib_neighbor_mac_hash_find (&key);
 
         if (p_mac_entry == NULL) {
 
@@ -1209,9 +1505,222 @@ sai_status_t sai_neighbor_fdb_callback (uint_t num_upd,
     return SAI_STATUS_SUCCESS;
 }
 
+/*
+ * Removes all the neighbors in a VRF, or only the ones on the given RIF
+ * when rif_id is not SAI_NULL_OBJECT_ID, in a single pass over the VRF's
+ * IP next hop tree. Caller must hold the FIB lock.
+ */
+static sai_status_t sai_fib_vrf_neighbors_remove (sai_fib_vrf_t *p_vrf_node,
+                                                  sai_object_id_t rif_id,
+                                                  uint_t *p_count)
+{
+    sai_fib_nh_key_t  nh_key;
+    sai_fib_nh_t     *p_nh_node = NULL;
+    sai_status_t      status = SAI_STATUS_SUCCESS;
+    sai_status_t      rc;
+
+    memset (&nh_key, 0, sizeof (sai_fib_nh_key_t));
+
+    p_nh_node = (sai_fib_nh_t *)
+                       std_radix_getexact (p_vrf_node->sai_nh_tree,
+                                           (uint8_t *) &nh_key,
+                                           SAI_FIB_NH_IP_ADDR_TREE_KEY_LEN);
+    if (p_nh_node == NULL) {
+
+        p_nh_node = (sai_fib_nh_t *)
+            std_radix_getnext (p_vrf_node->sai_nh_tree,
+                               (uint8_t *) &nh_key,
+                               SAI_FIB_NH_IP_ADDR_TREE_KEY_LEN);
+    }
+
+    while (p_nh_node != NULL) {
+
+        /* Node may be freed on neighbor removal, walk from its key */
+        memcpy (&nh_key, &p_nh_node->key, sizeof (sai_fib_nh_key_t));
+
+        if ((sai_fib_is_owner_neighbor (p_nh_node)) &&
+            ((rif_id == SAI_NULL_OBJECT_ID) ||
+             (p_nh_node->key.rif_id == rif_id))) {
+
+            rc = sai_fib_neighbor_node_remove (p_nh_node);
+
+            if (rc == SAI_STATUS_SUCCESS) {
+                (*p_count)++;
+            } else {
+                status = rc;
+            }
+        }
+
+        p_nh_node = (sai_fib_nh_t *)
+            std_radix_getnext (p_vrf_node->sai_nh_tree,
+                               (uint8_t *) &nh_key,
+                               SAI_FIB_NH_IP_ADDR_TREE_KEY_LEN);
+    }
+
+    return status;
+}
+
+sai_status_t sai_fib_neighbor_remove_all_in_vrf (sai_object_id_t vr_id)
+{
+    sai_fib_vrf_t *p_vrf_node = NULL;
+    sai_status_t   status;
+    uint_t         count = 0;
+
+    sai_fib_lock ();
+
+    p_vrf_node = sai_fib_vrf_node_index_get (vr_id);
+
+    if (p_vrf_node == NULL) {
+        SAI_NEIGHBOR_LOG_ERR ("VR Id: 0x%"PRIx64" not found.", vr_id);
+
+        sai_fib_unlock ();
+
+        return SAI_STATUS_INVALID_OBJECT_ID;
+    }
+
+    status = sai_fib_vrf_neighbors_remove (p_vrf_node, SAI_NULL_OBJECT_ID,
+                                           &count);
+
+    sai_fib_unlock ();
+
+    SAI_NEIGHBOR_LOG_INFO ("Removed %u neighbors in VR 0x%"PRIx64".",
+                           count, vr_id);
+
+    return status;
+}
+
+sai_status_t sai_fib_neighbor_remove_all_on_rif (sai_object_id_t rif_id)
+{
+    sai_fib_vrf_t *p_vrf_node = NULL;
+    sai_status_t   status;
+    uint_t         count = 0;
+
+    sai_fib_lock ();
+
+    p_vrf_node = sai_fib_get_vrf_node_for_rif (rif_id);
+
+    if (p_vrf_node == NULL) {
+        SAI_NEIGHBOR_LOG_ERR ("RIF Id: 0x%"PRIx64" not found.", rif_id);
+
+        sai_fib_unlock ();
+
+        return SAI_STATUS_INVALID_OBJECT_ID;
+    }
+
+    status = sai_fib_vrf_neighbors_remove (p_vrf_node, rif_id, &count);
+
+    sai_fib_unlock ();
+
+    SAI_NEIGHBOR_LOG_INFO ("Removed %u neighbors on RIF 0x%"PRIx64".",
+                           count, rif_id);
+
+    return status;
+}
+
 static sai_status_t sai_fib_neighbor_remove_all_entries (sai_object_id_t switch_id)
 {
-    return SAI_STATUS_NOT_IMPLEMENTED;
+    rbtree_handle  vrf_tree;
+    sai_fib_vrf_t *p_vrf_node = NULL;
+    sai_status_t   status = SAI_STATUS_SUCCESS;
+    sai_status_t   rc;
+    uint_t         count = 0;
+
+    SAI_NEIGHBOR_LOG_TRACE ("SAI Neighbor remove all entries.");
+
+    sai_fib_lock ();
+
+    vrf_tree = sai_fib_access_global_config()->vrf_tree;
+
+    for (p_vrf_node = std_rbtree_getfirst (vrf_tree); p_vrf_node != NULL;
+         p_vrf_node = std_rbtree_getnext (vrf_tree, p_vrf_node)) {
+
+        rc = sai_fib_vrf_neighbors_remove (p_vrf_node, SAI_NULL_OBJECT_ID,
+                                           &count);
+
+        if (rc != SAI_STATUS_SUCCESS) {
+            status = rc;
+        }
+    }
+
+    sai_fib_unlock ();
+
+    SAI_NEIGHBOR_LOG_INFO ("Removed %u neighbors.", count);
+
+    return status;
+}
+
+sai_status_t sai_fib_neighbor_bulk_create (uint32_t object_count,
+                                           const sai_neighbor_entry_t *neighbor_entry,
+                                           const uint32_t *attr_count,
+                                           const sai_attribute_t **attr_list,
+                                           bool stop_on_error,
+                                           sai_status_t *object_statuses)
+{
+    sai_status_t status = SAI_STATUS_SUCCESS;
+    uint32_t     idx;
+
+    if ((object_count == 0) || (neighbor_entry == NULL) ||
+        (attr_count == NULL) || (attr_list == NULL) ||
+        (object_statuses == NULL)) {
+        return SAI_STATUS_INVALID_PARAMETER;
+    }
+
+    sai_fib_lock ();
+
+    for (idx = 0; idx < object_count; idx++) {
+
+        if ((status != SAI_STATUS_SUCCESS) && stop_on_error) {
+            object_statuses [idx] = SAI_STATUS_NOT_EXECUTED;
+            continue;
+        }
+
+        object_statuses [idx] =
+            sai_fib_neighbor_entry_create (&neighbor_entry [idx],
+                                           attr_count [idx], attr_list [idx]);
+
+        if (object_statuses [idx] != SAI_STATUS_SUCCESS) {
+            status = SAI_STATUS_FAILURE;
+        }
+    }
+
+    sai_fib_unlock ();
+
+    return status;
+}
+
+sai_status_t sai_fib_neighbor_bulk_remove (uint32_t object_count,
+                                           const sai_neighbor_entry_t *neighbor_entry,
+                                           bool stop_on_error,
+                                           sai_status_t *object_statuses)
+{
+    sai_status_t status = SAI_STATUS_SUCCESS;
+    uint32_t     idx;
+
+    if ((object_count == 0) || (neighbor_entry == NULL) ||
+        (object_statuses == NULL)) {
+        return SAI_STATUS_INVALID_PARAMETER;
+    }
+
+    sai_fib_lock ();
+
+    for (idx = 0; idx < object_count; idx++) {
+
+        if ((status != SAI_STATUS_SUCCESS) && stop_on_error) {
+            object_statuses [idx] = SAI_STATUS_NOT_EXECUTED;
+            continue;
+        }
+
+        object_statuses [idx] =
+            sai_fib_neighbor_entry_remove (&neighbor_entry [idx]);
+
+        if (object_statuses [idx] != SAI_STATUS_SUCCESS) {
+            status = SAI_STATUS_FAILURE;
+        }
+    }
+
+    sai_fib_unlock ();
+
+    return status;
 }
 
 static sai_neighbor_api_t sai_neighbor_method_table = {
@@ -125,7 +125,7 @@ static inline bool sai_fib_next_hop_rif_validate (
 {
     /* Get the RIF node */
     sai_fib_router_interface_t *p_rif_node =
-                       sai_fib_router_interface_node_get(rif_id);
+                       sai_fib_router_interface_node_index_get(rif_id);
 
     if((p_rif_node != NULL) &&
        (p_rif_node->type != SAI_ROUTER_INTERFACE_TYPE_LOOPBACK)) {
@@ -499,6 +499,8 @@ static sai_status_t sai_fib_insert_nh_node_in_nh_id_database (
         return SAI_STATUS_FAILURE;
     }
 
+    sai_fib_next_hop_node_index_update (p_nh_node, true);
+
     SAI_NEXTHOP_LOG_TRACE ("Inserted Next Hop node in NH Id database. "
                            "NH Id: 0x%"PRIx64".", p_nh_node->next_hop_id);
 
@@ -526,6 +528,8 @@ static sai_status_t sai_fib_remove_nh_node_from_nh_id_database (
         return SAI_STATUS_FAILURE;
     }
 
+    sai_fib_next_hop_node_index_update (p_nh_node, false);
+
     SAI_NEXTHOP_LOG_TRACE ("Removed Next Hop node from NH Id database. "
                            "NH Id: 0x%"PRIx64".", p_nh_node->next_hop_id);
 
@@ -539,7 +543,7 @@ static void sai_fib_nh_rif_ref_count_incr (sai_fib_nh_t *p_next_hop)
     STD_ASSERT (p_next_hop != NULL);
 
     /* Get the RIF node */
-    p_rif_node = sai_fib_router_interface_node_get (p_next_hop->key.rif_id);
+    p_rif_node = sai_fib_router_interface_node_index_get (p_next_hop->key.rif_id);
 
     if (p_rif_node) {
 
@@ -558,7 +562,7 @@ static void sai_fib_nh_rif_ref_count_decr (sai_fib_nh_t *p_next_hop)
     STD_ASSERT (p_next_hop != NULL);
 
     /* Get the RIF node */
-    p_rif_node = sai_fib_router_interface_node_get (p_next_hop->key.rif_id);
+    p_rif_node = sai_fib_router_interface_node_index_get (p_next_hop->key.rif_id);
 
     if (p_rif_node) {
 
@@ -586,7 +590,7 @@ sai_fib_nh_t *sai_fib_ip_next_hop_node_create (sai_object_id_t vrf_id,
     STD_ASSERT (p_status != NULL);
 
     /* Get the VRF node */
-    p_vrf_node = sai_fib_vrf_node_get (vrf_id);
+    p_vrf_node = sai_fib_vrf_node_index_get (vrf_id);
 
     if ((!p_vrf_node)) {
 
@@ -651,7 +655,7 @@ sai_status_t sai_fib_check_and_delete_ip_next_hop_node (
     if ((!(p_nh_node->owner_flag))) {
 
         /* Get the VRF node */
-        p_vrf_node = sai_fib_vrf_node_get (vrf_id);
+        p_vrf_node = sai_fib_vrf_node_index_get (vrf_id);
 
         if ((!p_vrf_node)) {
 
@@ -909,7 +913,7 @@ static sai_status_t sai_fib_next_hop_remove (sai_object_id_t next_hop_id)
 
     do {
         /* Get the next hop node */
-        p_nh_node = sai_fib_next_hop_node_get_from_id (next_hop_id);
+        p_nh_node = sai_fib_next_hop_node_index_get (next_hop_id);
 
         if (!p_nh_node) {
 
@@ -1024,7 +1028,7 @@ static sai_status_t sai_fib_next_hop_attribute_get (
 
     do {
         /* Get the next hop node */
-        p_nh_node = sai_fib_next_hop_node_get_from_id (next_hop_id);
+        p_nh_node = sai_fib_next_hop_node_index_get (next_hop_id);
 
         if (!p_nh_node) {
 
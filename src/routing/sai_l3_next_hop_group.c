@@ -34,44 +34,37 @@
 #include "sai_common_infra.h"
 #include "sai_l3_api_utils.h"
 #include "sai_l3_next_hop_group_utl.h"
+#include "sai_id_allocator.h"
 #include <string.h>
 #include <inttypes.h>
 #include <stdlib.h>
 
-static dn_sai_id_gen_info_t next_hop_grp_member_gen_info;
-
-bool sai_fib_is_next_hop_grp_member_id_in_use(uint64_t obj_id)
-{
-    sai_object_id_t next_hop_grp_member_id =
-        sai_uoid_create(SAI_OBJECT_TYPE_NEXT_HOP_GROUP_MEMBER,obj_id);
-    sai_object_id_t nh_grp_id = SAI_NULL_OBJECT_ID;
-    sai_object_id_t nh_id = SAI_NULL_OBJECT_ID;
-
-    if(sai_next_hop_map_get_ids_from_member_id(next_hop_grp_member_id,
-                &nh_grp_id,&nh_id) == SAI_STATUS_SUCCESS) {
-        return true;
-    } else {
-        return false;
-    }
-}
+static sai_id_allocator_t next_hop_grp_member_id_allocator;
 
 static sai_object_id_t sai_fib_generate_next_hop_grp_member_id(void)
 {
+    uint64_t id = 0;
+
     if(SAI_STATUS_SUCCESS ==
-            dn_sai_get_next_free_id(&next_hop_grp_member_gen_info)) {
-        return (sai_uoid_create(SAI_OBJECT_TYPE_NEXT_HOP_GROUP_MEMBER,
-                    next_hop_grp_member_gen_info.cur_id));
+            sai_id_allocator_alloc(&next_hop_grp_member_id_allocator, &id)) {
+        return (sai_uoid_create(SAI_OBJECT_TYPE_NEXT_HOP_GROUP_MEMBER, id));
     }
     return SAI_NULL_OBJECT_ID;
 }
 
+static inline void sai_fib_release_next_hop_grp_member_id(sai_object_id_t member_id)
+{
+    sai_id_allocator_free(&next_hop_grp_member_id_allocator,
+                          sai_uoid_npu_obj_id_get(member_id));
+}
+
 inline void sai_fib_next_hop_grp_member_gen_info_init(void)
 {
-    next_hop_grp_member_gen_info.cur_id = 0;
-    next_hop_grp_member_gen_info.is_wrappped = false;
-    next_hop_grp_member_gen_info.mask = SAI_UOID_NPU_OBJ_ID_MASK;
-    next_hop_grp_member_gen_info.is_id_in_use =
-        sai_fib_is_next_hop_grp_member_id_in_use;
+    if(SAI_STATUS_SUCCESS !=
+            sai_id_allocator_init(&next_hop_grp_member_id_allocator,
+                                  "nh_grp_member", SAI_ID_ALLOCATOR_MAX_IDS)) {
+        SAI_NH_GROUP_LOG_ERR ("Next Hop Group Member Id allocator init failed.");
+    }
 }
 
 static inline void sai_fib_nh_group_log_error (sai_fib_nh_group_t *p_group,
@@ -512,7 +505,7 @@ static sai_status_t sai_fib_next_hop_fill_from_nh_id_list (
         }
 
         /* Get the next hop node from id */
-        p_nh_node = sai_fib_next_hop_node_get_from_id (
+        p_nh_node = sai_fib_next_hop_node_index_get (
                                                  p_next_hop_id [nh_index]);
         if ((!p_nh_node)) {
 
@@ -1328,6 +1321,10 @@ static sai_status_t sai_fib_next_hop_group_member_create (
         }
 
         rc = sai_next_hop_map_insert (nh_grp_id, nh_id, *out_member_id);
+
+        if (rc != SAI_STATUS_SUCCESS) {
+            sai_fib_release_next_hop_grp_member_id (*out_member_id);
+        }
     } while (0);
 
     sai_fib_unlock ();
@@ -1365,6 +1362,8 @@ static sai_status_t sai_fib_next_hop_group_member_remove (sai_object_id_t member
         }
 
         sai_next_hop_map_remove (nh_grp_id, nh_id, member_id);
+
+        sai_fib_release_next_hop_grp_member_id (member_id);
     } while (0);
 
     sai_fib_unlock ();
@@ -0,0 +1,248 @@
+/*
+ * Copyright (c) 2016 Dell Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * THIS CODE IS PROVIDED ON AN *AS IS* BASIS, WITHOUT WARRANTIES OR
+ * CONDITIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING WITHOUT
+ * LIMITATION ANY IMPLIED WARRANTIES OR CONDITIONS OF TITLE, FITNESS
+ * FOR A PARTICULAR PURPOSE, MERCHANTABLITY OR NON-INFRINGEMENT.
+ *
+ * See the Apache Version 2.0 License for specific language governing
+ * permissions and limitations under the License.
+ */
+
+
+/**
+ * @file sai_l3_obj_index.c
+ *
+ * @brief This file contains the direct indexed lookup tables from SAI
+ *        VRF, Router Interface and Next Hop object Id to the FIB node.
+ */
+
+#include "sai_l3_api_utils.h"
+#include "sai_l3_common.h"
+#include "sai_l3_util.h"
+#include "sai_oid_utils.h"
+#include "saistatus.h"
+#include "saitypes.h"
+#include "std_assert.h"
+#include <stdlib.h>
+#include <string.h>
+#include <inttypes.h>
+
+/*
+ * Object index is the NPU object Id embedded in the SAI object Id. Indexes
+ * are kept in two levels, pages of entries allocated on first use, so that
+ * sparse NPU object Id ranges do not cost a flat array. Object Ids beyond
+ * the table range are looked up from the rbtrees.
+ */
+#define SAI_FIB_OBJ_INDEX_PAGE_BITS     (10)
+#define SAI_FIB_OBJ_INDEX_PAGE_SIZE     (1 << SAI_FIB_OBJ_INDEX_PAGE_BITS)
+#define SAI_FIB_OBJ_INDEX_MAX_PAGES     (1024)
+#define SAI_FIB_OBJ_INDEX_MAX           \
+        (SAI_FIB_OBJ_INDEX_PAGE_SIZE * SAI_FIB_OBJ_INDEX_MAX_PAGES)
+
+typedef struct _sai_fib_obj_index_entry_t {
+    sai_object_id_t  obj_id;
+    void            *p_node;
+} sai_fib_obj_index_entry_t;
+
+typedef struct _sai_fib_obj_index_page_t {
+    uint_t                     count;
+    sai_fib_obj_index_entry_t  entry [SAI_FIB_OBJ_INDEX_PAGE_SIZE];
+} sai_fib_obj_index_page_t;
+
+typedef struct _sai_fib_obj_index_t {
+    sai_fib_obj_index_page_t  *page [SAI_FIB_OBJ_INDEX_MAX_PAGES];
+} sai_fib_obj_index_t;
+
+static sai_fib_obj_index_t sai_fib_vrf_index;
+static sai_fib_obj_index_t sai_fib_rif_index;
+static sai_fib_obj_index_t sai_fib_nh_index;
+
+static void *sai_fib_obj_index_get (const sai_fib_obj_index_t *p_index,
+                                    sai_object_id_t obj_id)
+{
+    const sai_fib_obj_index_page_t *p_page = NULL;
+    uint64_t                        index;
+
+    index = sai_uoid_npu_obj_id_get (obj_id);
+
+    if (index >= SAI_FIB_OBJ_INDEX_MAX) {
+        return NULL;
+    }
+
+    p_page = p_index->page [index >> SAI_FIB_OBJ_INDEX_PAGE_BITS];
+
+    if (p_page == NULL) {
+        return NULL;
+    }
+
+    index &= (SAI_FIB_OBJ_INDEX_PAGE_SIZE - 1);
+
+    if (p_page->entry [index].obj_id != obj_id) {
+        return NULL;
+    }
+
+    return p_page->entry [index].p_node;
+}
+
+static void sai_fib_obj_index_set (sai_fib_obj_index_t *p_index,
+                                   sai_object_id_t obj_id, void *p_node)
+{
+    sai_fib_obj_index_page_t  *p_page = NULL;
+    sai_fib_obj_index_entry_t *p_entry = NULL;
+    uint64_t                   index;
+    uint_t                     page_idx;
+
+    index = sai_uoid_npu_obj_id_get (obj_id);
+
+    /* Not indexed, lookup falls back to the rbtree */
+    if (index >= SAI_FIB_OBJ_INDEX_MAX) {
+        return;
+    }
+
+    page_idx = index >> SAI_FIB_OBJ_INDEX_PAGE_BITS;
+    p_page = p_index->page [page_idx];
+
+    if (p_page == NULL) {
+        p_page = (sai_fib_obj_index_page_t *) calloc (1, sizeof (*p_page));
+
+        if (p_page == NULL) {
+            SAI_ROUTER_LOG_WARN ("Object index page alloc failed for 0x%"PRIx64".",
+                                 obj_id);
+            return;
+        }
+
+        p_index->page [page_idx] = p_page;
+    }
+
+    p_entry = &p_page->entry [index & (SAI_FIB_OBJ_INDEX_PAGE_SIZE - 1)];
+
+    if (p_entry->p_node == NULL) {
+        p_page->count++;
+    }
+
+    p_entry->obj_id = obj_id;
+    p_entry->p_node = p_node;
+}
+
+static void sai_fib_obj_index_clear (sai_fib_obj_index_t *p_index,
+                                     sai_object_id_t obj_id)
+{
+    sai_fib_obj_index_page_t  *p_page = NULL;
+    sai_fib_obj_index_entry_t *p_entry = NULL;
+    uint64_t                   index;
+    uint_t                     page_idx;
+
+    index = sai_uoid_npu_obj_id_get (obj_id);
+
+    if (index >= SAI_FIB_OBJ_INDEX_MAX) {
+        return;
+    }
+
+    page_idx = index >> SAI_FIB_OBJ_INDEX_PAGE_BITS;
+    p_page = p_index->page [page_idx];
+
+    if (p_page == NULL) {
+        return;
+    }
+
+    p_entry = &p_page->entry [index & (SAI_FIB_OBJ_INDEX_PAGE_SIZE - 1)];
+
+    if ((p_entry->obj_id != obj_id) || (p_entry->p_node == NULL)) {
+        return;
+    }
+
+    memset (p_entry, 0, sizeof (*p_entry));
+
+    p_page->count--;
+
+    if (p_page->count == 0) {
+        free (p_page);
+        p_index->page [page_idx] = NULL;
+    }
+}
+
+sai_fib_vrf_t *sai_fib_vrf_node_index_get (sai_object_id_t vrf_id)
+{
+    sai_fib_vrf_t *p_vrf_node;
+
+    p_vrf_node = (sai_fib_vrf_t *) sai_fib_obj_index_get (&sai_fib_vrf_index,
+                                                          vrf_id);
+
+    if (p_vrf_node == NULL) {
+        p_vrf_node = sai_fib_vrf_node_get (vrf_id);
+    }
+
+    return p_vrf_node;
+}
+
+sai_fib_router_interface_t *sai_fib_router_interface_node_index_get (
+                                                        sai_object_id_t rif_id)
+{
+    sai_fib_router_interface_t *p_rif_node;
+
+    p_rif_node = (sai_fib_router_interface_t *)
+        sai_fib_obj_index_get (&sai_fib_rif_index, rif_id);
+
+    if (p_rif_node == NULL) {
+        p_rif_node = sai_fib_router_interface_node_get (rif_id);
+    }
+
+    return p_rif_node;
+}
+
+sai_fib_nh_t *sai_fib_next_hop_node_index_get (sai_object_id_t nh_id)
+{
+    sai_fib_nh_t *p_nh_node;
+
+    p_nh_node = (sai_fib_nh_t *) sai_fib_obj_index_get (&sai_fib_nh_index,
+                                                        nh_id);
+
+    if (p_nh_node == NULL) {
+        p_nh_node = sai_fib_next_hop_node_get_from_id (nh_id);
+    }
+
+    return p_nh_node;
+}
+
+void sai_fib_vrf_node_index_update (sai_fib_vrf_t *p_vrf_node, bool is_add)
+{
+    STD_ASSERT (p_vrf_node != NULL);
+
+    if (is_add) {
+        sai_fib_obj_index_set (&sai_fib_vrf_index, p_vrf_node->vrf_id,
+                               p_vrf_node);
+    } else {
+        sai_fib_obj_index_clear (&sai_fib_vrf_index, p_vrf_node->vrf_id);
+    }
+}
+
+void sai_fib_router_interface_node_index_update (
+                             sai_fib_router_interface_t *p_rif_node, bool is_add)
+{
+    STD_ASSERT (p_rif_node != NULL);
+
+    if (is_add) {
+        sai_fib_obj_index_set (&sai_fib_rif_index, p_rif_node->rif_id,
+                               p_rif_node);
+    } else {
+        sai_fib_obj_index_clear (&sai_fib_rif_index, p_rif_node->rif_id);
+    }
+}
+
+void sai_fib_next_hop_node_index_update (sai_fib_nh_t *p_nh_node, bool is_add)
+{
+    STD_ASSERT (p_nh_node != NULL);
+
+    if (is_add) {
+        sai_fib_obj_index_set (&sai_fib_nh_index, p_nh_node->next_hop_id,
+                               p_nh_node);
+    } else {
+        sai_fib_obj_index_clear (&sai_fib_nh_index, p_nh_node->next_hop_id);
+    }
+}
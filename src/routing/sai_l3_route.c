@@ -37,6 +37,7 @@
 #include "std_llist.h"
 #include "sai_oid_utils.h"
 #include "sai_common_infra.h"
+#include "sai_api_latency.h"
 #include <string.h>
 #include <inttypes.h>
 
@@ -199,7 +200,7 @@ static sai_status_t sai_fib_route_nh_id_attr_set (sai_fib_route_t *p_route_node,
 {
     sai_fib_nh_t *p_nh_node = NULL;
 
-    p_nh_node = sai_fib_next_hop_node_get_from_id (nh_id);
+    p_nh_node = sai_fib_next_hop_node_index_get (nh_id);
 
     if (!p_nh_node) {
         SAI_ROUTE_LOG_ERR ("Next hop Id 0x%"PRIx64" does not exist.", nh_id);
@@ -432,7 +433,7 @@ const sai_route_entry_t *p_uc_route)
 
     STD_ASSERT(p_uc_route != NULL);
 
-    p_vrf_node = sai_fib_vrf_node_get (p_uc_route->vr_id);
+    p_vrf_node = sai_fib_vrf_node_index_get (p_uc_route->vr_id);
 
     if (!p_vrf_node) {
         SAI_ROUTE_LOG_ERR ("VRF ID 0x%"PRIx64" does not exist in VRF tree.",
@@ -535,7 +536,7 @@ const sai_attribute_t *attr_list)
     sai_fib_lock ();
 
     do {
-        p_vrf_node = sai_fib_vrf_node_get (uc_route_entry->vr_id);
+        p_vrf_node = sai_fib_vrf_node_index_get (uc_route_entry->vr_id);
 
         if (!p_vrf_node) {
             SAI_ROUTE_LOG_ERR ("VRF ID 0x%"PRIx64" does not exist.",
@@ -606,7 +607,8 @@ const sai_attribute_t *attr_list)
 
         sai_fib_route_log_trace (p_route_node, "Parsing attributes successful");
 
-        sai_rc = sai_route_npu_api_get()->route_create (p_route_node);
+        SAI_API_LATENCY_NPU_CALL (sai_rc,
+                                  sai_route_npu_api_get()->route_create (p_route_node));
 
         if (sai_rc != SAI_STATUS_SUCCESS) {
             sai_fib_route_log_error (p_route_node, "Failed to create route");
@@ -674,7 +676,7 @@ const sai_route_entry_t *uc_route_entry)
     sai_fib_lock ();
 
     do {
-        p_vrf_node = sai_fib_vrf_node_get (uc_route_entry->vr_id);
+        p_vrf_node = sai_fib_vrf_node_index_get (uc_route_entry->vr_id);
 
         if (!p_vrf_node) {
             SAI_ROUTE_LOG_ERR ("VRF ID 0x%"PRIx64" does not exist in VRF tree.",
@@ -695,7 +697,8 @@ const sai_route_entry_t *uc_route_entry)
 
         sai_fib_route_log_trace (p_route_node, "Route to be removed in NPU");
 
-        sai_rc = sai_route_npu_api_get()->route_remove (p_route_node);
+        SAI_API_LATENCY_NPU_CALL (sai_rc,
+                                  sai_route_npu_api_get()->route_remove (p_route_node));
 
         if (sai_rc != SAI_STATUS_SUCCESS) {
             sai_fib_route_log_error (p_route_node,
@@ -764,7 +767,7 @@ const sai_route_entry_t *uc_route_entry, const sai_attribute_t *attr)
     sai_fib_lock ();
 
     do {
-        p_vrf_node = sai_fib_vrf_node_get (uc_route_entry->vr_id);
+        p_vrf_node = sai_fib_vrf_node_index_get (uc_route_entry->vr_id);
 
         if (!p_vrf_node) {
             SAI_ROUTE_LOG_ERR ("VRF ID 0x%"PRIx64" does not exist in VRF tree.",
@@ -800,8 +803,10 @@ const sai_route_entry_t *uc_route_entry, const sai_attribute_t *attr)
 
         sai_fib_route_log_trace (&route_node_in, "Parsing attributes success");
 
-        sai_rc = sai_route_npu_api_get()->route_attr_set (&route_node_in, attr_count,
-                                                          attr);
+        SAI_API_LATENCY_NPU_CALL (sai_rc,
+                                  sai_route_npu_api_get()->route_attr_set (&route_node_in,
+                                                                           attr_count,
+                                                                           attr));
         if (sai_rc != SAI_STATUS_SUCCESS) {
             sai_fib_route_log_error (&route_node_in,
                                      "Failed to Set/Modify Route in NPU");
@@ -876,8 +881,10 @@ sai_attribute_t *attr_list)
             break;
         }
 
-        sai_rc = sai_route_npu_api_get()->route_attr_get (p_route_node, attr_count,
-                                              attr_list);
+        SAI_API_LATENCY_NPU_CALL (sai_rc,
+                                  sai_route_npu_api_get()->route_attr_get (p_route_node,
+                                                                           attr_count,
+                                                                           attr_list));
 
         if (sai_rc != SAI_STATUS_SUCCESS) {
             sai_fib_route_log_error (p_route_node,
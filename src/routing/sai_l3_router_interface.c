@@ -37,8 +37,29 @@
 #include "sai_common_infra.h"
 #include <string.h>
 #include <stdio.h>
+#include <stdlib.h>
 #include <inttypes.h>
 
+/*
+ * Secondary index of the RIF nodes keyed on RIF type and attached port or
+ * VLAN id. The RIF id is part of the key as more than one RIF can be
+ * attached to the same port or VLAN with a different source MAC. All the
+ * RIFs of a given type and attachment are adjacent in the index.
+ */
+typedef struct _sai_fib_rif_attach_key_t {
+    uint32_t        type;
+    uint32_t        reserved;
+    uint64_t        port_or_vlan_id;
+    sai_object_id_t rif_id;
+} sai_fib_rif_attach_key_t;
+
+typedef struct _sai_fib_rif_attach_entry_t {
+    sai_fib_rif_attach_key_t    key;
+    sai_fib_router_interface_t *p_rif_node;
+} sai_fib_rif_attach_entry_t;
+
+static rbtree_handle sai_fib_rif_attach_tree = NULL;
+
 static inline bool sai_fib_is_rif_type_valid (uint_t type)
 {
     return ((type == SAI_ROUTER_INTERFACE_TYPE_PORT) ||
@@ -121,7 +142,7 @@ sai_fib_router_interface_t *p_rif_node, sai_object_id_t vr_id)
         return SAI_STATUS_INVALID_ATTR_VALUE_0;
     }
 
-    p_vrf_node = sai_fib_vrf_node_get (vr_id);
+    p_vrf_node = sai_fib_vrf_node_index_get (vr_id);
 
     if (!p_vrf_node) {
         SAI_RIF_LOG_ERR ("VR ID 0x%"PRIx64" does not exist in VRF tree.", vr_id);
@@ -512,7 +533,7 @@ sai_fib_router_interface_t *p_rif_node, uint_t rif_attr_flags)
                        "Attribute flags: 0x%x.", p_rif_node->vrf_id,
                        rif_attr_flags);
 
-    p_vrf_node = sai_fib_vrf_node_get (p_rif_node->vrf_id);
+    p_vrf_node = sai_fib_vrf_node_index_get (p_rif_node->vrf_id);
 
     if (!p_vrf_node) {
         SAI_RIF_LOG_ERR ("VR ID 0x%"PRIx64" does not exist in VRF tree.",
@@ -545,42 +566,175 @@ sai_fib_router_interface_t *p_rif_node, uint_t rif_attr_flags)
     return SAI_STATUS_SUCCESS;
 }
 
+static inline void sai_fib_rif_attach_key_fill (sai_fib_rif_attach_key_t *p_key,
+                                                uint_t type,
+                                                uint64_t port_or_vlan_id,
+                                                sai_object_id_t rif_id)
+{
+    memset (p_key, 0, sizeof (*p_key));
+
+    p_key->type            = type;
+    p_key->port_or_vlan_id = port_or_vlan_id;
+    p_key->rif_id          = rif_id;
+}
+
+/*
+ * Returns the first index entry of the given RIF type and attachment
+ * following p_entry, or the first entry when p_entry is NULL.
+ */
+static sai_fib_rif_attach_entry_t *sai_fib_rif_attach_entry_next (
+uint_t type, uint64_t port_or_vlan_id, sai_fib_rif_attach_entry_t *p_entry)
+{
+    sai_fib_rif_attach_entry_t  entry;
+    sai_fib_rif_attach_entry_t *p_next = NULL;
+
+    if (sai_fib_rif_attach_tree == NULL) {
+        return NULL;
+    }
+
+    if (p_entry == NULL) {
+        /* No RIF has a NULL object id, search from the lowest key */
+        sai_fib_rif_attach_key_fill (&entry.key, type, port_or_vlan_id,
+                                     SAI_NULL_OBJECT_ID);
+        p_entry = &entry;
+    }
+
+    p_next = std_rbtree_getnext (sai_fib_rif_attach_tree, p_entry);
+
+    if ((p_next == NULL) || (p_next->key.type != type) ||
+        (p_next->key.port_or_vlan_id != port_or_vlan_id)) {
+        return NULL;
+    }
+
+    return p_next;
+}
+
+static sai_status_t sai_fib_rif_attach_index_add (
+sai_fib_router_interface_t *p_rif_node)
+{
+    sai_fib_rif_attach_entry_t *p_entry = NULL;
+
+    if (p_rif_node->type == SAI_ROUTER_INTERFACE_TYPE_LOOPBACK) {
+        return SAI_STATUS_SUCCESS;
+    }
+
+    p_entry = (sai_fib_rif_attach_entry_t *) calloc (1, sizeof (*p_entry));
+
+    if (p_entry == NULL) {
+        sai_fib_rif_log_error (p_rif_node, "Failed to allocate RIF index entry");
+
+        return SAI_STATUS_NO_MEMORY;
+    }
+
+    sai_fib_rif_attach_key_fill (&p_entry->key, p_rif_node->type,
+                                 sai_fib_rif_port_or_vlan_id_get (p_rif_node),
+                                 p_rif_node->rif_id);
+    p_entry->p_rif_node = p_rif_node;
+
+    if (std_rbtree_insert (sai_fib_rif_attach_tree, p_entry) != STD_ERR_OK) {
+        sai_fib_rif_log_error (p_rif_node, "Failed to insert to RIF index");
+
+        free (p_entry);
+
+        return SAI_STATUS_FAILURE;
+    }
+
+    return SAI_STATUS_SUCCESS;
+}
+
+static void sai_fib_rif_attach_index_remove (
+sai_fib_router_interface_t *p_rif_node)
+{
+    sai_fib_rif_attach_entry_t  entry;
+    sai_fib_rif_attach_entry_t *p_entry = NULL;
+
+    if (p_rif_node->type == SAI_ROUTER_INTERFACE_TYPE_LOOPBACK) {
+        return;
+    }
+
+    sai_fib_rif_attach_key_fill (&entry.key, p_rif_node->type,
+                                 sai_fib_rif_port_or_vlan_id_get (p_rif_node),
+                                 p_rif_node->rif_id);
+
+    p_entry = std_rbtree_remove (sai_fib_rif_attach_tree, &entry);
+
+    if (p_entry != NULL) {
+        free (p_entry);
+    }
+}
+
+sai_status_t sai_fib_rif_attach_index_init (void)
+{
+    sai_fib_rif_attach_tree = std_rbtree_create_simple (
+                  "rif_attach_index_tree",
+                  STD_STR_OFFSET_OF (sai_fib_rif_attach_entry_t, key),
+                  STD_STR_SIZE_OF (sai_fib_rif_attach_entry_t, key));
+
+    if (sai_fib_rif_attach_tree == NULL) {
+        SAI_RIF_LOG_ERR ("RIF attachment index tree init failed.");
+
+        return SAI_STATUS_NO_MEMORY;
+    }
+
+    return SAI_STATUS_SUCCESS;
+}
+
+sai_fib_router_interface_t *sai_fib_port_rif_node_get (sai_object_id_t port_id)
+{
+    sai_fib_rif_attach_entry_t *p_entry = NULL;
+
+    p_entry = sai_fib_rif_attach_entry_next (SAI_ROUTER_INTERFACE_TYPE_PORT,
+                                             (uint64_t) port_id, NULL);
+
+    return ((p_entry != NULL) ? p_entry->p_rif_node : NULL);
+}
+
+sai_fib_router_interface_t *sai_fib_vlan_rif_node_get (sai_vlan_id_t vlan_id)
+{
+    sai_fib_rif_attach_entry_t *p_entry = NULL;
+
+    p_entry = sai_fib_rif_attach_entry_next (SAI_ROUTER_INTERFACE_TYPE_VLAN,
+                                             (uint64_t) vlan_id, NULL);
+
+    return ((p_entry != NULL) ? p_entry->p_rif_node : NULL);
+}
+
 static bool sai_fib_rif_is_duplicate (sai_fib_router_interface_t *p_rif_node)
 {
-    rbtree_handle  rif_tree;
+    sai_fib_rif_attach_entry_t *p_entry = NULL;
     sai_fib_router_interface_t *p_db_rif_node;
+    uint64_t                    port_or_vlan_id;
 
     STD_ASSERT(p_rif_node != NULL);
     if(p_rif_node->type == SAI_ROUTER_INTERFACE_TYPE_LOOPBACK) {
         return false;
     }
 
-    rif_tree = sai_fib_access_global_config()->router_interface_tree;
+    port_or_vlan_id = sai_fib_rif_port_or_vlan_id_get (p_rif_node);
 
-    p_db_rif_node = std_rbtree_getfirst (rif_tree);
+    p_entry = sai_fib_rif_attach_entry_next (p_rif_node->type,
+                                             port_or_vlan_id, NULL);
 
-    while (p_db_rif_node != NULL) {
+    while (p_entry != NULL) {
 
-        if ((p_rif_node->type == p_db_rif_node->type) &&
-            (sai_fib_rif_port_or_vlan_id_get (p_rif_node) ==
-            (sai_fib_rif_port_or_vlan_id_get (p_db_rif_node)))) {
+        p_db_rif_node = p_entry->p_rif_node;
 
-            if (p_rif_node->vrf_id != p_db_rif_node->vrf_id) {
-                sai_fib_rif_log_trace (p_db_rif_node, "Another RIF exists "
-                             "for the same Port or VLAN on different VRF.");
+        if (p_rif_node->vrf_id != p_db_rif_node->vrf_id) {
+            sai_fib_rif_log_trace (p_db_rif_node, "Another RIF exists "
+                         "for the same Port or VLAN on different VRF.");
 
-                return true;
-            }
+            return true;
+        }
 
-            if ((!(memcmp (p_rif_node->src_mac, p_db_rif_node->src_mac,
-                sizeof (sai_mac_t))))) {
-                sai_fib_rif_log_trace (p_db_rif_node, "Duplicate RIF object info.");
+        if ((!(memcmp (p_rif_node->src_mac, p_db_rif_node->src_mac,
+            sizeof (sai_mac_t))))) {
+            sai_fib_rif_log_trace (p_db_rif_node, "Duplicate RIF object info.");
 
-                return true;
-            }
+            return true;
         }
 
-        p_db_rif_node = std_rbtree_getnext (rif_tree, p_db_rif_node);
+        p_entry = sai_fib_rif_attach_entry_next (p_rif_node->type,
+                                                 port_or_vlan_id, p_entry);
     }
 
     return false;
@@ -1013,6 +1167,15 @@ const sai_attribute_t *attr_list)
             sai_rc = SAI_STATUS_FAILURE;
             break;
         }
+
+        sai_rc = sai_fib_rif_attach_index_add (p_rif_node);
+
+        if (sai_rc != SAI_STATUS_SUCCESS) {
+            std_rbtree_remove (rif_tree, p_rif_node);
+            break;
+        }
+
+        sai_fib_router_interface_node_index_update (p_rif_node, true);
     } while (0);
 
     if (sai_rc == SAI_STATUS_SUCCESS) {
@@ -1059,7 +1222,7 @@ sai_object_id_t rif_id)
     }
 
     sai_fib_lock ();
-    p_rif_node = sai_fib_router_interface_node_get (rif_id);
+    p_rif_node = sai_fib_router_interface_node_index_get (rif_id);
 
     if (!p_rif_node) {
         SAI_RIF_LOG_ERR ("RIF Id: 0x%"PRIx64" does not exist.", rif_id);
@@ -1107,6 +1270,10 @@ sai_object_id_t rif_id)
 
         std_rbtree_remove (rif_tree, p_rif_node);
 
+        sai_fib_rif_attach_index_remove (p_rif_node);
+
+        sai_fib_router_interface_node_index_update (p_rif_node, false);
+
         sai_fib_rif_routing_config_update (p_rif_node, false);
 
         sai_fib_rif_node_free (p_rif_node);
@@ -1157,7 +1324,7 @@ sai_object_id_t rif_id, const sai_attribute_t *p_attr)
     sai_fib_lock ();
 
     do {
-        p_rif_node = sai_fib_router_interface_node_get (rif_id);
+        p_rif_node = sai_fib_router_interface_node_index_get (rif_id);
 
         if (!p_rif_node) {
             SAI_RIF_LOG_ERR ("RIF Id: 0x%"PRIx64" does not exist.", rif_id);
@@ -1261,7 +1428,7 @@ sai_attribute_t *attr_list)
     sai_fib_lock ();
 
     do {
-        p_rif_node = sai_fib_router_interface_node_get (rif_id);
+        p_rif_node = sai_fib_router_interface_node_index_get (rif_id);
 
         if (!p_rif_node) {
             SAI_RIF_LOG_ERR ("RIF Id: 0x%"PRIx64" does not exist.", rif_id);
@@ -1294,8 +1461,8 @@ sai_attribute_t *attr_list)
     return sai_rc;
 }
 
-static sai_status_t sai_rif_lag_member_update (sai_object_id_t rif_id,
-sai_object_id_t lag_id, const sai_object_list_t *port_id_list, bool is_add)
+static sai_status_t sai_rif_lag_member_update (sai_object_id_t lag_id,
+const sai_object_list_t *port_id_list, bool is_add)
 
 {
     sai_status_t                sai_rc = SAI_STATUS_FAILURE;
@@ -1312,27 +1479,19 @@ sai_object_id_t lag_id, const sai_object_list_t *port_id_list, bool is_add)
     sai_fib_lock ();
 
     do {
-        p_rif_node = sai_fib_router_interface_node_get (rif_id);
+        /* LAG RIFs are indexed as Port RIFs on the LAG Id */
+        p_rif_node = sai_fib_port_rif_node_get (lag_id);
 
         if (!p_rif_node) {
-            SAI_RIF_LOG_TRACE ("RIF Id: 0x%"PRIx64" does not exist.", rif_id);
+            SAI_RIF_LOG_TRACE ("LAG Id: 0x%"PRIx64" has no RIF.", lag_id);
 
-            sai_rc = SAI_STATUS_INVALID_OBJECT_ID;
-            break;
+            sai_fib_unlock ();
+
+            return SAI_STATUS_SUCCESS;
         }
 
         sai_fib_rif_log_trace (p_rif_node, "Router Interface Info");
 
-        /* Validate the input LAG Id */
-        if (p_rif_node->attachment.port_id != lag_id) {
-            SAI_RIF_LOG_TRACE ("RIF attachment Id 0x%"PRIx64" is not same as the "
-                               "LAG Id 0x%"PRIx64".",
-                               p_rif_node->attachment.port_id, lag_id);
-
-            sai_rc = SAI_STATUS_FAILURE;
-            break;
-        }
-
         sai_rc = sai_rif_npu_api_get()->rif_lag_member_update (p_rif_node,
                                                                port_id_list,
                                                                is_add);
@@ -1353,8 +1512,8 @@ sai_object_id_t lag_id, const sai_object_list_t *port_id_list, bool is_add)
     }
 
     SAI_RIF_LOG_TRACE ("RIF Id: 0x%"PRIx64", LAG Id: 0x%"PRIx64", is_add: %d, "
-                       "Returning %d from LAG member update callback.", rif_id,
-                       lag_id, is_add, sai_rc);
+                       "Returning %d from LAG member update callback.",
+                       p_rif_node->rif_id, lag_id, is_add, sai_rc);
 
     return sai_rc;
 }
@@ -1363,10 +1522,8 @@ sai_status_t sai_rif_lag_callback (sai_object_id_t lag_id,
                                    sai_lag_operation_t lag_opcode,
                                    const sai_object_list_t *port_list)
 {
-    sai_object_id_t rif_id = SAI_NULL_OBJECT_ID;
-
-    SAI_RIF_LOG_TRACE ("RIF LAG callback for RIF Id: 0x%"PRIx64", LAG Id: "
-                       "0x%"PRIx64", op_code: %d", rif_id, lag_id, lag_opcode);
+    SAI_RIF_LOG_TRACE ("RIF LAG callback for LAG Id: 0x%"PRIx64", op_code: %d",
+                       lag_id, lag_opcode);
 
     /* Validate lag_opcode */
     if ((lag_opcode != SAI_LAG_OPER_ADD_PORTS) &&
@@ -1378,13 +1535,7 @@ sai_status_t sai_rif_lag_callback (sai_object_id_t lag_id,
         return SAI_STATUS_SUCCESS;
     }
 
-    sai_fib_get_rif_id_from_lag_id (lag_id, &rif_id);
-    if(rif_id == SAI_NULL_OBJECT_ID) {
-        SAI_RIF_LOG_TRACE ("LAG Id: 0x%"PRIx64" has no RIF mapping", lag_id);
-        return SAI_STATUS_SUCCESS;
-    }
-
-    return sai_rif_lag_member_update (rif_id, lag_id, port_list,
+    return sai_rif_lag_member_update (lag_id, port_list,
                                       ((lag_opcode == SAI_LAG_OPER_ADD_PORTS)
                                        ? true : false));
 }
@@ -386,11 +386,6 @@ static sai_status_t sai_fib_vrf_node_trees_create (sai_fib_vrf_t *p_vrf_node)
         return SAI_STATUS_NO_MEMORY;
     }
 
-    std_radix_enable_radical (p_vrf_node->sai_route_tree);
-
-    std_radical_walkconstructor (p_vrf_node->sai_route_tree,
-                                 &p_vrf_node->route_marker);
-
     return SAI_STATUS_SUCCESS;
 }
 
@@ -414,6 +409,8 @@ static sai_status_t sai_fib_vrf_node_insert_to_tree (sai_fib_vrf_t *p_vrf_node)
         return SAI_STATUS_FAILURE;
     }
 
+    sai_fib_vrf_node_index_update (p_vrf_node, true);
+
     return SAI_STATUS_SUCCESS;
 }
 
@@ -599,7 +596,7 @@ sai_object_id_t vr_id)
     sai_fib_lock ();
 
     do {
-        p_vrf_node = sai_fib_vrf_node_get (vr_id);
+        p_vrf_node = sai_fib_vrf_node_index_get (vr_id);
 
         if (!p_vrf_node) {
             SAI_ROUTER_LOG_ERR ("VR ID 0x%"PRIx64" does not exist in VRF tree.", vr_id);
@@ -653,6 +650,8 @@ sai_object_id_t vr_id)
 
         std_rbtree_remove (vrf_tree, p_vrf_node);
 
+        sai_fib_vrf_node_index_update (p_vrf_node, false);
+
         sai_fib_vrf_free_resources (p_vrf_node);
 
         sai_fib_num_virtual_routers_decr ();
@@ -696,7 +695,7 @@ sai_object_id_t vr_id, const sai_attribute_t *p_attr)
     sai_fib_lock ();
 
     do {
-        p_vrf_node = sai_fib_vrf_node_get (vr_id);
+        p_vrf_node = sai_fib_vrf_node_index_get (vr_id);
 
         if (!p_vrf_node) {
             SAI_ROUTER_LOG_ERR ("VR ID 0x%"PRIx64" does not exist.", vr_id);
@@ -774,7 +773,7 @@ sai_object_id_t vr_id, uint32_t attr_count, sai_attribute_t *attr_list)
     sai_fib_lock ();
 
     do {
-        p_vrf_node = sai_fib_vrf_node_get (vr_id);
+        p_vrf_node = sai_fib_vrf_node_index_get (vr_id);
 
         if (!p_vrf_node) {
             SAI_ROUTER_LOG_ERR ("VR ID 0x%"PRIx64" does not exist.", vr_id);
@@ -829,7 +828,7 @@ sai_fib_router_interface_t *p_rif_node, bool is_add)
 
     vr_id = p_rif_node->vrf_id;
 
-    p_vrf_node = sai_fib_vrf_node_get (vr_id);
+    p_vrf_node = sai_fib_vrf_node_index_get (vr_id);
 
     if (!p_vrf_node) {
         SAI_ROUTER_LOG_ERR ("VR ID 0x%"PRIx64" does not exist in VRF tree.", vr_id);
@@ -895,6 +894,14 @@ sai_status_t sai_router_init (void)
     /* Initialize the UOID generator for next hop group member id */
     sai_fib_next_hop_grp_member_gen_info_init();
 
+    sai_rc = sai_fib_rif_attach_index_init ();
+
+    if (sai_rc != SAI_STATUS_SUCCESS) {
+        SAI_ROUTER_LOG_CRIT ("SAI FIB RIF attachment index init failed.");
+
+        return sai_rc;
+    }
+
     sai_rc = sai_router_npu_api_get()->fib_init ();
 
     if (sai_rc != SAI_STATUS_SUCCESS) {
@@ -26,6 +26,7 @@
 
 #include "sai_port_common.h"
 #include "sai_port_utils.h"
+#include "sai_common_acl.h"
 #include "sai_samplepacket_defs.h"
 #include "sai_samplepacket_api.h"
 #include "sai_samplepacket_util.h"
@@ -42,6 +43,20 @@
 
 static std_rt_table *sai_acl_info_per_port = NULL;
 
+/*
+ * Samplepacket session applied on all the ports through ACL rules. The
+ * session is added to every port once, when the first such ACL rule is
+ * applied, and further rules only take a reference. Per port ACL info nodes
+ * are kept only for ACL rules with a port list, as overrides.
+ */
+typedef struct _sai_samplepacket_all_ports_bind_t {
+    sai_object_id_t sample_object;
+    uint_t          rule_count;
+} sai_samplepacket_all_ports_bind_t;
+
+static sai_samplepacket_all_ports_bind_t
+                       sai_samplepacket_all_ports_bind [SAI_SAMPLEPACKET_DIR_MAX];
+
 std_rt_table* sai_acl_info_per_port_tree_get(void)
 {
     return sai_acl_info_per_port;
@@ -102,23 +117,6 @@ sai_status_t sai_acl_samplepacket_init ()
     return SAI_STATUS_SUCCESS;
 }
 
-static void sai_port_list_get(sai_object_list_t *port_list)
-{
-    uint_t count = 0;
-    STD_ASSERT(port_list != NULL);
-    STD_ASSERT(port_list->list != NULL);
-    sai_port_info_t *port_info = NULL;
-
-    for (port_info = sai_port_info_getfirst(); (port_info != NULL);
-            port_info = sai_port_info_getnext(port_info)) {
-        port_list->list[count] = port_info->sai_port_id;
-        count++;
-    }
-
-    port_list->count = count;
-}
-
-
 static sai_status_t sai_samplepacket_acl_is_same_sample_on_port (sai_object_id_t port_id,
                                                                  sai_object_id_t sample_object,
                                                                  sai_samplepacket_direction_t
@@ -227,6 +225,15 @@ static sai_status_t sai_samplepacket_validate_object_on_portlist  (sai_object_li
     STD_ASSERT (portlist != NULL);
     STD_ASSERT (portlist->list != NULL);
 
+    if ((sai_samplepacket_all_ports_bind[sample_direction].rule_count > 0) &&
+        (sai_samplepacket_all_ports_bind[sample_direction].sample_object != sample_object)) {
+        SAI_SAMPLEPACKET_LOG_ERR ("SamplePacket session 0x%"PRIx64" is applied on all the ports "
+                                  "for direction %d",
+                                  sai_samplepacket_all_ports_bind[sample_direction].sample_object,
+                                  sample_direction);
+        return SAI_STATUS_FAILURE;
+    }
+
     for (port_count = 0; port_count < portlist->count; ++port_count)
     {
         port_id = portlist->list[port_count];
@@ -289,112 +296,212 @@ static sai_status_t sai_samplepacket_update_object_on_portlist  (sai_object_list
     return rc;
 }
 
-sai_status_t sai_samplepacket_validate_object  (sai_object_list_t *portlist,
-                                                sai_object_id_t sample_object,
-                                                sai_samplepacket_direction_t sample_direction,
-                                                bool validate,
-                                                bool update)
+/*
+ * Checks that no port has a different samplepacket session applied through
+ * an ACL rule with a port list, in a single walk of the ACL info tree.
+ */
+static sai_status_t sai_samplepacket_validate_object_on_all_ports (sai_object_id_t sample_object,
+                                                                   sai_samplepacket_direction_t
+                                                                   sample_direction)
+{
+    sai_samplepacket_all_ports_bind_t *p_bind = &sai_samplepacket_all_ports_bind[sample_direction];
+    dn_sai_samplepacket_acl_info_t *p_acl_info = NULL;
+    dn_sai_samplepacket_acl_info_key_t key;
+
+    if (p_bind->rule_count > 0) {
+        if (p_bind->sample_object != sample_object) {
+            SAI_SAMPLEPACKET_LOG_ERR ("SamplePacket session 0x%"PRIx64" is already applied on "
+                                      "all the ports for direction %d",
+                                      p_bind->sample_object, sample_direction);
+            return SAI_STATUS_FAILURE;
+        }
+        return SAI_STATUS_SUCCESS;
+    }
+
+    memset (&key, 0, sizeof(key));
+
+    for (p_acl_info = (dn_sai_samplepacket_acl_info_t *) std_radix_getnext (
+                sai_acl_info_per_port_tree_get(), (u_char *)&key,
+                SAI_ACL_INFO_PER_PORT_TREE_KEY_SIZE);
+         p_acl_info != NULL;
+         p_acl_info = (dn_sai_samplepacket_acl_info_t *) std_radix_getnext (
+                sai_acl_info_per_port_tree_get(), (u_char *)&p_acl_info->key,
+                SAI_ACL_INFO_PER_PORT_TREE_KEY_SIZE)) {
+
+        if ((p_acl_info->key.port_id != SAI_NULL_OBJECT_ID) &&
+            (p_acl_info->key.samplepacket_direction == sample_direction) &&
+            (p_acl_info->key.sample_object != sample_object)) {
+            SAI_SAMPLEPACKET_LOG_ERR ("SamplePacket session cannot be overwritten "
+                                      "for port 0x%"PRIx64" and direction %d",
+                                      p_acl_info->key.port_id, sample_direction);
+            return SAI_STATUS_FAILURE;
+        }
+    }
+
+    return SAI_STATUS_SUCCESS;
+}
+
+/*
+ * Adds all the ports to the samplepacket session, in a single pass over the
+ * port list. Ports added before a failure are removed again.
+ */
+static sai_status_t sai_samplepacket_all_ports_add (sai_object_id_t sample_object,
+                                                    sai_samplepacket_direction_t sample_direction)
 {
     sai_status_t rc = SAI_STATUS_SUCCESS;
-    sai_object_list_t gen_port_list;
+    sai_port_info_t *port_info = NULL;
+    sai_port_info_t *failed_port_info = NULL;
 
-    memset (&gen_port_list, 0, sizeof(gen_port_list));
+    for (port_info = sai_port_info_getfirst(); (port_info != NULL);
+            port_info = sai_port_info_getnext(port_info)) {
 
-    if (!validate && !update) {
-        SAI_SAMPLEPACKET_LOG_WARN ("No action to be performed");
+        rc = sai_samplepacket_session_port_add (sample_object,
+                port_info->sai_port_id, sample_direction, SAI_SAMPLEPACKET_MODE_FLOW_BASED);
+        if (rc != SAI_STATUS_SUCCESS) {
+            SAI_SAMPLEPACKET_LOG_ERR("Could not add port 0x%"PRIx64" to the samplepacket session 0x%"PRIx64"",
+                                      port_info->sai_port_id, sample_object);
+            failed_port_info = port_info;
+            break;
+        }
+    }
+
+    if (failed_port_info == NULL) {
         return SAI_STATUS_SUCCESS;
     }
 
-    do {
-        if (portlist == NULL) {
-            gen_port_list.list = (sai_object_id_t *) calloc(sai_switch_get_max_lport(),
-                    sizeof(sai_object_id_t));
+    for (port_info = sai_port_info_getfirst(); (port_info != failed_port_info);
+            port_info = sai_port_info_getnext(port_info)) {
+        sai_samplepacket_session_port_remove (sample_object,
+                port_info->sai_port_id, sample_direction, SAI_SAMPLEPACKET_MODE_FLOW_BASED);
+    }
 
-            if(gen_port_list.list == NULL) {
-                SAI_SAMPLEPACKET_LOG_ERR ("Allocation of Memory failed for port object list");
-                rc = SAI_STATUS_NO_MEMORY;
-                break;
-            }
+    return rc;
+}
 
-            sai_port_list_get (&gen_port_list);
+static sai_status_t sai_samplepacket_all_ports_remove (sai_object_id_t sample_object,
+                                                       sai_samplepacket_direction_t sample_direction)
+{
+    sai_status_t rc = SAI_STATUS_SUCCESS;
+    sai_status_t port_rc = SAI_STATUS_SUCCESS;
+    sai_port_info_t *port_info = NULL;
 
-            if (gen_port_list.count == 0) {
-                SAI_SAMPLEPACKET_LOG_ERR ("Ports are not configured on the system");
-                rc = SAI_STATUS_FAILURE;
-                break;
-            } else if (gen_port_list.count > sai_switch_get_max_lport()) {
-                free (gen_port_list.list);
-                gen_port_list.list = (sai_object_id_t *) calloc(gen_port_list.count,
-                                     sizeof(sai_object_id_t));
-
-                if(gen_port_list.list == NULL) {
-                    SAI_SAMPLEPACKET_LOG_ERR ("Allocation of Memory failed for port object list");
-                    rc = SAI_STATUS_NO_MEMORY;
-                    break;
-                }
+    for (port_info = sai_port_info_getfirst(); (port_info != NULL);
+            port_info = sai_port_info_getnext(port_info)) {
 
-                sai_port_list_get (&gen_port_list);
-            }
+        port_rc = sai_samplepacket_session_port_remove (sample_object,
+                port_info->sai_port_id, sample_direction, SAI_SAMPLEPACKET_MODE_FLOW_BASED);
 
-            if (validate) {
-                rc = sai_samplepacket_validate_object_on_portlist (&gen_port_list,
-                        sample_object,
-                        sample_direction);
+        /* Port is still referenced by an ACL rule with a port list */
+        if ((port_rc != SAI_STATUS_SUCCESS) && (port_rc != SAI_STATUS_OBJECT_IN_USE)) {
+            SAI_SAMPLEPACKET_LOG_WARN("Could not remove port 0x%"PRIx64" to the samplepacket "
+                                      "session 0x%"PRIx64"",
+                                       port_info->sai_port_id, sample_object);
+            rc = port_rc;
+        }
+    }
 
-                if (rc != SAI_STATUS_SUCCESS) {
-                    break;
-                }
-            }
+    return rc;
+}
 
-            if (update) {
-                rc = sai_samplepacket_update_object_on_portlist (&gen_port_list,
-                        sample_object,
-                        sample_direction);
+static sai_status_t sai_samplepacket_update_object_on_all_ports (sai_object_id_t sample_object,
+                                                                 sai_samplepacket_direction_t
+                                                                 sample_direction)
+{
+    sai_status_t rc = SAI_STATUS_SUCCESS;
+    sai_samplepacket_all_ports_bind_t *p_bind = &sai_samplepacket_all_ports_bind[sample_direction];
 
-                if (rc != SAI_STATUS_SUCCESS) {
-                   break;
-                }
+    if (p_bind->rule_count > 0) {
+        if (p_bind->sample_object != sample_object) {
+            SAI_SAMPLEPACKET_LOG_ERR ("SamplePacket session 0x%"PRIx64" is already applied on "
+                                      "all the ports for direction %d",
+                                      p_bind->sample_object, sample_direction);
+            return SAI_STATUS_FAILURE;
+        }
 
-                /*
-                 * A dummy node is inserted to identify that a samplepacket session is applied on all the
-                 * ports to be used for dynamic fanout
-                 */
-                rc = sai_samplepacket_check_and_insert_acl_info (SAI_NULL_OBJECT_ID,
-                        sample_object,
-                        sample_direction);
+        p_bind->rule_count++;
+        return SAI_STATUS_SUCCESS;
+    }
 
-                if (rc != SAI_STATUS_SUCCESS) {
-                    SAI_SAMPLEPACKET_LOG_WARN ("SamplePacket session 0x%"PRIx64" acl cache could not be"
-                            "updated for dummy port 0x%"PRIx64" and direction %d",
-                            sample_object, sample_direction);
-                }
-            }
+    if (sai_port_info_getfirst() == NULL) {
+        SAI_SAMPLEPACKET_LOG_ERR ("Ports are not configured on the system");
+        return SAI_STATUS_FAILURE;
+    }
 
-        } else {
-            if (validate) {
-                rc = sai_samplepacket_validate_object_on_portlist (portlist,
-                        sample_object,
-                        sample_direction);
+    rc = sai_samplepacket_all_ports_add (sample_object, sample_direction);
 
-                if (rc != SAI_STATUS_SUCCESS) {
-                    return rc;
-                }
+    if (rc != SAI_STATUS_SUCCESS) {
+        return rc;
+    }
+
+    /*
+     * A dummy node is inserted to identify that a samplepacket session is applied on all the
+     * ports to be used for dynamic fanout
+     */
+    rc = sai_samplepacket_check_and_insert_acl_info (SAI_NULL_OBJECT_ID,
+            sample_object,
+            sample_direction);
+
+    if (rc != SAI_STATUS_SUCCESS) {
+        SAI_SAMPLEPACKET_LOG_ERR ("SamplePacket session 0x%"PRIx64" acl cache could not be"
+                "updated for dummy port and direction %d",
+                sample_object, sample_direction);
+        sai_samplepacket_all_ports_remove (sample_object, sample_direction);
+        return rc;
+    }
+
+    p_bind->sample_object = sample_object;
+    p_bind->rule_count = 1;
+
+    return SAI_STATUS_SUCCESS;
+}
+
+sai_status_t sai_samplepacket_validate_object  (sai_object_list_t *portlist,
+                                                sai_object_id_t sample_object,
+                                                sai_samplepacket_direction_t sample_direction,
+                                                bool validate,
+                                                bool update)
+{
+    sai_status_t rc = SAI_STATUS_SUCCESS;
+
+    if (!validate && !update) {
+        SAI_SAMPLEPACKET_LOG_WARN ("No action to be performed");
+        return SAI_STATUS_SUCCESS;
+    }
+
+    if (sample_direction >= SAI_SAMPLEPACKET_DIR_MAX) {
+        return SAI_STATUS_INVALID_PARAMETER;
+    }
+
+    if (portlist == NULL) {
+        if (validate) {
+            rc = sai_samplepacket_validate_object_on_all_ports (sample_object,
+                    sample_direction);
+
+            if (rc != SAI_STATUS_SUCCESS) {
+                return rc;
             }
+        }
 
-            if (update) {
-                rc = sai_samplepacket_update_object_on_portlist (portlist,
-                        sample_object,
-                        sample_direction);
+        if (update) {
+            rc = sai_samplepacket_update_object_on_all_ports (sample_object,
+                    sample_direction);
+        }
+    } else {
+        if (validate) {
+            rc = sai_samplepacket_validate_object_on_portlist (portlist,
+                    sample_object,
+                    sample_direction);
 
-                if (rc != SAI_STATUS_SUCCESS) {
-                    return rc;
-                }
+            if (rc != SAI_STATUS_SUCCESS) {
+                return rc;
             }
         }
-    } while (0);
 
-    if (gen_port_list.list != NULL) {
-        free (gen_port_list.list);
+        if (update) {
+            rc = sai_samplepacket_update_object_on_portlist (portlist,
+                    sample_object,
+                    sample_direction);
+        }
     }
 
     return rc;
@@ -409,7 +516,7 @@ sai_status_t sai_samplepacket_remove_object (sai_object_list_t *portlist,
     sai_status_t rc = SAI_STATUS_SUCCESS;
     dn_sai_samplepacket_acl_info_t *p_acl_info = NULL;
     dn_sai_samplepacket_acl_info_key_t key;
-    sai_port_info_t *port_info = NULL;
+    sai_samplepacket_all_ports_bind_t *p_bind = NULL;
 
     memset (&key, 0, sizeof(key));
 
@@ -417,11 +524,29 @@ sai_status_t sai_samplepacket_remove_object (sai_object_list_t *portlist,
         return SAI_STATUS_FAILURE;
     }
 
+    if (sample_direction >= SAI_SAMPLEPACKET_DIR_MAX) {
+        return SAI_STATUS_INVALID_PARAMETER;
+    }
+
     key.sample_object = sample_object;
     key.samplepacket_direction = sample_direction;
 
     if (portlist == NULL) {
 
+        p_bind = &sai_samplepacket_all_ports_bind[sample_direction];
+
+        if ((p_bind->rule_count == 0) || (p_bind->sample_object != sample_object)) {
+            return SAI_STATUS_SUCCESS;
+        }
+
+        p_bind->rule_count--;
+
+        if (p_bind->rule_count > 0) {
+            return SAI_STATUS_SUCCESS;
+        }
+
+        p_bind->sample_object = SAI_NULL_OBJECT_ID;
+
         /*
          * Remove the dummy node
          */
@@ -436,27 +561,7 @@ sai_status_t sai_samplepacket_remove_object (sai_object_list_t *portlist,
             p_acl_info = NULL;
         }
 
-        for (port_info = sai_port_info_getfirst(); (port_info != NULL);
-                port_info = sai_port_info_getnext(port_info)) {
-
-            key.port_id = port_info->sai_port_id;
-            p_acl_info = (dn_sai_samplepacket_acl_info_t *) std_radix_getexact (
-                         sai_acl_info_per_port_tree_get(), (u_char *)&key,
-                         SAI_ACL_INFO_PER_PORT_TREE_KEY_SIZE);
-
-            if (p_acl_info) {
-                rc = sai_samplepacket_session_port_remove (sample_object,
-                        port_info->sai_port_id, sample_direction, SAI_SAMPLEPACKET_MODE_FLOW_BASED);
-                if (rc != SAI_STATUS_SUCCESS) {
-                    SAI_SAMPLEPACKET_LOG_WARN("Could not remove port 0x%"PRIx64" to the samplepacket "
-                                              "session 0x%"PRIx64"",
-                                               port_info->sai_port_id, sample_object);
-                } else {
-                    std_radix_remove (sai_acl_info_per_port_tree_get(), &p_acl_info->head);
-                    free (p_acl_info);
-                }
-            }
-        }
+        rc = sai_samplepacket_all_ports_remove (sample_object, sample_direction);
     } else {
         for (port_count = 0; port_count < portlist->count; ++port_count)
         {
@@ -482,3 +587,78 @@ sai_status_t sai_samplepacket_remove_object (sai_object_list_t *portlist,
 
     return rc;
 }
+
+/*
+ * Walks the dummy nodes of the samplepacket sessions applied on all the
+ * ports and adds or removes the given port to/from each of them.
+ */
+static sai_status_t sai_samplepacket_all_ports_fanout_update (sai_object_id_t port_id,
+                                                              bool is_add)
+{
+    sai_status_t rc = SAI_STATUS_SUCCESS;
+    sai_status_t port_rc = SAI_STATUS_SUCCESS;
+    dn_sai_samplepacket_acl_info_t *p_acl_info = NULL;
+    dn_sai_samplepacket_acl_info_key_t key;
+
+    if (!(sai_acl_info_per_port_tree_get()))  {
+        return SAI_STATUS_FAILURE;
+    }
+
+    memset (&key, 0, sizeof(key));
+
+    for (p_acl_info = (dn_sai_samplepacket_acl_info_t *) std_radix_getnext (
+                sai_acl_info_per_port_tree_get(), (u_char *)&key,
+                SAI_ACL_INFO_PER_PORT_TREE_KEY_SIZE);
+         (p_acl_info != NULL) && (p_acl_info->key.port_id == SAI_NULL_OBJECT_ID);
+         p_acl_info = (dn_sai_samplepacket_acl_info_t *) std_radix_getnext (
+                sai_acl_info_per_port_tree_get(), (u_char *)&p_acl_info->key,
+                SAI_ACL_INFO_PER_PORT_TREE_KEY_SIZE)) {
+
+        if (is_add) {
+            port_rc = sai_samplepacket_session_port_add (p_acl_info->key.sample_object,
+                    port_id, p_acl_info->key.samplepacket_direction,
+                    SAI_SAMPLEPACKET_MODE_FLOW_BASED);
+        } else {
+            port_rc = sai_samplepacket_session_port_remove (p_acl_info->key.sample_object,
+                    port_id, p_acl_info->key.samplepacket_direction,
+                    SAI_SAMPLEPACKET_MODE_FLOW_BASED);
+
+            if (port_rc == SAI_STATUS_OBJECT_IN_USE) {
+                port_rc = SAI_STATUS_SUCCESS;
+            }
+        }
+
+        if (port_rc != SAI_STATUS_SUCCESS) {
+            SAI_SAMPLEPACKET_LOG_ERR ("Could not %s port 0x%"PRIx64" for the samplepacket "
+                                      "session 0x%"PRIx64" in direction %d",
+                                      is_add ? "add" : "remove", port_id,
+                                      p_acl_info->key.sample_object,
+                                      p_acl_info->key.samplepacket_direction);
+            rc = port_rc;
+        }
+    }
+
+    return rc;
+}
+
+sai_status_t sai_samplepacket_port_cleanup_on_fanout (sai_object_id_t port_id)
+{
+    sai_status_t rc = SAI_STATUS_SUCCESS;
+
+    sai_acl_lock ();
+    rc = sai_samplepacket_all_ports_fanout_update (port_id, false);
+    sai_acl_unlock ();
+
+    return rc;
+}
+
+sai_status_t sai_samplepacket_port_config_post_fanout (sai_object_id_t port_id)
+{
+    sai_status_t rc = SAI_STATUS_SUCCESS;
+
+    sai_acl_lock ();
+    rc = sai_samplepacket_all_ports_fanout_update (port_id, true);
+    sai_acl_unlock ();
+
+    return rc;
+}
@@ -27,9 +27,12 @@
 
 #include <stdlib.h>
 #include "std_mutex_lock.h"
+#include "sai_lock_profile.h"
 
 static std_mutex_type_t samplepacket_lock;
 
+SAI_LOCK_PROFILE_DEFINE (samplepacket_lock_profile, "samplepacket")
+
 dn_sai_samplepacket_session_info_t *sai_samplepacket_session_node_alloc (void)
 {
     return ((dn_sai_samplepacket_session_info_t *)calloc (1,
@@ -61,10 +64,11 @@ void sai_samplepacket_mutex_lock_init(void)
 
 void sai_samplepacket_lock(void)
 {
-    std_mutex_lock (&samplepacket_lock);
+    sai_profiled_mutex_lock (&samplepacket_lock, &samplepacket_lock_profile,
+                             SAI_LOCK_PROFILE_CALL_SITE ());
 }
 
 void sai_samplepacket_unlock(void)
 {
-    std_mutex_unlock (&samplepacket_lock);
+    sai_profiled_mutex_unlock (&samplepacket_lock, &samplepacket_lock_profile);
 }
@@ -31,6 +31,8 @@
 #include "sai_qos_debug.h"
 #include "sai_l3_api_utils.h"
 #include "sai_bridge_main.h"
+#include "sai_lock_profile.h"
+#include "sai_api_latency.h"
 
 static void sai_shell_debug_vlan_help(void)
 {
@@ -1279,16 +1281,84 @@ static void sai_shell_debug_bridge(std_parsed_string_t handle)
         sai_shell_debug_bridge_help();
     }
 }
+static void sai_shell_debug_locks_help(void)
+{
+    SAI_DEBUG("::debug locks enable/disable");
+    SAI_DEBUG("\t- Enables/Disables SAI module lock profiling");
+    SAI_DEBUG("::debug locks dump [<lock-name>]");
+    SAI_DEBUG("\t- Dumps acquisition count, wait and hold time histograms of all/given lock");
+    SAI_DEBUG("::debug locks reset");
+    SAI_DEBUG("\t- Resets the lock profiling statistics");
+}
+
+static void sai_shell_debug_locks(std_parsed_string_t handle)
+{
+    size_t ix=1;
+    const char *token = NULL;
+
+    if((token = std_parse_string_next(handle,&ix))!= NULL) {
+        if(strcmp(token,"enable") == 0) {
+            sai_lock_profile_enable(true);
+        } else if(strcmp(token,"disable") == 0) {
+            sai_lock_profile_enable(false);
+        } else if(strcmp(token,"dump") == 0) {
+            sai_lock_profile_dump(std_parse_string_next(handle,&ix));
+        } else if(strcmp(token,"reset") == 0) {
+            sai_lock_profile_reset();
+        } else {
+            sai_shell_debug_locks_help();
+        }
+    } else {
+        sai_shell_debug_locks_help();
+    }
+}
+
+static void sai_shell_debug_api_latency_help(void)
+{
+    SAI_DEBUG("::debug api-latency enable/disable");
+    SAI_DEBUG("\t- Enables/Disables SAI API latency instrumentation");
+    SAI_DEBUG("::debug api-latency dump [<function-name>]");
+    SAI_DEBUG("\t- Dumps call/error count, common layer and NPU latency histograms of all/given function");
+    SAI_DEBUG("::debug api-latency reset");
+    SAI_DEBUG("\t- Resets the API latency statistics");
+}
+
+static void sai_shell_debug_api_latency(std_parsed_string_t handle)
+{
+    size_t ix=1;
+    const char *token = NULL;
+
+    if((token = std_parse_string_next(handle,&ix))!= NULL) {
+        if(strcmp(token,"enable") == 0) {
+            sai_api_latency_enable(true);
+        } else if(strcmp(token,"disable") == 0) {
+            sai_api_latency_enable(false);
+        } else if(strcmp(token,"dump") == 0) {
+            sai_api_latency_dump(std_parse_string_next(handle,&ix));
+        } else if(strcmp(token,"reset") == 0) {
+            sai_api_latency_reset();
+        } else {
+            sai_shell_debug_api_latency_help();
+        }
+    } else {
+        sai_shell_debug_api_latency_help();
+    }
+}
+
 static void sai_shell_debug_help(void)
 {
     SAI_DEBUG("::debug acl");
     SAI_DEBUG("\t- ACL module debug commands");
+    SAI_DEBUG("::debug api-latency");
+    SAI_DEBUG("\t- SAI API latency instrumentation commands");
     SAI_DEBUG("::debug fdb");
     SAI_DEBUG("\t- FDB module debug commands");
     SAI_DEBUG("::debug l3");
     SAI_DEBUG("\t- L3 module debug commands");
     SAI_DEBUG("::debug lag");
     SAI_DEBUG("\t- LAG module debug commands");
+    SAI_DEBUG("::debug locks");
+    SAI_DEBUG("\t- SAI module lock profiling commands");
     SAI_DEBUG("::debug mirror");
     SAI_DEBUG("\t- MIRROR module debug commands");
     SAI_DEBUG("::debug port");
@@ -1334,6 +1404,10 @@ static void sai_shell_debug(std_parsed_string_t handle)
             sai_shell_debug_qos(handle);
         } else if(strcmp(token,"bridge") == 0) {
             sai_shell_debug_bridge(handle);
+        } else if(strcmp(token,"locks") == 0) {
+            sai_shell_debug_locks(handle);
+        } else if(strcmp(token,"api-latency") == 0) {
+            sai_shell_debug_api_latency(handle);
         } else {
             sai_shell_debug_help();
         }
@@ -0,0 +1,727 @@
+/*
+ * Copyright (c) 2016 Dell Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * THIS CODE IS PROVIDED ON AN *AS IS* BASIS, WITHOUT WARRANTIES OR
+ * CONDITIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING WITHOUT
+ * LIMITATION ANY IMPLIED WARRANTIES OR CONDITIONS OF TITLE, FITNESS
+ * FOR A PARTICULAR PURPOSE, MERCHANTABLITY OR NON-INFRINGEMENT.
+ *
+ * See the Apache Version 2.0 License for specific language governing
+ * permissions and limitations under the License.
+ */
+
+/**
+ * @file sai_api_latency.c
+ *
+ * @brief This file contains the implementation of the SAI API latency
+ *        instrumentation layer.
+ */
+
+#include "sai_api_latency.h"
+#include "sai_debug_utils.h"
+#include "sai.h"
+#include "saitypes.h"
+#include "std_mutex_lock.h"
+#include "std_type_defs.h"
+
+#include <inttypes.h>
+#include <string.h>
+#include <time.h>
+
+bool sai_api_latency_enabled = false;
+
+static sai_api_latency_stats_t sai_api_latency_stats [SAI_API_LATENCY_FUNC_MAX] = {
+    [SAI_API_LATENCY_ROUTE_CREATE]     = { "create_route", SAI_API_ROUTE },
+    [SAI_API_LATENCY_ROUTE_REMOVE]     = { "remove_route", SAI_API_ROUTE },
+    [SAI_API_LATENCY_ROUTE_SET]        = { "set_route_attribute", SAI_API_ROUTE },
+    [SAI_API_LATENCY_ROUTE_GET]        = { "get_route_attribute", SAI_API_ROUTE },
+    [SAI_API_LATENCY_FDB_CREATE]       = { "create_fdb_entry", SAI_API_FDB },
+    [SAI_API_LATENCY_FDB_REMOVE]       = { "remove_fdb_entry", SAI_API_FDB },
+    [SAI_API_LATENCY_FDB_SET]          = { "set_fdb_entry_attribute", SAI_API_FDB },
+    [SAI_API_LATENCY_FDB_GET]          = { "get_fdb_entry_attribute", SAI_API_FDB },
+    [SAI_API_LATENCY_ACL_ENTRY_CREATE] = { "create_acl_entry", SAI_API_ACL },
+    [SAI_API_LATENCY_ACL_ENTRY_REMOVE] = { "remove_acl_entry", SAI_API_ACL },
+    [SAI_API_LATENCY_ACL_ENTRY_SET]    = { "set_acl_entry_attribute", SAI_API_ACL },
+    [SAI_API_LATENCY_ACL_ENTRY_GET]    = { "get_acl_entry_attribute", SAI_API_ACL },
+    [SAI_API_LATENCY_PORT_SET]         = { "set_port_attribute", SAI_API_PORT },
+    [SAI_API_LATENCY_PORT_GET]         = { "get_port_attribute", SAI_API_PORT },
+    [SAI_API_LATENCY_QUEUE_SET]        = { "set_queue_attribute", SAI_API_QUEUE },
+    [SAI_API_LATENCY_QUEUE_GET]        = { "get_queue_attribute", SAI_API_QUEUE },
+    [SAI_API_LATENCY_SCHEDULER_CREATE] = { "create_scheduler_profile", SAI_API_SCHEDULER },
+    [SAI_API_LATENCY_SCHEDULER_REMOVE] = { "remove_scheduler_profile", SAI_API_SCHEDULER },
+    [SAI_API_LATENCY_SCHEDULER_SET]    = { "set_scheduler_attribute", SAI_API_SCHEDULER },
+    [SAI_API_LATENCY_SCHEDULER_GET]    = { "get_scheduler_attribute", SAI_API_SCHEDULER },
+    [SAI_API_LATENCY_QOS_MAP_CREATE]   = { "create_qos_map", SAI_API_QOS_MAPS },
+    [SAI_API_LATENCY_QOS_MAP_REMOVE]   = { "remove_qos_map", SAI_API_QOS_MAPS },
+    [SAI_API_LATENCY_QOS_MAP_SET]      = { "set_qos_map_attribute", SAI_API_QOS_MAPS },
+    [SAI_API_LATENCY_QOS_MAP_GET]      = { "get_qos_map_attribute", SAI_API_QOS_MAPS },
+};
+
+/*
+ * The statistics are updated with per counter atomics, so concurrent calls
+ * of different modules do not serialize on a lock. The lock only protects
+ * the set up of the instrumented method tables.
+ */
+static std_mutex_lock_create_static_init_fast (sai_api_latency_lock);
+
+/*
+ * Per thread context of the instrumented call in progress. Nested
+ * instrumented calls save and restore the NPU time of the outer call.
+ */
+typedef struct _sai_api_latency_ctx_t {
+    uint64_t start_ns;
+    uint64_t saved_npu_ns;
+    uint_t   saved_npu_calls;
+    bool     saved_in_call;
+} sai_api_latency_ctx_t;
+
+static __thread uint64_t sai_api_latency_npu_ns = 0;
+static __thread uint_t   sai_api_latency_npu_calls = 0;
+static __thread bool     sai_api_latency_in_call = false;
+
+/* Original method tables and their instrumented copies */
+static sai_route_api_t *sai_route_orig_table = NULL;
+static sai_fdb_api_t   *sai_fdb_orig_table = NULL;
+static sai_acl_api_t   *sai_acl_orig_table = NULL;
+static sai_port_api_t  *sai_port_orig_table = NULL;
+static sai_queue_api_t *sai_queue_orig_table = NULL;
+static sai_scheduler_api_t *sai_scheduler_orig_table = NULL;
+static sai_qos_map_api_t   *sai_qos_map_orig_table = NULL;
+
+static sai_route_api_t  sai_route_latency_table;
+static sai_fdb_api_t    sai_fdb_latency_table;
+static sai_acl_api_t    sai_acl_latency_table;
+static sai_port_api_t   sai_port_latency_table;
+static sai_queue_api_t  sai_queue_latency_table;
+static sai_scheduler_api_t sai_scheduler_latency_table;
+static sai_qos_map_api_t   sai_qos_map_latency_table;
+
+static inline uint64_t sai_api_latency_time_ns_get (void)
+{
+    struct timespec ts;
+
+    clock_gettime (CLOCK_MONOTONIC, &ts);
+
+    return (((uint64_t) ts.tv_sec * 1000000000ULL) + ts.tv_nsec);
+}
+
+static inline uint_t sai_api_latency_hist_bucket_get (uint64_t time_ns)
+{
+    uint_t msb = 0;
+    uint_t octave = 0;
+    uint_t sub_bucket = 0;
+    uint_t bucket = 0;
+
+    if (time_ns < (1ULL << SAI_API_LATENCY_HIST_MIN_SHIFT)) {
+        return 0;
+    }
+
+    msb = 63 - __builtin_clzll (time_ns);
+    octave = msb - SAI_API_LATENCY_HIST_MIN_SHIFT;
+    sub_bucket = (time_ns >> (msb - SAI_API_LATENCY_HIST_SUB_SHIFT)) &
+                 (SAI_API_LATENCY_HIST_SUB_BUCKETS - 1);
+
+    bucket = 1 + (octave * SAI_API_LATENCY_HIST_SUB_BUCKETS) + sub_bucket;
+
+    return ((bucket < SAI_API_LATENCY_HIST_BUCKETS) ?
+            bucket : (SAI_API_LATENCY_HIST_BUCKETS - 1));
+}
+
+/* Lower bound in ns of a non zero histogram bucket */
+static inline uint64_t sai_api_latency_hist_bucket_min_ns (uint_t bucket)
+{
+    uint_t octave = (bucket - 1) / SAI_API_LATENCY_HIST_SUB_BUCKETS;
+    uint_t sub_bucket = (bucket - 1) % SAI_API_LATENCY_HIST_SUB_BUCKETS;
+
+    return (((uint64_t) (SAI_API_LATENCY_HIST_SUB_BUCKETS + sub_bucket)) <<
+            (octave + SAI_API_LATENCY_HIST_MIN_SHIFT -
+             SAI_API_LATENCY_HIST_SUB_SHIFT));
+}
+
+uint64_t sai_api_latency_npu_call_start (void)
+{
+    if ((!sai_api_latency_enabled) || (!sai_api_latency_in_call)) {
+        return 0;
+    }
+
+    return sai_api_latency_time_ns_get ();
+}
+
+void sai_api_latency_npu_call_end (uint64_t start_ns)
+{
+    if ((start_ns == 0) || (!sai_api_latency_in_call)) {
+        return;
+    }
+
+    sai_api_latency_npu_ns += (sai_api_latency_time_ns_get () - start_ns);
+    sai_api_latency_npu_calls++;
+}
+
+static inline void sai_api_latency_counter_add (uint64_t *p_counter,
+                                                uint64_t value)
+{
+    __atomic_fetch_add (p_counter, value, __ATOMIC_RELAXED);
+}
+
+static inline void sai_api_latency_max_update (uint64_t *p_max, uint64_t value)
+{
+    uint64_t cur_max = __atomic_load_n (p_max, __ATOMIC_RELAXED);
+
+    while ((value > cur_max) &&
+           (!__atomic_compare_exchange_n (p_max, &cur_max, value, true,
+                                          __ATOMIC_RELAXED, __ATOMIC_RELAXED))) {
+        /* cur_max is reloaded by a failed exchange */
+    }
+}
+
+static inline void sai_api_latency_call_start (sai_api_latency_ctx_t *p_ctx)
+{
+    p_ctx->saved_npu_ns = sai_api_latency_npu_ns;
+    p_ctx->saved_npu_calls = sai_api_latency_npu_calls;
+    p_ctx->saved_in_call = sai_api_latency_in_call;
+
+    sai_api_latency_npu_ns = 0;
+    sai_api_latency_npu_calls = 0;
+    sai_api_latency_in_call = true;
+
+    p_ctx->start_ns = sai_api_latency_time_ns_get ();
+}
+
+static void sai_api_latency_call_end (sai_api_latency_ctx_t *p_ctx,
+                                      sai_api_latency_func_t func,
+                                      sai_status_t rc)
+{
+    sai_api_latency_stats_t *p_stats = &sai_api_latency_stats [func];
+    uint64_t total_ns = sai_api_latency_time_ns_get () - p_ctx->start_ns;
+    uint64_t npu_ns = sai_api_latency_npu_ns;
+    uint64_t common_ns = 0;
+
+    if (npu_ns > total_ns) {
+        npu_ns = total_ns;
+    }
+    common_ns = total_ns - npu_ns;
+
+    sai_api_latency_counter_add (&p_stats->call_count, 1);
+    sai_api_latency_counter_add (&p_stats->total_ns, total_ns);
+    sai_api_latency_counter_add (&p_stats->common_total_ns, common_ns);
+    sai_api_latency_counter_add (
+              &p_stats->common_hist [sai_api_latency_hist_bucket_get (common_ns)], 1);
+
+    if (sai_api_latency_npu_calls != 0) {
+        sai_api_latency_counter_add (&p_stats->npu_call_count,
+                                     sai_api_latency_npu_calls);
+        sai_api_latency_counter_add (&p_stats->npu_total_ns, npu_ns);
+        sai_api_latency_counter_add (
+                  &p_stats->npu_hist [sai_api_latency_hist_bucket_get (npu_ns)], 1);
+    }
+
+    sai_api_latency_max_update (&p_stats->max_ns, total_ns);
+
+    if (rc != SAI_STATUS_SUCCESS) {
+        sai_api_latency_counter_add (&p_stats->error_count, 1);
+    }
+
+    /* NPU time of a nested call is accounted to the outer call too */
+    sai_api_latency_npu_ns = p_ctx->saved_npu_ns + npu_ns;
+    sai_api_latency_npu_calls = p_ctx->saved_npu_calls +
+                                sai_api_latency_npu_calls;
+    sai_api_latency_in_call = p_ctx->saved_in_call;
+}
+
+/*
+ * Instrumented method table functions. When the layer is disabled they
+ * cost a flag check over the call to the original function.
+ */
+#define SAI_API_LATENCY_CALL(func, orig_call)                               \
+    do {                                                                    \
+        sai_api_latency_ctx_t ctx;                                          \
+        sai_status_t          rc;                                           \
+                                                                            \
+        if (!sai_api_latency_enabled) {                                     \
+            return (orig_call);                                             \
+        }                                                                   \
+                                                                            \
+        sai_api_latency_call_start (&ctx);                                  \
+        rc = (orig_call);                                                   \
+        sai_api_latency_call_end (&ctx, (func), rc);                        \
+                                                                            \
+        return rc;                                                          \
+    } while (0)
+
+static sai_status_t sai_api_latency_route_create (
+const sai_route_entry_t *route_entry, uint32_t attr_count,
+const sai_attribute_t *attr_list)
+{
+    SAI_API_LATENCY_CALL (SAI_API_LATENCY_ROUTE_CREATE,
+                          sai_route_orig_table->create_route (route_entry,
+                                                              attr_count,
+                                                              attr_list));
+}
+
+static sai_status_t sai_api_latency_route_remove (
+const sai_route_entry_t *route_entry)
+{
+    SAI_API_LATENCY_CALL (SAI_API_LATENCY_ROUTE_REMOVE,
+                          sai_route_orig_table->remove_route (route_entry));
+}
+
+static sai_status_t sai_api_latency_route_set (
+const sai_route_entry_t *route_entry, const sai_attribute_t *attr)
+{
+    SAI_API_LATENCY_CALL (SAI_API_LATENCY_ROUTE_SET,
+                          sai_route_orig_table->set_route_attribute (route_entry,
+                                                                     attr));
+}
+
+static sai_status_t sai_api_latency_route_get (
+const sai_route_entry_t *route_entry, uint32_t attr_count,
+sai_attribute_t *attr_list)
+{
+    SAI_API_LATENCY_CALL (SAI_API_LATENCY_ROUTE_GET,
+                          sai_route_orig_table->get_route_attribute (route_entry,
+                                                                     attr_count,
+                                                                     attr_list));
+}
+
+static sai_status_t sai_api_latency_fdb_create (
+const sai_fdb_entry_t *fdb_entry, uint32_t attr_count,
+const sai_attribute_t *attr_list)
+{
+    SAI_API_LATENCY_CALL (SAI_API_LATENCY_FDB_CREATE,
+                          sai_fdb_orig_table->create_fdb_entry (fdb_entry,
+                                                                attr_count,
+                                                                attr_list));
+}
+
+static sai_status_t sai_api_latency_fdb_remove (const sai_fdb_entry_t *fdb_entry)
+{
+    SAI_API_LATENCY_CALL (SAI_API_LATENCY_FDB_REMOVE,
+                          sai_fdb_orig_table->remove_fdb_entry (fdb_entry));
+}
+
+static sai_status_t sai_api_latency_fdb_set (const sai_fdb_entry_t *fdb_entry,
+                                             const sai_attribute_t *attr)
+{
+    SAI_API_LATENCY_CALL (SAI_API_LATENCY_FDB_SET,
+                          sai_fdb_orig_table->set_fdb_entry_attribute (fdb_entry,
+                                                                       attr));
+}
+
+static sai_status_t sai_api_latency_fdb_get (const sai_fdb_entry_t *fdb_entry,
+                                             uint32_t attr_count,
+                                             sai_attribute_t *attr_list)
+{
+    SAI_API_LATENCY_CALL (SAI_API_LATENCY_FDB_GET,
+                          sai_fdb_orig_table->get_fdb_entry_attribute (fdb_entry,
+                                                                       attr_count,
+                                                                       attr_list));
+}
+
+static sai_status_t sai_api_latency_acl_entry_create (sai_object_id_t *acl_entry_id,
+                                                      sai_object_id_t switch_id,
+                                                      uint32_t attr_count,
+                                                      const sai_attribute_t *attr_list)
+{
+    SAI_API_LATENCY_CALL (SAI_API_LATENCY_ACL_ENTRY_CREATE,
+                          sai_acl_orig_table->create_acl_entry (acl_entry_id,
+                                                                switch_id,
+                                                                attr_count,
+                                                                attr_list));
+}
+
+static sai_status_t sai_api_latency_acl_entry_remove (sai_object_id_t acl_entry_id)
+{
+    SAI_API_LATENCY_CALL (SAI_API_LATENCY_ACL_ENTRY_REMOVE,
+                          sai_acl_orig_table->remove_acl_entry (acl_entry_id));
+}
+
+static sai_status_t sai_api_latency_acl_entry_set (sai_object_id_t acl_entry_id,
+                                                   const sai_attribute_t *attr)
+{
+    SAI_API_LATENCY_CALL (SAI_API_LATENCY_ACL_ENTRY_SET,
+                          sai_acl_orig_table->set_acl_entry_attribute (acl_entry_id,
+                                                                       attr));
+}
+
+static sai_status_t sai_api_latency_acl_entry_get (sai_object_id_t acl_entry_id,
+                                                   uint32_t attr_count,
+                                                   sai_attribute_t *attr_list)
+{
+    SAI_API_LATENCY_CALL (SAI_API_LATENCY_ACL_ENTRY_GET,
+                          sai_acl_orig_table->get_acl_entry_attribute (acl_entry_id,
+                                                                       attr_count,
+                                                                       attr_list));
+}
+
+static sai_status_t sai_api_latency_port_set (sai_object_id_t port_id,
+                                              const sai_attribute_t *attr)
+{
+    SAI_API_LATENCY_CALL (SAI_API_LATENCY_PORT_SET,
+                          sai_port_orig_table->set_port_attribute (port_id, attr));
+}
+
+static sai_status_t sai_api_latency_port_get (sai_object_id_t port_id,
+                                              uint32_t attr_count,
+                                              sai_attribute_t *attr_list)
+{
+    SAI_API_LATENCY_CALL (SAI_API_LATENCY_PORT_GET,
+                          sai_port_orig_table->get_port_attribute (port_id,
+                                                                   attr_count,
+                                                                   attr_list));
+}
+
+static sai_status_t sai_api_latency_queue_set (sai_object_id_t queue_id,
+                                               const sai_attribute_t *attr)
+{
+    SAI_API_LATENCY_CALL (SAI_API_LATENCY_QUEUE_SET,
+                          sai_queue_orig_table->set_queue_attribute (queue_id, attr));
+}
+
+static sai_status_t sai_api_latency_queue_get (sai_object_id_t queue_id,
+                                               uint32_t attr_count,
+                                               sai_attribute_t *attr_list)
+{
+    SAI_API_LATENCY_CALL (SAI_API_LATENCY_QUEUE_GET,
+                          sai_queue_orig_table->get_queue_attribute (queue_id,
+                                                                     attr_count,
+                                                                     attr_list));
+}
+
+static sai_status_t sai_api_latency_scheduler_create (sai_object_id_t *sched_id,
+                                                      sai_object_id_t switch_id,
+                                                      uint32_t attr_count,
+                                                      const sai_attribute_t *attr_list)
+{
+    SAI_API_LATENCY_CALL (SAI_API_LATENCY_SCHEDULER_CREATE,
+                          sai_scheduler_orig_table->create_scheduler_profile (
+                                                      sched_id, switch_id,
+                                                      attr_count, attr_list));
+}
+
+static sai_status_t sai_api_latency_scheduler_remove (sai_object_id_t sched_id)
+{
+    SAI_API_LATENCY_CALL (SAI_API_LATENCY_SCHEDULER_REMOVE,
+                          sai_scheduler_orig_table->remove_scheduler_profile (
+                                                                  sched_id));
+}
+
+static sai_status_t sai_api_latency_scheduler_set (sai_object_id_t sched_id,
+                                                   const sai_attribute_t *attr)
+{
+    SAI_API_LATENCY_CALL (SAI_API_LATENCY_SCHEDULER_SET,
+                          sai_scheduler_orig_table->set_scheduler_attribute (
+                                                                  sched_id, attr));
+}
+
+static sai_status_t sai_api_latency_scheduler_get (sai_object_id_t sched_id,
+                                                   uint32_t attr_count,
+                                                   sai_attribute_t *attr_list)
+{
+    SAI_API_LATENCY_CALL (SAI_API_LATENCY_SCHEDULER_GET,
+                          sai_scheduler_orig_table->get_scheduler_attribute (
+                                                      sched_id, attr_count,
+                                                      attr_list));
+}
+
+static sai_status_t sai_api_latency_qos_map_create (sai_object_id_t *map_id,
+                                                    sai_object_id_t switch_id,
+                                                    uint32_t attr_count,
+                                                    const sai_attribute_t *attr_list)
+{
+    SAI_API_LATENCY_CALL (SAI_API_LATENCY_QOS_MAP_CREATE,
+                          sai_qos_map_orig_table->create_qos_map (map_id,
+                                                                  switch_id,
+                                                                  attr_count,
+                                                                  attr_list));
+}
+
+static sai_status_t sai_api_latency_qos_map_remove (sai_object_id_t map_id)
+{
+    SAI_API_LATENCY_CALL (SAI_API_LATENCY_QOS_MAP_REMOVE,
+                          sai_qos_map_orig_table->remove_qos_map (map_id));
+}
+
+static sai_status_t sai_api_latency_qos_map_set (sai_object_id_t map_id,
+                                                 const sai_attribute_t *attr)
+{
+    SAI_API_LATENCY_CALL (SAI_API_LATENCY_QOS_MAP_SET,
+                          sai_qos_map_orig_table->set_qos_map_attribute (map_id,
+                                                                         attr));
+}
+
+static sai_status_t sai_api_latency_qos_map_get (sai_object_id_t map_id,
+                                                 uint32_t attr_count,
+                                                 sai_attribute_t *attr_list)
+{
+    SAI_API_LATENCY_CALL (SAI_API_LATENCY_QOS_MAP_GET,
+                          sai_qos_map_orig_table->get_qos_map_attribute (map_id,
+                                                                         attr_count,
+                                                                         attr_list));
+}
+
+void *sai_api_latency_method_table_wrap (sai_api_t api_id, void *api_method_table)
+{
+    void *p_table = api_method_table;
+
+    if (api_method_table == NULL) {
+        return NULL;
+    }
+
+    std_mutex_lock (&sai_api_latency_lock);
+
+    switch (api_id)
+    {
+        case SAI_API_ROUTE:
+            if (sai_route_orig_table == NULL) {
+                sai_route_orig_table = (sai_route_api_t *) api_method_table;
+                sai_route_latency_table = *sai_route_orig_table;
+                sai_route_latency_table.create_route = sai_api_latency_route_create;
+                sai_route_latency_table.remove_route = sai_api_latency_route_remove;
+                sai_route_latency_table.set_route_attribute = sai_api_latency_route_set;
+                sai_route_latency_table.get_route_attribute = sai_api_latency_route_get;
+            }
+            p_table = &sai_route_latency_table;
+            break;
+
+        case SAI_API_FDB:
+            if (sai_fdb_orig_table == NULL) {
+                sai_fdb_orig_table = (sai_fdb_api_t *) api_method_table;
+                sai_fdb_latency_table = *sai_fdb_orig_table;
+                sai_fdb_latency_table.create_fdb_entry = sai_api_latency_fdb_create;
+                sai_fdb_latency_table.remove_fdb_entry = sai_api_latency_fdb_remove;
+                sai_fdb_latency_table.set_fdb_entry_attribute = sai_api_latency_fdb_set;
+                sai_fdb_latency_table.get_fdb_entry_attribute = sai_api_latency_fdb_get;
+            }
+            p_table = &sai_fdb_latency_table;
+            break;
+
+        case SAI_API_ACL:
+            if (sai_acl_orig_table == NULL) {
+                sai_acl_orig_table = (sai_acl_api_t *) api_method_table;
+                sai_acl_latency_table = *sai_acl_orig_table;
+                sai_acl_latency_table.create_acl_entry = sai_api_latency_acl_entry_create;
+                sai_acl_latency_table.remove_acl_entry = sai_api_latency_acl_entry_remove;
+                sai_acl_latency_table.set_acl_entry_attribute = sai_api_latency_acl_entry_set;
+                sai_acl_latency_table.get_acl_entry_attribute = sai_api_latency_acl_entry_get;
+            }
+            p_table = &sai_acl_latency_table;
+            break;
+
+        case SAI_API_PORT:
+            if (sai_port_orig_table == NULL) {
+                sai_port_orig_table = (sai_port_api_t *) api_method_table;
+                sai_port_latency_table = *sai_port_orig_table;
+                sai_port_latency_table.set_port_attribute = sai_api_latency_port_set;
+                sai_port_latency_table.get_port_attribute = sai_api_latency_port_get;
+            }
+            p_table = &sai_port_latency_table;
+            break;
+
+        case SAI_API_QUEUE:
+            if (sai_queue_orig_table == NULL) {
+                sai_queue_orig_table = (sai_queue_api_t *) api_method_table;
+                sai_queue_latency_table = *sai_queue_orig_table;
+                sai_queue_latency_table.set_queue_attribute = sai_api_latency_queue_set;
+                sai_queue_latency_table.get_queue_attribute = sai_api_latency_queue_get;
+            }
+            p_table = &sai_queue_latency_table;
+            break;
+
+        case SAI_API_SCHEDULER:
+            if (sai_scheduler_orig_table == NULL) {
+                sai_scheduler_orig_table = (sai_scheduler_api_t *) api_method_table;
+                sai_scheduler_latency_table = *sai_scheduler_orig_table;
+                sai_scheduler_latency_table.create_scheduler_profile =
+                                               sai_api_latency_scheduler_create;
+                sai_scheduler_latency_table.remove_scheduler_profile =
+                                               sai_api_latency_scheduler_remove;
+                sai_scheduler_latency_table.set_scheduler_attribute =
+                                               sai_api_latency_scheduler_set;
+                sai_scheduler_latency_table.get_scheduler_attribute =
+                                               sai_api_latency_scheduler_get;
+            }
+            p_table = &sai_scheduler_latency_table;
+            break;
+
+        case SAI_API_QOS_MAPS:
+            if (sai_qos_map_orig_table == NULL) {
+                sai_qos_map_orig_table = (sai_qos_map_api_t *) api_method_table;
+                sai_qos_map_latency_table = *sai_qos_map_orig_table;
+                sai_qos_map_latency_table.create_qos_map = sai_api_latency_qos_map_create;
+                sai_qos_map_latency_table.remove_qos_map = sai_api_latency_qos_map_remove;
+                sai_qos_map_latency_table.set_qos_map_attribute = sai_api_latency_qos_map_set;
+                sai_qos_map_latency_table.get_qos_map_attribute = sai_api_latency_qos_map_get;
+            }
+            p_table = &sai_qos_map_latency_table;
+            break;
+
+        default:
+            break;
+    }
+
+    std_mutex_unlock (&sai_api_latency_lock);
+
+    return p_table;
+}
+
+void sai_api_latency_enable (bool enable)
+{
+    sai_api_latency_enabled = enable;
+}
+
+void sai_api_latency_reset (void)
+{
+    uint_t func = 0;
+    uint_t bucket = 0;
+    sai_api_latency_stats_t *p_stats = NULL;
+
+    for (func = 0; func < SAI_API_LATENCY_FUNC_MAX; func++) {
+
+        p_stats = &sai_api_latency_stats [func];
+
+        __atomic_store_n (&p_stats->call_count, 0, __ATOMIC_RELAXED);
+        __atomic_store_n (&p_stats->error_count, 0, __ATOMIC_RELAXED);
+        __atomic_store_n (&p_stats->total_ns, 0, __ATOMIC_RELAXED);
+        __atomic_store_n (&p_stats->max_ns, 0, __ATOMIC_RELAXED);
+        __atomic_store_n (&p_stats->common_total_ns, 0, __ATOMIC_RELAXED);
+        __atomic_store_n (&p_stats->npu_total_ns, 0, __ATOMIC_RELAXED);
+        __atomic_store_n (&p_stats->npu_call_count, 0, __ATOMIC_RELAXED);
+
+        for (bucket = 0; bucket < SAI_API_LATENCY_HIST_BUCKETS; bucket++) {
+            __atomic_store_n (&p_stats->common_hist [bucket], 0, __ATOMIC_RELAXED);
+            __atomic_store_n (&p_stats->npu_hist [bucket], 0, __ATOMIC_RELAXED);
+        }
+    }
+}
+
+/*
+ * Counters are read one by one while calls may be in progress, so a copy
+ * is not an atomic snapshot across counters of a function.
+ */
+static void sai_api_latency_stats_copy (sai_api_latency_stats_t *p_dst,
+                                        const sai_api_latency_stats_t *p_src)
+{
+    uint_t bucket = 0;
+
+    memcpy (p_dst->func_name, p_src->func_name, sizeof (p_dst->func_name));
+    p_dst->api_id = p_src->api_id;
+
+    p_dst->call_count = __atomic_load_n (&p_src->call_count, __ATOMIC_RELAXED);
+    p_dst->error_count = __atomic_load_n (&p_src->error_count, __ATOMIC_RELAXED);
+    p_dst->total_ns = __atomic_load_n (&p_src->total_ns, __ATOMIC_RELAXED);
+    p_dst->max_ns = __atomic_load_n (&p_src->max_ns, __ATOMIC_RELAXED);
+    p_dst->common_total_ns = __atomic_load_n (&p_src->common_total_ns,
+                                              __ATOMIC_RELAXED);
+    p_dst->npu_total_ns = __atomic_load_n (&p_src->npu_total_ns,
+                                           __ATOMIC_RELAXED);
+    p_dst->npu_call_count = __atomic_load_n (&p_src->npu_call_count,
+                                             __ATOMIC_RELAXED);
+
+    for (bucket = 0; bucket < SAI_API_LATENCY_HIST_BUCKETS; bucket++) {
+        p_dst->common_hist [bucket] =
+            __atomic_load_n (&p_src->common_hist [bucket], __ATOMIC_RELAXED);
+        p_dst->npu_hist [bucket] =
+            __atomic_load_n (&p_src->npu_hist [bucket], __ATOMIC_RELAXED);
+    }
+}
+
+sai_status_t sai_api_latency_stats_get (uint32_t *count,
+                                        sai_api_latency_stats_t *stats_list)
+{
+    uint_t func = 0;
+
+    if ((count == NULL) || ((*count != 0) && (stats_list == NULL))) {
+        return SAI_STATUS_INVALID_PARAMETER;
+    }
+
+    if (*count < SAI_API_LATENCY_FUNC_MAX) {
+        *count = SAI_API_LATENCY_FUNC_MAX;
+
+        return SAI_STATUS_BUFFER_OVERFLOW;
+    }
+
+    for (func = 0; func < SAI_API_LATENCY_FUNC_MAX; func++) {
+        sai_api_latency_stats_copy (&stats_list [func],
+                                    &sai_api_latency_stats [func]);
+    }
+
+    *count = SAI_API_LATENCY_FUNC_MAX;
+
+    return SAI_STATUS_SUCCESS;
+}
+
+static void sai_api_latency_hist_dump (const char *hist_name,
+                                       const uint64_t *hist)
+{
+    uint_t bucket = 0;
+
+    SAI_DEBUG ("  %s histogram:", hist_name);
+
+    for (bucket = 0; bucket < SAI_API_LATENCY_HIST_BUCKETS; bucket++) {
+
+        if (hist [bucket] == 0) {
+            continue;
+        }
+
+        if (bucket == 0) {
+            SAI_DEBUG ("    < %u ns : %"PRIu64"",
+                       (1 << SAI_API_LATENCY_HIST_MIN_SHIFT), hist [bucket]);
+        } else if (bucket == (SAI_API_LATENCY_HIST_BUCKETS - 1)) {
+            SAI_DEBUG ("    >= %"PRIu64" ns : %"PRIu64"",
+                       sai_api_latency_hist_bucket_min_ns (bucket),
+                       hist [bucket]);
+        } else {
+            SAI_DEBUG ("    %"PRIu64" - %"PRIu64" ns : %"PRIu64"",
+                       sai_api_latency_hist_bucket_min_ns (bucket),
+                       sai_api_latency_hist_bucket_min_ns (bucket + 1),
+                       hist [bucket]);
+        }
+    }
+}
+
+static void sai_api_latency_stats_dump (const sai_api_latency_stats_t *p_stats)
+{
+    SAI_DEBUG ("Function: %s, Calls: %"PRIu64", Errors: %"PRIu64"",
+               p_stats->func_name, p_stats->call_count, p_stats->error_count);
+
+    if (p_stats->call_count == 0) {
+        return;
+    }
+
+    SAI_DEBUG ("  Total avg: %"PRIu64" ns, max: %"PRIu64" ns",
+               p_stats->total_ns / p_stats->call_count, p_stats->max_ns);
+    SAI_DEBUG ("  Common layer avg: %"PRIu64" ns, NPU avg: %"PRIu64" ns, "
+               "NPU calls: %"PRIu64"",
+               p_stats->common_total_ns / p_stats->call_count,
+               p_stats->npu_total_ns / p_stats->call_count,
+               p_stats->npu_call_count);
+
+    sai_api_latency_hist_dump ("Common layer", p_stats->common_hist);
+    sai_api_latency_hist_dump ("NPU", p_stats->npu_hist);
+}
+
+void sai_api_latency_dump (const char *func_name)
+{
+    uint_t func = 0;
+    sai_api_latency_stats_t stats;
+
+    SAI_DEBUG ("API latency instrumentation is %s",
+               sai_api_latency_enabled ? "enabled" : "disabled");
+
+    for (func = 0; func < SAI_API_LATENCY_FUNC_MAX; func++) {
+
+        if ((func_name != NULL) &&
+            (strncmp (func_name, sai_api_latency_stats [func].func_name,
+                      SAI_API_LATENCY_NAME_LEN_MAX) != 0)) {
+            continue;
+        }
+
+        sai_api_latency_stats_copy (&stats, &sai_api_latency_stats [func]);
+
+        sai_api_latency_stats_dump (&stats);
+    }
+}
@@ -0,0 +1,284 @@
+/*
+ * Copyright (c) 2016 Dell Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * THIS CODE IS PROVIDED ON AN *AS IS* BASIS, WITHOUT WARRANTIES OR
+ * CONDITIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING WITHOUT
+ * LIMITATION ANY IMPLIED WARRANTIES OR CONDITIONS OF TITLE, FITNESS
+ * FOR A PARTICULAR PURPOSE, MERCHANTABLITY OR NON-INFRINGEMENT.
+ *
+ * See the Apache Version 2.0 License for specific language governing
+ * permissions and limitations under the License.
+ */
+
+/**
+ * @file sai_id_allocator.c
+ *
+ * @brief This file contains the implementation of the bitmap based object
+ *        Id allocator.
+ */
+
+#include "sai_id_allocator.h"
+#include "saistatus.h"
+#include "std_assert.h"
+#include "std_type_defs.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#define SAI_ID_ALLOCATOR_WORD_SHIFT  (6)
+#define SAI_ID_ALLOCATOR_BIT_MASK    (SAI_ID_ALLOCATOR_WORD_BITS - 1)
+#define SAI_ID_ALLOCATOR_FULL_WORD   (~((uint64_t) 0))
+
+static inline uint64_t sai_id_allocator_bit (uint64_t index)
+{
+    return (((uint64_t) 1) << (index & SAI_ID_ALLOCATOR_BIT_MASK));
+}
+
+/* Mask of the bits at and above the given bit position in a word */
+static inline uint64_t sai_id_allocator_mask_from (uint64_t index)
+{
+    return (SAI_ID_ALLOCATOR_FULL_WORD << (index & SAI_ID_ALLOCATOR_BIT_MASK));
+}
+
+static inline uint_t sai_id_allocator_first_set (uint64_t word)
+{
+    return ((uint_t) __builtin_ctzll (word));
+}
+
+/*
+ * Bitmap index is the Id less one. Sets the index as used and marks the
+ * upper level bits of the words which become full.
+ */
+static void sai_id_allocator_index_set (sai_id_allocator_t *p_allocator,
+                                        uint64_t index)
+{
+    uint64_t word;
+    uint_t   level;
+
+    for (level = 0; level < SAI_ID_ALLOCATOR_LEVELS; level++) {
+        word = index >> SAI_ID_ALLOCATOR_WORD_SHIFT;
+
+        p_allocator->p_level [level][word] |= sai_id_allocator_bit (index);
+
+        if (p_allocator->p_level [level][word] != SAI_ID_ALLOCATOR_FULL_WORD) {
+            return;
+        }
+
+        index = word;
+    }
+}
+
+static void sai_id_allocator_index_clear (sai_id_allocator_t *p_allocator,
+                                          uint64_t index)
+{
+    uint64_t word;
+    uint_t   level;
+
+    for (level = 0; level < SAI_ID_ALLOCATOR_LEVELS; level++) {
+        word = index >> SAI_ID_ALLOCATOR_WORD_SHIFT;
+
+        p_allocator->p_level [level][word] &= ~sai_id_allocator_bit (index);
+
+        index = word;
+    }
+}
+
+/*
+ * Returns the first clear bit at or after start_index in the given level,
+ * or -1 when there is none. A clear bit in an upper level points to a word
+ * with a clear bit in the level below.
+ */
+static int64_t sai_id_allocator_free_index_find (
+                                      const sai_id_allocator_t *p_allocator,
+                                      uint_t level, uint64_t start_index)
+{
+    uint64_t word = start_index >> SAI_ID_ALLOCATOR_WORD_SHIFT;
+    uint64_t free_bits;
+    int64_t  free_word;
+
+    if (word >= p_allocator->level_words [level]) {
+        return -1;
+    }
+
+    free_bits = (~p_allocator->p_level [level][word] &
+                 sai_id_allocator_mask_from (start_index));
+
+    if (free_bits == 0) {
+        if ((level + 1) >= SAI_ID_ALLOCATOR_LEVELS) {
+            return -1;
+        }
+
+        free_word = sai_id_allocator_free_index_find (p_allocator, level + 1,
+                                                      word + 1);
+        if (free_word < 0) {
+            return -1;
+        }
+
+        word = (uint64_t) free_word;
+        free_bits = ~p_allocator->p_level [level][word];
+    }
+
+    return ((int64_t) ((word << SAI_ID_ALLOCATOR_WORD_SHIFT) +
+                       sai_id_allocator_first_set (free_bits)));
+}
+
+static inline bool sai_id_allocator_is_id_valid (
+                                      const sai_id_allocator_t *p_allocator,
+                                      uint64_t id)
+{
+    return ((p_allocator->p_level [0] != NULL) && (id != 0) &&
+            (id <= p_allocator->max_id));
+}
+
+sai_status_t sai_id_allocator_init (sai_id_allocator_t *p_allocator,
+                                    const char *name, uint64_t max_id)
+{
+    uint64_t index;
+    uint64_t bits;
+    uint_t   level;
+
+    STD_ASSERT (p_allocator != NULL);
+
+    if ((max_id == 0) || (max_id > SAI_ID_ALLOCATOR_MAX_IDS)) {
+        return SAI_STATUS_INVALID_PARAMETER;
+    }
+
+    sai_id_allocator_deinit (p_allocator);
+
+    bits = max_id;
+
+    for (level = 0; level < SAI_ID_ALLOCATOR_LEVELS; level++) {
+        p_allocator->level_words [level] =
+            (uint_t) ((bits + SAI_ID_ALLOCATOR_BIT_MASK) >>
+                      SAI_ID_ALLOCATOR_WORD_SHIFT);
+
+        p_allocator->p_level [level] =
+            (uint64_t *) calloc (p_allocator->level_words [level],
+                                 sizeof (uint64_t));
+
+        if (p_allocator->p_level [level] == NULL) {
+            sai_id_allocator_deinit (p_allocator);
+
+            return SAI_STATUS_NO_MEMORY;
+        }
+
+        bits = p_allocator->level_words [level];
+    }
+
+    p_allocator->name = name;
+    p_allocator->max_id = max_id;
+    p_allocator->next_id = 1;
+
+    /*
+     * Pad the bitmaps past the end of the range as used. The upper levels
+     * are padded first so that filling the last Id word propagates up.
+     */
+    for (level = 1; level < SAI_ID_ALLOCATOR_LEVELS; level++) {
+        for (index = p_allocator->level_words [level - 1];
+             index < ((uint64_t) p_allocator->level_words [level] <<
+                      SAI_ID_ALLOCATOR_WORD_SHIFT); index++) {
+            p_allocator->p_level [level][index >> SAI_ID_ALLOCATOR_WORD_SHIFT] |=
+                sai_id_allocator_bit (index);
+        }
+    }
+
+    for (index = max_id; index < ((uint64_t) p_allocator->level_words [0] <<
+                                  SAI_ID_ALLOCATOR_WORD_SHIFT); index++) {
+        sai_id_allocator_index_set (p_allocator, index);
+    }
+
+    return SAI_STATUS_SUCCESS;
+}
+
+void sai_id_allocator_deinit (sai_id_allocator_t *p_allocator)
+{
+    uint_t level;
+
+    STD_ASSERT (p_allocator != NULL);
+
+    for (level = 0; level < SAI_ID_ALLOCATOR_LEVELS; level++) {
+        free (p_allocator->p_level [level]);
+    }
+
+    memset (p_allocator, 0, sizeof (*p_allocator));
+}
+
+sai_status_t sai_id_allocator_alloc (sai_id_allocator_t *p_allocator,
+                                     uint64_t *p_id)
+{
+    int64_t index = -1;
+
+    STD_ASSERT (p_allocator != NULL);
+    STD_ASSERT (p_id != NULL);
+
+    if (p_allocator->p_level [0] == NULL) {
+        return SAI_STATUS_UNINITIALIZED;
+    }
+
+    if (p_allocator->next_id <= p_allocator->max_id) {
+        index = sai_id_allocator_free_index_find (p_allocator, 0,
+                                                  p_allocator->next_id - 1);
+    }
+
+    if (index < 0) {
+        index = sai_id_allocator_free_index_find (p_allocator, 0, 0);
+    }
+
+    if (index < 0) {
+        return SAI_STATUS_INSUFFICIENT_RESOURCES;
+    }
+
+    sai_id_allocator_index_set (p_allocator, (uint64_t) index);
+
+    p_allocator->used_count++;
+
+    *p_id = (uint64_t) index + 1;
+
+    p_allocator->next_id = *p_id + 1;
+
+    return SAI_STATUS_SUCCESS;
+}
+
+sai_status_t sai_id_allocator_free (sai_id_allocator_t *p_allocator,
+                                    uint64_t id)
+{
+    STD_ASSERT (p_allocator != NULL);
+
+    if (!sai_id_allocator_is_allocated (p_allocator, id)) {
+        return SAI_STATUS_INVALID_PARAMETER;
+    }
+
+    sai_id_allocator_index_clear (p_allocator, id - 1);
+
+    p_allocator->used_count--;
+
+    return SAI_STATUS_SUCCESS;
+}
+
+bool sai_id_allocator_is_allocated (const sai_id_allocator_t *p_allocator,
+                                    uint64_t id)
+{
+    uint64_t index;
+
+    STD_ASSERT (p_allocator != NULL);
+
+    if (!sai_id_allocator_is_id_valid (p_allocator, id)) {
+        return false;
+    }
+
+    index = id - 1;
+
+    return ((p_allocator->p_level [0][index >> SAI_ID_ALLOCATOR_WORD_SHIFT] &
+             sai_id_allocator_bit (index)) != 0);
+}
+
+uint64_t sai_id_allocator_used_count_get (const sai_id_allocator_t *p_allocator)
+{
+    STD_ASSERT (p_allocator != NULL);
+
+    return p_allocator->used_count;
+}
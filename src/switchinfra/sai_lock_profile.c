@@ -0,0 +1,233 @@
+/*
+ * Copyright (c) 2016 Dell Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * THIS CODE IS PROVIDED ON AN *AS IS* BASIS, WITHOUT WARRANTIES OR
+ * CONDITIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING WITHOUT
+ * LIMITATION ANY IMPLIED WARRANTIES OR CONDITIONS OF TITLE, FITNESS
+ * FOR A PARTICULAR PURPOSE, MERCHANTABLITY OR NON-INFRINGEMENT.
+ *
+ * See the Apache Version 2.0 License for specific language governing
+ * permissions and limitations under the License.
+ */
+
+/**
+ * @file sai_lock_profile.c
+ *
+ * @brief This file contains the implementation of the SAI module lock
+ *        contention and hold time profiler.
+ */
+
+#define _GNU_SOURCE
+
+#include "sai_lock_profile.h"
+#include "sai_debug_utils.h"
+#include "std_mutex_lock.h"
+#include "std_type_defs.h"
+
+#include <dlfcn.h>
+#include <inttypes.h>
+#include <string.h>
+#include <time.h>
+
+bool sai_lock_profile_enabled = false;
+
+static sai_lock_profile_t *sai_lock_profile_list = NULL;
+
+static std_mutex_lock_create_static_init_fast (sai_lock_profile_list_lock);
+
+static inline uint64_t sai_lock_profile_time_ns_get (void)
+{
+    struct timespec ts;
+
+    clock_gettime (CLOCK_MONOTONIC, &ts);
+
+    return (((uint64_t) ts.tv_sec * 1000000000ULL) + ts.tv_nsec);
+}
+
+static inline uint_t sai_lock_profile_hist_bucket_get (uint64_t time_ns)
+{
+    uint64_t time_us = time_ns / 1000;
+    uint_t   bucket = 0;
+
+    if (time_us == 0) {
+        return 0;
+    }
+
+    /* Bucket n counts durations in [2^(n-1), 2^n) us */
+    bucket = (64 - __builtin_clzll (time_us));
+
+    return ((bucket < SAI_LOCK_PROFILE_HIST_BUCKETS) ?
+            bucket : (SAI_LOCK_PROFILE_HIST_BUCKETS - 1));
+}
+
+void sai_lock_profile_register (sai_lock_profile_t *p_profile)
+{
+    std_mutex_lock (&sai_lock_profile_list_lock);
+
+    p_profile->next = sai_lock_profile_list;
+    sai_lock_profile_list = p_profile;
+
+    std_mutex_unlock (&sai_lock_profile_list_lock);
+}
+
+void sai_lock_profile_acquire (std_mutex_type_t *p_mutex,
+                               sai_lock_profile_t *p_profile,
+                               void *call_site)
+{
+    uint64_t start_ns = sai_lock_profile_time_ns_get ();
+    uint64_t wait_ns = 0;
+    uint64_t now_ns = 0;
+
+    std_mutex_lock (p_mutex);
+
+    /* Stats are updated with the module lock held */
+    now_ns = sai_lock_profile_time_ns_get ();
+    wait_ns = now_ns - start_ns;
+
+    p_profile->acquire_count++;
+    p_profile->total_wait_ns += wait_ns;
+    p_profile->wait_hist [sai_lock_profile_hist_bucket_get (wait_ns)]++;
+
+    if (wait_ns > p_profile->max_wait_ns) {
+        p_profile->max_wait_ns = wait_ns;
+    }
+
+    /* A zero acquire time marks the lock as taken with profiling off */
+    p_profile->acquire_time_ns = (now_ns != 0) ? now_ns : 1;
+    p_profile->holder_call_site = call_site;
+}
+
+void sai_lock_profile_release (std_mutex_type_t *p_mutex,
+                               sai_lock_profile_t *p_profile)
+{
+    uint64_t hold_ns = sai_lock_profile_time_ns_get () -
+                       p_profile->acquire_time_ns;
+
+    p_profile->total_hold_ns += hold_ns;
+    p_profile->hold_hist [sai_lock_profile_hist_bucket_get (hold_ns)]++;
+
+    if (hold_ns > p_profile->max_hold_ns) {
+        p_profile->max_hold_ns = hold_ns;
+        p_profile->max_hold_call_site = p_profile->holder_call_site;
+    }
+
+    p_profile->acquire_time_ns = 0;
+    p_profile->holder_call_site = NULL;
+
+    std_mutex_unlock (p_mutex);
+}
+
+void sai_lock_profile_enable (bool enable)
+{
+    sai_lock_profile_enabled = enable;
+}
+
+void sai_lock_profile_reset (void)
+{
+    sai_lock_profile_t *p_profile = NULL;
+
+    std_mutex_lock (&sai_lock_profile_list_lock);
+
+    for (p_profile = sai_lock_profile_list; p_profile != NULL;
+         p_profile = p_profile->next) {
+
+        p_profile->acquire_count = 0;
+        p_profile->total_wait_ns = 0;
+        p_profile->max_wait_ns = 0;
+        p_profile->total_hold_ns = 0;
+        p_profile->max_hold_ns = 0;
+        p_profile->max_hold_call_site = NULL;
+
+        memset (p_profile->wait_hist, 0, sizeof (p_profile->wait_hist));
+        memset (p_profile->hold_hist, 0, sizeof (p_profile->hold_hist));
+    }
+
+    std_mutex_unlock (&sai_lock_profile_list_lock);
+}
+
+static void sai_lock_profile_hist_dump (const char *hist_name,
+                                        const uint64_t *hist)
+{
+    uint_t bucket = 0;
+
+    SAI_DEBUG ("  %s histogram:", hist_name);
+
+    for (bucket = 0; bucket < SAI_LOCK_PROFILE_HIST_BUCKETS; bucket++) {
+
+        if (hist [bucket] == 0) {
+            continue;
+        }
+
+        if (bucket == 0) {
+            SAI_DEBUG ("    < 1 us : %"PRIu64"", hist [bucket]);
+        } else if (bucket == (SAI_LOCK_PROFILE_HIST_BUCKETS - 1)) {
+            SAI_DEBUG ("    >= %"PRIu64" us : %"PRIu64"",
+                       (uint64_t) 1 << (bucket - 1), hist [bucket]);
+        } else {
+            SAI_DEBUG ("    %"PRIu64" - %"PRIu64" us : %"PRIu64"",
+                       (uint64_t) 1 << (bucket - 1), (uint64_t) 1 << bucket,
+                       hist [bucket]);
+        }
+    }
+}
+
+static void sai_lock_profile_node_dump (sai_lock_profile_t *p_profile)
+{
+    Dl_info     dl_info;
+    const char *call_site_sym = "-";
+
+    memset (&dl_info, 0, sizeof (dl_info));
+
+    if ((p_profile->max_hold_call_site != NULL) &&
+        (dladdr (p_profile->max_hold_call_site, &dl_info) != 0) &&
+        (dl_info.dli_sname != NULL)) {
+        call_site_sym = dl_info.dli_sname;
+    }
+
+    SAI_DEBUG ("Lock: %s, Acquired: %"PRIu64"", p_profile->name,
+               p_profile->acquire_count);
+
+    if (p_profile->acquire_count == 0) {
+        return;
+    }
+
+    SAI_DEBUG ("  Wait avg: %"PRIu64" ns, max: %"PRIu64" ns",
+               p_profile->total_wait_ns / p_profile->acquire_count,
+               p_profile->max_wait_ns);
+    SAI_DEBUG ("  Hold avg: %"PRIu64" ns, max: %"PRIu64" ns, "
+               "max hold call site: %s (%p)",
+               p_profile->total_hold_ns / p_profile->acquire_count,
+               p_profile->max_hold_ns, call_site_sym,
+               p_profile->max_hold_call_site);
+
+    sai_lock_profile_hist_dump ("Wait", p_profile->wait_hist);
+    sai_lock_profile_hist_dump ("Hold", p_profile->hold_hist);
+}
+
+void sai_lock_profile_dump (const char *lock_name)
+{
+    sai_lock_profile_t *p_profile = NULL;
+
+    SAI_DEBUG ("Lock profiling is %s",
+               sai_lock_profile_enabled ? "enabled" : "disabled");
+
+    std_mutex_lock (&sai_lock_profile_list_lock);
+
+    for (p_profile = sai_lock_profile_list; p_profile != NULL;
+         p_profile = p_profile->next) {
+
+        if ((lock_name != NULL) &&
+            (strncmp (lock_name, p_profile->name,
+                      SAI_LOCK_PROFILE_NAME_LEN_MAX) != 0)) {
+            continue;
+        }
+
+        sai_lock_profile_node_dump (p_profile);
+    }
+
+    std_mutex_unlock (&sai_lock_profile_list_lock);
+}
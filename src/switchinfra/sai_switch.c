@@ -884,6 +884,7 @@ static sai_status_t sai_switch_attribute_config(sai_switch_profile_id_t profile_
                 SAI_SWITCH_LOG_TRACE("L3 table size is %d", value);
             } else if (strncmp(key, SAI_KEY_L3_NEIGHBOR_TABLE_SIZE, key_len) == 0) {
                 sai_switch_l3_host_table_size_set(value);
+                sai_fib_neighbor_mac_hash_scale_set(value);
                 SAI_SWITCH_LOG_TRACE("Neighbor table size is %d", value);
             } else if (strncmp(key, SAI_KEY_NUM_LAG_MEMBERS, key_len) == 0) {
                 sai_switch_num_lag_members_set(value);
@@ -31,6 +31,7 @@
 #include "sai_switch_utils.h"
 #include "sai_common_infra.h"
 #include "sai_qos_api_utils.h"
+#include "sai_l3_api_utils.h"
 
 #include <string.h>
 #include <stdlib.h>
@@ -137,6 +138,8 @@ static sai_status_t sai_generic_switch_info_handler(std_config_node_t switch_nod
     /* Update the global switch info based on init config */
     sai_switch_info_initialize(&init_info);
 
+    sai_fib_neighbor_mac_hash_scale_set(init_info.l3_host_table_size);
+
     return ret_code;
 }
 
@@ -25,6 +25,7 @@
 #include "sai_modules_init.h"
 #include "sai_npu_fdb.h"
 #include "sai_common_infra.h"
+#include "sai_api_latency.h"
 #include "sai_fdb_api.h"
 #include "sai_fdb_common.h"
 #include "sai_fdb_main.h"
@@ -36,6 +37,7 @@
 #include "sai_gen_utils.h"
 #include "sai_lag_api.h"
 #include "std_thread_tools.h"
+#include "std_llist.h"
 #include "sai_stp_api.h"
 #include "sai_lag_api.h"
 
@@ -46,6 +48,62 @@ static sai_fdb_event_notification_fn sai_l2_fdb_notification_fn = NULL;
 static sai_fdb_event_notification_data_t valid_notification_data[SAI_FDB_MAX_MACS_PER_CALLBACK];
 static bool sai_fdb_delete_entry_by_entry_on_flush = true;
 
+/* Software aged batch queued for the notification thread */
+typedef struct _sai_fdb_aged_notif_batch_t {
+    /* Must be the first member, batch is linked in the aged queue */
+    std_dll                            dll_glue;
+    uint_t                             count;
+    sai_fdb_event_notification_data_t *data;
+    sai_attribute_t                   *attr;
+} sai_fdb_aged_notif_batch_t;
+
+/* Aged batches pending delivery, protected by the FDB lock */
+static std_dll_head sai_fdb_aged_notif_queue;
+
+/* Bumped on every FDB cache change, lets bulk readers detect changes */
+static uint64_t sai_fdb_cache_generation = 0;
+
+void sai_fdb_cache_generation_bump(void)
+{
+    sai_fdb_cache_generation++;
+}
+
+uint64_t sai_fdb_cache_generation_get(void)
+{
+    return sai_fdb_cache_generation;
+}
+
+static void sai_fdb_aged_notif_batch_free(sai_fdb_aged_notif_batch_t *batch)
+{
+    free(batch->attr);
+    free(batch->data);
+    free(batch);
+}
+
+/* Deliver the queued software aged batches to the application */
+static void sai_fdb_aged_notifications_send(void)
+{
+    sai_fdb_aged_notif_batch_t *batch = NULL;
+
+    while(1) {
+        sai_fdb_lock();
+        batch = (sai_fdb_aged_notif_batch_t *)
+            std_dll_getfirst(&sai_fdb_aged_notif_queue);
+        if(batch != NULL) {
+            std_dll_remove(&sai_fdb_aged_notif_queue, &batch->dll_glue);
+        }
+        sai_fdb_unlock();
+
+        if(batch == NULL) {
+            break;
+        }
+        if(sai_l2_fdb_notification_fn != NULL) {
+            sai_l2_fdb_notification_fn(batch->count, batch->data);
+        }
+        sai_fdb_aged_notif_batch_free(batch);
+    }
+}
+
 static void * _sai_fdb_internal_notif(void * param) {
     int len = 0;
     while(1) {
@@ -55,6 +113,7 @@ static void * _sai_fdb_internal_notif(void * param) {
         if(wake) {
             sai_fdb_send_internal_notifications ();
         }
+        sai_fdb_aged_notifications_send ();
     }
     return NULL;
 }
@@ -90,6 +149,8 @@ sai_status_t sai_fdb_init(void)
         return SAI_STATUS_FAILURE;
     }
 
+    std_dll_init(&sai_fdb_aged_notif_queue);
+
     std_thread_init_struct(&_thread);
     _thread.name = "sai_fdb_internal_notif";
     _thread.thread_function = _sai_fdb_internal_notif;
@@ -139,6 +200,7 @@ static void sai_delete_all_fdb_entry_nodes (bool delete_all, sai_fdb_flush_entry
             }
             if(remove_fdb_from_cache) {
                 sai_remove_fdb_entry_node(fdb_entry_node);
+                sai_fdb_cache_generation_bump();
             }
         }
         fdb_entry_node = sai_get_next_fdb_entry_node (&fdb_key);
@@ -183,6 +245,7 @@ static void sai_delete_fdb_entry_nodes_per_port (sai_object_id_t port_id, bool d
                 }
                 if(remove_fdb_from_cache) {
                     sai_remove_fdb_entry_node(fdb_entry_node);
+                    sai_fdb_cache_generation_bump();
                 }
 
             }
@@ -235,6 +298,7 @@ static void sai_delete_fdb_entry_nodes_per_vlan (sai_vlan_id_t vlan_id, bool del
             }
             if(remove_fdb_from_cache) {
                 sai_remove_fdb_entry_node(fdb_entry_node);
+                sai_fdb_cache_generation_bump();
             }
         }
         fdb_entry_node = sai_get_next_fdb_entry_node (&fdb_key);
@@ -285,6 +349,7 @@ static void sai_delete_fdb_entry_nodes_per_port_vlan (sai_object_id_t port_id,
                 }
                 if(remove_fdb_from_cache) {
                     sai_remove_fdb_entry_node(fdb_entry_node);
+                    sai_fdb_cache_generation_bump();
                 }
             }
         }
@@ -393,7 +458,8 @@ static sai_status_t sai_l2_remove_fdb_entry(const sai_fdb_entry_t *fdb_entry)
                         std_mac_to_string(&(fdb_entry->mac_address), mac_str,
                                     sizeof(mac_str)), fdb_entry->vlan_id);
     sai_fdb_lock();
-        ret_val = sai_fdb_npu_api_get()->flush_fdb_entry(fdb_entry , false);
+        SAI_API_LATENCY_NPU_CALL(ret_val,
+                sai_fdb_npu_api_get()->flush_fdb_entry(fdb_entry , false));
         if(ret_val != SAI_STATUS_SUCCESS) {
             sai_fdb_unlock();
             return ret_val;
@@ -401,7 +467,9 @@ static sai_status_t sai_l2_remove_fdb_entry(const sai_fdb_entry_t *fdb_entry)
     fdb_entry_node = sai_get_fdb_entry_node(fdb_entry);
     if(fdb_entry_node != NULL) {
          sai_remove_fdb_entry_node(fdb_entry_node);
+         sai_fdb_cache_generation_bump();
     }
+    sai_fdb_sw_aging_entry_remove(fdb_entry);
     sai_fdb_unlock();
     sai_fdb_wake_notification_thread ();
     return ret_val;
@@ -463,10 +531,14 @@ static sai_status_t sai_l2_create_fdb_entry(const sai_fdb_entry_t *fdb_entry,
         return SAI_STATUS_MANDATORY_ATTRIBUTE_MISSING;
     }
     sai_fdb_lock();
-    ret_val = sai_fdb_npu_api_get()->create_fdb_entry(fdb_entry, &fdb_entry_node_data);
+    SAI_API_LATENCY_NPU_CALL(ret_val,
+            sai_fdb_npu_api_get()->create_fdb_entry(fdb_entry, &fdb_entry_node_data));
 
     if(ret_val == SAI_STATUS_SUCCESS) {
         sai_insert_fdb_entry_node(fdb_entry, &fdb_entry_node_data);
+        sai_fdb_cache_generation_bump();
+        sai_fdb_sw_aging_entry_update(fdb_entry, fdb_entry_node_data.port_id,
+                                      fdb_entry_node_data.entry_type);
     }
     sai_fdb_unlock();
     sai_fdb_wake_notification_thread ();
@@ -490,6 +562,7 @@ static sai_fdb_entry_node_t *sai_fdb_populate_node_from_hardware(
     }
 
     sai_insert_fdb_entry_node(fdb_entry, &fdb_entry_node_data);
+    sai_fdb_cache_generation_bump();
 
     return sai_get_fdb_entry_node(fdb_entry);;
 }
@@ -532,9 +605,12 @@ static sai_status_t sai_l2_set_fdb_entry_attribute(const sai_fdb_entry_t *fdb_en
     }
     memcpy(&temp_node, fdb_entry_node, sizeof(temp_node));
     sai_update_fdb_entry_node(fdb_entry_node, attr);
-    ret_val = sai_fdb_npu_api_get()->write_fdb_entry_to_hardware(fdb_entry_node);
+    SAI_API_LATENCY_NPU_CALL(ret_val,
+            sai_fdb_npu_api_get()->write_fdb_entry_to_hardware(fdb_entry_node));
     if(ret_val != SAI_STATUS_SUCCESS) {
         memcpy(fdb_entry_node, &temp_node, sizeof(temp_node));
+    } else {
+        sai_fdb_cache_generation_bump();
     }
     sai_fdb_unlock();
     sai_fdb_wake_notification_thread ();
@@ -615,13 +691,31 @@ static sai_status_t sai_l2_get_fdb_entry_attribute(const sai_fdb_entry_t *fdb_en
 
 sai_status_t sai_l2_fdb_set_aging_time(uint32_t value)
 {
-    return sai_fdb_npu_api_get()->set_aging_time(value);
+    sai_status_t ret_val;
+
+    sai_fdb_lock();
+    if(sai_l2_fdb_sw_aging_is_enabled()) {
+        ret_val = sai_fdb_sw_aging_time_set(value);
+    } else {
+        ret_val = sai_fdb_npu_api_get()->set_aging_time(value);
+    }
+    sai_fdb_unlock();
+    return ret_val;
 }
 
 sai_status_t sai_l2_fdb_get_aging_time(uint32_t *value)
 {
+    sai_status_t ret_val;
+
     STD_ASSERT(value != NULL);
-    return sai_fdb_npu_api_get()->get_aging_time(value);
+    sai_fdb_lock();
+    if(sai_l2_fdb_sw_aging_is_enabled()) {
+        ret_val = sai_fdb_sw_aging_time_get(value);
+    } else {
+        ret_val = sai_fdb_npu_api_get()->get_aging_time(value);
+    }
+    sai_fdb_unlock();
+    return ret_val;
 }
 
 
@@ -740,6 +834,10 @@ static void sai_common_fdb_event_notification (uint32_t count, sai_fdb_event_dat
                                                    &fdb_entry_node_data);
                 if((sai_rc == SAI_STATUS_SUCCESS) ||
                    (sai_rc == SAI_STATUS_ITEM_ALREADY_EXISTS)) {
+                    sai_fdb_cache_generation_bump();
+                    sai_fdb_sw_aging_entry_update(&notification_data->fdb_entry,
+                                                  fdb_entry_node_data.port_id,
+                                                  fdb_entry_node_data.entry_type);
                     valid_notification_data[valid_count] = *notification_data;
                     valid_count++;
                 }
@@ -749,6 +847,8 @@ static void sai_common_fdb_event_notification (uint32_t count, sai_fdb_event_dat
             fdb_entry_node = sai_get_fdb_entry_node(&notification_data->fdb_entry);
             if(fdb_entry_node != NULL) {
                 sai_remove_fdb_entry_node (fdb_entry_node);
+                sai_fdb_cache_generation_bump();
+                sai_fdb_sw_aging_entry_remove(&notification_data->fdb_entry);
                 valid_notification_data[valid_count] = *notification_data;
                 valid_count++;
             }
@@ -760,6 +860,66 @@ static void sai_common_fdb_event_notification (uint32_t count, sai_fdb_event_dat
         sai_l2_fdb_notification_fn (valid_count, valid_notification_data);
     }
 }
+/*
+ * Queue a software aged batch to the notification thread, so the application
+ * callback does not run on the aging thread. The batch is copied as the
+ * aging thread reuses its buffers.
+ */
+void sai_l2_fdb_aged_entries_notify(uint_t count,
+                                    sai_fdb_event_notification_data_t *data)
+{
+    sai_fdb_aged_notif_batch_t *batch = NULL;
+    uint_t entry_idx = 0;
+    uint_t attr_count = 0;
+    int rc = 0;
+    bool wake;
+
+    STD_ASSERT(data != NULL);
+    if(count == 0) {
+        return;
+    }
+
+    for(entry_idx = 0; entry_idx < count; entry_idx++) {
+        attr_count += data[entry_idx].attr_count;
+    }
+
+    batch = (sai_fdb_aged_notif_batch_t *)calloc(1, sizeof(*batch));
+    if(batch != NULL) {
+        batch->data = (sai_fdb_event_notification_data_t *)
+            calloc(count, sizeof(*batch->data));
+        batch->attr = (sai_attribute_t *)
+            calloc((attr_count != 0) ? attr_count : 1, sizeof(*batch->attr));
+    }
+    if((batch == NULL) || (batch->data == NULL) || (batch->attr == NULL)) {
+        SAI_FDB_LOG_ERR("Aged notification allocation failed for %d entries",
+                        count);
+        if(batch != NULL) {
+            sai_fdb_aged_notif_batch_free(batch);
+        }
+        return;
+    }
+
+    batch->count = count;
+    attr_count = 0;
+    for(entry_idx = 0; entry_idx < count; entry_idx++) {
+        batch->data[entry_idx] = data[entry_idx];
+        batch->data[entry_idx].attr = &batch->attr[attr_count];
+        memcpy(&batch->attr[attr_count], data[entry_idx].attr,
+               data[entry_idx].attr_count * sizeof(sai_attribute_t));
+        attr_count += data[entry_idx].attr_count;
+    }
+
+    sai_fdb_lock();
+    std_dll_insertatback(&sai_fdb_aged_notif_queue, &batch->dll_glue);
+    sai_fdb_unlock();
+
+    /* Always write, the thread drains the aged queue on every wake up */
+    wake = sai_fdb_is_notifications_pending();
+    if((rc = write(sai_fdb_fd[SAI_FDB_WRITE_FD], &wake, sizeof(bool))) != sizeof(bool)) {
+        SAI_FDB_LOG_ERR("Writing to event queue failed");
+    }
+}
+
 sai_status_t sai_l2_fdb_register_callback(sai_fdb_event_notification_fn
                                                          fdb_notification_fn)
 {
@@ -0,0 +1,840 @@
+/*
+ * Copyright (c) 2016 Dell Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * THIS CODE IS PROVIDED ON AN *AS IS* BASIS, WITHOUT WARRANTIES OR
+ * CONDITIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING WITHOUT
+ * LIMITATION ANY IMPLIED WARRANTIES OR CONDITIONS OF TITLE, FITNESS
+ * FOR A PARTICULAR PURPOSE, MERCHANTABLITY OR NON-INFRINGEMENT.
+ *
+ * See the Apache Version 2.0 License for specific language governing
+ * permissions and limitations under the License.
+ */
+
+/**
+ * @file sai_fdb_aging.c
+ *
+ * @brief This file contains the software FDB aging implementation.
+ *
+ * In software aging mode the NPU aging is disabled and every dynamic FDB
+ * entry in the cache is armed in a hierarchical timer wheel. On expiry the
+ * entries are polled for hits in batches, hit entries are re-armed and the
+ * rest are flushed from the NPU and reported as aged to the application in
+ * one notification per batch, delivered from the FDB notification thread.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <inttypes.h>
+#include <unistd.h>
+#include <time.h>
+#include "saifdb.h"
+#include "saitypes.h"
+#include "saistatus.h"
+#include "sai_npu_fdb.h"
+#include "sai_fdb_api.h"
+#include "sai_fdb_common.h"
+#include "sai_fdb_main.h"
+#include "sai_vlan_api.h"
+#include "std_assert.h"
+#include "std_rbtree.h"
+#include "std_llist.h"
+#include "std_thread_tools.h"
+#include "std_mac_utils.h"
+
+/* Wheel geometry: 4 levels of 64 slots with a 1 second tick */
+#define SAI_FDB_AGING_WHEEL_LEVELS      4
+#define SAI_FDB_AGING_WHEEL_SLOT_BITS   6
+#define SAI_FDB_AGING_WHEEL_SLOTS       (1 << SAI_FDB_AGING_WHEEL_SLOT_BITS)
+#define SAI_FDB_AGING_WHEEL_SLOT_MASK   (SAI_FDB_AGING_WHEEL_SLOTS - 1)
+#define SAI_FDB_AGING_WHEEL_MAX_TICKS   \
+    ((uint64_t)1 << (SAI_FDB_AGING_WHEEL_LEVELS * SAI_FDB_AGING_WHEEL_SLOT_BITS))
+
+#define SAI_FDB_AGING_TICK_SEC          1
+
+typedef struct _sai_fdb_aging_key_t {
+    sai_mac_t     mac_address;
+    sai_vlan_id_t vlan_id;
+} sai_fdb_aging_key_t;
+
+typedef struct _sai_fdb_aging_timer_t {
+    /* Must be the first member, timer is linked in a wheel slot list */
+    std_dll              dll_glue;
+    sai_fdb_aging_key_t  key;
+    sai_object_id_t      port_id;
+    uint64_t             expiry_tick;
+    std_dll_head        *p_slot;
+} sai_fdb_aging_timer_t;
+
+typedef struct _sai_fdb_aging_port_entry_t {
+    sai_object_id_t port_id;
+    uint32_t        aging_time;
+} sai_fdb_aging_port_entry_t;
+
+typedef struct _sai_fdb_aging_ctx_t {
+    bool            enabled;
+    uint32_t        aging_time;
+    uint32_t        npu_aging_time;
+    uint64_t        cur_tick;
+    uint64_t        start_sec;
+    std_dll_head    wheel [SAI_FDB_AGING_WHEEL_LEVELS][SAI_FDB_AGING_WHEEL_SLOTS];
+    std_dll_head    expired_list;
+    rbtree_handle   timer_tree;
+    rbtree_handle   port_tree;
+    uint32_t        vlan_aging_time [SAI_MAX_VLAN_TAG_ID + 1];
+    sai_fdb_hit_poll_fn hit_poll_fn;
+    sai_fdb_sw_aging_stats_t stats;
+} sai_fdb_aging_ctx_t;
+
+static sai_fdb_aging_ctx_t sai_fdb_aging;
+static bool sai_fdb_aging_initialized = false;
+static std_thread_create_param_t sai_fdb_aging_thread;
+static bool sai_fdb_aging_thread_created = false;
+
+/* Aging thread owned batch buffers, only touched by the aging thread */
+static sai_fdb_entry_t sai_fdb_aging_batch [SAI_FDB_MAX_MACS_PER_CALLBACK];
+static sai_object_id_t sai_fdb_aging_batch_port [SAI_FDB_MAX_MACS_PER_CALLBACK];
+static bool sai_fdb_aging_batch_hit [SAI_FDB_MAX_MACS_PER_CALLBACK];
+static sai_attribute_t sai_fdb_aging_notif_attr [SAI_FDB_MAX_MACS_PER_CALLBACK];
+static sai_fdb_event_notification_data_t
+                     sai_fdb_aging_notif_data [SAI_FDB_MAX_MACS_PER_CALLBACK];
+
+static uint64_t sai_fdb_aging_time_sec_get (void)
+{
+    struct timespec ts;
+
+    clock_gettime (CLOCK_MONOTONIC, &ts);
+
+    return ((uint64_t) ts.tv_sec);
+}
+
+static void sai_fdb_aging_key_fill (sai_fdb_aging_key_t *p_key,
+                                    const sai_fdb_entry_t *fdb_entry)
+{
+    memset (p_key, 0, sizeof (*p_key));
+    memcpy (p_key->mac_address, fdb_entry->mac_address, sizeof (sai_mac_t));
+    p_key->vlan_id = fdb_entry->vlan_id;
+}
+
+static void sai_fdb_aging_entry_fill (sai_fdb_entry_t *fdb_entry,
+                                      const sai_fdb_aging_key_t *p_key)
+{
+    memset (fdb_entry, 0, sizeof (*fdb_entry));
+    memcpy (fdb_entry->mac_address, p_key->mac_address, sizeof (sai_mac_t));
+    fdb_entry->vlan_id = p_key->vlan_id;
+}
+
+/* Resolve the aging time as port override, then VLAN override, then global */
+static uint32_t sai_fdb_aging_time_resolve (sai_object_id_t port_id,
+                                            sai_vlan_id_t vlan_id)
+{
+    sai_fdb_aging_port_entry_t  tmp_entry;
+    sai_fdb_aging_port_entry_t *p_port_entry = NULL;
+
+    tmp_entry.port_id = port_id;
+
+    p_port_entry = (sai_fdb_aging_port_entry_t *)
+        std_rbtree_getexact (sai_fdb_aging.port_tree, &tmp_entry);
+
+    if (p_port_entry != NULL) {
+        return p_port_entry->aging_time;
+    }
+
+    if ((vlan_id <= SAI_MAX_VLAN_TAG_ID) &&
+        (sai_fdb_aging.vlan_aging_time [vlan_id] != SAI_FDB_AGING_TIME_INHERIT)) {
+        return sai_fdb_aging.vlan_aging_time [vlan_id];
+    }
+
+    return sai_fdb_aging.aging_time;
+}
+
+static void sai_fdb_aging_wheel_insert (sai_fdb_aging_timer_t *p_timer)
+{
+    uint64_t delta;
+    uint_t   level = 0;
+    uint_t   slot;
+
+    if (p_timer->expiry_tick <= sai_fdb_aging.cur_tick) {
+        p_timer->expiry_tick = sai_fdb_aging.cur_tick + 1;
+    }
+
+    delta = p_timer->expiry_tick - sai_fdb_aging.cur_tick;
+
+    if (delta >= SAI_FDB_AGING_WHEEL_MAX_TICKS) {
+        p_timer->expiry_tick = sai_fdb_aging.cur_tick +
+                               SAI_FDB_AGING_WHEEL_MAX_TICKS - 1;
+        delta = SAI_FDB_AGING_WHEEL_MAX_TICKS - 1;
+    }
+
+    while ((delta >> (SAI_FDB_AGING_WHEEL_SLOT_BITS * (level + 1))) != 0) {
+        level++;
+    }
+
+    slot = (p_timer->expiry_tick >> (SAI_FDB_AGING_WHEEL_SLOT_BITS * level)) &
+           SAI_FDB_AGING_WHEEL_SLOT_MASK;
+
+    p_timer->p_slot = &sai_fdb_aging.wheel [level][slot];
+
+    std_dll_insertatback (p_timer->p_slot, &p_timer->dll_glue);
+}
+
+static void sai_fdb_aging_wheel_unlink (sai_fdb_aging_timer_t *p_timer)
+{
+    if (p_timer->p_slot != NULL) {
+        std_dll_remove (p_timer->p_slot, &p_timer->dll_glue);
+        p_timer->p_slot = NULL;
+    }
+}
+
+static void sai_fdb_aging_timer_free (sai_fdb_aging_timer_t *p_timer)
+{
+    sai_fdb_aging_wheel_unlink (p_timer);
+
+    std_rbtree_remove (sai_fdb_aging.timer_tree, p_timer);
+
+    free (p_timer);
+
+    sai_fdb_aging.stats.timer_count--;
+}
+
+/* Arm the timer, a zero aging time leaves the entry unarmed */
+static void sai_fdb_aging_timer_arm (sai_fdb_aging_timer_t *p_timer)
+{
+    uint32_t aging_time = sai_fdb_aging_time_resolve (p_timer->port_id,
+                                                      p_timer->key.vlan_id);
+
+    sai_fdb_aging_wheel_unlink (p_timer);
+
+    if (aging_time == 0) {
+        return;
+    }
+
+    p_timer->expiry_tick = sai_fdb_aging.cur_tick +
+                           ((aging_time + SAI_FDB_AGING_TICK_SEC - 1) /
+                            SAI_FDB_AGING_TICK_SEC);
+
+    sai_fdb_aging_wheel_insert (p_timer);
+}
+
+/*
+ * Re-arm the timers matching the port and VLAN after an aging time change,
+ * a null port or a zero VLAN matches every timer. Entries learned while the
+ * time was zero get armed, and shortened or zeroed times take effect now
+ * instead of at the next expiry.
+ */
+static void sai_fdb_aging_timers_rearm (sai_object_id_t port_id,
+                                        sai_vlan_id_t vlan_id)
+{
+    sai_fdb_aging_timer_t *p_timer = NULL;
+
+    if (!sai_fdb_aging.enabled) {
+        return;
+    }
+
+    for (p_timer = (sai_fdb_aging_timer_t *)
+                   std_rbtree_getfirst (sai_fdb_aging.timer_tree);
+         p_timer != NULL;
+         p_timer = (sai_fdb_aging_timer_t *)
+                   std_rbtree_getnext (sai_fdb_aging.timer_tree, p_timer)) {
+
+        if ((port_id != SAI_NULL_OBJECT_ID) && (p_timer->port_id != port_id)) {
+            continue;
+        }
+
+        if ((vlan_id != 0) && (p_timer->key.vlan_id != vlan_id)) {
+            continue;
+        }
+
+        sai_fdb_aging_timer_arm (p_timer);
+    }
+}
+
+/* Move all the timers of a higher level slot down the wheel */
+static void sai_fdb_aging_wheel_cascade (uint_t level)
+{
+    std_dll_head          *p_slot;
+    sai_fdb_aging_timer_t *p_timer = NULL;
+    uint_t                 slot;
+
+    slot = (sai_fdb_aging.cur_tick >> (SAI_FDB_AGING_WHEEL_SLOT_BITS * level)) &
+           SAI_FDB_AGING_WHEEL_SLOT_MASK;
+
+    p_slot = &sai_fdb_aging.wheel [level][slot];
+
+    while ((p_timer = (sai_fdb_aging_timer_t *) std_dll_getfirst (p_slot))
+           != NULL) {
+        std_dll_remove (p_slot, &p_timer->dll_glue);
+        p_timer->p_slot = NULL;
+
+        sai_fdb_aging_wheel_insert (p_timer);
+    }
+}
+
+/* Advance the wheel by one tick and move the due timers to the expired list */
+static void sai_fdb_aging_wheel_tick (void)
+{
+    std_dll_head          *p_slot;
+    sai_fdb_aging_timer_t *p_timer = NULL;
+    uint_t                 level;
+
+    sai_fdb_aging.cur_tick++;
+
+    for (level = 1; level < SAI_FDB_AGING_WHEEL_LEVELS; level++) {
+        if ((sai_fdb_aging.cur_tick &
+             ((1ULL << (SAI_FDB_AGING_WHEEL_SLOT_BITS * level)) - 1)) != 0) {
+            break;
+        }
+
+        sai_fdb_aging_wheel_cascade (level);
+    }
+
+    p_slot = &sai_fdb_aging.wheel [0][sai_fdb_aging.cur_tick &
+                                      SAI_FDB_AGING_WHEEL_SLOT_MASK];
+
+    while ((p_timer = (sai_fdb_aging_timer_t *) std_dll_getfirst (p_slot))
+           != NULL) {
+        std_dll_remove (p_slot, &p_timer->dll_glue);
+
+        p_timer->p_slot = &sai_fdb_aging.expired_list;
+        std_dll_insertatback (&sai_fdb_aging.expired_list, &p_timer->dll_glue);
+    }
+}
+
+static sai_fdb_aging_timer_t *sai_fdb_aging_timer_get (
+                                            const sai_fdb_entry_t *fdb_entry)
+{
+    sai_fdb_aging_timer_t tmp_timer;
+
+    sai_fdb_aging_key_fill (&tmp_timer.key, fdb_entry);
+
+    return ((sai_fdb_aging_timer_t *)
+            std_rbtree_getexact (sai_fdb_aging.timer_tree, &tmp_timer));
+}
+
+void sai_fdb_sw_aging_entry_update (const sai_fdb_entry_t *fdb_entry,
+                                    sai_object_id_t port_id,
+                                    sai_fdb_entry_type_t entry_type)
+{
+    sai_fdb_aging_timer_t *p_timer = NULL;
+
+    STD_ASSERT (fdb_entry != NULL);
+
+    if (!sai_fdb_aging.enabled) {
+        return;
+    }
+
+    p_timer = sai_fdb_aging_timer_get (fdb_entry);
+
+    if (entry_type != SAI_FDB_ENTRY_TYPE_DYNAMIC) {
+        if (p_timer != NULL) {
+            sai_fdb_aging_timer_free (p_timer);
+        }
+        return;
+    }
+
+    if (p_timer == NULL) {
+        p_timer = (sai_fdb_aging_timer_t *) calloc (1, sizeof (*p_timer));
+
+        if (p_timer == NULL) {
+            SAI_FDB_LOG_ERR ("Aging timer allocation failed for vlan:%d",
+                             fdb_entry->vlan_id);
+            return;
+        }
+
+        sai_fdb_aging_key_fill (&p_timer->key, fdb_entry);
+
+        if (std_rbtree_insert (sai_fdb_aging.timer_tree, p_timer) != STD_ERR_OK) {
+            SAI_FDB_LOG_ERR ("Aging timer insert failed for vlan:%d",
+                             fdb_entry->vlan_id);
+            free (p_timer);
+            return;
+        }
+
+        sai_fdb_aging.stats.timer_count++;
+    }
+
+    p_timer->port_id = port_id;
+
+    sai_fdb_aging_timer_arm (p_timer);
+}
+
+void sai_fdb_sw_aging_entry_remove (const sai_fdb_entry_t *fdb_entry)
+{
+    sai_fdb_aging_timer_t *p_timer = NULL;
+
+    STD_ASSERT (fdb_entry != NULL);
+
+    if (!sai_fdb_aging.enabled) {
+        return;
+    }
+
+    p_timer = sai_fdb_aging_timer_get (fdb_entry);
+
+    if (p_timer != NULL) {
+        sai_fdb_aging_timer_free (p_timer);
+    }
+}
+
+static void sai_fdb_aging_timers_clear (void)
+{
+    sai_fdb_aging_timer_t *p_timer = NULL;
+
+    while ((p_timer = (sai_fdb_aging_timer_t *)
+            std_rbtree_getfirst (sai_fdb_aging.timer_tree)) != NULL) {
+        sai_fdb_aging_timer_free (p_timer);
+    }
+}
+
+/* Arm a timer for every dynamic entry already in the FDB cache */
+static void sai_fdb_aging_timers_populate (void)
+{
+    sai_fdb_entry_node_t *fdb_entry_node = NULL;
+    sai_fdb_entry_key_t   fdb_key;
+    sai_fdb_entry_t       fdb_entry;
+
+    memset (&fdb_key, 0, sizeof (fdb_key));
+
+    while ((fdb_entry_node = sai_get_next_fdb_entry_node (&fdb_key)) != NULL) {
+        memcpy (&fdb_key, &fdb_entry_node->fdb_key, sizeof (fdb_key));
+
+        memset (&fdb_entry, 0, sizeof (fdb_entry));
+        memcpy (fdb_entry.mac_address, fdb_entry_node->fdb_key.mac_address,
+                sizeof (sai_mac_t));
+        fdb_entry.vlan_id = fdb_entry_node->fdb_key.vlan_id;
+
+        sai_fdb_sw_aging_entry_update (&fdb_entry, fdb_entry_node->port_id,
+                                       fdb_entry_node->entry_type);
+    }
+}
+
+/*
+ * Collect up to a batch of expired timers. Timers whose cache entry has
+ * gone, turned static or moved to another port are dropped or re-armed
+ * here instead of being tracked on every cache change.
+ */
+static uint_t sai_fdb_aging_batch_collect (void)
+{
+    sai_fdb_aging_timer_t *p_timer = NULL;
+    sai_fdb_entry_node_t  *fdb_entry_node = NULL;
+    sai_fdb_entry_t        fdb_entry;
+    uint_t                 count = 0;
+
+    while ((count < SAI_FDB_MAX_MACS_PER_CALLBACK) &&
+           ((p_timer = (sai_fdb_aging_timer_t *)
+             std_dll_getfirst (&sai_fdb_aging.expired_list)) != NULL)) {
+
+        std_dll_remove (&sai_fdb_aging.expired_list, &p_timer->dll_glue);
+        p_timer->p_slot = NULL;
+
+        sai_fdb_aging_entry_fill (&fdb_entry, &p_timer->key);
+
+        fdb_entry_node = sai_get_fdb_entry_node (&fdb_entry);
+
+        if ((fdb_entry_node == NULL) ||
+            (fdb_entry_node->entry_type != SAI_FDB_ENTRY_TYPE_DYNAMIC)) {
+            sai_fdb_aging_timer_free (p_timer);
+            continue;
+        }
+
+        if (fdb_entry_node->port_id != p_timer->port_id) {
+            p_timer->port_id = fdb_entry_node->port_id;
+            sai_fdb_aging_timer_arm (p_timer);
+            continue;
+        }
+
+        sai_fdb_aging_batch [count] = fdb_entry;
+        sai_fdb_aging_batch_port [count] = p_timer->port_id;
+        sai_fdb_aging_batch_hit [count] = false;
+        count++;
+    }
+
+    return count;
+}
+
+/* Age out the batch entries which were not hit and build the notification */
+static uint_t sai_fdb_aging_batch_process (uint_t count)
+{
+    sai_fdb_aging_timer_t *p_timer = NULL;
+    sai_fdb_entry_node_t  *fdb_entry_node = NULL;
+    sai_status_t           sai_rc;
+    char                   mac_str [SAI_MAC_STR_LEN] = {0};
+    uint_t                 idx;
+    uint_t                 aged_count = 0;
+
+    for (idx = 0; idx < count; idx++) {
+        p_timer = sai_fdb_aging_timer_get (&sai_fdb_aging_batch [idx]);
+
+        if (p_timer == NULL) {
+            continue;
+        }
+
+        if (sai_fdb_aging_batch_hit [idx]) {
+            sai_fdb_aging.stats.hit_refresh_count++;
+            sai_fdb_aging_timer_arm (p_timer);
+            continue;
+        }
+
+        sai_rc = sai_fdb_npu_api_get()->flush_fdb_entry (
+                                            &sai_fdb_aging_batch [idx], false);
+
+        if (sai_rc != SAI_STATUS_SUCCESS) {
+            SAI_FDB_LOG_TRACE ("Aging flush failed for MAC:%s vlan:%d Error %d",
+                               std_mac_to_string ((const sai_mac_t *)
+                               &sai_fdb_aging_batch [idx].mac_address, mac_str,
+                               sizeof (mac_str)),
+                               sai_fdb_aging_batch [idx].vlan_id, sai_rc);
+            sai_fdb_aging.stats.flush_fail_count++;
+            sai_fdb_aging_timer_arm (p_timer);
+            continue;
+        }
+
+        fdb_entry_node = sai_get_fdb_entry_node (&sai_fdb_aging_batch [idx]);
+
+        if (fdb_entry_node != NULL) {
+            sai_remove_fdb_entry_node (fdb_entry_node);
+            sai_fdb_cache_generation_bump ();
+        }
+
+        sai_fdb_aging_timer_free (p_timer);
+
+        sai_fdb_aging_notif_attr [aged_count].id = SAI_FDB_ENTRY_ATTR_PORT_ID;
+        sai_fdb_aging_notif_attr [aged_count].value.oid =
+                                               sai_fdb_aging_batch_port [idx];
+
+        memset (&sai_fdb_aging_notif_data [aged_count], 0,
+                sizeof (sai_fdb_aging_notif_data [aged_count]));
+        sai_fdb_aging_notif_data [aged_count].event_type = SAI_FDB_EVENT_AGED;
+        sai_fdb_aging_notif_data [aged_count].fdb_entry =
+                                               sai_fdb_aging_batch [idx];
+        sai_fdb_aging_notif_data [aged_count].attr_count = 1;
+        sai_fdb_aging_notif_data [aged_count].attr =
+                                      &sai_fdb_aging_notif_attr [aged_count];
+        aged_count++;
+    }
+
+    sai_fdb_aging.stats.aged_count += aged_count;
+
+    return aged_count;
+}
+
+static void sai_fdb_aging_run (void)
+{
+    uint64_t target_tick;
+    uint_t   count;
+    uint_t   aged_count;
+
+    sai_fdb_lock ();
+
+    if (!sai_fdb_aging.enabled) {
+        sai_fdb_unlock ();
+        return;
+    }
+
+    target_tick = (sai_fdb_aging_time_sec_get () - sai_fdb_aging.start_sec) /
+                  SAI_FDB_AGING_TICK_SEC;
+
+    while (sai_fdb_aging.cur_tick < target_tick) {
+        sai_fdb_aging_wheel_tick ();
+    }
+
+    while (sai_fdb_aging.enabled &&
+           ((count = sai_fdb_aging_batch_collect ()) != 0)) {
+
+        /* Hit bits are polled for the whole batch in one NPU call */
+        if (sai_fdb_aging.hit_poll_fn != NULL) {
+            sai_fdb_aging.hit_poll_fn (count, sai_fdb_aging_batch,
+                                       sai_fdb_aging_batch_hit);
+        } else {
+            /* Callback removed while enabled, active entries can't be told apart */
+            memset (sai_fdb_aging_batch_hit, true, count * sizeof (bool));
+        }
+
+        aged_count = sai_fdb_aging_batch_process (count);
+
+        sai_fdb_aging.stats.batch_count++;
+
+        sai_fdb_unlock ();
+
+        if (aged_count != 0) {
+            sai_l2_fdb_aged_entries_notify (aged_count, sai_fdb_aging_notif_data);
+        }
+
+        sai_fdb_lock ();
+    }
+
+    sai_fdb_unlock ();
+}
+
+static void *sai_fdb_aging_thread_fn (void *param)
+{
+    struct timespec ts;
+
+    ts.tv_sec = SAI_FDB_AGING_TICK_SEC;
+    ts.tv_nsec = 0;
+
+    while (1) {
+        nanosleep (&ts, NULL);
+
+        sai_fdb_aging_run ();
+    }
+
+    return NULL;
+}
+
+static sai_status_t sai_fdb_aging_init (void)
+{
+    uint_t level;
+    uint_t slot;
+    uint_t vlan_id;
+
+    if (sai_fdb_aging_initialized) {
+        return SAI_STATUS_SUCCESS;
+    }
+
+    memset (&sai_fdb_aging, 0, sizeof (sai_fdb_aging));
+
+    for (level = 0; level < SAI_FDB_AGING_WHEEL_LEVELS; level++) {
+        for (slot = 0; slot < SAI_FDB_AGING_WHEEL_SLOTS; slot++) {
+            std_dll_init (&sai_fdb_aging.wheel [level][slot]);
+        }
+    }
+
+    std_dll_init (&sai_fdb_aging.expired_list);
+
+    for (vlan_id = 0; vlan_id <= SAI_MAX_VLAN_TAG_ID; vlan_id++) {
+        sai_fdb_aging.vlan_aging_time [vlan_id] = SAI_FDB_AGING_TIME_INHERIT;
+    }
+
+    sai_fdb_aging.timer_tree = std_rbtree_create_simple ("fdb_aging_timer_tree",
+                          STD_STR_OFFSET_OF (sai_fdb_aging_timer_t, key),
+                          STD_STR_SIZE_OF (sai_fdb_aging_timer_t, key));
+
+    sai_fdb_aging.port_tree = std_rbtree_create_simple ("fdb_aging_port_tree",
+                          STD_STR_OFFSET_OF (sai_fdb_aging_port_entry_t, port_id),
+                          STD_STR_SIZE_OF (sai_fdb_aging_port_entry_t, port_id));
+
+    if ((sai_fdb_aging.timer_tree == NULL) || (sai_fdb_aging.port_tree == NULL)) {
+        SAI_FDB_LOG_ERR ("FDB aging tree creation failed");
+        return SAI_STATUS_NO_MEMORY;
+    }
+
+    sai_fdb_aging_initialized = true;
+
+    return SAI_STATUS_SUCCESS;
+}
+
+sai_status_t sai_l2_fdb_sw_aging_enable (bool enable)
+{
+    sai_status_t ret_val = SAI_STATUS_SUCCESS;
+    uint32_t     npu_aging_time = 0;
+
+    sai_fdb_lock ();
+
+    ret_val = sai_fdb_aging_init ();
+
+    if (ret_val != SAI_STATUS_SUCCESS) {
+        sai_fdb_unlock ();
+        return ret_val;
+    }
+
+    if (enable == sai_fdb_aging.enabled) {
+        sai_fdb_unlock ();
+        return SAI_STATUS_SUCCESS;
+    }
+
+    if (enable) {
+        /* Without hit polling every active entry would age out */
+        if (sai_fdb_aging.hit_poll_fn == NULL) {
+            SAI_FDB_LOG_ERR ("FDB software aging needs a hit poll callback");
+            sai_fdb_unlock ();
+            return SAI_STATUS_UNINITIALIZED;
+        }
+
+        ret_val = sai_fdb_npu_api_get()->get_aging_time (&npu_aging_time);
+
+        if (ret_val == SAI_STATUS_SUCCESS) {
+            ret_val = sai_fdb_npu_api_get()->set_aging_time (0);
+        }
+
+        if (ret_val != SAI_STATUS_SUCCESS) {
+            SAI_FDB_LOG_ERR ("Disabling NPU aging failed with err %d", ret_val);
+            sai_fdb_unlock ();
+            return ret_val;
+        }
+
+        if (!sai_fdb_aging_thread_created) {
+            std_thread_init_struct (&sai_fdb_aging_thread);
+            sai_fdb_aging_thread.name = "sai_fdb_sw_aging";
+            sai_fdb_aging_thread.thread_function = sai_fdb_aging_thread_fn;
+
+            if (std_thread_create (&sai_fdb_aging_thread) != STD_ERR_OK) {
+                SAI_FDB_LOG_ERR ("FDB software aging thread create failed");
+                sai_fdb_npu_api_get()->set_aging_time (npu_aging_time);
+                sai_fdb_unlock ();
+                return SAI_STATUS_FAILURE;
+            }
+            sai_fdb_aging_thread_created = true;
+        }
+
+        sai_fdb_aging.npu_aging_time = npu_aging_time;
+        sai_fdb_aging.aging_time = npu_aging_time;
+        sai_fdb_aging.cur_tick = 0;
+        sai_fdb_aging.start_sec = sai_fdb_aging_time_sec_get ();
+        sai_fdb_aging.enabled = true;
+
+        sai_fdb_aging_timers_populate ();
+    } else {
+        ret_val = sai_fdb_npu_api_get()->set_aging_time (sai_fdb_aging.aging_time);
+
+        if (ret_val != SAI_STATUS_SUCCESS) {
+            SAI_FDB_LOG_ERR ("Restoring NPU aging failed with err %d", ret_val);
+            sai_fdb_unlock ();
+            return ret_val;
+        }
+
+        sai_fdb_aging_timers_clear ();
+        sai_fdb_aging.enabled = false;
+    }
+
+    SAI_FDB_LOG_TRACE ("FDB software aging %s", enable ? "enabled" : "disabled");
+
+    sai_fdb_unlock ();
+
+    return SAI_STATUS_SUCCESS;
+}
+
+bool sai_l2_fdb_sw_aging_is_enabled (void)
+{
+    return sai_fdb_aging.enabled;
+}
+
+/* Called with the FDB lock held */
+sai_status_t sai_fdb_sw_aging_time_set (uint32_t value)
+{
+    sai_fdb_aging.aging_time = value;
+
+    sai_fdb_aging_timers_rearm (SAI_NULL_OBJECT_ID, 0);
+
+    return SAI_STATUS_SUCCESS;
+}
+
+sai_status_t sai_fdb_sw_aging_time_get (uint32_t *value)
+{
+    STD_ASSERT (value != NULL);
+
+    *value = sai_fdb_aging.aging_time;
+
+    return SAI_STATUS_SUCCESS;
+}
+
+sai_status_t sai_l2_fdb_sw_aging_vlan_time_set (sai_vlan_id_t vlan_id,
+                                                uint32_t value)
+{
+    sai_status_t ret_val;
+
+    if (!sai_is_valid_vlan_id (vlan_id)) {
+        SAI_FDB_LOG_ERR ("Invalid vlan id %d", vlan_id);
+        return SAI_STATUS_INVALID_VLAN_ID;
+    }
+
+    sai_fdb_lock ();
+
+    ret_val = sai_fdb_aging_init ();
+
+    if (ret_val == SAI_STATUS_SUCCESS) {
+        sai_fdb_aging.vlan_aging_time [vlan_id] = value;
+
+        sai_fdb_aging_timers_rearm (SAI_NULL_OBJECT_ID, vlan_id);
+    }
+
+    sai_fdb_unlock ();
+
+    return ret_val;
+}
+
+sai_status_t sai_l2_fdb_sw_aging_port_time_set (sai_object_id_t port_id,
+                                                uint32_t value)
+{
+    sai_fdb_aging_port_entry_t  tmp_entry;
+    sai_fdb_aging_port_entry_t *p_port_entry = NULL;
+    sai_status_t                ret_val;
+
+    sai_fdb_lock ();
+
+    ret_val = sai_fdb_aging_init ();
+
+    if (ret_val != SAI_STATUS_SUCCESS) {
+        sai_fdb_unlock ();
+        return ret_val;
+    }
+
+    tmp_entry.port_id = port_id;
+
+    p_port_entry = (sai_fdb_aging_port_entry_t *)
+        std_rbtree_getexact (sai_fdb_aging.port_tree, &tmp_entry);
+
+    if (value == SAI_FDB_AGING_TIME_INHERIT) {
+        if (p_port_entry != NULL) {
+            std_rbtree_remove (sai_fdb_aging.port_tree, p_port_entry);
+            free (p_port_entry);
+        }
+        sai_fdb_aging_timers_rearm (port_id, 0);
+        sai_fdb_unlock ();
+        return SAI_STATUS_SUCCESS;
+    }
+
+    if (p_port_entry == NULL) {
+        p_port_entry = (sai_fdb_aging_port_entry_t *)
+                           calloc (1, sizeof (*p_port_entry));
+
+        if (p_port_entry == NULL) {
+            sai_fdb_unlock ();
+            return SAI_STATUS_NO_MEMORY;
+        }
+
+        p_port_entry->port_id = port_id;
+
+        if (std_rbtree_insert (sai_fdb_aging.port_tree, p_port_entry)
+            != STD_ERR_OK) {
+            free (p_port_entry);
+            sai_fdb_unlock ();
+            return SAI_STATUS_FAILURE;
+        }
+    }
+
+    p_port_entry->aging_time = value;
+
+    sai_fdb_aging_timers_rearm (port_id, 0);
+
+    sai_fdb_unlock ();
+
+    return SAI_STATUS_SUCCESS;
+}
+
+void sai_l2_fdb_register_hit_poll_callback (sai_fdb_hit_poll_fn hit_poll_fn)
+{
+    sai_fdb_lock ();
+
+    /* Init first so that the callback is not cleared by a later init */
+    if (sai_fdb_aging_init () == SAI_STATUS_SUCCESS) {
+        sai_fdb_aging.hit_poll_fn = hit_poll_fn;
+    }
+
+    sai_fdb_unlock ();
+}
+
+void sai_l2_fdb_sw_aging_stats_get (sai_fdb_sw_aging_stats_t *p_stats)
+{
+    STD_ASSERT (p_stats != NULL);
+
+    sai_fdb_lock ();
+
+    *p_stats = sai_fdb_aging.stats;
+
+
+    sai_fdb_unlock ();
+}
@@ -24,6 +24,7 @@
 #include "std_radix.h"
 #include "sai_fdb_api.h"
 #include "sai_fdb_common.h"
+#include "sai_fdb_main.h"
 #include "sai_debug_utils.h"
 #include "std_mac_utils.h"
 
@@ -205,3 +206,19 @@ void sai_dump_fdb_entry_nodes_per_port_vlan (sai_object_id_t port_id,
         fdb_entry_node = sai_get_next_fdb_entry_node (&fdb_key);
     }
 }
+
+void sai_dump_fdb_sw_aging (void)
+{
+    sai_fdb_sw_aging_stats_t stats;
+    uint32_t aging_time = 0;
+
+    sai_l2_fdb_sw_aging_stats_get(&stats);
+    sai_l2_fdb_get_aging_time(&aging_time);
+
+    SAI_DEBUG("Software aging: %s, Aging time: %u",
+              sai_l2_fdb_sw_aging_is_enabled() ? "Enabled" : "Disabled", aging_time);
+    SAI_DEBUG("Armed timers: %u, Aged: %"PRIu64", Hit refresh: %"PRIu64,
+              stats.timer_count, stats.aged_count, stats.hit_refresh_count);
+    SAI_DEBUG("Flush failures: %"PRIu64", Batches: %"PRIu64,
+              stats.flush_fail_count, stats.batch_count);
+}
@@ -0,0 +1,172 @@
+/*
+ * Copyright (c) 2016 Dell Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * THIS CODE IS PROVIDED ON AN *AS IS* BASIS, WITHOUT WARRANTIES OR
+ * CONDITIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING WITHOUT
+ * LIMITATION ANY IMPLIED WARRANTIES OR CONDITIONS OF TITLE, FITNESS
+ * FOR A PARTICULAR PURPOSE, MERCHANTABLITY OR NON-INFRINGEMENT.
+ *
+ * See the Apache Version 2.0 License for specific language governing
+ * permissions and limitations under the License.
+ */
+
+/**
+ * @file sai_fdb_export.c
+ *
+ * @brief This file contains the cursor based FDB bulk export.
+ *
+ * The export walks the FDB cache in key order one chunk at a time and
+ * releases the FDB lock between chunks so that learning is not blocked
+ * for the whole table walk.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <inttypes.h>
+#include "saifdb.h"
+#include "saitypes.h"
+#include "saistatus.h"
+#include "sai_fdb_api.h"
+#include "sai_fdb_common.h"
+#include "sai_fdb_main.h"
+#include "std_assert.h"
+
+/* Bound on the cache nodes visited per chunk, including filtered ones */
+#define SAI_FDB_EXPORT_MAX_SCAN_PER_CHUNK 1024
+
+static bool sai_fdb_export_filter_match (const sai_fdb_export_filter_t *filter,
+                                         const sai_fdb_entry_node_t *fdb_entry_node)
+{
+    if ((filter->match_port) && (fdb_entry_node->port_id != filter->port_id)) {
+        return false;
+    }
+
+    if ((filter->match_vlan) &&
+        (fdb_entry_node->fdb_key.vlan_id != filter->vlan_id)) {
+        return false;
+    }
+
+    if ((filter->match_type) &&
+        (fdb_entry_node->entry_type != filter->entry_type)) {
+        return false;
+    }
+
+    return true;
+}
+
+void sai_l2_fdb_export_start (sai_fdb_export_cursor_t *cursor,
+                              const sai_fdb_export_filter_t *filter)
+{
+    STD_ASSERT (cursor != NULL);
+
+    memset (cursor, 0, sizeof (*cursor));
+
+    if (filter != NULL) {
+        cursor->filter = *filter;
+    }
+
+    /* The cache is ordered by VLAN first, start just before the VLAN */
+    if ((cursor->filter.match_vlan) && (cursor->filter.vlan_id > 0)) {
+        cursor->vlan_id = cursor->filter.vlan_id - 1;
+        memset (cursor->mac_address, 0xff, sizeof (sai_mac_t));
+        cursor->key_valid = true;
+    }
+
+    sai_fdb_lock ();
+
+    cursor->start_generation = sai_fdb_cache_generation_get ();
+    cursor->generation = cursor->start_generation;
+
+    sai_fdb_unlock ();
+}
+
+sai_status_t sai_l2_fdb_export_next (sai_fdb_export_cursor_t *cursor,
+                                     uint_t max_count,
+                                     sai_fdb_export_entry_t *entry_list,
+                                     uint_t *count)
+{
+    sai_fdb_entry_node_t   *fdb_entry_node = NULL;
+    sai_fdb_entry_key_t     fdb_key;
+    sai_fdb_export_entry_t *p_entry = NULL;
+    uint_t                  scan_count = 0;
+    uint_t                  entry_count = 0;
+
+    STD_ASSERT (cursor != NULL);
+    STD_ASSERT (count != NULL);
+
+    *count = 0;
+
+    if (cursor->done) {
+        return SAI_STATUS_SUCCESS;
+    }
+
+    if ((max_count == 0) || (entry_list == NULL)) {
+        return SAI_STATUS_INVALID_PARAMETER;
+    }
+
+    memset (&fdb_key, 0, sizeof (fdb_key));
+
+    if (cursor->key_valid) {
+        memcpy (fdb_key.mac_address, cursor->mac_address, sizeof (sai_mac_t));
+        fdb_key.vlan_id = cursor->vlan_id;
+    }
+
+    sai_fdb_lock ();
+
+    while ((entry_count < max_count) &&
+           (scan_count < SAI_FDB_EXPORT_MAX_SCAN_PER_CHUNK)) {
+
+        fdb_entry_node = sai_get_next_fdb_entry_node (&fdb_key);
+
+        if ((fdb_entry_node == NULL) ||
+            ((cursor->filter.match_vlan) &&
+             (fdb_entry_node->fdb_key.vlan_id > cursor->filter.vlan_id))) {
+            cursor->done = true;
+            break;
+        }
+
+        memcpy (&fdb_key, &fdb_entry_node->fdb_key, sizeof (fdb_key));
+        scan_count++;
+
+        if (!sai_fdb_export_filter_match (&cursor->filter, fdb_entry_node)) {
+            continue;
+        }
+
+        p_entry = &entry_list [entry_count];
+
+        memset (p_entry, 0, sizeof (*p_entry));
+        memcpy (p_entry->fdb_entry.mac_address, fdb_entry_node->fdb_key.mac_address,
+                sizeof (sai_mac_t));
+        p_entry->fdb_entry.vlan_id = fdb_entry_node->fdb_key.vlan_id;
+        p_entry->port_id = fdb_entry_node->port_id;
+        p_entry->entry_type = fdb_entry_node->entry_type;
+        p_entry->action = fdb_entry_node->action;
+        p_entry->metadata = fdb_entry_node->metadata;
+
+        entry_count++;
+    }
+
+    cursor->generation = sai_fdb_cache_generation_get ();
+
+    sai_fdb_unlock ();
+
+    memcpy (cursor->mac_address, fdb_key.mac_address, sizeof (sai_mac_t));
+    cursor->vlan_id = fdb_key.vlan_id;
+    cursor->key_valid = true;
+
+    *count = entry_count;
+
+    return SAI_STATUS_SUCCESS;
+}
+
+bool sai_l2_fdb_export_is_consistent (const sai_fdb_export_cursor_t *cursor)
+{
+    STD_ASSERT (cursor != NULL);
+
+    return (cursor->generation == cursor->start_generation);
+}
@@ -38,6 +38,7 @@
 #include "sai_common_infra.h"
 #include "sai_stp_util.h"
 #include "sai_debug_utils.h"
+#include "sai_id_allocator.h"
 
 #include "std_rbtree.h"
 #include "std_assert.h"
@@ -54,7 +55,7 @@ static rbtree_handle stp_info_tree = NULL;
 static rbtree_handle global_stp_port_tree = NULL;
 static sai_object_id_t g_def_stp_id = 0;
 static sai_object_id_t g_stp_vlan_map[SAI_MAX_VLAN_TAG_ID+1] = {0};
-static dn_sai_id_gen_info_t sai_port_id_gen_info;
+static sai_id_allocator_t sai_port_id_allocator;
 
 rbtree_handle sai_stp_global_info_tree_get(void)
 {
@@ -66,36 +67,27 @@ rbtree_handle sai_stp_port_tree_get(void)
     return global_stp_port_tree;
 }
 
-bool sai_stp_port_id_in_use(uint64_t obj_id)
+static sai_object_id_t sai_stp_port_id_create(void)
 {
-    dn_sai_stp_port_info_t stp_port_node;
+    uint64_t id = 0;
 
-    stp_port_node.stp_port_id =
-        sai_uoid_create(SAI_OBJECT_TYPE_STP_PORT,obj_id);
-    if(std_rbtree_getexact(
-                global_stp_port_tree,(void *)&stp_port_node) == NULL) {
-        return true;
-    } else {
-        return false;
+    if(SAI_STATUS_SUCCESS ==
+            sai_id_allocator_alloc(&sai_port_id_allocator, &id)) {
+        return (sai_uoid_create(SAI_OBJECT_TYPE_STP_PORT, id));
     }
+    return SAI_NULL_OBJECT_ID;
 }
 
-static sai_object_id_t sai_stp_port_id_create(void)
+static inline void sai_stp_port_id_release(sai_object_id_t stp_port_id)
 {
-    if(SAI_STATUS_SUCCESS ==
-            dn_sai_get_next_free_id(&sai_port_id_gen_info)) {
-        return (sai_uoid_create(SAI_OBJECT_TYPE_STP_PORT,
-                    sai_port_id_gen_info.cur_id));
-    }
-    return SAI_NULL_OBJECT_ID;
+    sai_id_allocator_free(&sai_port_id_allocator,
+                          sai_uoid_npu_obj_id_get(stp_port_id));
 }
 
-static inline void sai_stp_port_id_gen_init(void)
+static inline sai_status_t sai_stp_port_id_gen_init(void)
 {
-    sai_port_id_gen_info.cur_id = 0;
-    sai_port_id_gen_info.is_wrappped = false;
-    sai_port_id_gen_info.mask = SAI_UOID_NPU_OBJ_ID_MASK;
-    sai_port_id_gen_info.is_id_in_use = sai_stp_port_id_in_use;
+    return sai_id_allocator_init(&sai_port_id_allocator, "stp_port",
+                                 SAI_ID_ALLOCATOR_MAX_IDS);
 }
 
 sai_object_id_t sai_stp_get_instance_from_vlan_map(sai_vlan_id_t vlan_id)
@@ -779,6 +771,10 @@ sai_status_t sai_stp_port_create(sai_object_id_t *stp_port_id,
         SAI_STP_LOG_ERR("STP port create failed for"
                 " STP Inst 0x%"PRIx64" Port 0x%"PRIx64"",
                 stp_inst_id, port_id);
+        if((p_stp_port_info != NULL) &&
+           (p_stp_port_info->stp_port_id != SAI_NULL_OBJECT_ID)) {
+            sai_stp_port_id_release(p_stp_port_info->stp_port_id);
+        }
         sai_stp_port_node_free(p_stp_port_info);
         p_stp_port_info = NULL;
     } else {
@@ -844,6 +840,7 @@ sai_status_t sai_stp_port_remove(sai_object_id_t stp_port_id)
 
     if(SAI_STATUS_SUCCESS == ret_val) {
         SAI_STP_LOG_ERR("Failed to remove STP port obj 0x%"PRIx64"",stp_port_id);
+        sai_stp_port_id_release(stp_port_id);
         sai_stp_port_node_free(p_stp_port_info);
         p_stp_port_info = NULL;
     }
@@ -1268,7 +1265,12 @@ sai_status_t sai_stp_init (void)
             break;
         }
 
-        sai_stp_port_id_gen_init();
+        ret = sai_stp_port_id_gen_init();
+
+        if (ret != SAI_STATUS_SUCCESS) {
+            SAI_STP_LOG_ERR ("STP Port Id allocator init failed");
+            break;
+        }
 
         ret = sai_stp_npu_api_get()->stp_init(&def_stp_id, &l3_stp_id);
 
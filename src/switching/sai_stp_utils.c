@@ -23,6 +23,7 @@
 
 #include <stdlib.h>
 #include "std_mutex_lock.h"
+#include "sai_lock_profile.h"
 #include "saitypes.h"
 #include "saistatus.h"
 #include "sai_stp_defs.h"
@@ -31,6 +32,8 @@
 
 static std_mutex_type_t stp_lock;
 
+SAI_LOCK_PROFILE_DEFINE (stp_lock_profile, "stp")
+
 dn_sai_stp_info_t *sai_stp_info_node_alloc (void)
 {
     return ((dn_sai_stp_info_t *)calloc (1,
@@ -73,12 +76,13 @@ void sai_stp_mutex_lock_init(void)
 
 void sai_stp_lock(void)
 {
-    std_mutex_lock (&stp_lock);
+    sai_profiled_mutex_lock (&stp_lock, &stp_lock_profile,
+                             SAI_LOCK_PROFILE_CALL_SITE ());
 }
 
 void sai_stp_unlock(void)
 {
-    std_mutex_unlock (&stp_lock);
+    sai_profiled_mutex_unlock (&stp_lock, &stp_lock_profile);
 }
 
 bool sai_stp_can_port_learn_mac (sai_vlan_id_t vlan_id, sai_object_id_t port_id)
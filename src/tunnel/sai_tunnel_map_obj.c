@@ -23,6 +23,7 @@
 #include "sai_tunnel_api_utils.h"
 #include "sai_tunnel_util.h"
 #include "sai_bridge_common.h"
+#include "sai_id_allocator.h"
 
 #include "std_rbtree.h"
 #include "std_llist.h"
@@ -34,71 +35,65 @@
 
 #include <stdlib.h>
 #include <inttypes.h>
-static dn_sai_id_gen_info_t tunnel_map_gen_info;
-static dn_sai_id_gen_info_t tunnel_map_entry_gen_info;
-
-bool dn_sai_tunnel_map_id_in_use(uint64_t id)
-{
-    sai_object_id_t tunnel_map_id =
-        sai_uoid_create(SAI_OBJECT_TYPE_TUNNEL_MAP, id);
-
-    if(dn_sai_tunnel_map_get(tunnel_map_id) != NULL) {
-        return true;
-    }
-
-    return false;
-}
+static sai_id_allocator_t tunnel_map_id_allocator;
+static sai_id_allocator_t tunnel_map_entry_id_allocator;
 
 static sai_object_id_t dn_sai_tunnel_map_id_generate(void)
 {
+    uint64_t id = 0;
+
     if(SAI_STATUS_SUCCESS ==
-       dn_sai_get_next_free_id(&tunnel_map_gen_info)) {
+       sai_id_allocator_alloc(&tunnel_map_id_allocator, &id)) {
 
-        return (sai_uoid_create(SAI_OBJECT_TYPE_TUNNEL_MAP,
-                                tunnel_map_gen_info.cur_id));
+        return (sai_uoid_create(SAI_OBJECT_TYPE_TUNNEL_MAP, id));
     }
 
     return SAI_NULL_OBJECT_ID;
 }
 
-bool dn_sai_tunnel_map_entry_id_in_use(uint64_t id)
+static void dn_sai_tunnel_map_id_release(sai_object_id_t tunnel_map_id)
 {
-    sai_object_id_t tunnel_map_entry_id =
-        sai_uoid_create(SAI_OBJECT_TYPE_TUNNEL_MAP_ENTRY, id);
-
-    if(dn_sai_tunnel_map_entry_get(tunnel_map_entry_id) != NULL) {
-        return true;
-    }
-
-    return false;
+    sai_id_allocator_free(&tunnel_map_id_allocator,
+                          sai_uoid_npu_obj_id_get(tunnel_map_id));
 }
 
 static sai_object_id_t dn_sai_tunnel_map_entry_id_generate(void)
 {
+    uint64_t id = 0;
+
     if(SAI_STATUS_SUCCESS ==
-       dn_sai_get_next_free_id(&tunnel_map_entry_gen_info)) {
+       sai_id_allocator_alloc(&tunnel_map_entry_id_allocator, &id)) {
 
-        return (sai_uoid_create(SAI_OBJECT_TYPE_TUNNEL_MAP_ENTRY,
-                                tunnel_map_entry_gen_info.cur_id));
+        return (sai_uoid_create(SAI_OBJECT_TYPE_TUNNEL_MAP_ENTRY, id));
     }
 
     return SAI_NULL_OBJECT_ID;
 }
 
+static void dn_sai_tunnel_map_entry_id_release(sai_object_id_t tunnel_map_entry_id)
+{
+    sai_id_allocator_free(&tunnel_map_entry_id_allocator,
+                          sai_uoid_npu_obj_id_get(tunnel_map_entry_id));
+}
+
 void dn_sai_tunnel_map_init()
 {
-    tunnel_map_gen_info.cur_id = 0;
-    tunnel_map_gen_info.is_wrappped = false;
-    tunnel_map_gen_info.mask = SAI_UOID_NPU_OBJ_ID_MASK;
-    tunnel_map_gen_info.is_id_in_use = dn_sai_tunnel_map_id_in_use;
+    if(SAI_STATUS_SUCCESS !=
+       sai_id_allocator_init(&tunnel_map_id_allocator, "tunnel_map",
+                             SAI_ID_ALLOCATOR_MAX_IDS)) {
+
+        SAI_TUNNEL_LOG_ERR("Failed to init tunnel map id allocator");
+    }
 }
 
 void dn_sai_tunnel_map_entry_init()
 {
-    tunnel_map_entry_gen_info.cur_id = 0;
-    tunnel_map_entry_gen_info.is_wrappped = false;
-    tunnel_map_entry_gen_info.mask = SAI_UOID_NPU_OBJ_ID_MASK;
-    tunnel_map_entry_gen_info.is_id_in_use = dn_sai_tunnel_map_entry_id_in_use;
+    if(SAI_STATUS_SUCCESS !=
+       sai_id_allocator_init(&tunnel_map_entry_id_allocator, "tunnel_map_entry",
+                             SAI_ID_ALLOCATOR_MAX_IDS)) {
+
+        SAI_TUNNEL_LOG_ERR("Failed to init tunnel map entry id allocator");
+    }
 }
 
 static sai_status_t dn_sai_tunnel_map_validate_type(sai_tunnel_map_type_t type)
@@ -217,6 +212,10 @@ static sai_status_t dn_sai_create_tunnel_map(sai_object_id_t *tunnel_map_id,
 
     if(sai_rc != SAI_STATUS_SUCCESS) {
 
+        if(p_tunnel_map->map_id != SAI_NULL_OBJECT_ID) {
+            dn_sai_tunnel_map_id_release(p_tunnel_map->map_id);
+        }
+
         free(p_tunnel_map);
     }
 
@@ -247,6 +246,8 @@ static sai_status_t dn_sai_remove_tunnel_map(sai_object_id_t tunnel_map_id)
 
     std_rbtree_remove(dn_sai_tunnel_map_tree_handle(), p_tunnel_map);
 
+    dn_sai_tunnel_map_id_release(tunnel_map_id);
+
     free(p_tunnel_map);
 
     return SAI_STATUS_SUCCESS;
@@ -485,6 +486,12 @@ static sai_status_t dn_sai_create_tunnel_map_entry(sai_object_id_t *tunnel_map_e
 
     } while(0);
 
+    if((sai_rc != SAI_STATUS_SUCCESS) &&
+       (p_tunnel_map_entry->tunnel_map_entry_id != SAI_NULL_OBJECT_ID)) {
+
+        dn_sai_tunnel_map_entry_id_release(p_tunnel_map_entry->tunnel_map_entry_id);
+    }
+
     sai_bridge_unlock();
     dn_sai_tunnel_unlock();
 
@@ -620,6 +627,8 @@ static sai_status_t dn_sai_remove_tunnel_map_entry(sai_object_id_t tunnel_map_en
         p_tunnel_map->ref_count--;
         p_bridge_info->ref_count--;
 
+        dn_sai_tunnel_map_entry_id_release(tunnel_map_entry_id);
+
         free(p_tunnel_map_entry);
 
         sai_rc = SAI_STATUS_SUCCESS;
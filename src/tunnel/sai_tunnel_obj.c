@@ -39,6 +39,7 @@
 #include "std_llist.h"
 #include <inttypes.h>
 #include <stdlib.h>
+#include <time.h>
 
 static sai_tunnel_api_t sai_tunnel_api_method_table;
 
@@ -66,17 +67,6 @@ static sai_status_t sai_tunnel_object_id_bitmap_init (void)
         return SAI_STATUS_NO_MEMORY;
     }
 
-
-    /* Create the tunnel termination entry index bitmap */
-    p_global_param->tunnel_term_id_bitmap =
-        std_bitmap_create_array (SAI_TUNNEL_TERM_OBJ_MAX_ID);
-    if (NULL == p_global_param->tunnel_term_id_bitmap) {
-
-        SAI_TUNNEL_LOG_CRIT ("Failed to allocate tunnel termination entry index bitmap.");
-
-        return SAI_STATUS_NO_MEMORY;
-    }
-
     return SAI_STATUS_SUCCESS;
 }
 
@@ -87,11 +77,6 @@ static void sai_tunnel_object_id_bitmap_deinit (void)
     if (p_global_param->tunnel_obj_id_bitmap != NULL) {
         std_bitmaparray_free_data (p_global_param->tunnel_obj_id_bitmap);
     }
-
-
-    if (p_global_param->tunnel_term_id_bitmap != NULL) {
-        std_bitmaparray_free_data (p_global_param->tunnel_term_id_bitmap);
-    }
 }
 
 sai_status_t sai_tunnel_init (void)
@@ -173,6 +158,7 @@ sai_status_t sai_tunnel_init (void)
         }
         dn_sai_tunnel_map_init();
         dn_sai_tunnel_map_entry_init();
+        dn_sai_tunnel_term_init();
 
         p_global_param->is_init_complete = true;
 
@@ -297,7 +283,7 @@ static sai_status_t dn_sai_tunnel_intf_set (dn_sai_tunnel_t *p_tunnel_obj,
         return SAI_STATUS_INVALID_OBJECT_TYPE;
     }
 
-    p_rif_node = sai_fib_router_interface_node_get (p_attr->value.oid);
+    p_rif_node = sai_fib_router_interface_node_index_get (p_attr->value.oid);
     if (NULL ==  p_rif_node) {
 
         SAI_TUNNEL_LOG_ERR ("RIF Id 0x%"PRIx64" not found.",
@@ -967,6 +953,125 @@ static sai_status_t dn_sai_tunnel_stats_clear (sai_object_id_t tunnel_id,
 
     return sai_rc;
 }
+static uint64_t dn_sai_tunnel_stats_time_us_get (void)
+{
+    struct timespec ts;
+
+    clock_gettime (CLOCK_MONOTONIC, &ts);
+
+    return (((uint64_t) ts.tv_sec * 1000000) + (ts.tv_nsec / 1000));
+}
+
+/* Fills tunnel_list with the ids of all tunnels, called with tunnel lock */
+static sai_status_t dn_sai_tunnel_id_list_get (uint32_t *tunnel_count,
+                                               sai_object_id_t *tunnel_list)
+{
+    dn_sai_tunnel_t *p_tunnel = NULL;
+    uint32_t         count = 0;
+
+    for (p_tunnel = (dn_sai_tunnel_t *) std_rbtree_getfirst (dn_sai_tunnel_tree_handle ());
+         p_tunnel != NULL;
+         p_tunnel = (dn_sai_tunnel_t *) std_rbtree_getnext (dn_sai_tunnel_tree_handle (),
+                                                            p_tunnel)) {
+        if (count < *tunnel_count) {
+            tunnel_list [count] = p_tunnel->tunnel_id;
+        }
+        count++;
+    }
+
+    if (count > *tunnel_count) {
+
+        SAI_TUNNEL_LOG_ERR ("Tunnel list size %u is less than tunnel count %u.",
+                            *tunnel_count, count);
+
+        *tunnel_count = count;
+
+        return SAI_STATUS_BUFFER_OVERFLOW;
+    }
+
+    *tunnel_count = count;
+
+    return SAI_STATUS_SUCCESS;
+}
+
+sai_status_t dn_sai_tunnel_stats_snapshot_get (bool all_tunnels,
+                                               uint32_t *tunnel_count,
+                                               sai_object_id_t *tunnel_list,
+                                               uint32_t num_counters,
+                                               const sai_tunnel_stat_t *counter_ids,
+                                               bool read_clear,
+                                               uint64_t *counters,
+                                               sai_status_t *tunnel_statuses,
+                                               uint64_t *p_timestamp_us)
+{
+    sai_status_t sai_rc = SAI_STATUS_SUCCESS;
+    uint32_t     tunnel_idx = 0;
+
+    if ((tunnel_count == NULL) || (num_counters == 0) || (counter_ids == NULL) ||
+        ((*tunnel_count != 0) &&
+         ((tunnel_list == NULL) || (counters == NULL) || (tunnel_statuses == NULL)))) {
+
+        SAI_TUNNEL_LOG_ERR ("Invalid paramter supplied for tunnel statistics snapshot");
+        return SAI_STATUS_INVALID_PARAMETER;
+    }
+
+    if (all_tunnels) {
+
+        dn_sai_tunnel_lock();
+
+        sai_rc = dn_sai_tunnel_id_list_get (tunnel_count, tunnel_list);
+
+        dn_sai_tunnel_unlock();
+
+        if (sai_rc != SAI_STATUS_SUCCESS) {
+            return sai_rc;
+        }
+    }
+
+    if (p_timestamp_us != NULL) {
+        *p_timestamp_us = dn_sai_tunnel_stats_time_us_get ();
+    }
+
+    for (tunnel_idx = 0; tunnel_idx < *tunnel_count; tunnel_idx++) {
+
+        /* Lock per tunnel, a tunnel removed since the list was built is skipped */
+        dn_sai_tunnel_lock();
+
+        if (dn_sai_tunnel_obj_get (tunnel_list [tunnel_idx]) == NULL) {
+
+            tunnel_statuses [tunnel_idx] = SAI_STATUS_INVALID_OBJECT_ID;
+
+        } else {
+
+            tunnel_statuses [tunnel_idx] =
+                sai_tunnel_npu_api_get()->tunnel_stats_get (tunnel_list [tunnel_idx],
+                                      num_counters, counter_ids,
+                                      &counters [tunnel_idx * num_counters]);
+
+            if ((tunnel_statuses [tunnel_idx] == SAI_STATUS_SUCCESS) && (read_clear)) {
+
+                tunnel_statuses [tunnel_idx] =
+                    sai_tunnel_npu_api_get()->tunnel_stats_clear (tunnel_list [tunnel_idx],
+                                                                  num_counters,
+                                                                  counter_ids);
+            }
+        }
+
+        dn_sai_tunnel_unlock();
+
+        if (tunnel_statuses [tunnel_idx] != SAI_STATUS_SUCCESS) {
+
+            SAI_TUNNEL_LOG_ERR ("Failed to read tunnel stats for tunnel 0x%"PRIx64
+                                " in snapshot, Error: %d.", tunnel_list [tunnel_idx],
+                                tunnel_statuses [tunnel_idx]);
+
+            sai_rc = SAI_STATUS_FAILURE;
+        }
+    }
+
+    return sai_rc;
+}
+
 void dn_sai_tunnel_obj_api_fill (sai_tunnel_api_t *api_table)
 {
     api_table->create_tunnel = dn_sai_tunnel_create;
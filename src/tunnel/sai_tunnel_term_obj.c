@@ -30,10 +30,44 @@
 #include "sai_tunnel.h"
 #include "sai_tunnel_util.h"
 #include "sai_l3_util.h"
+#include "sai_id_allocator.h"
 #include "std_assert.h"
 #include "std_llist.h"
 #include <inttypes.h>
 #include <stdlib.h>
+#include <string.h>
+
+/*
+ * Hash index of the Tunnel Termination entries on the match key, used for
+ * duplicate detection on create and set. Chained buckets, the bucket count
+ * is a power of 2.
+ */
+#define SAI_TUNNEL_TERM_KEY_HASH_BUCKETS  (1024)
+
+#define SAI_TUNNEL_TERM_IP_ADDR_LEN       (16)
+
+typedef struct _dn_sai_tunnel_term_key_t {
+    sai_object_id_t vr_id;
+    uint32_t        type;
+    uint32_t        tunnel_type;
+    uint32_t        dst_ip_family;
+    uint32_t        src_ip_family;
+    uint8_t         dst_ip [SAI_TUNNEL_TERM_IP_ADDR_LEN];
+    uint8_t         src_ip [SAI_TUNNEL_TERM_IP_ADDR_LEN];
+} dn_sai_tunnel_term_key_t;
+
+typedef struct _dn_sai_tunnel_term_key_node_t {
+    struct _dn_sai_tunnel_term_key_node_t *p_next;
+    dn_sai_tunnel_term_key_t               key;
+    dn_sai_tunnel_term_entry_t            *p_tunnel_term;
+    /* Id of the entry in NPU, a temporary Id after a key change */
+    sai_object_id_t                        npu_entry_id;
+} dn_sai_tunnel_term_key_node_t;
+
+static dn_sai_tunnel_term_key_node_t
+                   *tunnel_term_key_hash [SAI_TUNNEL_TERM_KEY_HASH_BUCKETS];
+
+static sai_id_allocator_t tunnel_term_id_allocator;
 
 static inline dn_sai_tunnel_term_entry_t *dn_sai_tunnel_term_object_alloc (void)
 {
@@ -47,6 +81,250 @@ static inline void dn_sai_tunnel_term_object_free (
     free ((void *) tunnel_term);
 }
 
+static sai_object_id_t dn_sai_tunnel_term_id_generate (void)
+{
+    uint64_t id = 0;
+
+    if (SAI_STATUS_SUCCESS ==
+        sai_id_allocator_alloc (&tunnel_term_id_allocator, &id)) {
+
+        return (sai_uoid_create (SAI_OBJECT_TYPE_TUNNEL_TERM_TABLE_ENTRY, id));
+    }
+
+    return SAI_NULL_OBJECT_ID;
+}
+
+static void dn_sai_tunnel_term_id_release (sai_object_id_t tunnel_term_id)
+{
+    sai_id_allocator_free (&tunnel_term_id_allocator,
+                           sai_uoid_npu_obj_id_get (tunnel_term_id));
+}
+
+void dn_sai_tunnel_term_init (void)
+{
+    memset (tunnel_term_key_hash, 0, sizeof (tunnel_term_key_hash));
+
+    if (SAI_STATUS_SUCCESS !=
+        sai_id_allocator_init (&tunnel_term_id_allocator, "tunnel_term",
+                               SAI_TUNNEL_TERM_OBJ_MAX_ID)) {
+
+        SAI_TUNNEL_LOG_ERR ("Failed to init tunnel term id allocator");
+    }
+}
+
+static void dn_sai_tunnel_term_key_ip_fill (const sai_ip_address_t *p_ip,
+                                            uint32_t *p_family, uint8_t *p_addr)
+{
+    *p_family = p_ip->addr_family;
+
+    if (p_ip->addr_family == SAI_IP_ADDR_FAMILY_IPV4) {
+        memcpy (p_addr, &p_ip->addr.ip4, sizeof (p_ip->addr.ip4));
+    } else if (p_ip->addr_family == SAI_IP_ADDR_FAMILY_IPV6) {
+        memcpy (p_addr, p_ip->addr.ip6, sizeof (p_ip->addr.ip6));
+    }
+}
+
+static void dn_sai_tunnel_term_key_fill (
+                                 const dn_sai_tunnel_term_entry_t *p_tunnel_term,
+                                 dn_sai_tunnel_term_key_t *p_key)
+{
+    /* Zero fill so that the unused address bytes compare equal */
+    memset (p_key, 0, sizeof (*p_key));
+
+    p_key->vr_id       = p_tunnel_term->vr_id;
+    p_key->type        = p_tunnel_term->type;
+    p_key->tunnel_type = p_tunnel_term->tunnel_type;
+
+    dn_sai_tunnel_term_key_ip_fill (&p_tunnel_term->dst_ip,
+                                    &p_key->dst_ip_family, p_key->dst_ip);
+
+    /* Source IP is part of the match only for P2P entries */
+    if (p_tunnel_term->type == SAI_TUNNEL_TERM_TABLE_ENTRY_TYPE_P2P) {
+        dn_sai_tunnel_term_key_ip_fill (&p_tunnel_term->src_ip,
+                                        &p_key->src_ip_family, p_key->src_ip);
+    }
+}
+
+static uint_t dn_sai_tunnel_term_key_hash_get (const dn_sai_tunnel_term_key_t *p_key)
+{
+    const uint8_t *p_byte = (const uint8_t *) p_key;
+    uint32_t       hash = 2166136261u;
+    uint_t         idx;
+
+    /* FNV-1a over the zero padded key */
+    for (idx = 0; idx < sizeof (*p_key); idx++) {
+        hash = (hash ^ p_byte [idx]) * 16777619u;
+    }
+
+    return (hash & (SAI_TUNNEL_TERM_KEY_HASH_BUCKETS - 1));
+}
+
+static dn_sai_tunnel_term_key_node_t **dn_sai_tunnel_term_key_node_ref_get (
+                                 const dn_sai_tunnel_term_key_t *p_key,
+                                 const dn_sai_tunnel_term_entry_t *p_tunnel_term)
+{
+    dn_sai_tunnel_term_key_node_t **pp_node = NULL;
+
+    pp_node = &tunnel_term_key_hash [dn_sai_tunnel_term_key_hash_get (p_key)];
+
+    for (; *pp_node != NULL; pp_node = &(*pp_node)->p_next) {
+
+        if ((p_tunnel_term != NULL) && ((*pp_node)->p_tunnel_term != p_tunnel_term)) {
+            continue;
+        }
+
+        if (memcmp (&(*pp_node)->key, p_key, sizeof (*p_key)) == 0) {
+            return pp_node;
+        }
+    }
+
+    return NULL;
+}
+
+static sai_status_t dn_sai_tunnel_term_key_index_add (
+                                dn_sai_tunnel_term_entry_t *p_tunnel_term)
+{
+    dn_sai_tunnel_term_key_node_t *p_node = NULL;
+    uint_t                         bucket;
+
+    p_node = (dn_sai_tunnel_term_key_node_t *) calloc (1, sizeof (*p_node));
+
+    if (p_node == NULL) {
+        SAI_TUNNEL_LOG_ERR ("Failed to allocate Tunnel Term key index node.");
+
+        return SAI_STATUS_NO_MEMORY;
+    }
+
+    dn_sai_tunnel_term_key_fill (p_tunnel_term, &p_node->key);
+    p_node->p_tunnel_term = p_tunnel_term;
+    p_node->npu_entry_id = p_tunnel_term->term_entry_id;
+
+    bucket = dn_sai_tunnel_term_key_hash_get (&p_node->key);
+
+    p_node->p_next = tunnel_term_key_hash [bucket];
+    tunnel_term_key_hash [bucket] = p_node;
+
+    return SAI_STATUS_SUCCESS;
+}
+
+static dn_sai_tunnel_term_key_node_t *dn_sai_tunnel_term_key_index_unlink (
+                                dn_sai_tunnel_term_entry_t *p_tunnel_term)
+{
+    dn_sai_tunnel_term_key_node_t **pp_node = NULL;
+    dn_sai_tunnel_term_key_node_t  *p_node = NULL;
+    dn_sai_tunnel_term_key_t        key;
+
+    dn_sai_tunnel_term_key_fill (p_tunnel_term, &key);
+
+    pp_node = dn_sai_tunnel_term_key_node_ref_get (&key, p_tunnel_term);
+
+    if (pp_node == NULL) {
+        return NULL;
+    }
+
+    p_node = *pp_node;
+    *pp_node = p_node->p_next;
+    p_node->p_next = NULL;
+
+    return p_node;
+}
+
+static void dn_sai_tunnel_term_key_index_remove (
+                                dn_sai_tunnel_term_entry_t *p_tunnel_term)
+{
+    free (dn_sai_tunnel_term_key_index_unlink (p_tunnel_term));
+}
+
+/* Moves the index node to the bucket of the updated key, does not allocate */
+static void dn_sai_tunnel_term_key_index_update (
+                                dn_sai_tunnel_term_entry_t *p_tunnel_term,
+                                const dn_sai_tunnel_term_entry_t *p_new_term)
+{
+    dn_sai_tunnel_term_key_node_t *p_node = NULL;
+    uint_t                         bucket;
+
+    p_node = dn_sai_tunnel_term_key_index_unlink (p_tunnel_term);
+
+    STD_ASSERT (p_node != NULL);
+
+    dn_sai_tunnel_term_key_fill (p_new_term, &p_node->key);
+
+    bucket = dn_sai_tunnel_term_key_hash_get (&p_node->key);
+
+    p_node->p_next = tunnel_term_key_hash [bucket];
+    tunnel_term_key_hash [bucket] = p_node;
+}
+
+static dn_sai_tunnel_term_key_node_t *dn_sai_tunnel_term_key_node_get (
+                                const dn_sai_tunnel_term_entry_t *p_tunnel_term)
+{
+    dn_sai_tunnel_term_key_node_t **pp_node = NULL;
+    dn_sai_tunnel_term_key_t        key;
+
+    dn_sai_tunnel_term_key_fill (p_tunnel_term, &key);
+
+    pp_node = dn_sai_tunnel_term_key_node_ref_get (&key, p_tunnel_term);
+
+    return ((pp_node != NULL) ? *pp_node : NULL);
+}
+
+static sai_object_id_t dn_sai_tunnel_term_npu_id_get (
+                                const dn_sai_tunnel_term_entry_t *p_tunnel_term)
+{
+    dn_sai_tunnel_term_key_node_t *p_node =
+                              dn_sai_tunnel_term_key_node_get (p_tunnel_term);
+
+    return ((p_node != NULL) ? p_node->npu_entry_id : p_tunnel_term->term_entry_id);
+}
+
+/* NPU create and remove of the entry under the Id it has in NPU */
+static sai_status_t dn_sai_tunnel_term_npu_entry_create (
+                                dn_sai_tunnel_term_entry_t *p_tunnel_term,
+                                sai_object_id_t npu_entry_id)
+{
+    dn_sai_tunnel_term_entry_t npu_term;
+
+    if (npu_entry_id == p_tunnel_term->term_entry_id) {
+        return sai_tunnel_npu_api_get()->tunnel_term_entry_create (p_tunnel_term);
+    }
+
+    npu_term = *p_tunnel_term;
+    npu_term.term_entry_id = npu_entry_id;
+
+    return sai_tunnel_npu_api_get()->tunnel_term_entry_create (&npu_term);
+}
+
+static sai_status_t dn_sai_tunnel_term_npu_entry_remove (
+                                dn_sai_tunnel_term_entry_t *p_tunnel_term,
+                                sai_object_id_t npu_entry_id)
+{
+    dn_sai_tunnel_term_entry_t npu_term;
+
+    if (npu_entry_id == p_tunnel_term->term_entry_id) {
+        return sai_tunnel_npu_api_get()->tunnel_term_entry_remove (p_tunnel_term);
+    }
+
+    npu_term = *p_tunnel_term;
+    npu_term.term_entry_id = npu_entry_id;
+
+    return sai_tunnel_npu_api_get()->tunnel_term_entry_remove (&npu_term);
+}
+
+dn_sai_tunnel_term_entry_t *dn_sai_tunnel_term_entry_key_lookup (
+                           const dn_sai_tunnel_term_entry_t *p_key_entry)
+{
+    dn_sai_tunnel_term_key_node_t **pp_node = NULL;
+    dn_sai_tunnel_term_key_t        key;
+
+    STD_ASSERT (p_key_entry != NULL);
+
+    dn_sai_tunnel_term_key_fill (p_key_entry, &key);
+
+    pp_node = dn_sai_tunnel_term_key_node_ref_get (&key, NULL);
+
+    return ((pp_node != NULL) ? (*pp_node)->p_tunnel_term : NULL);
+}
+
 static sai_status_t dn_sai_tunnel_term_ip_set (
                                      dn_sai_tunnel_term_entry_t *p_tunnel_term,
                                      const sai_attribute_t  *p_attr)
@@ -191,10 +469,11 @@ static sai_status_t dn_sai_tunnel_term_create (sai_object_id_t *tunnel_term_id,
     dn_sai_tunnel_term_entry_t *p_tunnel_term = NULL;
     dn_sai_tunnel_t            *p_tunnel = NULL;
     sai_status_t                status;
-    int                         tunnel_term_index;
     char                        ip_addr_str[SAI_FIB_MAX_BUFSZ];
     bool                        is_encap_nh_setup = false;
     bool                        is_term_set_in_npu = false;
+    bool                        is_id_allocated = false;
+    bool                        is_key_indexed = false;
 
     STD_ASSERT (tunnel_term_id != NULL);
     STD_ASSERT (attr_list != NULL);
@@ -220,26 +499,40 @@ static sai_status_t dn_sai_tunnel_term_create (sai_object_id_t *tunnel_term_id,
     dn_sai_tunnel_lock();
 
     do {
-    tunnel_term_index = std_find_first_bit (dn_sai_tunnel_term_obj_id_bitmap(),
-                                            SAI_TUNNEL_TERM_OBJ_MAX_ID, 1);
+        /* Validate and fill the attribute values passed in the list */
+        status = dn_sai_tunnel_term_attr_set (p_tunnel_term, attr_count, attr_list);
+
+        if (status != SAI_STATUS_SUCCESS) {
+            SAI_TUNNEL_LOG_ERR ("SAI Tunnel Term entry attribute error.");
+
+            break;
+        }
+
+        if (dn_sai_tunnel_term_entry_key_lookup (p_tunnel_term) != NULL) {
+            SAI_TUNNEL_LOG_ERR ("SAI Tunnel Term entry with the same key exists.");
+
+            status = SAI_STATUS_ITEM_ALREADY_EXISTS;
+            break;
+        }
+
+        p_tunnel_term->term_entry_id = dn_sai_tunnel_term_id_generate ();
 
-    if (tunnel_term_index < 0) {
+        if (p_tunnel_term->term_entry_id == SAI_NULL_OBJECT_ID) {
 
-        SAI_TUNNEL_LOG_INFO ("No free index in tunnel term object index bitmap"
-                             " of size %d.", SAI_TUNNEL_TERM_OBJ_MAX_ID);
+            SAI_TUNNEL_LOG_INFO ("No free index for tunnel term object of max "
+                                 "size %d.", SAI_TUNNEL_TERM_OBJ_MAX_ID);
 
             status = SAI_STATUS_INSUFFICIENT_RESOURCES;
             break;
-    }
+        }
+        is_id_allocated = true;
 
-        /* Validate and fill the attribute values passed in the list */
-        status = dn_sai_tunnel_term_attr_set (p_tunnel_term, attr_count, attr_list);
+        status = dn_sai_tunnel_term_key_index_add (p_tunnel_term);
 
         if (status != SAI_STATUS_SUCCESS) {
-            SAI_TUNNEL_LOG_ERR ("SAI Tunnel Term entry attribute error.");
-
             break;
         }
+        is_key_indexed = true;
 
         /* For vxlan underlay next hop needs to be setup when remote ip
          * is provided in the tunnel termination entry*/
@@ -270,10 +563,6 @@ static sai_status_t dn_sai_tunnel_term_create (sai_object_id_t *tunnel_term_id,
         }
         is_term_set_in_npu = true;
 
-        p_tunnel_term->term_entry_id =
-                           sai_uoid_create (SAI_OBJECT_TYPE_TUNNEL_TERM_TABLE_ENTRY,
-                                            tunnel_term_index);
-
         t_std_error rc = std_rbtree_insert (dn_sai_tunnel_term_tree_handle(),
                                             p_tunnel_term);
         if (rc != STD_ERR_OK) {
@@ -286,13 +575,10 @@ static sai_status_t dn_sai_tunnel_term_create (sai_object_id_t *tunnel_term_id,
             break;
         }
 
-        STD_BIT_ARRAY_CLR (dn_sai_tunnel_term_obj_id_bitmap(), tunnel_term_index);
-
         dn_sai_tunnel_term_add_to_tunnel_list (p_tunnel_term);
 
     } while (0);
 
-    dn_sai_tunnel_unlock();
     if (status != SAI_STATUS_SUCCESS) {
         if(is_term_set_in_npu) {
             sai_tunnel_npu_api_get()->tunnel_term_entry_remove (p_tunnel_term);
@@ -302,6 +588,17 @@ static sai_status_t dn_sai_tunnel_term_create (sai_object_id_t *tunnel_term_id,
             sai_tunnel_encap_nh_teardown(&p_tunnel_term->src_ip, p_tunnel);
         }
 
+        if (is_key_indexed) {
+            dn_sai_tunnel_term_key_index_remove (p_tunnel_term);
+        }
+
+        if (is_id_allocated) {
+            dn_sai_tunnel_term_id_release (p_tunnel_term->term_entry_id);
+        }
+    }
+    dn_sai_tunnel_unlock();
+
+    if (status != SAI_STATUS_SUCCESS) {
         dn_sai_tunnel_term_object_free (p_tunnel_term);
 
         SAI_TUNNEL_LOG_INFO ("SAI Tunnel Termination create error: %d.", status);
@@ -322,6 +619,7 @@ static sai_status_t dn_sai_tunnel_term_remove (sai_object_id_t tunnel_term_id)
     sai_status_t               status = SAI_STATUS_FAILURE;
     dn_sai_tunnel_t            *p_tunnel = NULL;
     dn_sai_tunnel_term_entry_t *p_tunnel_term = NULL;
+    sai_object_id_t             npu_entry_id = SAI_NULL_OBJECT_ID;
     char                        ip_addr_str[SAI_FIB_MAX_BUFSZ];
 
     SAI_TUNNEL_LOG_DEBUG ("Entering SAI Tunnel Termination entry remove.");
@@ -375,8 +673,10 @@ static sai_status_t dn_sai_tunnel_term_remove (sai_object_id_t tunnel_term_id)
                 break;
             }
         }
+        npu_entry_id = dn_sai_tunnel_term_npu_id_get (p_tunnel_term);
+
         /* Remove the tunnel termination entry in NPU */
-        status = sai_tunnel_npu_api_get()->tunnel_term_entry_remove (p_tunnel_term);
+        status = dn_sai_tunnel_term_npu_entry_remove (p_tunnel_term, npu_entry_id);
 
         if (status != SAI_STATUS_SUCCESS) {
             SAI_TUNNEL_LOG_ERR ("SAI Tunnel Termination entry remove failed in NPU.");
@@ -385,8 +685,13 @@ static sai_status_t dn_sai_tunnel_term_remove (sai_object_id_t tunnel_term_id)
             break;
         }
 
-        STD_BIT_ARRAY_SET (dn_sai_tunnel_term_obj_id_bitmap(),
-                           sai_uoid_npu_obj_id_get (tunnel_term_id));
+        dn_sai_tunnel_term_key_index_remove (p_tunnel_term);
+
+        dn_sai_tunnel_term_id_release (tunnel_term_id);
+
+        if (npu_entry_id != tunnel_term_id) {
+            dn_sai_tunnel_term_id_release (npu_entry_id);
+        }
 
         dn_sai_tunnel_term_remove_from_tunnel_list (p_tunnel_term);
 
@@ -402,17 +707,372 @@ static sai_status_t dn_sai_tunnel_term_remove (sai_object_id_t tunnel_term_id)
     return status;
 }
 
+static sai_status_t dn_sai_tunnel_term_set_attr_validate (
+                               const dn_sai_tunnel_term_entry_t *p_tunnel_term,
+                               const sai_attribute_t *attr)
+{
+    dn_sai_tunnel_t *p_tunnel = NULL;
+
+    switch (attr->id) {
+
+        case SAI_TUNNEL_TERM_TABLE_ENTRY_ATTR_VR_ID:
+        case SAI_TUNNEL_TERM_TABLE_ENTRY_ATTR_DST_IP:
+            break;
+
+        case SAI_TUNNEL_TERM_TABLE_ENTRY_ATTR_SRC_IP:
+            if (p_tunnel_term->type != SAI_TUNNEL_TERM_TABLE_ENTRY_TYPE_P2P) {
+
+                SAI_TUNNEL_LOG_ERR ("Source IP can be set only on P2P Tunnel "
+                                    "Term entry.");
+
+                return SAI_STATUS_INVALID_ATTRIBUTE_0;
+            }
+            break;
+
+        case SAI_TUNNEL_TERM_TABLE_ENTRY_ATTR_ACTION_TUNNEL_ID:
+            p_tunnel = dn_sai_tunnel_obj_get (attr->value.oid);
+
+            if ((p_tunnel != NULL) &&
+                (p_tunnel->tunnel_type != p_tunnel_term->tunnel_type)) {
+
+                SAI_TUNNEL_LOG_ERR ("Tunnel 0x%"PRIx64" type %d does not match "
+                                    "Tunnel Term entry tunnel type %d.",
+                                    attr->value.oid, p_tunnel->tunnel_type,
+                                    p_tunnel_term->tunnel_type);
+
+                return SAI_STATUS_INVALID_ATTR_VALUE_0;
+            }
+            break;
+
+        case SAI_TUNNEL_TERM_TABLE_ENTRY_ATTR_TYPE:
+        case SAI_TUNNEL_TERM_TABLE_ENTRY_ATTR_TUNNEL_TYPE:
+            return SAI_STATUS_INVALID_ATTRIBUTE_0;
+
+        default:
+            return SAI_STATUS_UNKNOWN_ATTRIBUTE_0;
+    }
+
+    return SAI_STATUS_SUCCESS;
+}
+
+/*
+ * Programs the updated entry in NPU. When the match key changes the new
+ * entry is added before the old one is removed so that decap traffic for
+ * the old key keeps flowing until the new key is in place. Both entries
+ * are in NPU for a while, so the new one is created under another Id: the
+ * SAI Id if the old entry has a temporary Id, else a new temporary Id from
+ * the allocator. The entry keeps its SAI Id, and the Id it has in NPU is
+ * tracked in the key index. When only the action changes the key is the
+ * same, so the old entry is removed first.
+ */
+static sai_status_t dn_sai_tunnel_term_npu_update (
+                                  dn_sai_tunnel_term_entry_t *p_tunnel_term,
+                                  dn_sai_tunnel_term_entry_t *p_new_term,
+                                  bool is_key_changed)
+{
+    sai_status_t                   status;
+    sai_object_id_t                npu_entry_id;
+    sai_object_id_t                new_npu_entry_id;
+    dn_sai_tunnel_term_key_node_t *p_node = NULL;
+
+    p_node = dn_sai_tunnel_term_key_node_get (p_tunnel_term);
+
+    STD_ASSERT (p_node != NULL);
+
+    npu_entry_id = p_node->npu_entry_id;
+
+    if (is_key_changed) {
+
+        if (npu_entry_id != p_tunnel_term->term_entry_id) {
+            new_npu_entry_id = p_tunnel_term->term_entry_id;
+        } else {
+            new_npu_entry_id = dn_sai_tunnel_term_id_generate ();
+
+            if (new_npu_entry_id == SAI_NULL_OBJECT_ID) {
+
+                SAI_TUNNEL_LOG_ERR ("Failed to allocate temporary Id for Tunnel "
+                                    "Term entry 0x%"PRIx64".",
+                                    p_tunnel_term->term_entry_id);
+
+                return SAI_STATUS_INSUFFICIENT_RESOURCES;
+            }
+        }
+
+        status = dn_sai_tunnel_term_npu_entry_create (p_new_term, new_npu_entry_id);
+
+        if (status == SAI_STATUS_SUCCESS) {
+
+            status = dn_sai_tunnel_term_npu_entry_remove (p_tunnel_term,
+                                                          npu_entry_id);
+
+            if (status != SAI_STATUS_SUCCESS) {
+                dn_sai_tunnel_term_npu_entry_remove (p_new_term, new_npu_entry_id);
+            }
+        }
+
+        /* Release the temporary Id that is not in NPU */
+        if (status == SAI_STATUS_SUCCESS) {
+            p_node->npu_entry_id = new_npu_entry_id;
+
+            if (npu_entry_id != p_tunnel_term->term_entry_id) {
+                dn_sai_tunnel_term_id_release (npu_entry_id);
+            }
+        } else if (new_npu_entry_id != p_tunnel_term->term_entry_id) {
+            dn_sai_tunnel_term_id_release (new_npu_entry_id);
+        }
+
+        return status;
+    }
+
+    status = dn_sai_tunnel_term_npu_entry_remove (p_tunnel_term, npu_entry_id);
+
+    if (status != SAI_STATUS_SUCCESS) {
+        return status;
+    }
+
+    status = dn_sai_tunnel_term_npu_entry_create (p_new_term, npu_entry_id);
+
+    if (status != SAI_STATUS_SUCCESS) {
+
+        if (dn_sai_tunnel_term_npu_entry_create (p_tunnel_term, npu_entry_id)
+            != SAI_STATUS_SUCCESS) {
+            SAI_TUNNEL_LOG_ERR ("Failed to restore Tunnel Term entry 0x%"PRIx64" "
+                                "in NPU.", p_tunnel_term->term_entry_id);
+        }
+    }
+
+    return status;
+}
+
 static sai_status_t dn_sai_tunnel_term_set_attr (sai_object_id_t tunnel_term_id,
                                                  const sai_attribute_t *attr)
 {
-    return SAI_STATUS_NOT_SUPPORTED;
+    sai_status_t                status = SAI_STATUS_FAILURE;
+    dn_sai_tunnel_term_entry_t *p_tunnel_term = NULL;
+    dn_sai_tunnel_term_entry_t *p_dup_term = NULL;
+    dn_sai_tunnel_term_entry_t  new_term;
+    dn_sai_tunnel_t            *p_old_tunnel = NULL;
+    dn_sai_tunnel_t            *p_new_tunnel = NULL;
+    bool                        is_key_changed = false;
+    bool                        is_nh_changed = false;
+    char                        ip_addr_str[SAI_FIB_MAX_BUFSZ];
+
+    STD_ASSERT (attr != NULL);
+
+    SAI_TUNNEL_LOG_DEBUG ("Entering SAI Tunnel Termination entry set.");
+
+    if (!sai_is_obj_id_tunnel_term_entry (tunnel_term_id)) {
+
+        SAI_TUNNEL_LOG_ERR ("OID: 0x%"PRIx64" is not of tunnel term entry object.",
+                            tunnel_term_id);
+
+        return SAI_STATUS_INVALID_OBJECT_TYPE;
+    }
+
+    dn_sai_tunnel_lock();
+
+    do {
+        p_tunnel_term = dn_sai_tunnel_term_entry_get (tunnel_term_id);
+
+        if (p_tunnel_term == NULL) {
+
+            SAI_TUNNEL_LOG_ERR ("Tunnel Term entry not found for OID: 0x%"PRIx64".",
+                                tunnel_term_id);
+
+            status = SAI_STATUS_INVALID_OBJECT_ID;
+            break;
+        }
+
+        status = dn_sai_tunnel_term_set_attr_validate (p_tunnel_term, attr);
+
+        if (status != SAI_STATUS_SUCCESS) {
+
+            SAI_TUNNEL_LOG_ERR ("Attribute Id %d can not be set on Tunnel Term "
+                                "entry 0x%"PRIx64", Error: %d.", attr->id,
+                                tunnel_term_id, status);
+            break;
+        }
+
+        new_term = *p_tunnel_term;
+
+        status = dn_sai_tunnel_term_attr_set (&new_term, 1, attr);
+
+        if (status != SAI_STATUS_SUCCESS) {
+            break;
+        }
+
+        is_key_changed = (attr->id != SAI_TUNNEL_TERM_TABLE_ENTRY_ATTR_ACTION_TUNNEL_ID);
+
+        if (is_key_changed) {
+
+            p_dup_term = dn_sai_tunnel_term_entry_key_lookup (&new_term);
+
+            if (p_dup_term == p_tunnel_term) {
+                /* Same value set again */
+                break;
+            }
+
+            if (p_dup_term != NULL) {
+
+                SAI_TUNNEL_LOG_ERR ("Tunnel Term entry 0x%"PRIx64" has the same "
+                                    "key.", p_dup_term->term_entry_id);
+
+                status = SAI_STATUS_ITEM_ALREADY_EXISTS;
+                break;
+            }
+        } else if (new_term.tunnel_id == p_tunnel_term->tunnel_id) {
+            break;
+        }
+
+        /* VXLAN underlay next hop is keyed on the remote IP and tunnel */
+        is_nh_changed = ((p_tunnel_term->tunnel_type == SAI_TUNNEL_TYPE_VXLAN) &&
+                         ((attr->id == SAI_TUNNEL_TERM_TABLE_ENTRY_ATTR_SRC_IP) ||
+                          (attr->id == SAI_TUNNEL_TERM_TABLE_ENTRY_ATTR_ACTION_TUNNEL_ID)));
+
+        if (is_nh_changed) {
+
+            p_old_tunnel = dn_sai_tunnel_obj_get (p_tunnel_term->tunnel_id);
+            p_new_tunnel = dn_sai_tunnel_obj_get (new_term.tunnel_id);
+
+            status = sai_tunnel_encap_nh_setup (&new_term.src_ip, p_new_tunnel);
+
+            if (status != SAI_STATUS_SUCCESS) {
+                SAI_TUNNEL_LOG_ERR ("Failed to set up VXLAN underlay nexthop for ip"
+                                    " address %s on tunnel id %"PRIx64"",
+                                    sai_ip_addr_to_str(&new_term.src_ip,
+                                    ip_addr_str, sizeof(ip_addr_str)),
+                                    new_term.tunnel_id);
+                break;
+            }
+        }
+
+        status = dn_sai_tunnel_term_npu_update (p_tunnel_term, &new_term,
+                                                is_key_changed);
+
+        if (status != SAI_STATUS_SUCCESS) {
+
+            SAI_TUNNEL_LOG_ERR ("SAI Tunnel Term entry 0x%"PRIx64" update failed "
+                                "in NPU.", tunnel_term_id);
+
+            if (is_nh_changed) {
+                sai_tunnel_encap_nh_teardown (&new_term.src_ip, p_new_tunnel);
+            }
+            break;
+        }
+
+        if (is_nh_changed) {
+            sai_tunnel_encap_nh_teardown (&p_tunnel_term->src_ip, p_old_tunnel);
+        }
+
+        if (is_key_changed) {
+            dn_sai_tunnel_term_key_index_update (p_tunnel_term, &new_term);
+        }
+
+        if (new_term.tunnel_id != p_tunnel_term->tunnel_id) {
+            dn_sai_tunnel_term_remove_from_tunnel_list (p_tunnel_term);
+            p_tunnel_term->tunnel_id = new_term.tunnel_id;
+            dn_sai_tunnel_term_add_to_tunnel_list (p_tunnel_term);
+        }
+
+        p_tunnel_term->vr_id = new_term.vr_id;
+        sai_fib_ip_addr_copy (&p_tunnel_term->dst_ip, &new_term.dst_ip);
+        sai_fib_ip_addr_copy (&p_tunnel_term->src_ip, &new_term.src_ip);
+
+    } while (0);
+
+    dn_sai_tunnel_unlock();
+
+    SAI_TUNNEL_LOG_INFO ("SAI Tunnel Term entry Id 0x%"PRIx64" set attribute Id %d "
+                         "status: %d.", tunnel_term_id, attr->id, status);
+
+    return status;
 }
 
 static sai_status_t dn_sai_tunnel_term_get_attr (sai_object_id_t tunnel_term_id,
                                                  uint32_t attr_count,
                                                  sai_attribute_t *attr_list)
 {
-    return SAI_STATUS_NOT_IMPLEMENTED;
+    sai_status_t                status = SAI_STATUS_FAILURE;
+    dn_sai_tunnel_term_entry_t *p_tunnel_term = NULL;
+    sai_attribute_t            *p_attr = NULL;
+    uint_t                      attr_idx;
+
+    STD_ASSERT (attr_list != NULL);
+
+    if (!sai_is_obj_id_tunnel_term_entry (tunnel_term_id)) {
+
+        SAI_TUNNEL_LOG_ERR ("OID: 0x%"PRIx64" is not of tunnel term entry object.",
+                            tunnel_term_id);
+
+        return SAI_STATUS_INVALID_OBJECT_TYPE;
+    }
+
+    dn_sai_tunnel_lock();
+
+    do {
+        p_tunnel_term = dn_sai_tunnel_term_entry_get (tunnel_term_id);
+
+        if (p_tunnel_term == NULL) {
+
+            SAI_TUNNEL_LOG_ERR ("Tunnel Term entry not found for OID: 0x%"PRIx64".",
+                                tunnel_term_id);
+
+            status = SAI_STATUS_INVALID_OBJECT_ID;
+            break;
+        }
+
+        status = SAI_STATUS_SUCCESS;
+
+        for (attr_idx = 0, p_attr = attr_list; (attr_idx < attr_count);
+             ++attr_idx, ++p_attr) {
+
+            switch (p_attr->id) {
+
+                case SAI_TUNNEL_TERM_TABLE_ENTRY_ATTR_VR_ID:
+                    p_attr->value.oid = p_tunnel_term->vr_id;
+                    break;
+
+                case SAI_TUNNEL_TERM_TABLE_ENTRY_ATTR_TYPE:
+                    p_attr->value.s32 = p_tunnel_term->type;
+                    break;
+
+                case SAI_TUNNEL_TERM_TABLE_ENTRY_ATTR_DST_IP:
+                    sai_fib_ip_addr_copy (&p_attr->value.ipaddr,
+                                          &p_tunnel_term->dst_ip);
+                    break;
+
+                case SAI_TUNNEL_TERM_TABLE_ENTRY_ATTR_SRC_IP:
+                    sai_fib_ip_addr_copy (&p_attr->value.ipaddr,
+                                          &p_tunnel_term->src_ip);
+                    break;
+
+                case SAI_TUNNEL_TERM_TABLE_ENTRY_ATTR_TUNNEL_TYPE:
+                    p_attr->value.s32 = p_tunnel_term->tunnel_type;
+                    break;
+
+                case SAI_TUNNEL_TERM_TABLE_ENTRY_ATTR_ACTION_TUNNEL_ID:
+                    p_attr->value.oid = p_tunnel_term->tunnel_id;
+                    break;
+
+                default:
+                    SAI_TUNNEL_LOG_ERR ("Unknown attr id %d in Tunnel Term entry "
+                                        "0x%"PRIx64" get.", p_attr->id,
+                                        tunnel_term_id);
+
+                    status = sai_get_indexed_ret_val (SAI_STATUS_UNKNOWN_ATTRIBUTE_0,
+                                                      attr_idx);
+                    break;
+            }
+
+            if (status != SAI_STATUS_SUCCESS) {
+                break;
+            }
+        }
+    } while (0);
+
+    dn_sai_tunnel_unlock();
+
+    return status;
 }
 
 void dn_sai_tunnel_term_obj_api_fill (sai_tunnel_api_t *api_table)
@@ -28,6 +28,7 @@
 #include "sai_common_utils.h"
 
 #include "std_mutex_lock.h"
+#include "sai_lock_profile.h"
 #include "std_llist.h"
 #include "std_assert.h"
 #include <string.h>
@@ -54,14 +55,17 @@ dn_sai_udf_global_t *dn_sai_udf_access_global_param (void)
  */
 static std_mutex_lock_create_static_init_fast (sai_udf_lock);
 
+SAI_LOCK_PROFILE_DEFINE (udf_lock_profile, "udf")
+
 void dn_sai_udf_lock ()
 {
-    std_mutex_lock (&sai_udf_lock);
+    sai_profiled_mutex_lock (&sai_udf_lock, &udf_lock_profile,
+                             SAI_LOCK_PROFILE_CALL_SITE ());
 }
 
 void dn_sai_udf_unlock ()
 {
-    std_mutex_unlock (&sai_udf_lock);
+    sai_profiled_mutex_unlock (&sai_udf_lock, &udf_lock_profile);
 }
 
 /**
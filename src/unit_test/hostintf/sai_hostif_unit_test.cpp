@@ -25,6 +25,8 @@ extern "C" {
 #include "sai.h"
 #include "saihostintf.h"
 #include "saitypes.h"
+#include "sai_hostif_api.h"
+#include "sai_hostif_main.h"
 }
 
 
@@ -34,6 +36,7 @@ extern "C" {
 #include <string.h>
 #include <stdio.h>
 #include <inttypes.h>
+#include <time.h>
 
 #define SAI_MAX_PORTS  256
 
@@ -563,6 +566,258 @@ TEST_F(hostIntfInit, send_pkt_pipeline_lookup)
     ASSERT_EQ (rc, SAI_STATUS_SUCCESS);
 }
 
+#define SAI_GTEST_PKT_SEND_COUNT 10000
+
+static double sai_gtest_elapsed_secs (const struct timespec *start,
+                                      const struct timespec *end)
+{
+    return ((end->tv_sec - start->tv_sec) +
+            ((end->tv_nsec - start->tv_nsec) / 1e9));
+}
+
+/*
+ * Compare the per packet send path against the bulk send path which
+ * validates the shared attribute list only once for the whole batch.
+ */
+TEST_F(hostIntfInit, send_pkt_bulk_rate)
+{
+    sai_attribute_t sai_attr[2];
+    sai_status_t rc = SAI_STATUS_FAILURE;
+    struct timespec start, end;
+    double elapsed = 0;
+    unsigned int index = 0;
+    static void *buffer_list[SAI_GTEST_PKT_SEND_COUNT];
+    static sai_size_t buffer_size_list[SAI_GTEST_PKT_SEND_COUNT];
+    static sai_status_t status_list[SAI_GTEST_PKT_SEND_COUNT];
+
+    unsigned char buffer[] =
+    {0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x82, 0x2f,
+     0x2e, 0x42, 0x46, 0x74, 0x08, 0x06, 0x00, 0x01,
+     0x08, 0x00, 0x06, 0x04, 0x00, 0x01, 0x82, 0x2f,
+     0x2e, 0x42, 0x46, 0x74, 0x0a, 0x00, 0x00, 0x01,
+     0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x0a, 0x00,
+     0x00, 0x02, 0x00, 0x00, 0x00, 0x00};
+
+    sai_attr[0].id = SAI_HOSTIF_PACKET_ATTR_EGRESS_PORT_OR_LAG;
+    sai_attr[0].value.oid = port_list[port_count - 1];
+
+    sai_attr[1].id = SAI_HOSTIF_PACKET_ATTR_HOSTIF_TX_TYPE;
+    sai_attr[1].value.s32 = SAI_HOSTIF_TX_TYPE_PIPELINE_BYPASS;
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (index = 0; index < SAI_GTEST_PKT_SEND_COUNT; index++) {
+        rc = sai_hostif_api_table->send_packet(SAI_NULL_OBJECT_ID, buffer,
+                                               sizeof(buffer), 2, &sai_attr[0]);
+        ASSERT_EQ (rc, SAI_STATUS_SUCCESS);
+    }
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    elapsed = sai_gtest_elapsed_secs(&start, &end);
+    printf("Per packet send: %u pkts in %f secs, %.0f pps\n",
+           SAI_GTEST_PKT_SEND_COUNT, elapsed,
+           (elapsed > 0) ? (SAI_GTEST_PKT_SEND_COUNT / elapsed) : 0);
+
+    for (index = 0; index < SAI_GTEST_PKT_SEND_COUNT; index++) {
+        buffer_list[index] = buffer;
+        buffer_size_list[index] = sizeof(buffer);
+        status_list[index] = SAI_STATUS_FAILURE;
+    }
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    rc = sai_hostif_send_packet_bulk(SAI_NULL_OBJECT_ID,
+                                     SAI_GTEST_PKT_SEND_COUNT, buffer_list,
+                                     buffer_size_list, 2, &sai_attr[0],
+                                     status_list);
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    ASSERT_EQ (rc, SAI_STATUS_SUCCESS);
+
+    for (index = 0; index < SAI_GTEST_PKT_SEND_COUNT; index++) {
+        ASSERT_EQ (status_list[index], SAI_STATUS_SUCCESS);
+    }
+
+    elapsed = sai_gtest_elapsed_secs(&start, &end);
+    printf("Bulk packet send: %u pkts in %f secs, %.0f pps\n",
+           SAI_GTEST_PKT_SEND_COUNT, elapsed,
+           (elapsed > 0) ? (SAI_GTEST_PKT_SEND_COUNT / elapsed) : 0);
+}
+
+TEST_F(hostIntfInit, send_pkt_invalid_attr)
+{
+    sai_attribute_t sai_attr[2];
+    sai_status_t rc = SAI_STATUS_FAILURE;
+    unsigned char buffer[64] = {0};
+
+    /* Duplicate attribute */
+    sai_attr[0].id = SAI_HOSTIF_PACKET_ATTR_HOSTIF_TX_TYPE;
+    sai_attr[0].value.s32 = SAI_HOSTIF_TX_TYPE_PIPELINE_LOOKUP;
+    sai_attr[1].id = SAI_HOSTIF_PACKET_ATTR_HOSTIF_TX_TYPE;
+    sai_attr[1].value.s32 = SAI_HOSTIF_TX_TYPE_PIPELINE_LOOKUP;
+
+    rc = sai_hostif_api_table->send_packet(SAI_NULL_OBJECT_ID, buffer,
+                                           sizeof(buffer), 2, &sai_attr[0]);
+    ASSERT_NE (rc, SAI_STATUS_SUCCESS);
+
+    /* Attribute not valid on send */
+    sai_attr[1].id = SAI_HOSTIF_PACKET_ATTR_INGRESS_PORT;
+    sai_attr[1].value.oid = port_list[0];
+
+    rc = sai_hostif_api_table->send_packet(SAI_NULL_OBJECT_ID, buffer,
+                                           sizeof(buffer), 2, &sai_attr[0]);
+    ASSERT_NE (rc, SAI_STATUS_SUCCESS);
+
+    /* Mandatory tx type missing */
+    sai_attr[0].id = SAI_HOSTIF_PACKET_ATTR_EGRESS_PORT_OR_LAG;
+    sai_attr[0].value.oid = port_list[0];
+
+    rc = sai_hostif_api_table->send_packet(SAI_NULL_OBJECT_ID, buffer,
+                                           sizeof(buffer), 1, &sai_attr[0]);
+    ASSERT_EQ (rc, SAI_STATUS_MANDATORY_ATTRIBUTE_MISSING);
+}
+
+/*
+ * Traps inside the direct indexed ranges are looked up by index and follow
+ * trap group changes; ids outside the ranges are not indexed.
+ */
+TEST_F(hostIntfInit, trap_lookup_by_index)
+{
+    sai_status_t rc = SAI_STATUS_FAILURE;
+    sai_object_id_t trap_group_oid = 0;
+    sai_attribute_t attr = {0};
+    dn_sai_trap_node_t *trap_node = NULL;
+    dn_sai_trap_group_node_t *trap_group = NULL;
+    uint_t index = 0;
+
+    ASSERT_TRUE(dn_sai_hostif_trap_index_get(SAI_HOSTIF_TRAP_TYPE_TTL_ERROR,
+                                             &index));
+    EXPECT_LT(index, (uint_t)DN_HOSTIF_MAX_TRAP_INDEX);
+    EXPECT_FALSE(dn_sai_hostif_trap_index_get((sai_hostif_trap_type_t)
+                                              (DN_HOSTIF_TRAP_RANGE_SIZE),
+                                              &index));
+    EXPECT_FALSE(dn_sai_hostif_trap_index_get((sai_hostif_trap_type_t)
+                                              (DN_HOSTIF_TRAP_RANGE_COUNT <<
+                                               DN_HOSTIF_TRAP_RANGE_SHIFT),
+                                              &index));
+
+    rc = sai_test_create_trapgroup(&trap_group_oid, true, SAI_GTEST_CPU_QUEUE_2);
+    ASSERT_EQ (rc, SAI_STATUS_SUCCESS);
+
+    trap_group = dn_sai_hostif_trapgroup_get(trap_group_oid);
+    ASSERT_TRUE(trap_group != NULL);
+    EXPECT_EQ(trap_group->key.trap_group_id, trap_group_oid);
+    EXPECT_EQ(dn_sai_hostif_find_trapgroup_by_queue(SAI_GTEST_CPU_QUEUE_2),
+              trap_group);
+
+    attr.id = SAI_HOSTIF_TRAP_ATTR_PACKET_ACTION;
+    attr.value.s32 = SAI_PACKET_ACTION_TRAP;
+    rc = sai_hostif_api_table->set_trap_attribute(SAI_HOSTIF_TRAP_TYPE_TTL_ERROR, &attr);
+    ASSERT_EQ (rc, SAI_STATUS_SUCCESS);
+
+    attr.id = SAI_HOSTIF_TRAP_ATTR_TRAP_GROUP;
+    attr.value.oid = trap_group_oid;
+    rc = sai_hostif_api_table->set_trap_attribute(SAI_HOSTIF_TRAP_TYPE_TTL_ERROR, &attr);
+    ASSERT_EQ (rc, SAI_STATUS_SUCCESS);
+
+    trap_node = dn_sai_hostif_trap_node_get(SAI_HOSTIF_TRAP_TYPE_TTL_ERROR);
+    ASSERT_TRUE(trap_node != NULL);
+    EXPECT_EQ(trap_node->key.trap_id, SAI_HOSTIF_TRAP_TYPE_TTL_ERROR);
+    EXPECT_EQ(trap_node->trap_group, trap_group_oid);
+
+    /* Moving the trap group to another queue moves the queue index */
+    attr.id = SAI_HOSTIF_TRAP_GROUP_ATTR_QUEUE;
+    attr.value.u32 = SAI_GTEST_CPU_QUEUE_1;
+    rc = sai_hostif_api_table->set_trap_group_attribute(trap_group_oid, &attr);
+    ASSERT_EQ (rc, SAI_STATUS_SUCCESS);
+
+    EXPECT_EQ(dn_sai_hostif_find_trapgroup_by_queue(SAI_GTEST_CPU_QUEUE_1),
+              trap_group);
+    EXPECT_TRUE(dn_sai_hostif_find_trapgroup_by_queue(SAI_GTEST_CPU_QUEUE_2) == NULL);
+
+    attr.id = SAI_HOSTIF_TRAP_ATTR_TRAP_GROUP;
+    attr.value.oid = SAI_NULL_OBJECT_ID;
+    rc = sai_hostif_api_table->set_trap_attribute(SAI_HOSTIF_TRAP_TYPE_TTL_ERROR, &attr);
+    ASSERT_EQ (rc, SAI_STATUS_SUCCESS);
+
+    rc = sai_hostif_api_table->remove_hostif_trap_group(trap_group_oid);
+    ASSERT_EQ (rc, SAI_STATUS_SUCCESS);
+
+    EXPECT_TRUE(dn_sai_hostif_trapgroup_get(trap_group_oid) == NULL);
+    EXPECT_TRUE(dn_sai_hostif_find_trapgroup_by_queue(SAI_GTEST_CPU_QUEUE_1) == NULL);
+}
+
+/*
+ * Received packets are counted per trap and per cpu queue of the trap
+ * group of the trap, and the counters can be read and cleared.
+ */
+TEST_F(hostIntfInit, rx_counters_get_clear)
+{
+    sai_status_t rc = SAI_STATUS_FAILURE;
+    sai_object_id_t trap_group_oid = 0;
+    sai_attribute_t attr = {0};
+    sai_attribute_t pkt_attr[2];
+    uint64_t packets = 0, bytes = 0;
+    const sai_size_t pkt_size = 64;
+    const unsigned int pkt_count = 5;
+    unsigned int index = 0;
+
+    rc = sai_test_create_trapgroup(&trap_group_oid, true, SAI_GTEST_CPU_QUEUE_2);
+    ASSERT_EQ (rc, SAI_STATUS_SUCCESS);
+
+    attr.id = SAI_HOSTIF_TRAP_ATTR_PACKET_ACTION;
+    attr.value.s32 = SAI_PACKET_ACTION_TRAP;
+    rc = sai_hostif_api_table->set_trap_attribute(SAI_HOSTIF_TRAP_TYPE_TTL_ERROR, &attr);
+    ASSERT_EQ (rc, SAI_STATUS_SUCCESS);
+
+    attr.id = SAI_HOSTIF_TRAP_ATTR_TRAP_GROUP;
+    attr.value.oid = trap_group_oid;
+    rc = sai_hostif_api_table->set_trap_attribute(SAI_HOSTIF_TRAP_TYPE_TTL_ERROR, &attr);
+    ASSERT_EQ (rc, SAI_STATUS_SUCCESS);
+
+    sai_hostif_counters_clear();
+
+    memset(pkt_attr, 0, sizeof(pkt_attr));
+    pkt_attr[0].id = SAI_HOSTIF_PACKET_ATTR_INGRESS_PORT;
+    pkt_attr[0].value.oid = port_list[0];
+    pkt_attr[1].id = SAI_HOSTIF_PACKET_ATTR_HOSTIF_TRAP_ID;
+    pkt_attr[1].value.oid = SAI_HOSTIF_TRAP_TYPE_TTL_ERROR;
+
+    for (index = 0; index < pkt_count; index++) {
+        dn_sai_hostif_rx_pkt_counters_update(pkt_size, 2, pkt_attr);
+    }
+
+    rc = sai_hostif_trap_counters_get(SAI_HOSTIF_TRAP_TYPE_TTL_ERROR,
+                                      &packets, &bytes);
+    ASSERT_EQ (rc, SAI_STATUS_SUCCESS);
+    EXPECT_EQ(packets, pkt_count);
+    EXPECT_EQ(bytes, pkt_count * pkt_size);
+
+    rc = sai_hostif_cpu_queue_counters_get(SAI_GTEST_CPU_QUEUE_2, &packets, &bytes);
+    ASSERT_EQ (rc, SAI_STATUS_SUCCESS);
+    EXPECT_EQ(packets, pkt_count);
+    EXPECT_EQ(bytes, pkt_count * pkt_size);
+
+    rc = sai_hostif_cpu_queue_counters_get(DN_HOSTIF_MAX_CPU_QUEUES, &packets, &bytes);
+    EXPECT_EQ (rc, SAI_STATUS_INVALID_PARAMETER);
+
+    sai_hostif_counters_clear();
+
+    rc = sai_hostif_trap_counters_get(SAI_HOSTIF_TRAP_TYPE_TTL_ERROR,
+                                      &packets, &bytes);
+    ASSERT_EQ (rc, SAI_STATUS_SUCCESS);
+    EXPECT_EQ(packets, 0);
+    EXPECT_EQ(bytes, 0);
+
+    rc = sai_hostif_cpu_queue_counters_get(SAI_GTEST_CPU_QUEUE_2, &packets, &bytes);
+    ASSERT_EQ (rc, SAI_STATUS_SUCCESS);
+    EXPECT_EQ(packets, 0);
+    EXPECT_EQ(bytes, 0);
+
+    attr.id = SAI_HOSTIF_TRAP_ATTR_TRAP_GROUP;
+    attr.value.oid = SAI_NULL_OBJECT_ID;
+    rc = sai_hostif_api_table->set_trap_attribute(SAI_HOSTIF_TRAP_TYPE_TTL_ERROR, &attr);
+    ASSERT_EQ (rc, SAI_STATUS_SUCCESS);
+
+    rc = sai_hostif_api_table->remove_hostif_trap_group(trap_group_oid);
+    ASSERT_EQ (rc, SAI_STATUS_SUCCESS);
+}
 
 int main(int argc, char **argv) {
     ::testing::InitGoogleTest(&argc, argv);
@@ -111,6 +111,73 @@ TEST_F(mirrorTest, span_set) {
     free (sessions);
 }
 
+/*
+ * Attach and detach a session to a list of ports in one call with per port
+ * status.
+ */
+TEST_F(mirrorTest, span_port_list_add) {
+    sai_status_t sai_rc = SAI_STATUS_SUCCESS;
+    sai_object_id_t  session_id = 0;
+    sai_attribute_t attr[SAI_LOCAL_SPAN_NO_OF_MANDAT_ATTRIB + 1] = {0};
+    sai_object_id_t ports[3] = {sai_mirror_first_port, sai_mirror_second_port,
+                                sai_mirror_third_port};
+    sai_status_t port_statuses[3];
+    sai_object_list_t port_list;
+    sai_object_list_t obj_list;
+
+    attr[0].id =  SAI_MIRROR_SESSION_ATTR_MONITOR_PORT;
+    attr[0].value.oid = sai_monitor_port;
+    attr[1].id =  SAI_MIRROR_SESSION_ATTR_TYPE;
+    attr[1].value.s32 = SAI_MIRROR_SESSION_TYPE_LOCAL;
+
+    sai_rc = sai_test_mirror_session_create (&session_id, SAI_LOCAL_SPAN_NO_OF_MANDAT_ATTRIB, attr);
+
+    EXPECT_EQ (SAI_STATUS_SUCCESS, sai_rc);
+
+    port_list.count = 3;
+    port_list.list = ports;
+    sai_rc = sai_mirror_session_port_list_add (session_id, &port_list,
+                                               SAI_MIRROR_DIR_INGRESS, port_statuses);
+
+    EXPECT_EQ (SAI_STATUS_SUCCESS, sai_rc);
+    EXPECT_EQ (SAI_STATUS_SUCCESS, port_statuses[0]);
+    EXPECT_EQ (SAI_STATUS_SUCCESS, port_statuses[1]);
+    EXPECT_EQ (SAI_STATUS_SUCCESS, port_statuses[2]);
+
+    /* Session cannot be removed while ports are attached */
+    EXPECT_NE (SAI_STATUS_SUCCESS, sai_test_mirror_session_destroy (session_id));
+
+    /* Port already attached through the list fails, the rest succeed */
+    ports[1] = sai_invalid_port;
+    sai_rc = sai_mirror_session_port_list_add (session_id, &port_list,
+                                               SAI_MIRROR_DIR_INGRESS, port_statuses);
+
+    EXPECT_NE (SAI_STATUS_SUCCESS, sai_rc);
+    EXPECT_EQ (SAI_STATUS_ITEM_ALREADY_EXISTS, port_statuses[0]);
+    EXPECT_NE (SAI_STATUS_SUCCESS, port_statuses[1]);
+    EXPECT_EQ (SAI_STATUS_ITEM_ALREADY_EXISTS, port_statuses[2]);
+
+    /* Port attribute update detaches the session from the first port */
+    obj_list.count = 0;
+    obj_list.list = NULL;
+    sai_rc = sai_test_mirror_session_ingress_port_add (sai_mirror_first_port, &obj_list);
+
+    EXPECT_EQ (SAI_STATUS_SUCCESS, sai_rc);
+
+    ports[1] = sai_mirror_second_port;
+    sai_rc = sai_mirror_session_port_list_remove (session_id, &port_list,
+                                                  SAI_MIRROR_DIR_INGRESS, port_statuses);
+
+    EXPECT_NE (SAI_STATUS_SUCCESS, sai_rc);
+    EXPECT_EQ (SAI_STATUS_ITEM_NOT_FOUND, port_statuses[0]);
+    EXPECT_EQ (SAI_STATUS_SUCCESS, port_statuses[1]);
+    EXPECT_EQ (SAI_STATUS_SUCCESS, port_statuses[2]);
+
+    sai_rc = sai_test_mirror_session_destroy (session_id);
+
+    EXPECT_EQ (SAI_STATUS_SUCCESS, sai_rc);
+}
+
 TEST_F(mirrorTest, span_lag_set) {
     sai_status_t sai_rc = SAI_STATUS_SUCCESS;
     sai_object_id_t  session_id = 0;
@@ -227,6 +227,76 @@ TEST_F(policer, storm_control)
     ASSERT_EQ(SAI_STATUS_SUCCESS,sai_policer_api_table->remove_policer(policer_id));
 }
 
+/*
+ * Share storm control policers across ports. Move a port between policers
+ * and update the rate of a policer bound to a port set.
+ */
+TEST_F(policer, storm_control_shared_ports)
+{
+    sai_attribute_t new_attr_list[3];
+    sai_attribute_t set_attr;
+    sai_object_id_t policer_id[2] = {SAI_NULL_OBJECT_ID, SAI_NULL_OBJECT_ID};
+    const unsigned int port_count = 4;
+    unsigned int attr_count = 0;
+    unsigned int idx = 0;
+
+    new_attr_list[attr_count].id = SAI_POLICER_ATTR_METER_TYPE;
+    new_attr_list[attr_count].value.s32 = 0;
+    attr_count ++;
+
+    new_attr_list[attr_count].id = SAI_POLICER_ATTR_MODE;
+    new_attr_list[attr_count].value.s32 = SAI_POLICER_MODE_STORM_CONTROL ;
+    attr_count ++;
+
+    new_attr_list[attr_count].id = SAI_POLICER_ATTR_PIR;
+    new_attr_list[attr_count].value.u64 = 200;
+    attr_count ++;
+
+    for(idx = 0; idx < 2; idx ++){
+        ASSERT_EQ(SAI_STATUS_SUCCESS, sai_policer_api_table->create_policer
+                  (&policer_id[idx], switch_id, attr_count,
+                   (const sai_attribute_t *)new_attr_list));
+    }
+
+    set_attr.id = SAI_PORT_ATTR_BROADCAST_STORM_CONTROL_POLICER_ID;
+    set_attr.value.oid = policer_id[0];
+
+    for(idx = 0; idx < port_count; idx ++){
+        ASSERT_EQ(SAI_STATUS_SUCCESS,sai_port_api_table->set_port_attribute
+                  (sai_qos_port_id_get(idx), (const sai_attribute_t *)&set_attr));
+    }
+
+    set_attr.id = SAI_POLICER_ATTR_PIR;
+    set_attr.value.u64 = 400;
+    ASSERT_EQ(SAI_STATUS_SUCCESS,sai_policer_api_table->set_policer_attribute
+              (policer_id[0], (const sai_attribute_t *)&set_attr));
+
+    /* Move port 0 to the second policer */
+    set_attr.id = SAI_PORT_ATTR_BROADCAST_STORM_CONTROL_POLICER_ID;
+    set_attr.value.oid = policer_id[1];
+    ASSERT_EQ(SAI_STATUS_SUCCESS,sai_port_api_table->set_port_attribute
+              (sai_qos_port_id_get(0), (const sai_attribute_t *)&set_attr));
+
+    ASSERT_EQ(SAI_STATUS_OBJECT_IN_USE,sai_policer_api_table->remove_policer(policer_id[0]));
+    ASSERT_EQ(SAI_STATUS_OBJECT_IN_USE,sai_policer_api_table->remove_policer(policer_id[1]));
+
+    set_attr.value.oid = SAI_NULL_OBJECT_ID;
+
+    ASSERT_EQ(SAI_STATUS_SUCCESS,sai_port_api_table->set_port_attribute
+              (sai_qos_port_id_get(0), (const sai_attribute_t *)&set_attr));
+
+    ASSERT_EQ(SAI_STATUS_SUCCESS,sai_policer_api_table->remove_policer(policer_id[1]));
+
+    for(idx = 1; idx < port_count; idx ++){
+        ASSERT_EQ(SAI_STATUS_OBJECT_IN_USE,sai_policer_api_table->remove_policer(policer_id[0]));
+
+        ASSERT_EQ(SAI_STATUS_SUCCESS,sai_port_api_table->set_port_attribute
+                  (sai_qos_port_id_get(idx), (const sai_attribute_t *)&set_attr));
+    }
+
+    ASSERT_EQ(SAI_STATUS_SUCCESS,sai_policer_api_table->remove_policer(policer_id[0]));
+}
+
 /*
  * Invalid attribute tests for storm control policer.
  */
@@ -28,6 +28,7 @@
 
 extern "C" {
 #include "sai_qos_unit_test_utils.h"
+#include "sai_qos_api_utils.h"
 #include "sai.h"
 #include "saibuffer.h"
 #include "saiport.h"
@@ -1582,6 +1583,181 @@ TEST_F(qos_buffer, queue_buffer_profile_replace_test)
     ASSERT_EQ (SAI_STATUS_SUCCESS, sai_buffer_api_table->remove_buffer_pool (pool_id[3]));
 }
 
+TEST_F(qos_buffer, buffer_profile_pg_bulk_test)
+{
+    sai_attribute_t get_attr[1];
+    sai_object_id_t profile_id[2] = {0};
+    sai_object_id_t pool_id_1 = 0;
+    sai_object_id_t pg_list[4];
+    sai_object_id_t profile_list[4];
+    unsigned int shared_size = sai_buffer_pool_test_size_1 * MAX_SWITCH_TILES;
+    unsigned int cur_shared_size = 0;
+    unsigned int idx = 0;
+
+    ASSERT_EQ(SAI_STATUS_SUCCESS, sai_create_buffer_pool(sai_buffer_api_table, &pool_id_1,
+              sai_buffer_pool_test_size_1, SAI_BUFFER_POOL_TYPE_INGRESS, SAI_BUFFER_POOL_THRESHOLD_MODE_DYNAMIC));
+
+    ASSERT_EQ(SAI_STATUS_SUCCESS, sai_create_buffer_profile(sai_buffer_api_table, &profile_id[0],
+                                  0x6b ,pool_id_1, sai_buffer_profile_test_size_2, 0, 1, 0,
+                                  sai_buffer_profile_test_size_1, sai_buffer_profile_test_size_1));
+
+    for (idx = 0; idx < 4; idx++) {
+        ASSERT_EQ(SAI_STATUS_SUCCESS, sai_qos_buffer_get_first_pg(sai_port_api_table,
+                                      sai_qos_port_id_get (idx), &pg_list[idx]));
+        profile_list[idx] = profile_id[0];
+    }
+
+    /** Attach the profile to all the PGs in one batch */
+    ASSERT_EQ (SAI_STATUS_SUCCESS, sai_qos_buffer_profile_bulk_apply (4, pg_list, profile_list));
+
+    memset(get_attr, 0, sizeof(get_attr));
+    get_attr[0].id = SAI_BUFFER_POOL_ATTR_SHARED_SIZE;
+    ASSERT_EQ (SAI_STATUS_SUCCESS,
+               sai_buffer_api_table->get_buffer_pool_attr (pool_id_1, 1, get_attr));
+    cur_shared_size = shared_size -
+        (4 * (sai_buffer_profile_test_size_2 + sai_buffer_profile_test_size_1));
+    EXPECT_EQ (get_attr[0].value.u32, cur_shared_size);
+
+    /** Each PG alone fits the pool but the whole batch does not */
+    ASSERT_EQ(SAI_STATUS_SUCCESS, sai_create_buffer_profile(sai_buffer_api_table, &profile_id[1],
+                                  0x6b ,pool_id_1, (cur_shared_size / 2) + sai_buffer_profile_test_size_2,
+                                  0, 1, 0, sai_buffer_profile_test_size_1,
+                                  sai_buffer_profile_test_size_1));
+
+    for (idx = 0; idx < 4; idx++) {
+        profile_list[idx] = profile_id[1];
+    }
+    ASSERT_EQ (SAI_STATUS_INSUFFICIENT_RESOURCES,
+               sai_qos_buffer_profile_bulk_apply (4, pg_list, profile_list));
+
+    get_attr[0].id = SAI_BUFFER_POOL_ATTR_SHARED_SIZE;
+    ASSERT_EQ (SAI_STATUS_SUCCESS,
+               sai_buffer_api_table->get_buffer_pool_attr (pool_id_1, 1, get_attr));
+    EXPECT_EQ (get_attr[0].value.u32, cur_shared_size);
+
+    for (idx = 0; idx < 4; idx++) {
+        get_attr[0].id = SAI_INGRESS_PRIORITY_GROUP_ATTR_BUFFER_PROFILE;
+        ASSERT_EQ (SAI_STATUS_SUCCESS, sai_buffer_api_table->
+                   get_ingress_priority_group_attr (pg_list[idx], 1, get_attr));
+        EXPECT_EQ (get_attr[0].value.oid, profile_id[0]);
+    }
+
+    /** Detach all the PGs in one batch */
+    for (idx = 0; idx < 4; idx++) {
+        profile_list[idx] = SAI_NULL_OBJECT_ID;
+    }
+    ASSERT_EQ (SAI_STATUS_SUCCESS, sai_qos_buffer_profile_bulk_apply (4, pg_list, profile_list));
+
+    get_attr[0].id = SAI_BUFFER_POOL_ATTR_SHARED_SIZE;
+    ASSERT_EQ (SAI_STATUS_SUCCESS,
+               sai_buffer_api_table->get_buffer_pool_attr (pool_id_1, 1, get_attr));
+    EXPECT_EQ (get_attr[0].value.u32, shared_size);
+
+    ASSERT_EQ (SAI_STATUS_SUCCESS, sai_buffer_api_table->remove_buffer_profile (profile_id[0]));
+    ASSERT_EQ (SAI_STATUS_SUCCESS, sai_buffer_api_table->remove_buffer_profile (profile_id[1]));
+    ASSERT_EQ (SAI_STATUS_SUCCESS, sai_buffer_api_table->remove_buffer_pool (pool_id_1));
+}
+
+TEST_F(qos_buffer, buffer_profile_bulk_create_set_remove)
+{
+    sai_attribute_t create_attr[3];
+    sai_attribute_t set_attr[3];
+    sai_attribute_t get_attr[1];
+    const sai_attribute_t *create_attr_list[2];
+    uint32_t create_attr_count[2];
+    sai_object_id_t profile_id[2] = {SAI_NULL_OBJECT_ID, SAI_NULL_OBJECT_ID};
+    sai_object_id_t object_id[3];
+    sai_status_t statuses[3];
+    sai_object_id_t pool_id = 0;
+
+    ASSERT_EQ(SAI_STATUS_SUCCESS,
+              sai_create_buffer_pool(sai_buffer_api_table, &pool_id, sai_buffer_pool_test_size_1,
+                                     SAI_BUFFER_POOL_TYPE_EGRESS, SAI_BUFFER_POOL_THRESHOLD_MODE_STATIC));
+
+    create_attr[0].id = SAI_BUFFER_PROFILE_ATTR_POOL_ID;
+    create_attr[0].value.oid = pool_id;
+    create_attr[1].id = SAI_BUFFER_PROFILE_ATTR_BUFFER_SIZE;
+    create_attr[1].value.u32 = sai_buffer_profile_test_size_1;
+    create_attr[2].id = SAI_BUFFER_PROFILE_ATTR_SHARED_STATIC_TH;
+    create_attr[2].value.u32 = sai_buffer_profile_test_size_3;
+
+    /** A profile missing mandatory attributes stops the batch */
+    create_attr_count[0] = 1;
+    create_attr_list[0] = create_attr;
+    create_attr_count[1] = 3;
+    create_attr_list[1] = create_attr;
+
+    ASSERT_EQ (SAI_STATUS_FAILURE, sai_qos_buffer_profile_bulk_create
+               (switch_id, 2, create_attr_count, create_attr_list,
+                DN_SAI_QOS_BULK_OP_ERROR_MODE_STOP_ON_ERROR, profile_id, statuses));
+    EXPECT_EQ (SAI_STATUS_MANDATORY_ATTRIBUTE_MISSING, statuses[0]);
+    EXPECT_EQ (SAI_QOS_BULK_STATUS_NOT_EXECUTED, statuses[1]);
+
+    create_attr_count[0] = 3;
+
+    ASSERT_EQ (SAI_STATUS_SUCCESS, sai_qos_buffer_profile_bulk_create
+               (switch_id, 2, create_attr_count, create_attr_list,
+                DN_SAI_QOS_BULK_OP_ERROR_MODE_STOP_ON_ERROR, profile_id, statuses));
+    EXPECT_EQ (SAI_STATUS_SUCCESS, statuses[0]);
+    EXPECT_EQ (SAI_STATUS_SUCCESS, statuses[1]);
+
+    /** Objects after the failed set keep their threshold */
+    object_id[0] = profile_id[0];
+    object_id[1] = SAI_NULL_OBJECT_ID;
+    object_id[2] = profile_id[1];
+    set_attr[0].id = SAI_BUFFER_PROFILE_ATTR_SHARED_STATIC_TH;
+    set_attr[0].value.u32 = sai_buffer_profile_test_size_4;
+    set_attr[1] = set_attr[0];
+    set_attr[2] = set_attr[0];
+
+    ASSERT_EQ (SAI_STATUS_FAILURE, sai_qos_buffer_profile_bulk_set
+               (3, object_id, set_attr,
+                DN_SAI_QOS_BULK_OP_ERROR_MODE_STOP_ON_ERROR, statuses));
+    EXPECT_EQ (SAI_STATUS_SUCCESS, statuses[0]);
+    EXPECT_NE (SAI_STATUS_SUCCESS, statuses[1]);
+    EXPECT_EQ (SAI_QOS_BULK_STATUS_NOT_EXECUTED, statuses[2]);
+
+    get_attr[0].id = SAI_BUFFER_PROFILE_ATTR_SHARED_STATIC_TH;
+    ASSERT_EQ (SAI_STATUS_SUCCESS,
+               sai_buffer_api_table->get_buffer_profile_attr (profile_id[0], 1, get_attr));
+    EXPECT_EQ (get_attr[0].value.u32, sai_buffer_profile_test_size_4);
+
+    ASSERT_EQ (SAI_STATUS_SUCCESS,
+               sai_buffer_api_table->get_buffer_profile_attr (profile_id[1], 1, get_attr));
+    EXPECT_EQ (get_attr[0].value.u32, sai_buffer_profile_test_size_3);
+
+    /** Ignore error sets the objects after the failure */
+    ASSERT_EQ (SAI_STATUS_FAILURE, sai_qos_buffer_profile_bulk_set
+               (3, object_id, set_attr,
+                DN_SAI_QOS_BULK_OP_ERROR_MODE_IGNORE_ERROR, statuses));
+    EXPECT_EQ (SAI_STATUS_SUCCESS, statuses[0]);
+    EXPECT_NE (SAI_STATUS_SUCCESS, statuses[1]);
+    EXPECT_EQ (SAI_STATUS_SUCCESS, statuses[2]);
+
+    ASSERT_EQ (SAI_STATUS_SUCCESS,
+               sai_buffer_api_table->get_buffer_profile_attr (profile_id[1], 1, get_attr));
+    EXPECT_EQ (get_attr[0].value.u32, sai_buffer_profile_test_size_4);
+
+    /** Stop on error leaves the profile after the failure in place */
+    object_id[0] = profile_id[0];
+    object_id[1] = profile_id[0];
+    object_id[2] = profile_id[1];
+
+    ASSERT_EQ (SAI_STATUS_FAILURE, sai_qos_buffer_profile_bulk_remove
+               (3, object_id, DN_SAI_QOS_BULK_OP_ERROR_MODE_STOP_ON_ERROR, statuses));
+    EXPECT_EQ (SAI_STATUS_SUCCESS, statuses[0]);
+    EXPECT_NE (SAI_STATUS_SUCCESS, statuses[1]);
+    EXPECT_EQ (SAI_QOS_BULK_STATUS_NOT_EXECUTED, statuses[2]);
+
+    ASSERT_EQ (SAI_STATUS_SUCCESS,
+               sai_buffer_api_table->get_buffer_profile_attr (profile_id[1], 1, get_attr));
+
+    ASSERT_EQ (SAI_STATUS_SUCCESS, sai_qos_buffer_profile_bulk_remove
+               (1, &profile_id[1], DN_SAI_QOS_BULK_OP_ERROR_MODE_IGNORE_ERROR, statuses));
+
+    ASSERT_EQ (SAI_STATUS_SUCCESS, sai_buffer_api_table->remove_buffer_pool (pool_id));
+}
+
 TEST_F (qos_buffer, ingress_buffer_pool_stats_get)
 {
     sai_status_t     sai_rc = SAI_STATUS_SUCCESS;
@@ -3086,3 +3262,54 @@ TEST_F(qos_buffer, qos_ing_egr_admn_ctrl_pfc_test)
 
 
 }
+
+TEST_F (qos_buffer, watermark_poll_snapshot)
+{
+    sai_qos_watermark_snapshot_t snapshot;
+    uint64_t     sequence = 0;
+    unsigned int type = 0;
+    unsigned int list_size [SAI_QOS_WATERMARK_OBJ_TYPE_MAX];
+
+    memset (&snapshot, 0, sizeof (snapshot));
+
+    ASSERT_EQ (SAI_STATUS_INVALID_PARAMETER, sai_qos_watermark_poll_start (0));
+    ASSERT_EQ (SAI_STATUS_SUCCESS, sai_qos_watermark_poll_start (100));
+
+    usleep (500 * 1000);
+
+    /* Empty lists report the entry counts of the snapshot */
+    ASSERT_EQ (SAI_STATUS_BUFFER_OVERFLOW, sai_qos_watermark_snapshot_read (&snapshot));
+    EXPECT_NE (0u, snapshot.count [SAI_QOS_WATERMARK_OBJ_QUEUE]);
+
+    for (type = 0; type < SAI_QOS_WATERMARK_OBJ_TYPE_MAX; type++) {
+        /* Room for objects created in between */
+        list_size [type] = snapshot.count [type] + 1;
+        snapshot.count [type] = list_size [type];
+        snapshot.list [type] = (sai_qos_watermark_entry_t *)
+            calloc (list_size [type], sizeof (sai_qos_watermark_entry_t));
+        ASSERT_TRUE (snapshot.list [type] != NULL);
+    }
+
+    ASSERT_EQ (SAI_STATUS_SUCCESS, sai_qos_watermark_snapshot_read (&snapshot));
+    EXPECT_NE (0u, snapshot.sequence);
+    EXPECT_TRUE (snapshot.list [SAI_QOS_WATERMARK_OBJ_QUEUE][0].object_id
+                 != SAI_NULL_OBJECT_ID);
+
+    sequence = snapshot.sequence;
+
+    ASSERT_EQ (SAI_STATUS_SUCCESS, sai_qos_watermark_poll_stop ());
+
+    for (type = 0; type < SAI_QOS_WATERMARK_OBJ_TYPE_MAX; type++) {
+        snapshot.count [type] = list_size [type];
+    }
+
+    usleep (300 * 1000);
+
+    /* The last snapshot stays readable once polling stops */
+    ASSERT_EQ (SAI_STATUS_SUCCESS, sai_qos_watermark_snapshot_read (&snapshot));
+    EXPECT_GE (snapshot.sequence, sequence);
+
+    for (type = 0; type < SAI_QOS_WATERMARK_OBJ_TYPE_MAX; type++) {
+        free (snapshot.list [type]);
+    }
+}
@@ -30,6 +30,7 @@ extern "C" {
 #include "sai_qos_unit_test_utils.h"
 #include "sai.h"
 #include "saiqosmaps.h"
+#include "sai_qos_api_utils.h"
 #include <inttypes.h>
 }
 
@@ -2434,3 +2435,189 @@ TEST_F(qosMap, pfc_pri_to_queue_map_test)
               sai_qos_map_api_table->get_qos_map_attribute
               (map_id, 1, &get_attr));
 }
+
+static void sai_qos_map_dscp_list_fill (sai_qos_map_list_t *p_map_list,
+                                        unsigned int tc)
+{
+    p_map_list->list[0].key.dscp = 10;
+    p_map_list->list[0].value.tc = tc;
+    p_map_list->list[1].key.dscp = 11;
+    p_map_list->list[1].value.tc = 6;
+}
+
+static unsigned int sai_qos_map_dscp_tc_get (sai_qos_map_list_t *p_map_list,
+                                             unsigned int dscp)
+{
+    unsigned int loop_idx = 0;
+
+    for (loop_idx = 0; loop_idx < p_map_list->count; loop_idx++) {
+        if (p_map_list->list[loop_idx].key.dscp == dscp) {
+            return p_map_list->list[loop_idx].value.tc;
+        }
+    }
+    return 0;
+}
+
+/*
+ * Maps with the same contents share one hardware profile. A shared map
+ * that is modified gets its own profile and shares again once the
+ * contents match.
+ */
+TEST_F(qosMap, identical_maps_share_profile)
+{
+    sai_attribute_t attr_list[2];
+    sai_attribute_t set_attr;
+    sai_attribute_t get_attr;
+    sai_qos_map_list_t map_list;
+    sai_object_id_t map_id = 0;
+    sai_object_id_t map_id1 = 0;
+    sai_qos_map_t map_entries[2];
+    sai_qos_map_t get_entries[64];
+
+    memset (map_entries, 0, sizeof (map_entries));
+    map_list.count = 2;
+    map_list.list = map_entries;
+    sai_qos_map_dscp_list_fill (&map_list, 5);
+
+    attr_list[0].id = SAI_QOS_MAP_ATTR_TYPE;
+    attr_list[0].value.s32 = SAI_QOS_MAP_TYPE_DSCP_TO_TC;
+    attr_list[1].id = SAI_QOS_MAP_ATTR_MAP_TO_VALUE_LIST;
+    attr_list[1].value.qosmap = map_list;
+
+    ASSERT_EQ(SAI_STATUS_SUCCESS, sai_qos_map_api_table->create_qos_map
+              (&map_id, switch_id, 2, (const sai_attribute_t *)attr_list));
+    ASSERT_EQ(SAI_STATUS_SUCCESS, sai_qos_map_api_table->create_qos_map
+              (&map_id1, switch_id, 2, (const sai_attribute_t *)attr_list));
+
+    EXPECT_NE(map_id, map_id1);
+
+    if (sai_qos_map_profile_ref_count_get (map_id) == 0) {
+        LOG_PRINT("Map type is programmed per port, profiles not shared\r\n");
+    } else {
+        EXPECT_EQ(2u, sai_qos_map_profile_ref_count_get (map_id));
+        EXPECT_EQ(sai_qos_map_npu_id_get (map_id), sai_qos_map_npu_id_get (map_id1));
+    }
+
+    set_attr.id = SAI_PORT_ATTR_QOS_DSCP_TO_TC_MAP;
+    set_attr.value.oid = map_id1;
+    ASSERT_EQ(SAI_STATUS_SUCCESS,sai_port_api_table->set_port_attribute
+              (sai_qos_port_id_get(test_port_id_1), (const sai_attribute_t *)&set_attr));
+
+    /* Copy on write of the shared profile */
+    sai_qos_map_dscp_list_fill (&map_list, 4);
+    set_attr.id = SAI_QOS_MAP_ATTR_MAP_TO_VALUE_LIST;
+    set_attr.value.qosmap = map_list;
+    ASSERT_EQ(SAI_STATUS_SUCCESS, sai_qos_map_api_table->set_qos_map_attribute
+              (map_id1, (const sai_attribute_t *)&set_attr));
+
+    if (sai_qos_map_profile_ref_count_get (map_id) != 0) {
+        EXPECT_EQ(1u, sai_qos_map_profile_ref_count_get (map_id));
+        EXPECT_EQ(1u, sai_qos_map_profile_ref_count_get (map_id1));
+        EXPECT_NE(sai_qos_map_npu_id_get (map_id), sai_qos_map_npu_id_get (map_id1));
+    }
+
+    get_attr.id = SAI_QOS_MAP_ATTR_MAP_TO_VALUE_LIST;
+    get_attr.value.qosmap.count = 64;
+    get_attr.value.qosmap.list = get_entries;
+    ASSERT_EQ(SAI_STATUS_SUCCESS, sai_qos_map_api_table->get_qos_map_attribute
+              (map_id, 1, &get_attr));
+    EXPECT_EQ(5u, sai_qos_map_dscp_tc_get (&get_attr.value.qosmap, 10));
+
+    get_attr.value.qosmap.count = 64;
+    ASSERT_EQ(SAI_STATUS_SUCCESS, sai_qos_map_api_table->get_qos_map_attribute
+              (map_id1, 1, &get_attr));
+    EXPECT_EQ(4u, sai_qos_map_dscp_tc_get (&get_attr.value.qosmap, 10));
+
+    /* Matching contents again shares the profile again */
+    sai_qos_map_dscp_list_fill (&map_list, 5);
+    set_attr.value.qosmap = map_list;
+    ASSERT_EQ(SAI_STATUS_SUCCESS, sai_qos_map_api_table->set_qos_map_attribute
+              (map_id1, (const sai_attribute_t *)&set_attr));
+
+    if (sai_qos_map_profile_ref_count_get (map_id) != 0) {
+        EXPECT_EQ(2u, sai_qos_map_profile_ref_count_get (map_id1));
+        EXPECT_EQ(sai_qos_map_npu_id_get (map_id), sai_qos_map_npu_id_get (map_id1));
+    }
+
+    set_attr.id = SAI_PORT_ATTR_QOS_DSCP_TO_TC_MAP;
+    set_attr.value.oid = SAI_NULL_OBJECT_ID;
+    ASSERT_EQ(SAI_STATUS_SUCCESS,sai_port_api_table->set_port_attribute
+              (sai_qos_port_id_get(test_port_id_1), (const sai_attribute_t *)&set_attr));
+
+    ASSERT_EQ(SAI_STATUS_SUCCESS, sai_qos_map_api_table->remove_qos_map (map_id));
+
+    if (sai_qos_map_profile_ref_count_get (map_id1) != 0) {
+        EXPECT_EQ(1u, sai_qos_map_profile_ref_count_get (map_id1));
+    }
+
+    ASSERT_EQ(SAI_STATUS_SUCCESS, sai_qos_map_api_table->remove_qos_map (map_id1));
+}
+
+/*
+ * Setting map entries to the values they already have is a no-op and
+ * only the changed entries differ after a partial update.
+ */
+TEST_F(qosMap, map_set_unchanged_entries)
+{
+    sai_attribute_t attr_list[2];
+    sai_attribute_t set_attr;
+    sai_attribute_t get_attr;
+    sai_qos_map_list_t map_list;
+    sai_object_id_t map_id = 0;
+    sai_qos_map_t map_entries[2];
+    sai_qos_map_t get_entries[64];
+    uint_t npu_update_count = 0;
+    uint_t port_update_count = 0;
+
+    memset (map_entries, 0, sizeof (map_entries));
+    map_list.count = 2;
+    map_list.list = map_entries;
+    sai_qos_map_dscp_list_fill (&map_list, 3);
+
+    attr_list[0].id = SAI_QOS_MAP_ATTR_TYPE;
+    attr_list[0].value.s32 = SAI_QOS_MAP_TYPE_DSCP_TO_TC;
+    attr_list[1].id = SAI_QOS_MAP_ATTR_MAP_TO_VALUE_LIST;
+    attr_list[1].value.qosmap = map_list;
+
+    ASSERT_EQ(SAI_STATUS_SUCCESS, sai_qos_map_api_table->create_qos_map
+              (&map_id, switch_id, 2, (const sai_attribute_t *)attr_list));
+
+    set_attr.id = SAI_PORT_ATTR_QOS_DSCP_TO_TC_MAP;
+    set_attr.value.oid = map_id;
+    ASSERT_EQ(SAI_STATUS_SUCCESS,sai_port_api_table->set_port_attribute
+              (sai_qos_port_id_get(test_port_id_1), (const sai_attribute_t *)&set_attr));
+
+    npu_update_count = sai_qos_map_npu_update_count_get ();
+    port_update_count = sai_qos_map_port_update_count_get ();
+
+    /* Same entries, neither the NPU nor the port is reprogrammed */
+    set_attr.id = SAI_QOS_MAP_ATTR_MAP_TO_VALUE_LIST;
+    set_attr.value.qosmap = map_list;
+    ASSERT_EQ(SAI_STATUS_SUCCESS, sai_qos_map_api_table->set_qos_map_attribute
+              (map_id, (const sai_attribute_t *)&set_attr));
+    EXPECT_EQ(npu_update_count, sai_qos_map_npu_update_count_get ());
+    EXPECT_EQ(port_update_count, sai_qos_map_port_update_count_get ());
+
+    /* Single codepoint update */
+    map_list.count = 1;
+    map_list.list[0].value.tc = 2;
+    set_attr.value.qosmap = map_list;
+    ASSERT_EQ(SAI_STATUS_SUCCESS, sai_qos_map_api_table->set_qos_map_attribute
+              (map_id, (const sai_attribute_t *)&set_attr));
+    EXPECT_EQ(npu_update_count + 1, sai_qos_map_npu_update_count_get ());
+
+    get_attr.id = SAI_QOS_MAP_ATTR_MAP_TO_VALUE_LIST;
+    get_attr.value.qosmap.count = 64;
+    get_attr.value.qosmap.list = get_entries;
+    ASSERT_EQ(SAI_STATUS_SUCCESS, sai_qos_map_api_table->get_qos_map_attribute
+              (map_id, 1, &get_attr));
+    EXPECT_EQ(2u, sai_qos_map_dscp_tc_get (&get_attr.value.qosmap, 10));
+    EXPECT_EQ(6u, sai_qos_map_dscp_tc_get (&get_attr.value.qosmap, 11));
+
+    set_attr.id = SAI_PORT_ATTR_QOS_DSCP_TO_TC_MAP;
+    set_attr.value.oid = SAI_NULL_OBJECT_ID;
+    ASSERT_EQ(SAI_STATUS_SUCCESS,sai_port_api_table->set_port_attribute
+              (sai_qos_port_id_get(test_port_id_1), (const sai_attribute_t *)&set_attr));
+
+    ASSERT_EQ(SAI_STATUS_SUCCESS, sai_qos_map_api_table->remove_qos_map (map_id));
+}
@@ -29,6 +29,7 @@
 
 extern "C" {
 #include "sai_qos_unit_test_utils.h"
+#include "sai_qos_api_utils.h"
 #include "sai.h"
 #include "saistatus.h"
 #include <inttypes.h>
@@ -316,6 +317,139 @@ TEST (saiQosQueueTest, clear_queue_stats)
     }
 }
 
+/*
+ * Validate bulk set and remove of queues, and the not executed statuses in
+ * stop on error mode.
+ */
+TEST (saiQosQueueTest, queue_bulk_set_remove)
+{
+    sai_status_t     sai_rc = SAI_STATUS_SUCCESS;
+    sai_attribute_t  set_attr[3];
+    sai_attribute_t  get_attr;
+    sai_object_id_t  object_id[3];
+    sai_status_t     statuses[3];
+    unsigned int     max_queues = 0;
+
+    sai_rc = sai_test_port_max_number_queues_get (default_port_id,
+                                                  &max_queues);
+    ASSERT_EQ (SAI_STATUS_SUCCESS, sai_rc);
+    ASSERT_TRUE (max_queues >= 2);
+
+    sai_object_id_t queue_id_list[max_queues];
+
+    sai_rc = sai_test_port_queue_id_list_get (default_port_id, max_queues,
+                                              &queue_id_list[0]);
+    ASSERT_EQ (SAI_STATUS_SUCCESS, sai_rc);
+
+    /* The queue type is create only, the set fails and stops the batch */
+    object_id[0] = queue_id_list[0];
+    object_id[1] = queue_id_list[1];
+    object_id[2] = queue_id_list[1];
+    set_attr[0].id = SAI_QUEUE_ATTR_WRED_PROFILE_ID;
+    set_attr[0].value.oid = SAI_NULL_OBJECT_ID;
+    set_attr[1].id = SAI_QUEUE_ATTR_TYPE;
+    set_attr[1].value.s32 = SAI_QUEUE_TYPE_MULTICAST;
+    set_attr[2] = set_attr[0];
+
+    sai_rc = sai_qos_queue_bulk_set (3, object_id, set_attr,
+                                     DN_SAI_QOS_BULK_OP_ERROR_MODE_STOP_ON_ERROR,
+                                     statuses);
+    EXPECT_EQ (SAI_STATUS_FAILURE, sai_rc);
+    EXPECT_EQ (SAI_STATUS_SUCCESS, statuses[0]);
+    EXPECT_EQ (SAI_STATUS_INVALID_ATTRIBUTE_0, statuses[1]);
+    EXPECT_EQ (SAI_QOS_BULK_STATUS_NOT_EXECUTED, statuses[2]);
+
+    sai_rc = sai_qos_queue_bulk_set (3, object_id, set_attr,
+                                     DN_SAI_QOS_BULK_OP_ERROR_MODE_IGNORE_ERROR,
+                                     statuses);
+    EXPECT_EQ (SAI_STATUS_FAILURE, sai_rc);
+    EXPECT_EQ (SAI_STATUS_SUCCESS, statuses[0]);
+    EXPECT_EQ (SAI_STATUS_INVALID_ATTRIBUTE_0, statuses[1]);
+    EXPECT_EQ (SAI_STATUS_SUCCESS, statuses[2]);
+
+    get_attr.id = SAI_QUEUE_ATTR_TYPE;
+    sai_rc = p_sai_qos_queue_api_table->get_queue_attribute (queue_id_list[1], 1,
+                                                             &get_attr);
+    EXPECT_EQ (SAI_STATUS_SUCCESS, sai_rc);
+    EXPECT_EQ (SAI_QUEUE_TYPE_UNICAST, get_attr.value.s32);
+
+    /* An invalid queue stops the batch, the port queue is not removed */
+    object_id[0] = SAI_NULL_OBJECT_ID;
+    object_id[1] = queue_id_list[0];
+
+    sai_rc = sai_qos_queue_bulk_remove (2, object_id,
+                                        DN_SAI_QOS_BULK_OP_ERROR_MODE_STOP_ON_ERROR,
+                                        statuses);
+    EXPECT_EQ (SAI_STATUS_FAILURE, sai_rc);
+    EXPECT_NE (SAI_STATUS_SUCCESS, statuses[0]);
+    EXPECT_EQ (SAI_QOS_BULK_STATUS_NOT_EXECUTED, statuses[1]);
+
+    sai_rc = p_sai_qos_queue_api_table->get_queue_attribute (queue_id_list[0], 1,
+                                                             &get_attr);
+    EXPECT_EQ (SAI_STATUS_SUCCESS, sai_rc);
+}
+
+/*
+ * Queue watermark reads keep the peak since the last clear while the
+ * watermark poller clears the hardware counter.
+ */
+TEST (saiQosQueueTest, watermark_stats_with_poller)
+{
+    sai_status_t     sai_rc = SAI_STATUS_SUCCESS;
+    unsigned int     max_queues = 0;
+    sai_queue_stat_t counter_ids[2] = {SAI_QUEUE_STAT_PACKETS,
+                                       SAI_QUEUE_STAT_WATERMARK_BYTES};
+    uint64_t         counter_val = 0;
+    uint64_t         prev_counter_val = 0;
+
+    sai_rc = sai_test_port_max_number_queues_get (default_port_id,
+                                                  &max_queues);
+    ASSERT_EQ (SAI_STATUS_SUCCESS, sai_rc);
+
+    sai_object_id_t queue_id_list[max_queues];
+
+    sai_rc = sai_test_port_queue_id_list_get (default_port_id, max_queues,
+                                              &queue_id_list[0]);
+    ASSERT_EQ (SAI_STATUS_SUCCESS, sai_rc);
+
+    sai_object_id_t  queue_id = queue_id_list[0];
+
+    sai_rc = p_sai_qos_queue_api_table->get_queue_stats (queue_id, &counter_ids[1], 1,
+                                                         &counter_val);
+    if (sai_rc == SAI_STATUS_NOT_SUPPORTED) {
+        printf ("Queue watermark is not supported.\r\n");
+        return;
+    }
+    ASSERT_EQ (SAI_STATUS_SUCCESS, sai_rc);
+
+    ASSERT_EQ (SAI_STATUS_SUCCESS, sai_qos_watermark_poll_start (100));
+
+    usleep (300 * 1000);
+
+    ASSERT_EQ (SAI_STATUS_SUCCESS,
+               p_sai_qos_queue_api_table->get_queue_stats (queue_id, &counter_ids[1], 1,
+                                                           &prev_counter_val));
+
+    usleep (300 * 1000);
+
+    /* Polls do not lower the peak seen by the client */
+    ASSERT_EQ (SAI_STATUS_SUCCESS,
+               p_sai_qos_queue_api_table->get_queue_stats (queue_id, &counter_ids[1], 1,
+                                                           &counter_val));
+    EXPECT_GE (counter_val, prev_counter_val);
+
+    /* Clears are served from the peak, other counters still reach the NPU */
+    EXPECT_EQ (SAI_STATUS_SUCCESS,
+               p_sai_qos_queue_api_table->clear_queue_stats (queue_id, &counter_ids[1], 1));
+    EXPECT_EQ (SAI_STATUS_SUCCESS,
+               p_sai_qos_queue_api_table->clear_queue_stats (queue_id, counter_ids, 2));
+
+    ASSERT_EQ (SAI_STATUS_SUCCESS, sai_qos_watermark_poll_stop ());
+
+    EXPECT_EQ (SAI_STATUS_SUCCESS,
+               p_sai_qos_queue_api_table->clear_queue_stats (queue_id, &counter_ids[1], 1));
+}
+
 int main (int argc, char **argv)
 {
     ::testing::InitGoogleTest(&argc, argv);
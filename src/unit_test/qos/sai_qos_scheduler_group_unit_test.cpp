@@ -24,6 +24,7 @@
 
 extern "C" {
 #include "sai_qos_unit_test_utils.h"
+#include "sai_qos_api_utils.h"
 #include "sai.h"
 #include "saistatus.h"
 #include <inttypes.h>
@@ -1473,6 +1474,124 @@ TEST (saiQosSchedulerGroupTest, two_strict_priority)
     EXPECT_EQ (wrr_sched_id, get_attr.value.oid);
 }
 
+/*
+ * Validate bulk create, set and remove of scheduler groups, and the not
+ * executed statuses in stop on error mode.
+ */
+TEST (saiQosSchedulerGroupTest, sched_group_bulk_create_set_remove)
+{
+    sai_status_t           sai_rc = SAI_STATUS_SUCCESS;
+    sai_attribute_t        create_attr[4];
+    sai_attribute_t        set_attr[3];
+    sai_attribute_t        get_attr;
+    const sai_attribute_t *create_attr_list[2];
+    uint32_t               create_attr_count[2];
+    sai_object_id_t        sg_id[2] = {SAI_NULL_OBJECT_ID, SAI_NULL_OBJECT_ID};
+    sai_object_id_t        object_id[3];
+    sai_status_t           statuses[3];
+    sai_object_id_t        sched_id = SAI_NULL_OBJECT_ID;
+
+    if (is_fixed_hqos)
+        return;
+
+    memset (create_attr, 0, sizeof (create_attr));
+
+    create_attr[0].id = SAI_SCHEDULER_GROUP_ATTR_PORT_ID;
+    create_attr[0].value.oid = default_port_id;
+    create_attr[1].id = SAI_SCHEDULER_GROUP_ATTR_LEVEL;
+    create_attr[1].value.u32 = 0;
+    create_attr[2].id = SAI_SCHEDULER_GROUP_ATTR_MAX_CHILDS;
+    create_attr[2].value.u32 = 1;
+    create_attr[3].id = SAI_SCHEDULER_GROUP_ATTR_PARENT_NODE;
+    create_attr[3].value.oid = default_port_id;
+
+    /* A group missing mandatory attributes stops the batch */
+    create_attr_count[0] = 1;
+    create_attr_list[0] = create_attr;
+    create_attr_count[1] = 4;
+    create_attr_list[1] = create_attr;
+
+    sai_rc = sai_qos_sched_group_bulk_create (switch_id, 2, create_attr_count,
+                                              create_attr_list,
+                                              DN_SAI_QOS_BULK_OP_ERROR_MODE_STOP_ON_ERROR,
+                                              sg_id, statuses);
+    ASSERT_EQ (SAI_STATUS_FAILURE, sai_rc);
+    EXPECT_NE (SAI_STATUS_SUCCESS, statuses[0]);
+    EXPECT_EQ (SAI_QOS_BULK_STATUS_NOT_EXECUTED, statuses[1]);
+
+    sai_rc = sai_qos_sched_group_bulk_create (switch_id, 1, &create_attr_count[1],
+                                              &create_attr_list[1],
+                                              DN_SAI_QOS_BULK_OP_ERROR_MODE_STOP_ON_ERROR,
+                                              sg_id, statuses);
+    ASSERT_EQ (SAI_STATUS_SUCCESS, sai_rc);
+    EXPECT_EQ (SAI_STATUS_SUCCESS, statuses[0]);
+
+    sai_rc = sai_test_scheduler_create (&sched_id, 2,
+                                        SAI_SCHEDULER_ATTR_SCHEDULING_TYPE, SAI_SCHEDULING_TYPE_DWRR,
+                                        SAI_SCHEDULER_ATTR_SCHEDULING_WEIGHT, 10);
+    ASSERT_EQ (SAI_STATUS_SUCCESS, sai_rc);
+
+    /* Objects after the failed set keep their scheduler profile */
+    object_id[0] = sg_id[0];
+    object_id[1] = SAI_NULL_OBJECT_ID;
+    object_id[2] = sg_id[0];
+    set_attr[0].id = SAI_SCHEDULER_GROUP_ATTR_SCHEDULER_PROFILE_ID;
+    set_attr[0].value.oid = sched_id;
+    set_attr[1] = set_attr[0];
+    set_attr[2].id = SAI_SCHEDULER_GROUP_ATTR_SCHEDULER_PROFILE_ID;
+    set_attr[2].value.oid = SAI_NULL_OBJECT_ID;
+
+    sai_rc = sai_qos_sched_group_bulk_set (3, object_id, set_attr,
+                                           DN_SAI_QOS_BULK_OP_ERROR_MODE_STOP_ON_ERROR,
+                                           statuses);
+    ASSERT_EQ (SAI_STATUS_FAILURE, sai_rc);
+    EXPECT_EQ (SAI_STATUS_SUCCESS, statuses[0]);
+    EXPECT_NE (SAI_STATUS_SUCCESS, statuses[1]);
+    EXPECT_EQ (SAI_QOS_BULK_STATUS_NOT_EXECUTED, statuses[2]);
+
+    get_attr.id = SAI_SCHEDULER_GROUP_ATTR_SCHEDULER_PROFILE_ID;
+    sai_rc = p_sai_qos_sg_api_table->get_scheduler_group_attribute (sg_id[0], 1, &get_attr);
+    ASSERT_EQ (SAI_STATUS_SUCCESS, sai_rc);
+    EXPECT_EQ (sched_id, get_attr.value.oid);
+
+    /* Ignore error runs the reset after the failure */
+    sai_rc = sai_qos_sched_group_bulk_set (3, object_id, set_attr,
+                                           DN_SAI_QOS_BULK_OP_ERROR_MODE_IGNORE_ERROR,
+                                           statuses);
+    ASSERT_EQ (SAI_STATUS_FAILURE, sai_rc);
+    EXPECT_EQ (SAI_STATUS_SUCCESS, statuses[0]);
+    EXPECT_NE (SAI_STATUS_SUCCESS, statuses[1]);
+    EXPECT_EQ (SAI_STATUS_SUCCESS, statuses[2]);
+
+    sai_rc = p_sai_qos_sg_api_table->get_scheduler_group_attribute (sg_id[0], 1, &get_attr);
+    ASSERT_EQ (SAI_STATUS_SUCCESS, sai_rc);
+    EXPECT_EQ (SAI_NULL_OBJECT_ID, get_attr.value.oid);
+
+    /* Stop on error leaves the group after the failure in place */
+    object_id[0] = SAI_NULL_OBJECT_ID;
+    object_id[1] = sg_id[0];
+
+    sai_rc = sai_qos_sched_group_bulk_remove (2, object_id,
+                                              DN_SAI_QOS_BULK_OP_ERROR_MODE_STOP_ON_ERROR,
+                                              statuses);
+    ASSERT_EQ (SAI_STATUS_FAILURE, sai_rc);
+    EXPECT_NE (SAI_STATUS_SUCCESS, statuses[0]);
+    EXPECT_EQ (SAI_QOS_BULK_STATUS_NOT_EXECUTED, statuses[1]);
+
+    sai_rc = p_sai_qos_sg_api_table->get_scheduler_group_attribute (sg_id[0], 1, &get_attr);
+    ASSERT_EQ (SAI_STATUS_SUCCESS, sai_rc);
+
+    sai_rc = sai_qos_sched_group_bulk_remove (1, sg_id,
+                                              DN_SAI_QOS_BULK_OP_ERROR_MODE_IGNORE_ERROR,
+                                              statuses);
+    ASSERT_EQ (SAI_STATUS_SUCCESS, sai_rc);
+
+    sai_sched_group_verify_after_removal (sg_id[0]);
+
+    sai_rc = sai_test_scheduler_remove (sched_id);
+    EXPECT_EQ (SAI_STATUS_SUCCESS, sai_rc);
+}
+
 int main (int argc, char **argv)
 {
     ::testing::InitGoogleTest(&argc, argv);
@@ -29,6 +29,7 @@
 
 extern "C" {
 #include "sai_qos_unit_test_utils.h"
+#include "sai_qos_api_utils.h"
 #include "sai.h"
 #include "saistatus.h"
 #include <inttypes.h>
@@ -791,6 +792,73 @@ TEST (saiQosSchedulerTest, scheduler_modify)
     ASSERT_EQ (SAI_STATUS_SUCCESS, sai_rc);
 }
 
+/*
+ * Validate multi attribute scheduler set reapplied on all port queues.
+ */
+TEST (saiQosSchedulerTest, scheduler_multi_attribute_modify)
+{
+    sai_status_t     sai_rc = SAI_STATUS_SUCCESS;
+    sai_attribute_t  attr;
+    sai_attribute_t  set_attr_list[3];
+    sai_attribute_t  get_attr_list[3];
+    unsigned int     queue_index = 0;
+    sai_object_id_t  sched_id = SAI_NULL_OBJECT_ID;
+
+    sai_rc = sai_test_port_max_number_queues_get (default_port_id,
+                                                  &max_queues);
+    ASSERT_EQ (SAI_STATUS_SUCCESS, sai_rc);
+
+    sai_rc = sai_test_scheduler_create (&sched_id, 3,
+                                        SAI_SCHEDULER_ATTR_SCHEDULING_TYPE, SAI_SCHEDULING_TYPE_WRR,
+                                        SAI_SCHEDULER_ATTR_SCHEDULING_WEIGHT, 10,
+                                        SAI_SCHEDULER_ATTR_MAX_BANDWIDTH_RATE, 20480);
+    ASSERT_EQ (SAI_STATUS_SUCCESS, sai_rc);
+
+    attr.id = SAI_QUEUE_ATTR_SCHEDULER_PROFILE_ID;
+    attr.value.oid = sched_id;
+
+    for (queue_index = 0; queue_index < max_queues; queue_index++) {
+        sai_rc = p_sai_qos_queue_api_table->set_queue_attribute (
+                                         queue_id_list[queue_index], &attr);
+        ASSERT_EQ (SAI_STATUS_SUCCESS, sai_rc);
+    }
+
+    set_attr_list[0].id = SAI_SCHEDULER_ATTR_SCHEDULING_WEIGHT;
+    set_attr_list[0].value.u8 = 40;
+    set_attr_list[1].id = SAI_SCHEDULER_ATTR_MIN_BANDWIDTH_RATE;
+    set_attr_list[1].value.u64 = 4096;
+    set_attr_list[2].id = SAI_SCHEDULER_ATTR_MAX_BANDWIDTH_RATE;
+    set_attr_list[2].value.u64 = 40960;
+
+    sai_rc = sai_qos_scheduler_attributes_set (sched_id, 3, set_attr_list);
+    ASSERT_EQ (SAI_STATUS_SUCCESS, sai_rc);
+
+    /* Duplicate multi attribute set */
+    sai_rc = sai_qos_scheduler_attributes_set (sched_id, 3, set_attr_list);
+    ASSERT_EQ (SAI_STATUS_SUCCESS, sai_rc);
+
+    sai_rc = sai_test_scheduler_attr_get (sched_id, &get_attr_list[0], 3,
+                                          SAI_SCHEDULER_ATTR_SCHEDULING_WEIGHT,
+                                          SAI_SCHEDULER_ATTR_MIN_BANDWIDTH_RATE,
+                                          SAI_SCHEDULER_ATTR_MAX_BANDWIDTH_RATE);
+    ASSERT_EQ (SAI_STATUS_SUCCESS, sai_rc);
+    ASSERT_EQ (40, get_attr_list[0].value.u8);
+    ASSERT_EQ (4096, get_attr_list[1].value.u64);
+    ASSERT_EQ (40960, get_attr_list[2].value.u64);
+
+    attr.id = SAI_QUEUE_ATTR_SCHEDULER_PROFILE_ID;
+    attr.value.oid = SAI_NULL_OBJECT_ID;
+
+    for (queue_index = 0; queue_index < max_queues; queue_index++) {
+        sai_rc = p_sai_qos_queue_api_table->set_queue_attribute (
+                                         queue_id_list[queue_index], &attr);
+        ASSERT_EQ (SAI_STATUS_SUCCESS, sai_rc);
+    }
+
+    sai_rc =  sai_test_scheduler_remove (sched_id);
+    ASSERT_EQ (SAI_STATUS_SUCCESS, sai_rc);
+}
+
 /*
  * Validate scheduler appply on CPU port queues.
  */
@@ -921,6 +989,105 @@ TEST (saiQosSchedulerTest, scheduler_on_cpu_port)
 }
 
 
+/*
+ * Validate bulk create, set and remove of schedulers, and the not executed
+ * statuses in stop on error mode.
+ */
+TEST (saiQosSchedulerTest, scheduler_bulk_create_set_remove)
+{
+    sai_status_t           sai_rc = SAI_STATUS_SUCCESS;
+    sai_attribute_t        create_attr[2];
+    sai_attribute_t        set_attr[3];
+    sai_attribute_t        get_attr[1];
+    sai_attribute_t        attr;
+    const sai_attribute_t *create_attr_list[2];
+    uint32_t               create_attr_count[2];
+    sai_object_id_t        sched_id[2] = {SAI_NULL_OBJECT_ID, SAI_NULL_OBJECT_ID};
+    sai_object_id_t        object_id[3];
+    sai_status_t           statuses[3];
+
+    create_attr[0].id = SAI_SCHEDULER_ATTR_SCHEDULING_TYPE;
+    create_attr[0].value.s32 = SAI_SCHEDULING_TYPE_DWRR;
+    create_attr[1].id = SAI_SCHEDULER_ATTR_SCHEDULING_WEIGHT;
+    create_attr[1].value.u8 = 10;
+
+    create_attr_count[0] = 2;
+    create_attr_list[0] = create_attr;
+    create_attr_count[1] = 2;
+    create_attr_list[1] = create_attr;
+
+    sai_rc = sai_qos_scheduler_bulk_create (switch_id, 2, create_attr_count,
+                                            create_attr_list,
+                                            DN_SAI_QOS_BULK_OP_ERROR_MODE_STOP_ON_ERROR,
+                                            sched_id, statuses);
+    ASSERT_EQ (SAI_STATUS_SUCCESS, sai_rc);
+    EXPECT_EQ (SAI_STATUS_SUCCESS, statuses[0]);
+    EXPECT_EQ (SAI_STATUS_SUCCESS, statuses[1]);
+
+    /* Bind the first scheduler so the set reapplies on a queue */
+    sai_rc = sai_test_port_max_number_queues_get (default_port_id,
+                                                  &max_queues);
+    ASSERT_EQ (SAI_STATUS_SUCCESS, sai_rc);
+
+    attr.id = SAI_QUEUE_ATTR_SCHEDULER_PROFILE_ID;
+    attr.value.oid = sched_id[0];
+
+    sai_rc = p_sai_qos_queue_api_table->set_queue_attribute (queue_id_list[0], &attr);
+    ASSERT_EQ (SAI_STATUS_SUCCESS, sai_rc);
+
+    /* Objects after the failed set keep their weight */
+    object_id[0] = sched_id[0];
+    object_id[1] = SAI_NULL_OBJECT_ID;
+    object_id[2] = sched_id[1];
+    set_attr[0].id = SAI_SCHEDULER_ATTR_SCHEDULING_WEIGHT;
+    set_attr[0].value.u8 = 20;
+    set_attr[1] = set_attr[0];
+    set_attr[2] = set_attr[0];
+
+    sai_rc = sai_qos_scheduler_bulk_set (3, object_id, set_attr,
+                                         DN_SAI_QOS_BULK_OP_ERROR_MODE_STOP_ON_ERROR,
+                                         statuses);
+    ASSERT_EQ (SAI_STATUS_FAILURE, sai_rc);
+    EXPECT_EQ (SAI_STATUS_SUCCESS, statuses[0]);
+    EXPECT_NE (SAI_STATUS_SUCCESS, statuses[1]);
+    EXPECT_EQ (SAI_QOS_BULK_STATUS_NOT_EXECUTED, statuses[2]);
+
+    sai_rc = sai_test_scheduler_attr_get (sched_id[0], get_attr, 1,
+                                          SAI_SCHEDULER_ATTR_SCHEDULING_WEIGHT);
+    ASSERT_EQ (SAI_STATUS_SUCCESS, sai_rc);
+    EXPECT_EQ (20, get_attr[0].value.u8);
+
+    sai_rc = sai_test_scheduler_attr_get (sched_id[1], get_attr, 1,
+                                          SAI_SCHEDULER_ATTR_SCHEDULING_WEIGHT);
+    ASSERT_EQ (SAI_STATUS_SUCCESS, sai_rc);
+    EXPECT_EQ (10, get_attr[0].value.u8);
+
+    /* Stop on error leaves the scheduler after the in use one in place */
+    sai_rc = sai_qos_scheduler_bulk_remove (2, sched_id,
+                                            DN_SAI_QOS_BULK_OP_ERROR_MODE_STOP_ON_ERROR,
+                                            statuses);
+    ASSERT_EQ (SAI_STATUS_FAILURE, sai_rc);
+    EXPECT_EQ (SAI_STATUS_OBJECT_IN_USE, statuses[0]);
+    EXPECT_EQ (SAI_QOS_BULK_STATUS_NOT_EXECUTED, statuses[1]);
+
+    sai_rc = sai_test_scheduler_attr_get (sched_id[1], get_attr, 1,
+                                          SAI_SCHEDULER_ATTR_SCHEDULING_WEIGHT);
+    ASSERT_EQ (SAI_STATUS_SUCCESS, sai_rc);
+
+    attr.value.oid = SAI_NULL_OBJECT_ID;
+
+    sai_rc = p_sai_qos_queue_api_table->set_queue_attribute (queue_id_list[0], &attr);
+    ASSERT_EQ (SAI_STATUS_SUCCESS, sai_rc);
+
+    sai_rc = sai_qos_scheduler_bulk_remove (2, sched_id,
+                                            DN_SAI_QOS_BULK_OP_ERROR_MODE_IGNORE_ERROR,
+                                            statuses);
+    ASSERT_EQ (SAI_STATUS_SUCCESS, sai_rc);
+
+    sai_scheduler_verify_after_removal (sched_id[0]);
+    sai_scheduler_verify_after_removal (sched_id[1]);
+}
+
 int main (int argc, char **argv)
 {
     ::testing::InitGoogleTest(&argc, argv);
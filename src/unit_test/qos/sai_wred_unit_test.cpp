@@ -28,6 +28,7 @@
 
 extern "C" {
 #include "sai_qos_unit_test_utils.h"
+#include "sai_qos_api_utils.h"
 #include "sai.h"
 #include "saitypes.h"
 #include "saistatus.h"
@@ -739,6 +740,164 @@ TEST_F(wred, create_set_get)
               (wred_id1));
 }
 
+TEST_F(wred, deferred_set_get)
+{
+    sai_attribute_t new_attr_list[3];
+    sai_attribute_t set_attr;
+    sai_attribute_t get_attr[3];
+    sai_object_id_t wred_id1 = SAI_NULL_OBJECT_ID;
+    sai_object_id_t queue_id = SAI_NULL_OBJECT_ID;
+    unsigned int queue_idx = 0;
+    sai_status_t sai_rc = SAI_STATUS_SUCCESS;
+
+    for ( ; (queue_idx < max_queues) && (queue_id == SAI_NULL_OBJECT_ID); queue_idx++)
+    {
+         get_attr[0].id = SAI_QUEUE_ATTR_TYPE;
+         sai_rc = sai_queue_api_table->get_queue_attribute (
+                                                 queue_list[queue_idx],
+                                                 1, &get_attr[0]);
+
+         if ((sai_rc == SAI_STATUS_SUCCESS) &&
+               (get_attr[0].value.s32 == SAI_QUEUE_TYPE_UNICAST)) {
+             queue_id = queue_list[queue_idx];
+         }
+    }
+
+    ASSERT_NE(SAI_NULL_OBJECT_ID, queue_id);
+
+    new_attr_list[0].id = SAI_WRED_ATTR_GREEN_ENABLE;
+    new_attr_list[0].value.booldata = true;
+    new_attr_list[1].id = SAI_WRED_ATTR_GREEN_MIN_THRESHOLD;
+    new_attr_list[1].value.u32 = 5000;
+    new_attr_list[2].id = SAI_WRED_ATTR_GREEN_MAX_THRESHOLD;
+    new_attr_list[2].value.u32 = 22000;
+
+    ASSERT_EQ(SAI_STATUS_SUCCESS, sai_wred_api_table->create_wred_profile
+              (&wred_id1, switch_id, 3, (const sai_attribute_t *)new_attr_list));
+
+    set_attr.id = SAI_QUEUE_ATTR_WRED_PROFILE_ID;
+    set_attr.value.oid = wred_id1;
+
+    ASSERT_EQ(SAI_STATUS_SUCCESS, sai_queue_api_table->set_queue_attribute
+              (queue_id,(const sai_attribute_t *)&set_attr));
+
+    /* Several sets in the deferral window are propagated once at the end */
+    ASSERT_EQ(SAI_STATUS_SUCCESS, sai_qos_wred_update_defer_begin());
+
+    set_attr.id = SAI_WRED_ATTR_GREEN_MIN_THRESHOLD;
+    set_attr.value.u32 = 6000;
+    ASSERT_EQ(SAI_STATUS_SUCCESS, sai_wred_api_table->set_wred_attribute
+              (wred_id1,(const sai_attribute_t *)&set_attr));
+
+    set_attr.id = SAI_WRED_ATTR_GREEN_MAX_THRESHOLD;
+    set_attr.value.u32 = 20000;
+    ASSERT_EQ(SAI_STATUS_SUCCESS, sai_wred_api_table->set_wred_attribute
+              (wred_id1,(const sai_attribute_t *)&set_attr));
+
+    set_attr.id = SAI_WRED_ATTR_WEIGHT;
+    set_attr.value.u32 = 10;
+    ASSERT_EQ(SAI_STATUS_SUCCESS, sai_wred_api_table->set_wred_attribute
+              (wred_id1,(const sai_attribute_t *)&set_attr));
+
+    ASSERT_EQ(SAI_STATUS_SUCCESS, sai_qos_wred_update_defer_end());
+    ASSERT_EQ(SAI_STATUS_INVALID_PARAMETER, sai_qos_wred_update_defer_end());
+
+    get_attr[0].id = SAI_WRED_ATTR_GREEN_MIN_THRESHOLD;
+    get_attr[1].id = SAI_WRED_ATTR_GREEN_MAX_THRESHOLD;
+    get_attr[2].id = SAI_WRED_ATTR_WEIGHT;
+
+    ASSERT_EQ(SAI_STATUS_SUCCESS,sai_wred_api_table->
+              get_wred_attribute(wred_id1, 3, get_attr));
+    EXPECT_EQ(6000, get_attr[0].value.u32);
+    EXPECT_EQ(20000, get_attr[1].value.u32);
+    EXPECT_EQ(10, get_attr[2].value.u32);
+
+    set_attr.id = SAI_QUEUE_ATTR_WRED_PROFILE_ID;
+    set_attr.value.oid = SAI_NULL_OBJECT_ID;
+
+    ASSERT_EQ(SAI_STATUS_SUCCESS, sai_queue_api_table->set_queue_attribute
+              (queue_id,(const sai_attribute_t *)&set_attr));
+
+    ASSERT_EQ(SAI_STATUS_SUCCESS, sai_wred_api_table->remove_wred_profile
+              (wred_id1));
+}
+
+TEST_F(wred, bulk_create_set_remove)
+{
+    sai_attribute_t new_attr_list[3];
+    sai_attribute_t set_attr_list[3];
+    sai_attribute_t get_attr[2];
+    const sai_attribute_t *create_attr_list[2];
+    uint32_t create_attr_count[2];
+    sai_object_id_t wred_id[2] = {SAI_NULL_OBJECT_ID, SAI_NULL_OBJECT_ID};
+    sai_object_id_t set_id[3];
+    sai_object_id_t remove_id[3];
+    sai_status_t statuses[3];
+
+    new_attr_list[0].id = SAI_WRED_ATTR_GREEN_ENABLE;
+    new_attr_list[0].value.booldata = true;
+    new_attr_list[1].id = SAI_WRED_ATTR_GREEN_MIN_THRESHOLD;
+    new_attr_list[1].value.u32 = 5000;
+    new_attr_list[2].id = SAI_WRED_ATTR_GREEN_MAX_THRESHOLD;
+    new_attr_list[2].value.u32 = 22000;
+
+    create_attr_count[0] = 3;
+    create_attr_list[0] = new_attr_list;
+    create_attr_count[1] = 3;
+    create_attr_list[1] = new_attr_list;
+
+    ASSERT_EQ(SAI_STATUS_SUCCESS, sai_qos_wred_bulk_create
+              (switch_id, 2, create_attr_count, create_attr_list,
+               DN_SAI_QOS_BULK_OP_ERROR_MODE_STOP_ON_ERROR, wred_id, statuses));
+    EXPECT_EQ(SAI_STATUS_SUCCESS, statuses[0]);
+    EXPECT_EQ(SAI_STATUS_SUCCESS, statuses[1]);
+
+    /* Two sets on the same profile are propagated together */
+    set_id[0] = wred_id[0];
+    set_attr_list[0].id = SAI_WRED_ATTR_GREEN_MIN_THRESHOLD;
+    set_attr_list[0].value.u32 = 6000;
+    set_id[1] = wred_id[0];
+    set_attr_list[1].id = SAI_WRED_ATTR_GREEN_MAX_THRESHOLD;
+    set_attr_list[1].value.u32 = 20000;
+    set_id[2] = wred_id[1];
+    set_attr_list[2].id = SAI_WRED_ATTR_WEIGHT;
+    set_attr_list[2].value.u32 = 10;
+
+    ASSERT_EQ(SAI_STATUS_SUCCESS, sai_qos_wred_bulk_set
+              (3, set_id, set_attr_list,
+               DN_SAI_QOS_BULK_OP_ERROR_MODE_IGNORE_ERROR, statuses));
+
+    get_attr[0].id = SAI_WRED_ATTR_GREEN_MIN_THRESHOLD;
+    get_attr[1].id = SAI_WRED_ATTR_GREEN_MAX_THRESHOLD;
+
+    ASSERT_EQ(SAI_STATUS_SUCCESS,sai_wred_api_table->
+              get_wred_attribute(wred_id[0], 2, get_attr));
+    EXPECT_EQ(6000, get_attr[0].value.u32);
+    EXPECT_EQ(20000, get_attr[1].value.u32);
+
+    get_attr[0].id = SAI_WRED_ATTR_WEIGHT;
+
+    ASSERT_EQ(SAI_STATUS_SUCCESS,sai_wred_api_table->
+              get_wred_attribute(wred_id[1], 1, get_attr));
+    EXPECT_EQ(10, get_attr[0].value.u32);
+
+    /* Stop on error leaves the objects after the failure untouched */
+    remove_id[0] = wred_id[0];
+    remove_id[1] = wred_id[0];
+    remove_id[2] = wred_id[1];
+
+    ASSERT_EQ(SAI_STATUS_FAILURE, sai_qos_wred_bulk_remove
+              (3, remove_id, DN_SAI_QOS_BULK_OP_ERROR_MODE_STOP_ON_ERROR,
+               statuses));
+    EXPECT_EQ(SAI_STATUS_SUCCESS, statuses[0]);
+    EXPECT_NE(SAI_STATUS_SUCCESS, statuses[1]);
+    EXPECT_EQ(SAI_QOS_BULK_STATUS_NOT_EXECUTED, statuses[2]);
+
+    ASSERT_EQ(SAI_STATUS_SUCCESS, sai_qos_wred_bulk_remove
+              (1, &wred_id[1], DN_SAI_QOS_BULK_OP_ERROR_MODE_IGNORE_ERROR,
+               statuses));
+}
+
 /*
  * Apply a wred profile on port.
  * For now its not supported.
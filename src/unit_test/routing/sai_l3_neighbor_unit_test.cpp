@@ -36,6 +36,9 @@ extern "C" {
 #include <stdlib.h>
 #include <arpa/inet.h>
 #include <inttypes.h>
+#include <time.h>
+#include "sai_fdb_main.h"
+#include "sai_l3_api_utils.h"
 }
 
 class saiL3NeighborTest : public saiL3Test
@@ -932,6 +935,176 @@ TEST_F (saiL3NeighborTest, drop_action_on_vlan_rif)
     EXPECT_EQ (SAI_STATUS_SUCCESS, status);
 }
 
+/*
+ * Benchmark the FDB event driven neighbor port resolution. Replays FDB
+ * learn events moving the neighbor MACs between two ports against the
+ * neighbors created on the VLAN RIF.
+ */
+TEST_F (saiL3NeighborTest, fdb_move_event_replay_benchmark)
+{
+    static const unsigned int max_neighbors = 65536;
+    static const unsigned int fdb_event_count = 100000;
+    static const unsigned int fdb_event_batch = 100;
+    sai_status_t          status;
+    sai_ip_addr_family_t  ip_af = SAI_IP_ADDR_FAMILY_IPV4;
+    sai_object_id_t       move_port_id = sai_l3_port_id_get (default_port + 1);
+    sai_fdb_internal_notification_data_t fdb_upd [fdb_event_batch];
+    static const unsigned int mac_str_len = 18;
+    static char           ip_str [max_neighbors][INET_ADDRSTRLEN];
+    static char           mac_str [max_neighbors][mac_str_len];
+    unsigned int          nbr_count = 0;
+    unsigned int          event_idx;
+    unsigned int          batch_idx;
+    unsigned int          nbr_idx;
+    struct timespec       ts_start, ts_end;
+    double                elapsed_ms;
+
+    for (nbr_count = 0; nbr_count < max_neighbors; nbr_count++) {
+        snprintf (ip_str [nbr_count], INET_ADDRSTRLEN, "12.%u.%u.%u",
+                  (nbr_count >> 16) & 0xff, (nbr_count >> 8) & 0xff,
+                  (nbr_count & 0xff) + 1);
+        snprintf (mac_str [nbr_count], mac_str_len,
+                  "00:d1:d2:%02x:%02x:%02x", (nbr_count >> 16) & 0xff,
+                  (nbr_count >> 8) & 0xff, nbr_count & 0xff);
+
+        status = sai_test_neighbor_create (vlan_rif_id, ip_af,
+                                           ip_str [nbr_count],
+                                           default_neighbor_attr_count,
+                                           SAI_NEIGHBOR_ENTRY_ATTR_DST_MAC_ADDRESS,
+                                           mac_str [nbr_count]);
+
+        /* Stop at the neighbor table size supported by the NPU */
+        if (status != SAI_STATUS_SUCCESS) {
+            break;
+        }
+    }
+
+    ASSERT_NE (0, nbr_count);
+
+    memset (fdb_upd, 0, sizeof (fdb_upd));
+
+    clock_gettime (CLOCK_MONOTONIC, &ts_start);
+
+    for (event_idx = 0; event_idx < fdb_event_count;
+         event_idx += fdb_event_batch) {
+
+        for (batch_idx = 0; batch_idx < fdb_event_batch; batch_idx++) {
+            nbr_idx = ((event_idx + batch_idx) * 7919) % nbr_count;
+
+            fdb_upd [batch_idx].fdb_event = SAI_FDB_EVENT_LEARNED;
+            fdb_upd [batch_idx].fdb_entry.vlan_id = default_vlan;
+            fdb_upd [batch_idx].fdb_entry.mac_address [0] = 0x00;
+            fdb_upd [batch_idx].fdb_entry.mac_address [1] = 0xd1;
+            fdb_upd [batch_idx].fdb_entry.mac_address [2] = 0xd2;
+            fdb_upd [batch_idx].fdb_entry.mac_address [3] = (nbr_idx >> 16) & 0xff;
+            fdb_upd [batch_idx].fdb_entry.mac_address [4] = (nbr_idx >> 8) & 0xff;
+            fdb_upd [batch_idx].fdb_entry.mac_address [5] = nbr_idx & 0xff;
+            fdb_upd [batch_idx].port_id = (((event_idx + batch_idx) & 1) ?
+                                           move_port_id : default_port_id);
+        }
+
+        EXPECT_EQ (SAI_STATUS_SUCCESS,
+                   sai_neighbor_fdb_callback (fdb_event_batch, fdb_upd));
+    }
+
+    clock_gettime (CLOCK_MONOTONIC, &ts_end);
+
+    elapsed_ms = ((ts_end.tv_sec - ts_start.tv_sec) * 1000.0) +
+        ((ts_end.tv_nsec - ts_start.tv_nsec) / 1000000.0);
+
+    printf ("Replayed %u FDB move events against %u neighbors in %.2f ms "
+            "(%.0f events/sec)\n", fdb_event_count, nbr_count, elapsed_ms,
+            (elapsed_ms > 0) ? (fdb_event_count * 1000.0 / elapsed_ms) : 0);
+
+    for (nbr_idx = 0; nbr_idx < nbr_count; nbr_idx++) {
+        EXPECT_EQ (SAI_STATUS_SUCCESS,
+                   sai_test_neighbor_remove (vlan_rif_id, ip_af,
+                                             ip_str [nbr_idx]));
+    }
+}
+
+/*
+ * Validates bulk Neighbor creation and removal with per entry status and
+ * removal of all the neighbors on a router interface.
+ */
+TEST_F (saiL3NeighborTest, bulk_create_remove_and_remove_all_on_rif)
+{
+    static const unsigned int nbr_count = 16;
+    sai_ip_addr_family_t  ip_af = SAI_IP_ADDR_FAMILY_IPV4;
+    sai_neighbor_entry_t  nbr_entry [nbr_count];
+    sai_attribute_t       attr [nbr_count];
+    const sai_attribute_t *attr_list [nbr_count];
+    uint32_t              attr_count [nbr_count];
+    sai_status_t          nbr_status [nbr_count];
+    char                  ip_str [nbr_count][INET_ADDRSTRLEN];
+    char                  mac_str [nbr_count][18];
+    unsigned int          idx;
+
+    for (idx = 0; idx < nbr_count; idx++) {
+        snprintf (ip_str [idx], INET_ADDRSTRLEN, "13.0.0.%u", idx + 1);
+        snprintf (mac_str [idx], sizeof (mac_str [idx]),
+                  "00:e1:e2:e3:e4:%02x", idx);
+
+        memset (&nbr_entry [idx], 0, sizeof (sai_neighbor_entry_t));
+        nbr_entry [idx].rif_id = port_rif_id;
+        nbr_entry [idx].ip_address.addr_family = ip_af;
+        inet_pton (AF_INET, ip_str [idx],
+                   (void *) &nbr_entry [idx].ip_address.addr.ip4);
+
+        memset (&attr [idx], 0, sizeof (sai_attribute_t));
+        attr [idx].id = SAI_NEIGHBOR_ENTRY_ATTR_DST_MAC_ADDRESS;
+        sai_test_router_mac_str_to_bytes_get (mac_str [idx],
+                                              attr [idx].value.mac);
+
+        attr_list [idx] = &attr [idx];
+        attr_count [idx] = 1;
+    }
+
+    ASSERT_EQ (SAI_STATUS_SUCCESS,
+               sai_fib_neighbor_bulk_create (nbr_count, nbr_entry, attr_count,
+                                             attr_list, false, nbr_status));
+
+    for (idx = 0; idx < nbr_count; idx++) {
+        EXPECT_EQ (SAI_STATUS_SUCCESS, nbr_status [idx]);
+
+        sai_neighbor_verify_after_creation (port_rif_id, ip_af, ip_str [idx],
+                                            mac_str [idx], default_pkt_action);
+    }
+
+    /* Duplicate entry fails, remaining entries are not executed */
+    EXPECT_NE (SAI_STATUS_SUCCESS,
+               sai_fib_neighbor_bulk_create (2, nbr_entry, attr_count,
+                                             attr_list, true, nbr_status));
+
+    EXPECT_NE (SAI_STATUS_SUCCESS, nbr_status [0]);
+    EXPECT_EQ (SAI_STATUS_NOT_EXECUTED, nbr_status [1]);
+
+    /* Remove the first half in bulk */
+    EXPECT_EQ (SAI_STATUS_SUCCESS,
+               sai_fib_neighbor_bulk_remove (nbr_count / 2, nbr_entry,
+                                             false, nbr_status));
+
+    for (idx = 0; idx < (nbr_count / 2); idx++) {
+        EXPECT_EQ (SAI_STATUS_SUCCESS, nbr_status [idx]);
+
+        sai_neighbor_verify_after_removal (port_rif_id, ip_af, ip_str [idx]);
+    }
+
+    /* Already removed entries report not found */
+    EXPECT_NE (SAI_STATUS_SUCCESS,
+               sai_fib_neighbor_bulk_remove (1, nbr_entry, false, nbr_status));
+
+    EXPECT_EQ (SAI_STATUS_ITEM_NOT_FOUND, nbr_status [0]);
+
+    /* Remove the rest with a single call on the RIF */
+    EXPECT_EQ (SAI_STATUS_SUCCESS,
+               sai_fib_neighbor_remove_all_on_rif (port_rif_id));
+
+    for (idx = (nbr_count / 2); idx < nbr_count; idx++) {
+        sai_neighbor_verify_after_removal (port_rif_id, ip_af, ip_str [idx]);
+    }
+}
+
 int main (int argc, char **argv)
 {
     ::testing::InitGoogleTest (&argc, argv);
@@ -32,7 +32,9 @@ extern "C" {
 #include "sairouterintf.h"
 #include "sailag.h"
 #include "sai.h"
+#include "sai_l3_api_utils.h"
 #include <string.h>
+#include <time.h>
 }
 
 class saiL3RifTest : public saiL3Test {
@@ -1392,6 +1394,138 @@ TEST_F (saiL3RifTest, rif_lag_member_update)
                 sai_l3_port_id_get(5)));
 }
 
+/*
+ * Create and remove VLAN RIFs on all the 4094 VLANs. Duplicate detection
+ * on RIF create is an indexed lookup, so the time taken for each half of
+ * the VLAN range must be of the same order.
+ */
+TEST_F (saiL3RifTest, rif_vlan_scale_create_and_remove)
+{
+    static const unsigned int max_vlan_id = 4094;
+    sai_status_t     sai_rc = SAI_STATUS_SUCCESS;
+    unsigned int     vlan_id;
+    unsigned int     rif_count = 0;
+    sai_object_id_t  dup_rif_id = 0;
+    static sai_object_id_t rif_id [max_vlan_id + 1];
+    static sai_object_id_t vlan_obj_id [max_vlan_id + 1];
+    struct timespec  ts_start, ts_mid, ts_end;
+    double           first_half_ms, second_half_ms;
+
+    memset (rif_id, 0, sizeof (rif_id));
+    memset (vlan_obj_id, 0, sizeof (vlan_obj_id));
+
+    /* VLANs already created by the test setup are left as is */
+    for (vlan_id = 2; vlan_id <= max_vlan_id; vlan_id++) {
+        if ((vlan_id == test_vlan_id) || (vlan_id == test_vlan_id_2)) {
+            continue;
+        }
+
+        ASSERT_EQ (SAI_STATUS_SUCCESS,
+                   sai_test_vlan_create (&vlan_obj_id [vlan_id], vlan_id));
+    }
+
+    clock_gettime (CLOCK_MONOTONIC, &ts_start);
+
+    for (vlan_id = 1; vlan_id <= max_vlan_id; vlan_id++) {
+
+        if (vlan_id == ((max_vlan_id / 2) + 1)) {
+            clock_gettime (CLOCK_MONOTONIC, &ts_mid);
+        }
+
+        sai_rc = sai_test_rif_create (&rif_id [vlan_id], 3,
+                                      SAI_ROUTER_INTERFACE_ATTR_VIRTUAL_ROUTER_ID,
+                                      vr_id_dflt,
+                                      SAI_ROUTER_INTERFACE_ATTR_TYPE,
+                                      SAI_ROUTER_INTERFACE_TYPE_VLAN,
+                                      SAI_ROUTER_INTERFACE_ATTR_VLAN_ID,
+                                      vlan_id);
+
+        if (vlan_id == test_vlan_id_2) {
+            /* test_vlan_rif exists on this VLAN with the same info */
+            EXPECT_EQ (SAI_STATUS_ITEM_ALREADY_EXISTS, sai_rc);
+
+            rif_id [vlan_id] = SAI_NULL_OBJECT_ID;
+            rif_count++;
+            continue;
+        }
+
+        ASSERT_EQ (SAI_STATUS_SUCCESS, sai_rc);
+
+        rif_count++;
+    }
+
+    clock_gettime (CLOCK_MONOTONIC, &ts_end);
+
+    EXPECT_EQ (max_vlan_id, rif_count);
+
+    /* Each VLAN resolves to its VLAN RIF through the RIF index */
+    for (vlan_id = 1; vlan_id <= max_vlan_id; vlan_id++) {
+        sai_fib_router_interface_t *p_rif_node =
+                                     sai_fib_vlan_rif_node_get (vlan_id);
+
+        ASSERT_TRUE (p_rif_node != NULL);
+        EXPECT_EQ (SAI_ROUTER_INTERFACE_TYPE_VLAN, p_rif_node->type);
+        EXPECT_EQ (vlan_id, p_rif_node->attachment.vlan_id);
+
+        if (rif_id [vlan_id] != SAI_NULL_OBJECT_ID) {
+            EXPECT_EQ (rif_id [vlan_id], p_rif_node->rif_id);
+        }
+    }
+
+    first_half_ms = ((ts_mid.tv_sec - ts_start.tv_sec) * 1000.0) +
+        ((ts_mid.tv_nsec - ts_start.tv_nsec) / 1000000.0);
+    second_half_ms = ((ts_end.tv_sec - ts_mid.tv_sec) * 1000.0) +
+        ((ts_end.tv_nsec - ts_mid.tv_nsec) / 1000000.0);
+
+    printf ("VLAN RIF create: %u RIFs, first half %.2f ms, "
+            "second half %.2f ms\r\n", rif_count, first_half_ms,
+            second_half_ms);
+
+    /* Duplicate VLAN RIF on a different VRF must be detected */
+    sai_rc = sai_test_rif_create (&dup_rif_id, 3,
+                                  SAI_ROUTER_INTERFACE_ATTR_VIRTUAL_ROUTER_ID,
+                                  vr_id_with_mac_attr,
+                                  SAI_ROUTER_INTERFACE_ATTR_TYPE,
+                                  SAI_ROUTER_INTERFACE_TYPE_VLAN,
+                                  SAI_ROUTER_INTERFACE_ATTR_VLAN_ID,
+                                  max_vlan_id);
+
+    EXPECT_EQ (SAI_STATUS_ITEM_ALREADY_EXISTS, sai_rc);
+
+    for (vlan_id = 1; vlan_id <= max_vlan_id; vlan_id++) {
+        if (rif_id [vlan_id] != SAI_NULL_OBJECT_ID) {
+            EXPECT_EQ (SAI_STATUS_SUCCESS, sai_test_rif_remove (rif_id [vlan_id]));
+        }
+
+        if (vlan_obj_id [vlan_id] != SAI_NULL_OBJECT_ID) {
+            EXPECT_EQ (SAI_STATUS_SUCCESS,
+                       sai_test_vlan_remove (vlan_obj_id [vlan_id]));
+        }
+    }
+
+    /* Removed VLAN RIFs are no longer found in the RIF index */
+    for (vlan_id = 1; vlan_id <= max_vlan_id; vlan_id++) {
+        if ((vlan_id == test_vlan_id) || (vlan_id == test_vlan_id_2)) {
+            continue;
+        }
+
+        EXPECT_TRUE (sai_fib_vlan_rif_node_get (vlan_id) == NULL);
+    }
+
+    /* VLAN RIF can be created again once removed */
+    sai_rc = sai_test_rif_create (&dup_rif_id, 3,
+                                  SAI_ROUTER_INTERFACE_ATTR_VIRTUAL_ROUTER_ID,
+                                  vr_id_with_mac_attr,
+                                  SAI_ROUTER_INTERFACE_ATTR_TYPE,
+                                  SAI_ROUTER_INTERFACE_TYPE_VLAN,
+                                  SAI_ROUTER_INTERFACE_ATTR_VLAN_ID,
+                                  test_vlan_id);
+
+    EXPECT_EQ (SAI_STATUS_SUCCESS, sai_rc);
+
+    EXPECT_EQ (SAI_STATUS_SUCCESS, sai_test_rif_remove (dup_rif_id));
+}
+
 int main (int argc, char **argv)
 {
     ::testing::InitGoogleTest(&argc, argv);
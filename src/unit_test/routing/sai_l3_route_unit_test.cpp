@@ -32,6 +32,7 @@ extern "C" {
 #include "saivlan.h"
 #include "sailag.h"
 #include "sai.h"
+#include "sai_api_latency.h"
 #include <stdio.h>
 }
 
@@ -1110,6 +1111,115 @@ TEST_F (saiL3RouteTest, route_next_hop_with_no_host_route_attr)
     EXPECT_EQ (SAI_STATUS_SUCCESS, sai_rc);
 }
 
+static uint64_t sai_test_latency_hist_sum (const uint64_t *hist)
+{
+    uint64_t     sum = 0;
+    unsigned int bucket;
+
+    for (bucket = 0; bucket < SAI_API_LATENCY_HIST_BUCKETS; bucket++) {
+        sum += hist [bucket];
+    }
+
+    return sum;
+}
+
+/*
+ * Checks that the API latency layer records one histogram sample per
+ * wrapped route API call, counts errors and records nothing when disabled.
+ */
+TEST_F (saiL3RouteTest, route_api_latency_histogram)
+{
+    sai_status_t          sai_rc = SAI_STATUS_SUCCESS;
+    const unsigned int    route_count = 8;
+    unsigned int          prefix_len = 24;
+    sai_ip_addr_family_t  family = SAI_IP_ADDR_FAMILY_IPV4;
+    char                  prefix_str [32];
+    uint32_t              count = 0;
+    unsigned int          itr;
+    static sai_api_latency_stats_t stats [SAI_API_LATENCY_FUNC_MAX];
+    const sai_api_latency_stats_t *p_create =
+                                     &stats [SAI_API_LATENCY_ROUTE_CREATE];
+    const sai_api_latency_stats_t *p_remove =
+                                     &stats [SAI_API_LATENCY_ROUTE_REMOVE];
+
+    sai_rc = sai_api_latency_stats_get (&count, NULL);
+
+    EXPECT_EQ (SAI_STATUS_BUFFER_OVERFLOW, sai_rc);
+    EXPECT_EQ (SAI_API_LATENCY_FUNC_MAX, count);
+
+    sai_api_latency_reset ();
+    sai_api_latency_enable (true);
+
+    for (itr = 0; itr < route_count; itr++) {
+        snprintf (prefix_str, sizeof (prefix_str), "70.1.%u.0", itr);
+
+        sai_rc = sai_test_route_create (vr_id, family, prefix_str, prefix_len,
+                                        1, SAI_ROUTE_ENTRY_ATTR_NEXT_HOP_ID,
+                                        nh_id_1);
+        EXPECT_EQ (SAI_STATUS_SUCCESS, sai_rc);
+    }
+
+    /* Duplicate create is recorded as an error */
+    sai_rc = sai_test_route_create (vr_id, family, prefix_str, prefix_len,
+                                    1, SAI_ROUTE_ENTRY_ATTR_NEXT_HOP_ID,
+                                    nh_id_1);
+    EXPECT_EQ (SAI_STATUS_ITEM_ALREADY_EXISTS, sai_rc);
+
+    for (itr = 0; itr < route_count; itr++) {
+        snprintf (prefix_str, sizeof (prefix_str), "70.1.%u.0", itr);
+
+        sai_rc = sai_test_route_remove (vr_id, family, prefix_str, prefix_len);
+        EXPECT_EQ (SAI_STATUS_SUCCESS, sai_rc);
+    }
+
+    sai_api_latency_enable (false);
+
+    /* Calls made while the layer is disabled are not recorded */
+    sai_rc = sai_test_route_create (vr_id, family, prefix_str, prefix_len,
+                                    1, SAI_ROUTE_ENTRY_ATTR_NEXT_HOP_ID,
+                                    nh_id_1);
+    EXPECT_EQ (SAI_STATUS_SUCCESS, sai_rc);
+
+    sai_rc = sai_test_route_remove (vr_id, family, prefix_str, prefix_len);
+    EXPECT_EQ (SAI_STATUS_SUCCESS, sai_rc);
+
+    count = SAI_API_LATENCY_FUNC_MAX;
+    sai_rc = sai_api_latency_stats_get (&count, stats);
+
+    ASSERT_EQ (SAI_STATUS_SUCCESS, sai_rc);
+    ASSERT_EQ (SAI_API_LATENCY_FUNC_MAX, count);
+
+    EXPECT_EQ ((route_count + 1), p_create->call_count);
+    EXPECT_EQ (1, p_create->error_count);
+    EXPECT_EQ (p_create->call_count,
+               sai_test_latency_hist_sum (p_create->common_hist));
+
+    /* Only the successful creates reach the NPU */
+    EXPECT_EQ (route_count, sai_test_latency_hist_sum (p_create->npu_hist));
+    EXPECT_GE (p_create->npu_call_count, route_count);
+    EXPECT_GE (p_create->total_ns, p_create->max_ns);
+    EXPECT_GE (p_create->total_ns,
+               (p_create->common_total_ns + p_create->npu_total_ns));
+
+    EXPECT_EQ (route_count, p_remove->call_count);
+    EXPECT_EQ (0, p_remove->error_count);
+    EXPECT_EQ (route_count, sai_test_latency_hist_sum (p_remove->common_hist));
+    EXPECT_EQ (route_count, sai_test_latency_hist_sum (p_remove->npu_hist));
+
+    EXPECT_EQ (0, stats [SAI_API_LATENCY_ROUTE_SET].call_count);
+
+    /* Reset clears the counters and the histograms */
+    sai_api_latency_reset ();
+
+    sai_rc = sai_api_latency_stats_get (&count, stats);
+
+    ASSERT_EQ (SAI_STATUS_SUCCESS, sai_rc);
+    EXPECT_EQ (0, p_create->call_count);
+    EXPECT_EQ (0, p_create->max_ns);
+    EXPECT_EQ (0, sai_test_latency_hist_sum (p_create->common_hist));
+    EXPECT_EQ (0, sai_test_latency_hist_sum (p_create->npu_hist));
+}
+
 int main (int argc, char **argv)
 {
     ::testing::InitGoogleTest(&argc, argv);
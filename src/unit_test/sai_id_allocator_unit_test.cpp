@@ -0,0 +1,182 @@
+/*
+ * Copyright (c) 2016 Dell Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * THIS CODE IS PROVIDED ON AN *AS IS* BASIS, WITHOUT WARRANTIES OR
+ * CONDITIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING WITHOUT
+ * LIMITATION ANY IMPLIED WARRANTIES OR CONDITIONS OF TITLE, FITNESS
+ * FOR A PARTICULAR PURPOSE, MERCHANTABLITY OR NON-INFRINGEMENT.
+ *
+ * See the Apache Version 2.0 License for specific language governing
+ * permissions and limitations under the License.
+ */
+
+/**
+ * @file sai_id_allocator_unit_test.cpp
+ *
+ * @brief This file contains the google unit test cases for the bitmap
+ *        based object Id allocator.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+#include "gtest/gtest.h"
+
+extern "C" {
+#include "sai.h"
+#include "sai_id_allocator.h"
+}
+
+/* Id spaces of the modules using the allocator */
+static const char *sai_test_id_space_name [] = {
+    "nh_grp_member", "stp_port", "tunnel_map", "tunnel_map_entry",
+    "acl_counter", "acl_range", "acl_table_group", "acl_table_group_member",
+    "port_pool",
+};
+
+static const unsigned int sai_test_churn_count = 1000000;
+
+/*
+ * Fill the Id space, verify it is exhausted and then churn it by freeing
+ * and allocating random Ids. With a single free Id, the allocator must
+ * return exactly that Id.
+ */
+static void sai_test_id_space_fill_and_churn (const char *name, uint64_t max_id)
+{
+    sai_id_allocator_t allocator;
+    uint64_t           id = 0;
+    uint64_t           free_id;
+    uint64_t           index;
+    unsigned int       churn;
+
+    memset (&allocator, 0, sizeof (allocator));
+
+    ASSERT_EQ (SAI_STATUS_SUCCESS, sai_id_allocator_init (&allocator, name, max_id));
+
+    for (index = 1; index <= max_id; index++) {
+        ASSERT_EQ (SAI_STATUS_SUCCESS, sai_id_allocator_alloc (&allocator, &id));
+        ASSERT_EQ (index, id);
+    }
+
+    EXPECT_EQ (SAI_STATUS_INSUFFICIENT_RESOURCES,
+               sai_id_allocator_alloc (&allocator, &id));
+    EXPECT_EQ (max_id, sai_id_allocator_used_count_get (&allocator));
+
+    srand (max_id);
+
+    for (churn = 0; churn < sai_test_churn_count; churn++) {
+        free_id = 1 + ((uint64_t) rand () % max_id);
+
+        ASSERT_EQ (SAI_STATUS_SUCCESS, sai_id_allocator_free (&allocator, free_id));
+        ASSERT_FALSE (sai_id_allocator_is_allocated (&allocator, free_id));
+
+        ASSERT_EQ (SAI_STATUS_SUCCESS, sai_id_allocator_alloc (&allocator, &id));
+        ASSERT_EQ (free_id, id);
+    }
+
+    EXPECT_EQ (max_id, sai_id_allocator_used_count_get (&allocator));
+
+    /* Free every other Id and verify only those are handed out again */
+    for (index = 1; index <= max_id; index += 2) {
+        ASSERT_EQ (SAI_STATUS_SUCCESS, sai_id_allocator_free (&allocator, index));
+    }
+
+    for (index = 1; index <= max_id; index += 2) {
+        ASSERT_EQ (SAI_STATUS_SUCCESS, sai_id_allocator_alloc (&allocator, &id));
+        ASSERT_EQ (1u, (id % 2));
+    }
+
+    EXPECT_EQ (SAI_STATUS_INSUFFICIENT_RESOURCES,
+               sai_id_allocator_alloc (&allocator, &id));
+
+    sai_id_allocator_deinit (&allocator);
+}
+
+TEST (sai_id_allocator_test, fill_and_churn_id_spaces)
+{
+    unsigned int index;
+
+    for (index = 0; index < (sizeof (sai_test_id_space_name) /
+                             sizeof (sai_test_id_space_name [0])); index++) {
+
+        printf ("Id space %s.\n", sai_test_id_space_name [index]);
+
+        sai_test_id_space_fill_and_churn (sai_test_id_space_name [index],
+                                          SAI_ID_ALLOCATOR_MAX_IDS);
+    }
+}
+
+TEST (sai_id_allocator_test, fill_and_churn_partial_words)
+{
+    const uint64_t max_ids [] = {1, 63, 64, 65, 4095, 4097, 100000, 262145};
+    unsigned int   index;
+
+    for (index = 0; index < (sizeof (max_ids) / sizeof (max_ids [0])); index++) {
+        sai_test_id_space_fill_and_churn ("partial", max_ids [index]);
+    }
+}
+
+/*
+ * Ids are handed out round robin, a freed Id is not reused until the rest
+ * of the range is used.
+ */
+TEST (sai_id_allocator_test, round_robin_alloc)
+{
+    sai_id_allocator_t allocator;
+    uint64_t           id = 0;
+
+    memset (&allocator, 0, sizeof (allocator));
+
+    ASSERT_EQ (SAI_STATUS_SUCCESS, sai_id_allocator_init (&allocator, "rr", 128));
+
+    ASSERT_EQ (SAI_STATUS_SUCCESS, sai_id_allocator_alloc (&allocator, &id));
+    ASSERT_EQ (1u, id);
+    ASSERT_EQ (SAI_STATUS_SUCCESS, sai_id_allocator_free (&allocator, id));
+
+    ASSERT_EQ (SAI_STATUS_SUCCESS, sai_id_allocator_alloc (&allocator, &id));
+    EXPECT_EQ (2u, id);
+
+    sai_id_allocator_deinit (&allocator);
+}
+
+/*
+ * Ranges up to SAI_ID_ALLOCATOR_MAX_IDS are accepted, the QoS map shared Id
+ * range of 0xfffff Ids needs the fourth bitmap level.
+ */
+TEST (sai_id_allocator_test, max_id_cap)
+{
+    sai_id_allocator_t allocator;
+    uint64_t           id = 0;
+
+    memset (&allocator, 0, sizeof (allocator));
+
+    EXPECT_EQ (SAI_STATUS_INVALID_PARAMETER,
+               sai_id_allocator_init (&allocator, "cap", 0));
+    EXPECT_EQ (SAI_STATUS_INVALID_PARAMETER,
+               sai_id_allocator_init (&allocator, "cap",
+                                      SAI_ID_ALLOCATOR_MAX_IDS + 1));
+
+    ASSERT_EQ (SAI_STATUS_SUCCESS,
+               sai_id_allocator_init (&allocator, "cap", 0xfffff));
+
+    ASSERT_EQ (SAI_STATUS_SUCCESS, sai_id_allocator_alloc (&allocator, &id));
+    EXPECT_EQ (1u, id);
+
+    EXPECT_EQ (SAI_STATUS_INVALID_PARAMETER,
+               sai_id_allocator_free (&allocator, 0x100000));
+    EXPECT_EQ (SAI_STATUS_INVALID_PARAMETER,
+               sai_id_allocator_free (&allocator, 0));
+
+    sai_id_allocator_deinit (&allocator);
+}
+
+int main (int argc, char **argv)
+{
+    ::testing::InitGoogleTest (&argc, argv);
+
+    return RUN_ALL_TESTS ();
+}
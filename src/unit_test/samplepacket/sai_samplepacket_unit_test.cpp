@@ -304,6 +304,105 @@ TEST_F(samplepacketTest, flow_based) {
     EXPECT_EQ (SAI_STATUS_SUCCESS, sai_rc);
 }
 
+/*
+ * Multiple ACL rules without INPORTS share a single all ports binding of the
+ * samplepacket session. A different session cannot be applied on all the
+ * ports or on a port list while the binding exists.
+ */
+TEST_F(samplepacketTest, flow_based_all_ports_shared) {
+    static const unsigned int rule_count = 64;
+    sai_object_id_t acl_table_id;
+    sai_object_id_t acl_rule_id[rule_count];
+    sai_object_id_t acl_rule_id_dup;
+    sai_object_id_t session_id;
+    sai_object_id_t session_id_dup;
+    sai_attribute_t rule_attr[10] = {0};
+    sai_attribute_t table_attr[12] = {0};
+    sai_status_t sai_rc = SAI_STATUS_SUCCESS;
+    sai_attribute_t attr[SAI_SAMPLE_NO_OF_MANDAT_ATTRIB + 1] = {0};
+    unsigned int idx;
+
+    attr[0].id =  SAI_SAMPLEPACKET_ATTR_SAMPLE_RATE;
+    attr[0].value.u32 = 2048;
+
+    sai_rc = sai_test_samplepacket_session_create (&session_id, SAI_SAMPLE_NO_OF_MANDAT_ATTRIB, attr);
+
+    EXPECT_EQ (SAI_STATUS_SUCCESS, sai_rc);
+
+    attr[0].value.u32 = 100;
+
+    sai_rc = sai_test_samplepacket_session_create (&session_id_dup, SAI_SAMPLE_NO_OF_MANDAT_ATTRIB, attr);
+
+    EXPECT_EQ (SAI_STATUS_SUCCESS, sai_rc);
+
+    table_attr[0].id = SAI_ACL_TABLE_ATTR_ACL_STAGE;
+    table_attr[0].value.s32= 0;
+    table_attr[1].id =  SAI_ACL_TABLE_ATTR_PRIORITY;
+    table_attr[1].value.u32 = 1;
+    table_attr[2].id = SAI_ACL_TABLE_ATTR_FIELD_SRC_MAC;
+    table_attr[3].id = SAI_ACL_TABLE_ATTR_FIELD_DST_MAC;
+    table_attr[4].id = SAI_ACL_TABLE_ATTR_FIELD_ETHER_TYPE;
+    table_attr[5].id = SAI_ACL_TABLE_ATTR_FIELD_ACL_IP_TYPE;
+    table_attr[6].id = SAI_ACL_TABLE_ATTR_FIELD_INNER_VLAN_ID;
+    table_attr[7].id = SAI_ACL_TABLE_ATTR_FIELD_INNER_VLAN_PRI;
+    table_attr[8].id = SAI_ACL_TABLE_ATTR_FIELD_INNER_VLAN_CFI;
+    table_attr[9].id = SAI_ACL_TABLE_ATTR_FIELD_IP_PROTOCOL;
+    table_attr[10].id = SAI_ACL_ENTRY_ATTR_FIELD_IN_PORT;
+    table_attr[11].id = SAI_ACL_ENTRY_ATTR_FIELD_IN_PORTS;
+    sai_rc = p_sai_acl_api_tbl->create_acl_table (&acl_table_id, switch_id, 12,
+                                                  table_attr);
+    EXPECT_EQ (SAI_STATUS_SUCCESS, sai_rc);
+
+    rule_attr[0].id = SAI_ACL_ENTRY_ATTR_TABLE_ID;
+    rule_attr[0].value.oid = acl_table_id;
+    rule_attr[1].id =  SAI_ACL_ENTRY_ATTR_PRIORITY;
+    rule_attr[2].id = SAI_ACL_ENTRY_ATTR_ADMIN_STATE;
+    rule_attr[2].value.booldata= true;
+    rule_attr[3].id = SAI_ACL_ENTRY_ATTR_FIELD_IP_PROTOCOL;
+    rule_attr[3].value.aclfield.enable = true;
+    rule_attr[3].value.aclfield.mask.u8 = 0xff;
+    rule_attr[4].id = SAI_ACL_ENTRY_ATTR_ACTION_INGRESS_SAMPLEPACKET_ENABLE;
+    rule_attr[4].value.aclaction.enable = true;
+    rule_attr[4].value.aclaction.parameter.oid = session_id;
+
+    for (idx = 0; idx < rule_count; idx++) {
+        rule_attr[1].value.u32 = idx + 1;
+        rule_attr[3].value.aclfield.data.u8 = idx;
+        sai_rc = p_sai_acl_api_tbl->create_acl_entry (&acl_rule_id[idx], switch_id, 5,
+                                                      rule_attr);
+        ASSERT_EQ (SAI_STATUS_SUCCESS, sai_rc);
+    }
+
+    /* Different session on all the ports */
+    rule_attr[1].value.u32 = rule_count + 1;
+    rule_attr[4].value.aclaction.parameter.oid = session_id_dup;
+    sai_rc = p_sai_acl_api_tbl->create_acl_entry (&acl_rule_id_dup, switch_id, 5, rule_attr);
+    EXPECT_NE (SAI_STATUS_SUCCESS, sai_rc);
+
+    /* Different session on a port list */
+    rule_attr[3].id = SAI_ACL_ENTRY_ATTR_FIELD_IN_PORTS;
+    rule_attr[3].value.aclfield.data.objlist.count = 1;
+    rule_attr[3].value.aclfield.data.objlist.list = &port_id_1;
+    sai_rc = p_sai_acl_api_tbl->create_acl_entry (&acl_rule_id_dup, switch_id, 5, rule_attr);
+    EXPECT_NE (SAI_STATUS_SUCCESS, sai_rc);
+
+    /* Binding is released with the last rule */
+    for (idx = 0; idx < rule_count; idx++) {
+        EXPECT_EQ (SAI_STATUS_SUCCESS, p_sai_acl_api_tbl->remove_acl_entry(acl_rule_id[idx]));
+    }
+
+    sai_rc = p_sai_acl_api_tbl->create_acl_entry (&acl_rule_id_dup, switch_id, 5, rule_attr);
+    EXPECT_EQ (SAI_STATUS_SUCCESS, sai_rc);
+
+    EXPECT_EQ (SAI_STATUS_SUCCESS, p_sai_acl_api_tbl->remove_acl_entry(acl_rule_id_dup));
+
+    EXPECT_EQ (SAI_STATUS_SUCCESS, p_sai_acl_api_tbl->remove_acl_table (acl_table_id));
+
+    EXPECT_EQ (SAI_STATUS_SUCCESS, sai_test_samplepacket_session_destroy (session_id));
+
+    EXPECT_EQ (SAI_STATUS_SUCCESS, sai_test_samplepacket_session_destroy (session_id_dup));
+}
+
 TEST_F(samplepacketTest, flow_based_set) {
     sai_object_id_t acl_table_id;
     sai_object_id_t acl_rule_id;
@@ -699,6 +798,98 @@ TEST_F(samplepacketTest, flow_based_duplicate) {
     EXPECT_EQ (SAI_STATUS_SUCCESS, sai_rc);
 }
 
+TEST_F(samplepacketTest, flow_based_all_ports_breakout) {
+    sai_object_id_t acl_table_id;
+    sai_object_id_t acl_rule_id;
+    sai_object_id_t session_id;
+    sai_object_id_t old_port_id = port_id_2;
+    sai_object_id_t new_port_list[4] = {0};
+    uint32_t lane_list[4] = {0};
+    uint32_t lane_count = 0;
+    uint32_t speed = 0;
+    uint32_t lane = 0;
+    sai_attribute_t rule_attr[10] = {0};
+    sai_attribute_t table_attr[12] = {0};
+    sai_status_t sai_rc = SAI_STATUS_SUCCESS;
+    sai_attribute_t attr[SAI_SAMPLE_NO_OF_MANDAT_ATTRIB + 1] = {0};
+
+    attr[0].id =  SAI_SAMPLEPACKET_ATTR_SAMPLE_RATE;
+    attr[0].value.u32 = 2048;
+
+    sai_rc = sai_test_samplepacket_session_create (&session_id, SAI_SAMPLE_NO_OF_MANDAT_ATTRIB, attr);
+
+    EXPECT_EQ (SAI_STATUS_SUCCESS, sai_rc);
+
+    table_attr[0].id = SAI_ACL_TABLE_ATTR_ACL_STAGE;
+    table_attr[0].value.s32= 0;
+    table_attr[1].id =  SAI_ACL_TABLE_ATTR_PRIORITY;
+    table_attr[1].value.u32 = 1;
+    table_attr[2].id = SAI_ACL_TABLE_ATTR_FIELD_SRC_MAC;
+    table_attr[3].id = SAI_ACL_TABLE_ATTR_FIELD_DST_MAC;
+    table_attr[4].id = SAI_ACL_TABLE_ATTR_FIELD_ETHER_TYPE;
+    table_attr[5].id = SAI_ACL_TABLE_ATTR_FIELD_ACL_IP_TYPE;
+    table_attr[6].id = SAI_ACL_TABLE_ATTR_FIELD_INNER_VLAN_ID;
+    table_attr[7].id = SAI_ACL_TABLE_ATTR_FIELD_INNER_VLAN_PRI;
+    table_attr[8].id = SAI_ACL_TABLE_ATTR_FIELD_INNER_VLAN_CFI;
+    table_attr[9].id = SAI_ACL_TABLE_ATTR_FIELD_IP_PROTOCOL;
+    table_attr[10].id = SAI_ACL_ENTRY_ATTR_FIELD_IN_PORT;
+    table_attr[11].id = SAI_ACL_ENTRY_ATTR_FIELD_IN_PORTS;
+    sai_rc = p_sai_acl_api_tbl->create_acl_table (&acl_table_id, switch_id, 12, table_attr);
+    EXPECT_EQ (SAI_STATUS_SUCCESS, sai_rc);
+
+    /* Samplepacket session on all the ports */
+    rule_attr[0].id = SAI_ACL_ENTRY_ATTR_TABLE_ID;
+    rule_attr[0].value.oid = acl_table_id;
+    rule_attr[1].id =  SAI_ACL_ENTRY_ATTR_PRIORITY;
+    rule_attr[1].value.u32 = 1;
+    rule_attr[2].id = SAI_ACL_ENTRY_ATTR_ADMIN_STATE;
+    rule_attr[2].value.booldata = true;
+    rule_attr[3].id = SAI_ACL_ENTRY_ATTR_FIELD_IP_PROTOCOL;
+    rule_attr[3].value.aclfield.enable = true;
+    rule_attr[3].value.aclfield.data.u8 = 6;
+    rule_attr[3].value.aclfield.mask.u8 = 0xff;
+    rule_attr[4].id = SAI_ACL_ENTRY_ATTR_ACTION_INGRESS_SAMPLEPACKET_ENABLE;
+    rule_attr[4].value.aclaction.enable = true;
+    rule_attr[4].value.aclaction.parameter.oid = session_id;
+    sai_rc = p_sai_acl_api_tbl->create_acl_entry (&acl_rule_id, switch_id, 5, rule_attr);
+    EXPECT_EQ (SAI_STATUS_SUCCESS, sai_rc);
+
+    EXPECT_TRUE (sai_test_samplepacket_is_port_sampled (session_id, old_port_id,
+                                                        SAI_SAMPLEPACKET_DIR_INGRESS));
+
+    sai_rc = sai_test_samplepacket_port_breakout (old_port_id, &lane_count, lane_list,
+                                                  &speed, new_port_list);
+    ASSERT_EQ (SAI_STATUS_SUCCESS, sai_rc);
+
+    /* Removed port is released and the new ports inherit the session */
+    EXPECT_FALSE (sai_test_samplepacket_is_port_sampled (session_id, old_port_id,
+                                                         SAI_SAMPLEPACKET_DIR_INGRESS));
+
+    for (lane = 0; lane < lane_count; lane++) {
+        EXPECT_TRUE (sai_test_samplepacket_is_port_sampled (session_id, new_port_list[lane],
+                                                            SAI_SAMPLEPACKET_DIR_INGRESS));
+    }
+
+    sai_rc = sai_test_samplepacket_port_breakin (lane_count, lane_list, speed,
+                                                 new_port_list, &port_id_2);
+    ASSERT_EQ (SAI_STATUS_SUCCESS, sai_rc);
+
+    for (lane = 0; lane < lane_count; lane++) {
+        EXPECT_FALSE (sai_test_samplepacket_is_port_sampled (session_id, new_port_list[lane],
+                                                             SAI_SAMPLEPACKET_DIR_INGRESS));
+    }
+
+    EXPECT_TRUE (sai_test_samplepacket_is_port_sampled (session_id, port_id_2,
+                                                        SAI_SAMPLEPACKET_DIR_INGRESS));
+
+    EXPECT_EQ (SAI_STATUS_SUCCESS, p_sai_acl_api_tbl->remove_acl_entry(acl_rule_id));
+    EXPECT_EQ (SAI_STATUS_SUCCESS, p_sai_acl_api_tbl->remove_acl_table (acl_table_id));
+
+    EXPECT_FALSE (sai_test_samplepacket_is_port_sampled (session_id, port_id_2,
+                                                         SAI_SAMPLEPACKET_DIR_INGRESS));
+
+    EXPECT_EQ (SAI_STATUS_SUCCESS, sai_test_samplepacket_session_destroy (session_id));
+}
 
 int main(int argc, char **argv) {
     ::testing::InitGoogleTest(&argc, argv);
@@ -28,6 +28,7 @@ extern "C" {
 #include "saiacl.h"
 #include "saisamplepacket.h"
 #include "saitypes.h"
+#include "sai_samplepacket_api.h"
 }
 
 class samplepacketTest : public ::testing::Test
@@ -52,7 +53,14 @@ class samplepacketTest : public ::testing::Test
         static sai_status_t sai_test_samplepacket_session_egress_port_get (sai_object_id_t port_id,
         sai_object_id_t sample_object);
         static sai_status_t sai_test_samplepacket_session_destroy (sai_object_id_t session_id);
-        static void sai_test_samplepacket_port_breakout (void);
+        static sai_status_t sai_test_samplepacket_port_breakout (sai_object_id_t port_id,
+        uint32_t *lane_count, uint32_t *lane_list, uint32_t *speed,
+        sai_object_id_t *new_port_list);
+        static sai_status_t sai_test_samplepacket_port_breakin (uint32_t lane_count,
+        uint32_t *lane_list, uint32_t speed, sai_object_id_t *port_list,
+        sai_object_id_t *p_port_id);
+        static bool sai_test_samplepacket_is_port_sampled (sai_object_id_t session_id,
+        sai_object_id_t port_id, sai_samplepacket_direction_t direction);
         static sai_object_id_t port_id_1;
         static sai_object_id_t port_id_2;
         static sai_object_id_t switch_id;
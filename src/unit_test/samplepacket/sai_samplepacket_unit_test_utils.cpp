@@ -36,9 +36,11 @@ extern "C" {
 #include "saiswitch.h"
 #include "saisamplepacket.h"
 #include "sai_samplepacket_api.h"
+#include "std_rbtree.h"
 }
 
 #define SAI_MAX_PORTS  256
+#define SAI_MAX_PORT_LANES  4
 
 static uint32_t port_count = 0;
 
@@ -244,3 +246,122 @@ sai_status_t samplepacketTest ::sai_test_samplepacket_session_egress_port_add (s
     return sai_rc;
 }
 
+/*
+ * Breaks out the port into one port per lane. The lanes and the speed of the
+ * port are returned to break the ports back in.
+ */
+sai_status_t samplepacketTest ::sai_test_samplepacket_port_breakout (sai_object_id_t port_id,
+            uint32_t *lane_count, uint32_t *lane_list, uint32_t *speed,
+            sai_object_id_t *new_port_list) {
+
+    sai_status_t sai_rc = SAI_STATUS_SUCCESS;
+    sai_attribute_t attr[2];
+    uint32_t lane = 0;
+
+    memset (attr, 0, sizeof(attr));
+
+    attr[0].id = SAI_PORT_ATTR_HW_LANE_LIST;
+    attr[0].value.u32list.count = SAI_MAX_PORT_LANES;
+    attr[0].value.u32list.list = lane_list;
+    attr[1].id = SAI_PORT_ATTR_SPEED;
+
+    sai_rc = p_sai_port_api_tbl->get_port_attribute (port_id, 2, attr);
+
+    if (sai_rc != SAI_STATUS_SUCCESS) {
+        printf ("Get port attribute API failed with error: %d\r\n", sai_rc);
+        return sai_rc;
+    }
+
+    *lane_count = attr[0].value.u32list.count;
+    *speed = attr[1].value.u32;
+
+    sai_rc = p_sai_port_api_tbl->remove_port (port_id);
+
+    if (sai_rc != SAI_STATUS_SUCCESS) {
+        printf ("Remove port API failed with error: %d\r\n", sai_rc);
+        return sai_rc;
+    }
+
+    for (lane = 0; lane < *lane_count; lane++) {
+        attr[0].value.u32list.count = 1;
+        attr[0].value.u32list.list = &lane_list[lane];
+        attr[1].value.u32 = *speed / *lane_count;
+
+        sai_rc = p_sai_port_api_tbl->create_port (&new_port_list[lane], switch_id, 2, attr);
+
+        if (sai_rc != SAI_STATUS_SUCCESS) {
+            printf ("Create port API failed with error: %d\r\n", sai_rc);
+            return sai_rc;
+        }
+        printf ("Create port API success for port id: %lu\r\n", new_port_list[lane]);
+    }
+
+    return sai_rc;
+}
+
+sai_status_t samplepacketTest ::sai_test_samplepacket_port_breakin (uint32_t lane_count,
+            uint32_t *lane_list, uint32_t speed, sai_object_id_t *port_list,
+            sai_object_id_t *p_port_id) {
+
+    sai_status_t sai_rc = SAI_STATUS_SUCCESS;
+    sai_attribute_t attr[2];
+    uint32_t lane = 0;
+
+    for (lane = 0; lane < lane_count; lane++) {
+        sai_rc = p_sai_port_api_tbl->remove_port (port_list[lane]);
+
+        if (sai_rc != SAI_STATUS_SUCCESS) {
+            printf ("Remove port API failed with error: %d\r\n", sai_rc);
+            return sai_rc;
+        }
+    }
+
+    memset (attr, 0, sizeof(attr));
+
+    attr[0].id = SAI_PORT_ATTR_HW_LANE_LIST;
+    attr[0].value.u32list.count = lane_count;
+    attr[0].value.u32list.list = lane_list;
+    attr[1].id = SAI_PORT_ATTR_SPEED;
+    attr[1].value.u32 = speed;
+
+    sai_rc = p_sai_port_api_tbl->create_port (p_port_id, switch_id, 2, attr);
+
+    if (sai_rc != SAI_STATUS_SUCCESS) {
+        printf ("Create port API failed with error: %d\r\n", sai_rc);
+    } else {
+        printf ("Create port API success for port id: %lu\r\n", *p_port_id);
+    }
+
+    return sai_rc;
+}
+
+/*
+ * Checks whether the port is attached to the samplepacket session
+ * in the given direction.
+ */
+bool samplepacketTest ::sai_test_samplepacket_is_port_sampled (sai_object_id_t session_id,
+            sai_object_id_t port_id, sai_samplepacket_direction_t direction) {
+
+    dn_sai_samplepacket_session_info_t *p_session_info = NULL;
+    dn_sai_samplepacket_port_info_t    *p_port_node = NULL;
+    dn_sai_samplepacket_port_info_t     tmp_port_node;
+
+    memset (&tmp_port_node, 0, sizeof(tmp_port_node));
+
+    tmp_port_node.key.samplepacket_port = port_id;
+    tmp_port_node.key.samplepacket_direction = direction;
+
+    sai_samplepacket_lock ();
+
+    p_session_info = (dn_sai_samplepacket_session_info_t *) std_rbtree_getexact (
+                            sai_samplepacket_sessions_db_get(), (void *)&session_id);
+
+    if (p_session_info != NULL) {
+        p_port_node = (dn_sai_samplepacket_port_info_t *) std_rbtree_getexact (
+                            p_session_info->port_tree, (void *)&tmp_port_node);
+    }
+
+    sai_samplepacket_unlock ();
+
+    return (p_port_node != NULL);
+}
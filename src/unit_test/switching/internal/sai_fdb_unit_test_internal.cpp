@@ -251,3 +251,182 @@ TEST_F(fdbInit, sai_fdb_port_change_notification_callback)
     ASSERT_EQ (SAI_STATUS_SUCCESS,
                sai_l2_deregister_fdb_entry(&fdb_entry));
 }
+
+/* Reports no hit, so every expired entry ages out */
+static void sai_fdb_test_hit_poll_none (uint_t count,
+                                        const sai_fdb_entry_t *fdb_entry_list,
+                                        bool *hit_list)
+{
+    memset (hit_list, 0, count * sizeof (bool));
+}
+
+TEST_F(fdbInit, sai_fdb_sw_aging)
+{
+    sai_fdb_entry_t fdb_entry1;
+    sai_fdb_entry_t fdb_entry2;
+    sai_fdb_sw_aging_stats_t stats;
+    sai_attribute_t attr;
+    uint32_t aging_time = 0;
+    uint64_t aged_count = 0;
+    uint_t wait_sec = 0;
+
+    sai_set_test_registered_entry(0xc,&fdb_entry1);
+    sai_set_test_registered_entry(0xd,&fdb_entry2);
+
+    /* Software aging is refused without hit polling */
+    sai_l2_fdb_register_hit_poll_callback(NULL);
+    ASSERT_EQ (SAI_STATUS_UNINITIALIZED, sai_l2_fdb_sw_aging_enable(true));
+    ASSERT_FALSE (sai_l2_fdb_sw_aging_is_enabled());
+
+    sai_l2_fdb_register_hit_poll_callback(sai_fdb_test_hit_poll_none);
+    ASSERT_EQ (SAI_STATUS_SUCCESS, sai_l2_fdb_sw_aging_enable(true));
+    ASSERT_TRUE (sai_l2_fdb_sw_aging_is_enabled());
+
+    ASSERT_EQ (SAI_STATUS_SUCCESS, sai_l2_fdb_set_aging_time(300));
+    ASSERT_EQ (SAI_STATUS_SUCCESS, sai_l2_fdb_get_aging_time(&aging_time));
+    ASSERT_EQ (300, aging_time);
+
+    ASSERT_EQ (SAI_STATUS_SUCCESS, sai_l2_fdb_sw_aging_port_time_set(port_id_1, 1));
+
+    sai_l2_fdb_sw_aging_stats_get(&stats);
+    aged_count = stats.aged_count;
+
+    sai_fdb_create_registered_entry(fdb_entry1, SAI_FDB_ENTRY_TYPE_DYNAMIC, port_id_1, SAI_PACKET_ACTION_FORWARD);
+    sai_fdb_create_registered_entry(fdb_entry2, SAI_FDB_ENTRY_TYPE_STATIC, port_id_1, SAI_PACKET_ACTION_FORWARD);
+
+    do {
+        sleep(1);
+        sai_l2_fdb_sw_aging_stats_get(&stats);
+        wait_sec++;
+    } while((stats.aged_count == aged_count) && (wait_sec < 5));
+
+    ASSERT_EQ (aged_count + 1, stats.aged_count);
+
+    attr.id = SAI_FDB_ENTRY_ATTR_PORT_ID;
+    ASSERT_NE (SAI_STATUS_SUCCESS,
+               sai_fdb_api_table->get_fdb_entry_attribute(
+                                  (const sai_fdb_entry_t*)&fdb_entry1, 1, &attr));
+    ASSERT_EQ (SAI_STATUS_SUCCESS,
+               sai_fdb_api_table->get_fdb_entry_attribute(
+                                  (const sai_fdb_entry_t*)&fdb_entry2, 1, &attr));
+    ASSERT_EQ (port_id_1, attr.value.oid);
+
+    ASSERT_EQ (SAI_STATUS_SUCCESS,
+               sai_fdb_api_table->remove_fdb_entry(
+                                  (const sai_fdb_entry_t*)&fdb_entry2));
+
+    ASSERT_EQ (SAI_STATUS_SUCCESS,
+               sai_l2_fdb_sw_aging_port_time_set(port_id_1, SAI_FDB_AGING_TIME_INHERIT));
+    ASSERT_EQ (SAI_STATUS_SUCCESS, sai_l2_fdb_sw_aging_enable(false));
+    ASSERT_FALSE (sai_l2_fdb_sw_aging_is_enabled());
+    ASSERT_EQ (SAI_STATUS_SUCCESS, sai_l2_fdb_get_aging_time(&aging_time));
+    ASSERT_EQ (300, aging_time);
+}
+
+/*
+ * An entry learned while the aging time is zero is armed when aging is
+ * turned on, and ages out at the new aging time.
+ */
+TEST_F(fdbInit, sai_fdb_sw_aging_time_rearm)
+{
+    sai_fdb_entry_t fdb_entry;
+    sai_fdb_sw_aging_stats_t stats;
+    sai_attribute_t attr;
+    uint64_t aged_count = 0;
+    uint_t wait_sec = 0;
+
+    sai_set_test_registered_entry(0xe,&fdb_entry);
+
+    sai_l2_fdb_register_hit_poll_callback(sai_fdb_test_hit_poll_none);
+    ASSERT_EQ (SAI_STATUS_SUCCESS, sai_l2_fdb_sw_aging_enable(true));
+    ASSERT_EQ (SAI_STATUS_SUCCESS, sai_l2_fdb_set_aging_time(0));
+
+    sai_l2_fdb_sw_aging_stats_get(&stats);
+    aged_count = stats.aged_count;
+
+    sai_fdb_create_registered_entry(fdb_entry, SAI_FDB_ENTRY_TYPE_DYNAMIC, port_id_1, SAI_PACKET_ACTION_FORWARD);
+
+    sleep(2);
+    sai_l2_fdb_sw_aging_stats_get(&stats);
+    ASSERT_EQ (aged_count, stats.aged_count);
+
+    attr.id = SAI_FDB_ENTRY_ATTR_PORT_ID;
+    ASSERT_EQ (SAI_STATUS_SUCCESS,
+               sai_fdb_api_table->get_fdb_entry_attribute(
+                                  (const sai_fdb_entry_t*)&fdb_entry, 1, &attr));
+
+    ASSERT_EQ (SAI_STATUS_SUCCESS, sai_l2_fdb_set_aging_time(1));
+
+    do {
+        sleep(1);
+        sai_l2_fdb_sw_aging_stats_get(&stats);
+        wait_sec++;
+    } while((stats.aged_count == aged_count) && (wait_sec < 5));
+
+    ASSERT_EQ (aged_count + 1, stats.aged_count);
+    ASSERT_NE (SAI_STATUS_SUCCESS,
+               sai_fdb_api_table->get_fdb_entry_attribute(
+                                  (const sai_fdb_entry_t*)&fdb_entry, 1, &attr));
+
+    ASSERT_EQ (SAI_STATUS_SUCCESS, sai_l2_fdb_set_aging_time(300));
+    ASSERT_EQ (SAI_STATUS_SUCCESS, sai_l2_fdb_sw_aging_enable(false));
+}
+
+TEST_F(fdbInit, sai_fdb_export)
+{
+    sai_fdb_entry_t fdb_entry[4];
+    sai_fdb_export_cursor_t cursor;
+    sai_fdb_export_filter_t filter;
+    sai_fdb_export_entry_t entry_list[2];
+    uint_t count = 0;
+    uint_t total = 0;
+    uint_t idx = 0;
+
+    for(idx = 0; idx < 4; idx++) {
+        sai_set_test_registered_entry(0x20 + idx, &fdb_entry[idx]);
+        sai_fdb_create_registered_entry(fdb_entry[idx], SAI_FDB_ENTRY_TYPE_STATIC,
+                                        (idx % 2) ? port_id_2 : port_id_1,
+                                        SAI_PACKET_ACTION_FORWARD);
+    }
+
+    memset(&filter, 0, sizeof(filter));
+    filter.match_port = true;
+    filter.port_id = port_id_1;
+    filter.match_vlan = true;
+    filter.vlan_id = SAI_GTEST_VLAN;
+
+    sai_l2_fdb_export_start(&cursor, &filter);
+    while(!cursor.done) {
+        ASSERT_EQ(SAI_STATUS_SUCCESS,
+                  sai_l2_fdb_export_next(&cursor, 1, entry_list, &count));
+        for(idx = 0; idx < count; idx++) {
+            ASSERT_EQ(port_id_1, entry_list[idx].port_id);
+            ASSERT_EQ(SAI_GTEST_VLAN, entry_list[idx].fdb_entry.vlan_id);
+        }
+        total += count;
+    }
+    ASSERT_EQ(2, total);
+    ASSERT_TRUE(sai_l2_fdb_export_is_consistent(&cursor));
+
+    /* A change in the middle of the export must be detected */
+    sai_l2_fdb_export_start(&cursor, &filter);
+    ASSERT_EQ(SAI_STATUS_SUCCESS,
+              sai_l2_fdb_export_next(&cursor, 1, entry_list, &count));
+    ASSERT_EQ(1, count);
+    ASSERT_EQ(SAI_STATUS_SUCCESS,
+              sai_fdb_api_table->remove_fdb_entry(
+                                 (const sai_fdb_entry_t*)&fdb_entry[1]));
+    while(!cursor.done) {
+        ASSERT_EQ(SAI_STATUS_SUCCESS,
+                  sai_l2_fdb_export_next(&cursor, 2, entry_list, &count));
+    }
+    ASSERT_FALSE(sai_l2_fdb_export_is_consistent(&cursor));
+
+    for(idx = 0; idx < 4; idx++) {
+        if(idx != 1) {
+            ASSERT_EQ(SAI_STATUS_SUCCESS,
+                      sai_fdb_api_table->remove_fdb_entry(
+                                         (const sai_fdb_entry_t*)&fdb_entry[idx]));
+        }
+    }
+}
@@ -31,8 +31,16 @@ extern "C" {
 #include "saistatus.h"
 #include "saitunnel.h"
 #include "sainexthop.h"
+#include "sai_tunnel_api_utils.h"
+#include "sai_l3_api_utils.h"
 }
 
+#include <string.h>
+#include <stdio.h>
+#include <unistd.h>
+#include <arpa/inet.h>
+#include <map>
+
 /*
  * Validates IP Tunnel object creation and removal.
  */
@@ -109,6 +117,214 @@ TEST_F (saiTunnelTest, create_and_remove_tunnel_term_entry)
     EXPECT_EQ (SAI_STATUS_SUCCESS, status);
 }
 
+/*
+ * Validates Tunnel Termination table entry attribute set and get, and
+ * duplicate key detection on create and set.
+ */
+TEST_F (saiTunnelTest, tunnel_term_entry_attr_set_get)
+{
+    sai_status_t          status;
+    sai_object_id_t       tunnel_id = SAI_NULL_OBJECT_ID;
+    sai_object_id_t       tunnel_term_id = SAI_NULL_OBJECT_ID;
+    sai_object_id_t       tunnel_term_id_2 = SAI_NULL_OBJECT_ID;
+    sai_object_id_t       dup_term_id = SAI_NULL_OBJECT_ID;
+    const char           *tunnel_sip = "10.0.0.1";
+    const char           *tunnel_dip = "20.0.0.1";
+    const char           *new_remote_ip = "20.0.0.2";
+    const char           *next_remote_ip = "20.0.0.3";
+    sai_ip_addr_family_t  ip4_af = SAI_IP_ADDR_FAMILY_IPV4;
+    sai_attribute_t       attr;
+    sai_attribute_t       get_attr [2];
+    struct in_addr        new_remote_addr;
+
+    status = sai_test_tunnel_create (&tunnel_id, dflt_tunnel_obj_attr_count,
+                                     SAI_TUNNEL_ATTR_TYPE,
+                                     SAI_TUNNEL_TYPE_IPINIP,
+                                     SAI_TUNNEL_ATTR_UNDERLAY_INTERFACE,
+                                     dflt_port_rif_id,
+                                     SAI_TUNNEL_ATTR_OVERLAY_INTERFACE,
+                                     dflt_overlay_rif_id,
+                                     SAI_TUNNEL_ATTR_ENCAP_SRC_IP,
+                                     SAI_IP_ADDR_FAMILY_IPV4, tunnel_sip);
+
+    ASSERT_EQ (SAI_STATUS_SUCCESS, status);
+
+    status = sai_test_tunnel_term_entry_create (&tunnel_term_id,
+                                                max_tunnel_term_attr_count,
+                                                SAI_TUNNEL_TERM_TABLE_ENTRY_ATTR_VR_ID,
+                                                dflt_vr_id,
+                                                SAI_TUNNEL_TERM_TABLE_ENTRY_ATTR_TYPE,
+                                                SAI_TUNNEL_TERM_TABLE_ENTRY_TYPE_P2P,
+                                                SAI_TUNNEL_TERM_TABLE_ENTRY_ATTR_DST_IP,
+                                                ip4_af, tunnel_sip,
+                                                SAI_TUNNEL_TERM_TABLE_ENTRY_ATTR_SRC_IP,
+                                                ip4_af, tunnel_dip,
+                                                SAI_TUNNEL_TERM_TABLE_ENTRY_ATTR_TUNNEL_TYPE,
+                                                SAI_TUNNEL_TYPE_IPINIP,
+                                                SAI_TUNNEL_TERM_TABLE_ENTRY_ATTR_ACTION_TUNNEL_ID,
+                                                tunnel_id);
+
+    ASSERT_EQ (SAI_STATUS_SUCCESS, status);
+
+    /* Same key is rejected */
+    status = sai_test_tunnel_term_entry_create (&dup_term_id,
+                                                max_tunnel_term_attr_count,
+                                                SAI_TUNNEL_TERM_TABLE_ENTRY_ATTR_VR_ID,
+                                                dflt_vr_id,
+                                                SAI_TUNNEL_TERM_TABLE_ENTRY_ATTR_TYPE,
+                                                SAI_TUNNEL_TERM_TABLE_ENTRY_TYPE_P2P,
+                                                SAI_TUNNEL_TERM_TABLE_ENTRY_ATTR_DST_IP,
+                                                ip4_af, tunnel_sip,
+                                                SAI_TUNNEL_TERM_TABLE_ENTRY_ATTR_SRC_IP,
+                                                ip4_af, tunnel_dip,
+                                                SAI_TUNNEL_TERM_TABLE_ENTRY_ATTR_TUNNEL_TYPE,
+                                                SAI_TUNNEL_TYPE_IPINIP,
+                                                SAI_TUNNEL_TERM_TABLE_ENTRY_ATTR_ACTION_TUNNEL_ID,
+                                                tunnel_id);
+
+    EXPECT_EQ (SAI_STATUS_ITEM_ALREADY_EXISTS, status);
+
+    /* Move the entry to a new source IP in place */
+    inet_pton (AF_INET, new_remote_ip, &new_remote_addr);
+
+    memset (&attr, 0, sizeof (attr));
+    attr.id = SAI_TUNNEL_TERM_TABLE_ENTRY_ATTR_SRC_IP;
+    attr.value.ipaddr.addr_family = SAI_IP_ADDR_FAMILY_IPV4;
+    attr.value.ipaddr.addr.ip4 = new_remote_addr.s_addr;
+
+    status = p_sai_tunnel_api_tbl->set_tunnel_term_table_entry_attribute (
+                                                      tunnel_term_id, &attr);
+
+    EXPECT_EQ (SAI_STATUS_SUCCESS, status);
+
+    memset (get_attr, 0, sizeof (get_attr));
+    get_attr [0].id = SAI_TUNNEL_TERM_TABLE_ENTRY_ATTR_SRC_IP;
+    get_attr [1].id = SAI_TUNNEL_TERM_TABLE_ENTRY_ATTR_ACTION_TUNNEL_ID;
+
+    status = p_sai_tunnel_api_tbl->get_tunnel_term_table_entry_attribute (
+                                                  tunnel_term_id, 2, get_attr);
+
+    EXPECT_EQ (SAI_STATUS_SUCCESS, status);
+    EXPECT_EQ (new_remote_addr.s_addr, get_attr [0].value.ipaddr.addr.ip4);
+    EXPECT_EQ (tunnel_id, get_attr [1].value.oid);
+
+    /* A second move programs the entry back under its own Id in NPU */
+    inet_pton (AF_INET, next_remote_ip, &new_remote_addr);
+    attr.value.ipaddr.addr.ip4 = new_remote_addr.s_addr;
+
+    status = p_sai_tunnel_api_tbl->set_tunnel_term_table_entry_attribute (
+                                                      tunnel_term_id, &attr);
+
+    EXPECT_EQ (SAI_STATUS_SUCCESS, status);
+
+    status = p_sai_tunnel_api_tbl->get_tunnel_term_table_entry_attribute (
+                                                  tunnel_term_id, 2, get_attr);
+
+    EXPECT_EQ (SAI_STATUS_SUCCESS, status);
+    EXPECT_EQ (new_remote_addr.s_addr, get_attr [0].value.ipaddr.addr.ip4);
+
+    /* The old key is free again, and moving back onto it is rejected */
+    status = sai_test_tunnel_term_entry_create (&tunnel_term_id_2,
+                                                max_tunnel_term_attr_count,
+                                                SAI_TUNNEL_TERM_TABLE_ENTRY_ATTR_VR_ID,
+                                                dflt_vr_id,
+                                                SAI_TUNNEL_TERM_TABLE_ENTRY_ATTR_TYPE,
+                                                SAI_TUNNEL_TERM_TABLE_ENTRY_TYPE_P2P,
+                                                SAI_TUNNEL_TERM_TABLE_ENTRY_ATTR_DST_IP,
+                                                ip4_af, tunnel_sip,
+                                                SAI_TUNNEL_TERM_TABLE_ENTRY_ATTR_SRC_IP,
+                                                ip4_af, tunnel_dip,
+                                                SAI_TUNNEL_TERM_TABLE_ENTRY_ATTR_TUNNEL_TYPE,
+                                                SAI_TUNNEL_TYPE_IPINIP,
+                                                SAI_TUNNEL_TERM_TABLE_ENTRY_ATTR_ACTION_TUNNEL_ID,
+                                                tunnel_id);
+
+    ASSERT_EQ (SAI_STATUS_SUCCESS, status);
+
+    inet_pton (AF_INET, tunnel_dip, &attr.value.ipaddr.addr.ip4);
+
+    status = p_sai_tunnel_api_tbl->set_tunnel_term_table_entry_attribute (
+                                                      tunnel_term_id, &attr);
+
+    EXPECT_EQ (SAI_STATUS_ITEM_ALREADY_EXISTS, status);
+
+    /* Type is part of the key and can not be changed */
+    memset (&attr, 0, sizeof (attr));
+    attr.id = SAI_TUNNEL_TERM_TABLE_ENTRY_ATTR_TYPE;
+    attr.value.s32 = SAI_TUNNEL_TERM_TABLE_ENTRY_TYPE_P2MP;
+
+    status = p_sai_tunnel_api_tbl->set_tunnel_term_table_entry_attribute (
+                                                      tunnel_term_id, &attr);
+
+    EXPECT_NE (SAI_STATUS_SUCCESS, status);
+
+    status = sai_test_tunnel_term_entry_remove (tunnel_term_id_2);
+
+    EXPECT_EQ (SAI_STATUS_SUCCESS, status);
+
+    status = sai_test_tunnel_term_entry_remove (tunnel_term_id);
+
+    EXPECT_EQ (SAI_STATUS_SUCCESS, status);
+
+    status = sai_test_tunnel_remove (tunnel_id);
+
+    EXPECT_EQ (SAI_STATUS_SUCCESS, status);
+}
+
+/*
+ * Validates tunnel list sizing and per tunnel status of the multi tunnel
+ * stats snapshot.
+ */
+TEST_F (saiTunnelTest, tunnel_stats_snapshot)
+{
+    sai_status_t       status;
+    sai_object_id_t    tunnel_id = SAI_NULL_OBJECT_ID;
+    sai_object_id_t    tunnel_list [2];
+    sai_status_t       tunnel_statuses [2];
+    uint64_t           counters [2];
+    uint64_t           timestamp_us = 0;
+    uint32_t           tunnel_count = 0;
+    sai_tunnel_stat_t  counter_id = SAI_TUNNEL_STAT_IN_PACKETS;
+
+    status = sai_test_tunnel_create (&tunnel_id, dflt_tunnel_obj_attr_count,
+                                     SAI_TUNNEL_ATTR_TYPE,
+                                     SAI_TUNNEL_TYPE_IPINIP,
+                                     SAI_TUNNEL_ATTR_UNDERLAY_INTERFACE,
+                                     dflt_port_rif_id,
+                                     SAI_TUNNEL_ATTR_OVERLAY_INTERFACE,
+                                     dflt_overlay_rif_id,
+                                     SAI_TUNNEL_ATTR_ENCAP_SRC_IP,
+                                     SAI_IP_ADDR_FAMILY_IPV4,
+                                     "10.0.0.1");
+
+    ASSERT_EQ (SAI_STATUS_SUCCESS, status);
+
+    /* Size query for all tunnels */
+    status = dn_sai_tunnel_stats_snapshot_get (true, &tunnel_count, NULL, 1,
+                                               &counter_id, false, NULL, NULL,
+                                               NULL);
+
+    EXPECT_EQ (SAI_STATUS_BUFFER_OVERFLOW, status);
+    EXPECT_GE (tunnel_count, 1u);
+
+    /* Unknown tunnel is reported in its own status */
+    tunnel_list [0] = tunnel_id;
+    tunnel_list [1] = SAI_NULL_OBJECT_ID;
+    tunnel_count = 2;
+
+    status = dn_sai_tunnel_stats_snapshot_get (false, &tunnel_count, tunnel_list,
+                                               1, &counter_id, false, counters,
+                                               tunnel_statuses, &timestamp_us);
+
+    EXPECT_EQ (SAI_STATUS_FAILURE, status);
+    EXPECT_EQ (SAI_STATUS_INVALID_OBJECT_ID, tunnel_statuses [1]);
+    EXPECT_NE (0u, timestamp_us);
+
+    status = sai_test_tunnel_remove (tunnel_id);
+
+    EXPECT_EQ (SAI_STATUS_SUCCESS, status);
+}
+
 /*
  * Validates IP Tunnel Encap Next Hop object creation and removal.
  */
@@ -1159,6 +1375,173 @@ TEST_F (saiTunnelTest, overlay_next_hop_group_add_remove_next_hop)
     EXPECT_EQ (SAI_STATUS_SUCCESS, status);
 }
 
+/* Visits per route recorded by the Encap NH dependent route walker */
+static std::map<const sai_fib_route_t *, unsigned int> dep_route_walk_visits;
+
+static void sai_test_dep_route_walk_visit (const sai_fib_route_t *p_route)
+{
+    dep_route_walk_visits [p_route]++;
+}
+
+static void sai_test_dep_route_walk_wait (sai_fib_encap_nh_walk_stats_t *p_stats)
+{
+    const unsigned int max_wait_count = 1000;
+
+    for (unsigned int itr = 0; itr < max_wait_count; itr++)
+    {
+        sai_fib_encap_nh_dep_route_walk_stats_get (p_stats);
+
+        if (p_stats->pending_encap_nh_count == 0) {
+            return;
+        }
+
+        usleep (10000);
+    }
+}
+
+/*
+ * Validates that the Encap Next Hop dependent route walk stops at the per
+ * FIB lock hold bound and that the resumed walk visits every dependent
+ * route exactly once.
+ */
+TEST_F (saiTunnelTest, tunnel_encap_next_hop_dep_route_bounded_walk)
+{
+    sai_status_t          status;
+    sai_object_id_t       tunnel_id = SAI_NULL_OBJECT_ID;
+    sai_object_id_t       encap_nh_id = SAI_NULL_OBJECT_ID;
+    const char           *tunnel_sip = "100.1.1.1";
+    const char           *tunnel_dip = "200.1.1.1";
+    const char           *prefix_str = "200.1.0.0";
+    const unsigned int    prefix_len = 16;
+    const unsigned int    route_attr_count = 1;
+    sai_ip_addr_family_t  ip4_af = SAI_IP_ADDR_FAMILY_IPV4;
+    const unsigned int    route_count =
+                             ((2 * SAI_FIB_MAX_DEP_ROUTES_WALK_COUNT) + 10);
+    const unsigned int    min_batch_count =
+                             ((route_count + SAI_FIB_MAX_DEP_ROUTES_WALK_COUNT - 1) /
+                              SAI_FIB_MAX_DEP_ROUTES_WALK_COUNT);
+    const unsigned int    overlay_ip4_route_len = 24;
+    char                  overlay_ip4_route [32];
+    sai_fib_encap_nh_walk_stats_t start_stats;
+    sai_fib_encap_nh_walk_stats_t end_stats;
+
+    status = sai_test_tunnel_create (&tunnel_id, dflt_tunnel_obj_attr_count,
+                                     SAI_TUNNEL_ATTR_TYPE,
+                                     SAI_TUNNEL_TYPE_IPINIP,
+                                     SAI_TUNNEL_ATTR_UNDERLAY_INTERFACE,
+                                     dflt_port_rif_id,
+                                     SAI_TUNNEL_ATTR_OVERLAY_INTERFACE,
+                                     dflt_overlay_rif_id,
+                                     SAI_TUNNEL_ATTR_ENCAP_SRC_IP,
+                                     SAI_IP_ADDR_FAMILY_IPV4, tunnel_sip);
+
+    ASSERT_EQ (SAI_STATUS_SUCCESS, status);
+
+    /* Create a Underlay route for the tunnel DIP */
+    status = saiL3Test::sai_test_route_create (dflt_vr_id, ip4_af,
+                                               prefix_str, prefix_len,
+                                               route_attr_count,
+                                               SAI_ROUTE_ENTRY_ATTR_NEXT_HOP_ID,
+                                               dflt_underlay_port_nh_id);
+    ASSERT_EQ (SAI_STATUS_SUCCESS, status);
+
+    /* Create the tunnel encap next hop object */
+    status = saiL3Test::sai_test_nexthop_create (&encap_nh_id,
+                                                 dflt_tunnel_encap_nh_attr_count,
+                                                 SAI_NEXT_HOP_ATTR_TYPE,
+                                                 SAI_NEXT_HOP_TYPE_TUNNEL_ENCAP,
+                                                 SAI_NEXT_HOP_ATTR_IP,
+                                                 ip4_af, tunnel_dip,
+                                                 SAI_NEXT_HOP_ATTR_ROUTER_INTERFACE_ID,
+                                                 dflt_port_rif_id,
+                                                 SAI_NEXT_HOP_ATTR_TUNNEL_ID,
+                                                 tunnel_id);
+
+    ASSERT_EQ (SAI_STATUS_SUCCESS, status);
+
+    /* Create more Overlay routes than a single walk batch reprograms */
+    for (unsigned int itr = 0; itr < route_count; itr++)
+    {
+        snprintf (overlay_ip4_route, sizeof (overlay_ip4_route), "%u.%u.%u.0",
+                  (150 + (itr / 256)), (itr % 256), 1);
+
+        status = saiL3Test::sai_test_route_create (dflt_overlay_vr_id, ip4_af,
+                                                   overlay_ip4_route,
+                                                   overlay_ip4_route_len,
+                                                   route_attr_count,
+                                                   SAI_ROUTE_ENTRY_ATTR_NEXT_HOP_ID,
+                                                   encap_nh_id);
+        ASSERT_EQ (SAI_STATUS_SUCCESS, status);
+    }
+
+    sai_test_dep_route_walk_wait (&start_stats);
+    ASSERT_EQ (0, start_stats.pending_encap_nh_count);
+
+    dep_route_walk_visits.clear ();
+    sai_fib_encap_nh_dep_route_walk_visit_fn_set (sai_test_dep_route_walk_visit);
+
+    /* Move the Underlay route to the NHG to trigger a single walk */
+    status = saiL3Test::sai_test_route_attr_set (dflt_vr_id, ip4_af,
+                                                 prefix_str, prefix_len,
+                                                 SAI_ROUTE_ENTRY_ATTR_NEXT_HOP_ID,
+                                                 dflt_underlay_nhg_id);
+    EXPECT_EQ (SAI_STATUS_SUCCESS, status);
+
+    sai_test_dep_route_walk_wait (&end_stats);
+
+    sai_fib_encap_nh_dep_route_walk_visit_fn_set (NULL);
+
+    EXPECT_EQ (0, end_stats.pending_encap_nh_count);
+    EXPECT_EQ (1, (end_stats.walks_completed - start_stats.walks_completed));
+    EXPECT_EQ (route_count,
+               (end_stats.routes_walked - start_stats.routes_walked));
+
+    /* The walk was split across batches at the bound and then resumed */
+    EXPECT_GE ((end_stats.batches - start_stats.batches), min_batch_count);
+
+    /* Every dependent route is visited exactly once */
+    EXPECT_EQ (route_count, dep_route_walk_visits.size ());
+
+    for (std::map<const sai_fib_route_t *, unsigned int>::iterator it =
+         dep_route_walk_visits.begin (); it != dep_route_walk_visits.end (); ++it)
+    {
+        EXPECT_EQ (1, it->second);
+    }
+
+    /* Remove the Overlay routes */
+    for (unsigned int itr = 0; itr < route_count; itr++)
+    {
+        snprintf (overlay_ip4_route, sizeof (overlay_ip4_route), "%u.%u.%u.0",
+                  (150 + (itr / 256)), (itr % 256), 1);
+
+        status = saiL3Test::sai_test_route_remove (dflt_overlay_vr_id, ip4_af,
+                                                   overlay_ip4_route,
+                                                   overlay_ip4_route_len);
+        EXPECT_EQ (SAI_STATUS_SUCCESS, status);
+    }
+
+    /* Remove the tunnel encap next hop */
+    status = saiL3Test::sai_test_nexthop_remove (encap_nh_id);
+
+    EXPECT_EQ (SAI_STATUS_SUCCESS, status);
+
+    /* Set the Underlay route back to the port NH and remove it */
+    status = saiL3Test::sai_test_route_attr_set (dflt_vr_id, ip4_af,
+                                                 prefix_str, prefix_len,
+                                                 SAI_ROUTE_ENTRY_ATTR_NEXT_HOP_ID,
+                                                 dflt_underlay_port_nh_id);
+    EXPECT_EQ (SAI_STATUS_SUCCESS, status);
+
+    status = saiL3Test::sai_test_route_remove (dflt_vr_id, ip4_af,
+                                               prefix_str, prefix_len);
+    EXPECT_EQ (SAI_STATUS_SUCCESS, status);
+
+    /* Remove the tunnel object */
+    status = sai_test_tunnel_remove (tunnel_id);
+
+    EXPECT_EQ (SAI_STATUS_SUCCESS, status);
+}
+
 int main (int argc, char **argv)
 {
     ::testing::InitGoogleTest(&argc, argv);